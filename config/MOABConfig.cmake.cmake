@@ -46,6 +46,7 @@ set(MOAB_USE_LAPACK @MOAB_HAVE_LAPACK@)
 set(LAPACK_LIBRARIES "@LAPACK_LIBRARIES@")
 set(MOAB_USE_EIGEN @MOAB_HAVE_EIGEN3@)
 set(EIGEN3_DIR "@EIGEN3_DIR@")
+set(MOAB_USE_OPENMP @MOAB_HAVE_OPENMP@)
 
 set(MOAB_MESH_DIR "@CMAKE_SOURCE_DIR@/MeshFiles/unittest")
 
@@ -116,7 +116,8 @@ enablezlib=no
 if test "x$ZLIB_DIR" != "xno"; then
   old_LDFLAGS="$LDFLAGS"
   LDFLAGS="$LDFLAGS $HDF5_LDFLAGS"
-  AC_CHECK_LIB([z],[deflate],[enablezlib=yes; HDF5_LIBS="$HDF5_LIBS -lz"],
+  AC_CHECK_LIB([z],[deflate],[enablezlib=yes; HDF5_LIBS="$HDF5_LIBS -lz"
+    AC_DEFINE([HAVE_ZLIB],[1],[Define if configured with zlib compression support.])],
     [if test "x$ZLIB_DIR" != "x"; then AC_MSG_ERROR([Could not find zlib]); fi])
   LDFLAGS="$old_LDFLAGS"
 fi
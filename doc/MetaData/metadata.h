@@ -216,6 +216,10 @@ Indicates that no mixed elements (e.g. pentagons and hexagons) should be created
 
 Indicates that no edges should be created and no edge variables will be read. This option can be used when there is no need to read variables on edges. For a huge MPAS file with 65M cells, it can save more than 3GB MOAB internal storage for edge connectivity.
 
+<H3>prefetch_timesteps </H3>
+
+Indicates that, when several time steps of a variable are read, the reads of all of them should be posted before PnetCDF is asked to complete them, so that they are serviced by one collective wait instead of one per time step. PnetCDF does the actual I/O of nonblocking requests inside that wait, so this does not overlap I/O with computation; it aggregates the requests into fewer, larger collective reads. This option is only effective with PnetCDF builds, for float and double variables of HOMME, MPAS, GCRM and Eulerian/finite-volume files. Time steps are read straight into tag storage, except for MPAS cell variables when the cells are split into several groups; those are read two time steps at a time, with a second buffer the size of one time step of the variable. The values read are identical to those read without this option.
+
 \ref md-contents "Top"
 
   \section meta-references References
@@ -15,11 +15,39 @@ from . import types
 from libcpp.vector cimport vector
 from libcpp.string cimport string as std_string
 from libc.stdlib cimport malloc
+from libc.string cimport memcpy
 
 from collections import Iterable
 
 cdef void* null = NULL
 
+np.import_array()
+
+cdef object _array_view(object owner, void* ptr, int count, int entry_bytes, dtype, bint writeable):
+    """
+    Returns a NumPy array of count entries of entry_bytes bytes each, viewing
+    the memory at ptr rather than copying it. The array holds a reference to
+    owner so that the memory is not freed while the array is in use.
+    """
+    cdef np.npy_intp dims[2]
+    dims[0] = count
+    dims[1] = entry_bytes
+    cdef np.ndarray arr = np.PyArray_SimpleNewFromData(2, dims, np.NPY_UINT8, ptr)
+    np.set_array_base(arr, owner)
+    view = arr.view(dtype)
+    view.flags.writeable = writeable
+    return view
+
+cdef Range _as_range(entities):
+    if isinstance(entities, Range):
+        return entities
+    return Range(entities)
+
+cdef Range _chunk_range(eh.EntityHandle first, int count):
+    cdef Range r = Range()
+    r.inst.insert(first, first + count - 1)
+    return r
+
 cdef class Core(object):
 
     def __cinit__(self):
@@ -551,6 +579,10 @@ cdef class Core(object):
         """
         Create an elments of type, entity_type, using vertex EntityHandles in connectivity.
 
+        All elements are created in a single block of contiguous handles and
+        the connectivity is copied in one pass, so this is much faster than
+        repeated calls to create_element when creating many elements.
+
         Example
         -------
         mb = core.Core()
@@ -594,21 +626,38 @@ cdef class Core(object):
         ValueError
             if an EntityHandle is not of the correct type
         """
-        cdef int i
         cdef moab.ErrorCode err
         cdef moab.EntityType typ = <moab.EntityType> entity_type
         cdef np.ndarray connectivity_as_arr = np.asarray(connectivity)
         assert connectivity_as_arr.ndim == 2 #required for now
         cdef int nelems = connectivity_as_arr.shape[0]
         cdef int nnodes = connectivity_as_arr.shape[1]
-        cdef np.ndarray[np.uint64_t, ndim=1] connectivity_i
-        cdef np.ndarray[np.uint64_t, ndim=1] handles = np.empty(nelems, 'uint64')
-        for i in range(nelems):
-            connectivity_i = _eh_array(connectivity[i])
-            err = self.inst.create_element(typ, <eh.EntityHandle*> connectivity_i.data,
-                                           nnodes, deref((<eh.EntityHandle*> handles.data)+i))
-            check_error(err, exceptions)
-        return Range(handles)
+        cdef Range rng = Range()
+        if nelems == 0:
+            return rng
+        if typ == moab.MBVERTEX or typ == moab.MBENTITYSET:
+            check_error(moab.MB_TYPE_OUT_OF_RANGE, exceptions)
+            return rng
+        # make sure we have enough vertices for this entity type
+        if nnodes < moab.VerticesPerEntity(typ):
+            check_error(moab.MB_FAILURE, exceptions)
+            return rng
+        cdef np.ndarray[np.uint64_t, ndim=1] conn_arr = np.ascontiguousarray(_eh_array(connectivity_as_arr.ravel()))
+        # allocate all elements in one block, as file readers do
+        cdef moab.ReadUtilIface* read_iface = NULL
+        err = self.inst.query_interface(read_iface)
+        check_error(err, exceptions)
+        cdef eh.EntityHandle start_handle = 0
+        cdef eh.EntityHandle* conn = NULL
+        # 1 is the first entity id (MB_START_ID)
+        err = read_iface.get_element_connect(nelems, nnodes, typ, 1, start_handle, conn)
+        if err == moab.MB_SUCCESS:
+            memcpy(conn, conn_arr.data, nelems*nnodes*sizeof(eh.EntityHandle))
+            err = read_iface.update_adjacencies(start_handle, nelems, nnodes, conn)
+        self.inst.release_interface(read_iface)
+        check_error(err, exceptions)
+        rng.inst.insert(start_handle, start_handle + nelems - 1)
+        return rng
 
     def tag_get_handle(self,
                        name,
@@ -970,6 +1019,81 @@ cdef class Core(object):
             entry_len = 1 if tag_type == types.MB_TYPE_OPAQUE else length
             return data.reshape((ehs.size,entry_len))
 
+    def tag_iterate(self, Tag tag, entities, bint writeable = False, exceptions = ()):
+        """
+        Provides direct access to the data of a tag, without copying. The
+        entities are split into blocks whose tag values are contiguous in
+        MOAB's storage, and for each block a Numpy array viewing that storage
+        is returned. Tag storage is allocated for entities which do not have
+        a value yet. This is intended for dense tags: the values of a sparse
+        tag are not contiguous, so each block holds a single entity.
+
+        The arrays keep this Core alive, but they are invalidated if the
+        entities they cover are deleted.
+
+        Example
+        -------
+        temp_tag = mb.tag_get_handle("Temperature", 1, types.MB_TYPE_DOUBLE,
+                                     types.MB_TAG_DENSE, create_if_missing = True)
+        verts = mb.get_entities_by_type(0, types.MBVERTEX)
+        for ents, temp in mb.tag_iterate(temp_tag, verts, writeable = True):
+            temp[:] = 300.0
+
+        Parameters
+        ----------
+        tag : MOAB TagHandle
+            a tag of fixed length (bit tags are not supported)
+        entities : Range, iterable of MOAB EntityHandles or a single EntityHandle
+            the entities to access the tag data of
+        writeable : bool (default is False)
+            If True, the returned arrays can be modified, changing the tag
+            values in MOAB. Otherwise they are read-only.
+        exceptions : tuple (default is empty tuple)
+            A tuple containing any error types that should
+            be ignored. (see pymoab.types module for more info)
+
+        Returns
+        -------
+        List of (Range, array) pairs, one per block of contiguous data. The
+        Range holds the entities of the block and the array has shape
+        (len(Range), tag length), or (len(Range), 1) for opaque tags, with
+        dtype matching that of the tag's type.
+
+        Raises
+        ------
+        MOAB ErrorCode
+            if a MOAB error occurs
+        ValueError
+            if an EntityHandle is not of the correct type
+        """
+        cdef moab.ErrorCode err
+        cdef Range r = _as_range(entities)
+        cdef moab.DataType tag_type = moab.MB_MAX_DATA_TYPE
+        err = self.inst.tag_get_data_type(tag.inst, tag_type)
+        check_error(err, exceptions)
+        cdef int length = 0
+        err = self.inst.tag_get_length(tag.inst, length)
+        check_error(err, exceptions)
+        if tag_type == types.MB_TYPE_OPAQUE:
+            dtype = np.dtype('S'+str(length))
+        else:
+            dtype = np.dtype(np_tag_type(tag_type))
+        cdef int entry_bytes = length if tag_type == types.MB_TYPE_OPAQUE else length*dtype.itemsize
+        cdef moab.Range.const_iterator it = r.inst.begin()
+        cdef moab.Range.const_iterator end = r.inst.end()
+        cdef void* data = NULL
+        cdef int count = 0
+        blocks = []
+        while it != end:
+            err = self.inst.tag_iterate(tag.inst, it, end, count, data, True)
+            check_error(err, exceptions)
+            if err != moab.MB_SUCCESS:
+                break
+            blocks.append((_chunk_range(deref(it), count),
+                           _array_view(self, data, count, entry_bytes, dtype, writeable)))
+            it = r.inst.lower_bound(deref(it) + count)
+        return blocks
+
     def tag_delete_data(self, Tag tag, entity_handles, exceptions = ()):
         """
         Delete the data of a tag on a set of EntityHandle's. Only sparse tag
@@ -1380,6 +1504,68 @@ cdef class Core(object):
 
         return np.asarray(ehs_out, dtype = np.uint64)
 
+    def connect_iterate(self, entities, bint writeable = False, exceptions = ()):
+        """
+        Provides direct access to the connectivity of mesh entities, without
+        copying. The entities are split into blocks whose connectivity is
+        contiguous in MOAB's storage, and for each block a Numpy array viewing
+        that storage is returned.
+
+        The arrays keep this Core alive, but they are invalidated if the
+        entities they cover are deleted.
+
+        Example
+        -------
+        hexes = mb.get_entities_by_type(0, types.MBHEX)
+        for ents, conn in mb.connect_iterate(hexes):
+            # conn is a (len(ents), 8) array of vertex handles
+            corners = conn[:,0]
+
+        Parameters
+        ----------
+        entities : Range, iterable of MOAB EntityHandles or a single EntityHandle
+            the elements to access the connectivity of. Polyhedra are not
+            supported.
+        writeable : bool (default is False)
+            If True, the returned arrays can be modified, changing the
+            connectivity in MOAB. Note that vertex adjacencies are not updated
+            when doing so. Otherwise the arrays are read-only.
+        exceptions : tuple (default is empty tuple)
+            A tuple containing any error types that should
+            be ignored. (see pymoab.types module for more info)
+
+        Returns
+        -------
+        List of (Range, array) pairs, one per block of contiguous data. The
+        Range holds the elements of the block and the array of vertex
+        EntityHandles has shape (len(Range), vertices per element).
+
+        Raises
+        ------
+        MOAB ErrorCode
+            if a MOAB error occurs
+        ValueError
+            if an EntityHandle is not of the correct type
+        """
+        cdef moab.ErrorCode err
+        cdef Range r = _as_range(entities)
+        cdef moab.Range.const_iterator it = r.inst.begin()
+        cdef moab.Range.const_iterator end = r.inst.end()
+        cdef eh.EntityHandle* conn = NULL
+        cdef int verts_per_ent = 0
+        cdef int count = 0
+        dtype = np.dtype(np.uint64)
+        blocks = []
+        while it != end:
+            err = self.inst.connect_iterate(it, end, conn, verts_per_ent, count)
+            check_error(err, exceptions)
+            if err != moab.MB_SUCCESS:
+                break
+            blocks.append((_chunk_range(deref(it), count),
+                           _array_view(self, conn, count, verts_per_ent*dtype.itemsize, dtype, writeable)))
+            it = r.inst.lower_bound(deref(it) + count)
+        return blocks
+
     def get_coords(self, entities, exceptions = ()):
         """
         Returns the xyz coordinate information for a set of vertices.
@@ -1473,6 +1659,85 @@ cdef class Core(object):
             err = self.inst.set_coords(<eh.EntityHandle*> arr.data, len(entities), <const double*> coords.data)
         check_error(err, exceptions)
 
+    def coords_iterate(self, entities, bint writeable = False, exceptions = ()):
+        """
+        Provides direct access to the coordinates of vertices, without
+        copying. The vertices are split into blocks whose coordinates are
+        contiguous in MOAB's storage, and for each block Numpy arrays viewing
+        that storage are returned. MOAB stores the x, y and z coordinates in
+        separate arrays, so there is one array for each.
+
+        The arrays keep this Core alive, but they are invalidated if the
+        vertices they cover are deleted.
+
+        Example
+        -------
+        verts = mb.get_entities_by_type(0, types.MBVERTEX)
+        for ents, (x, y, z) in mb.coords_iterate(verts, writeable = True):
+            # translate the mesh
+            x += 1.0
+
+        Parameters
+        ----------
+        entities : Range, iterable of MOAB EntityHandles or a single EntityHandle
+            the vertices to access the coordinates of
+        writeable : bool (default is False)
+            If True, the returned arrays can be modified, moving the vertices
+            in MOAB. Otherwise they are read-only.
+        exceptions : tuple (default is empty tuple)
+            A tuple containing any error types that should
+            be ignored. (see pymoab.types module for more info)
+
+        Returns
+        -------
+        List of (Range, (x, y, z)) pairs, one per block of contiguous data.
+        The Range holds the vertices of the block and x, y and z are 1-D
+        arrays of len(Range) values. Their dtype is float64, or float32 for
+        vertices stored in single precision.
+
+        Raises
+        ------
+        MOAB ErrorCode
+            if a MOAB error occurs
+        ValueError
+            if an EntityHandle is not of the correct type
+        """
+        cdef moab.ErrorCode err
+        cdef Range r = _as_range(entities)
+        cdef moab.Range.const_iterator it = r.inst.begin()
+        cdef moab.Range.const_iterator end = r.inst.end()
+        cdef double* x = NULL
+        cdef double* y = NULL
+        cdef double* z = NULL
+        cdef float* xf = NULL
+        cdef float* yf = NULL
+        cdef float* zf = NULL
+        cdef int count = 0
+        blocks = []
+        while it != end:
+            err = self.inst.coords_iterate(it, end, x, y, z, count)
+            if err == moab.MB_TYPE_OUT_OF_RANGE:
+                # possibly a block of single precision vertices
+                err = self.inst.coords_iterate(it, end, xf, yf, zf, count)
+                check_error(err, exceptions)
+                if err != moab.MB_SUCCESS:
+                    break
+                dtype = np.dtype(np.float32)
+                xyz = (_array_view(self, xf, count, dtype.itemsize, dtype, writeable).reshape(count),
+                       _array_view(self, yf, count, dtype.itemsize, dtype, writeable).reshape(count),
+                       _array_view(self, zf, count, dtype.itemsize, dtype, writeable).reshape(count))
+            else:
+                check_error(err, exceptions)
+                if err != moab.MB_SUCCESS:
+                    break
+                dtype = np.dtype(np.float64)
+                xyz = (_array_view(self, x, count, dtype.itemsize, dtype, writeable).reshape(count),
+                       _array_view(self, y, count, dtype.itemsize, dtype, writeable).reshape(count),
+                       _array_view(self, z, count, dtype.itemsize, dtype, writeable).reshape(count))
+            blocks.append((_chunk_range(deref(it), count), xyz))
+            it = r.inst.lower_bound(deref(it) + count)
+        return blocks
+
     def get_entities_by_type(self, meshset, entity_type, bint recur = False, bint as_list = False, exceptions = ()):
         """
         Retrieves all entities of a given entity type in the database or meshset
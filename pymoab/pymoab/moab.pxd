@@ -34,6 +34,7 @@ cdef extern from 'moab/Types.hpp' namespace "moab":
         MB_TAG_ANY
         MB_TAG_NOOPQ
         MB_TAG_DFTOK
+        MB_TAG_FLOAT
 
 
 cdef extern from "TagInfo.hpp" namespace "moab":
@@ -86,6 +87,10 @@ cdef extern from "moab/EntityType.hpp" namespace "moab":
         MBENTITYSET
         MBMAXTYPE
 
+cdef extern from "moab/CN.hpp" namespace "moab::CN":
+
+    short VerticesPerEntity(EntityType t)
+
 cdef extern from "moab/Range.hpp" namespace "moab":
 
     Range intersect(Range&, Range&)
@@ -93,6 +98,12 @@ cdef extern from "moab/Range.hpp" namespace "moab":
     Range unite(Range&, Range&)
 
     cdef cppclass Range:
+        cppclass const_iterator:
+            EntityHandle operator*()
+            const_iterator operator++()
+            bint operator==(const_iterator)
+            bint operator!=(const_iterator)
+
         Range()
         Range(EntityHandle val1, EntityHandle val2)
 
@@ -107,6 +118,7 @@ cdef extern from "moab/Range.hpp" namespace "moab":
         void print_ "print"()
         std_string str_rep()
         void insert(EntityHandle val)
+        void insert(EntityHandle val1, EntityHandle val2)
         void erase(EntityHandle val)
         void merge(Range& range)
         bool contains(const Range& range)
@@ -119,6 +131,10 @@ cdef extern from "moab/Range.hpp" namespace "moab":
 
         EntityHandle operator[](EntityID index)
 
+        const_iterator begin()
+        const_iterator end()
+        const_iterator lower_bound(EntityHandle val)
+
 
 cdef extern from "moab/Interface.hpp" namespace "moab":
 
@@ -148,6 +164,21 @@ cdef extern from "moab/MeshTopoUtil.hpp" namespace "moab":
                                        double * avg_position)
 
 
+cdef extern from "moab/ReadUtilIface.hpp" namespace "moab":
+
+    cdef cppclass ReadUtilIface:
+        ErrorCode get_element_connect(const int num_elements,
+                                      const int verts_per_element,
+                                      const EntityType mdb_type,
+                                      const int preferred_start_id,
+                                      EntityHandle& actual_start_handle,
+                                      EntityHandle*& array)
+        ErrorCode update_adjacencies(const EntityHandle start_handle,
+                                     const int number_elements,
+                                     const int number_vertices_per_element,
+                                     const EntityHandle* conn_array)
+
+
 cdef extern from "moab/Core.hpp" namespace "moab":
 
     cdef cppclass Core:
@@ -183,6 +214,9 @@ cdef extern from "moab/Core.hpp" namespace "moab":
                             const char *options, const char *set_tag_names,
                             const char *set_tag_values, int num_set_tag_values)
 
+        ErrorCode query_interface(ReadUtilIface*& iface)
+        ErrorCode release_interface(ReadUtilIface* iface)
+
         ErrorCode create_meshset(const unsigned int options, EntityHandle &ms_handle)
         ErrorCode create_meshset(const unsigned int options, EntityHandle &ms_handle, int start_id)
 
@@ -241,6 +275,13 @@ cdef extern from "moab/Core.hpp" namespace "moab":
 
         ErrorCode tag_delete(Tag tag_handle);
 
+        ErrorCode tag_iterate(Tag tag_handle,
+                              Range.const_iterator begin,
+                              Range.const_iterator end,
+                              int& count,
+                              void*& data_ptr,
+                              bool allocate)
+
         ErrorCode tag_get_data_type(const Tag tag_handle,
 	                            DataType& type)
         ErrorCode tag_get_length(const Tag tag_handle,
@@ -286,6 +327,23 @@ cdef extern from "moab/Core.hpp" namespace "moab":
                              double* coords)
         ErrorCode get_coords(const Range& entity_handles,
                              double* coords)
+        ErrorCode coords_iterate(Range.const_iterator iter,
+                                 Range.const_iterator end,
+                                 double*& xcoords_ptr,
+                                 double*& ycoords_ptr,
+                                 double*& zcoords_ptr,
+                                 int& count)
+        ErrorCode coords_iterate(Range.const_iterator iter,
+                                 Range.const_iterator end,
+                                 float*& xcoords_ptr,
+                                 float*& ycoords_ptr,
+                                 float*& zcoords_ptr,
+                                 int& count)
+        ErrorCode connect_iterate(Range.const_iterator iter,
+                                  Range.const_iterator end,
+                                  EntityHandle*& connect,
+                                  int& verts_per_entity,
+                                  int& count)
         ErrorCode set_coords(const EntityHandle* entity_handles,
                              const int num_entities,
                              const double* coords)
@@ -249,6 +249,7 @@ MB_TAG_STORE = moab.MB_TAG_STORE
 MB_TAG_ANY = moab.MB_TAG_ANY   
 MB_TAG_NOOPQ = moab.MB_TAG_NOOPQ 
 MB_TAG_DFTOK = moab.MB_TAG_DFTOK 
+MB_TAG_FLOAT = moab.MB_TAG_FLOAT
 
 # Query selection types
 INTERSECT = 0
@@ -1065,6 +1065,37 @@ def test_create_elements_iterable():
     all_tris = mb.get_entities_by_type(rs,types.MBTRI)
     CHECK_EQ(len(all_tris),4)
 
+def test_create_elements_bulk():
+    mb = core.Core()
+    # a row of n hexes
+    n = 100
+    coords = np.array([(i,j,k) for i in range(n+1) for k in (0,1) for j in (0,1)],dtype='float64')
+    verts = mb.create_vertices(coords)
+    conn = np.array([[verts[4*i+c] for c in (0,4,5,1,2,6,7,3)] for i in range(n)],dtype='uint64')
+    hexes = mb.create_elements(types.MBHEX,conn)
+    CHECK_EQ(len(hexes),n)
+    # elements are created in a single block of handles
+    CHECK_EQ(hexes[n-1]-hexes[0],n-1)
+    CHECK_ITER_EQ(mb.get_connectivity(hexes),conn.flatten())
+    # vertex to element adjacencies are up to date
+    adjs = mb.get_adjacencies(verts[4],3)
+    CHECK_ITER_EQ(adjs,hexes[0:2])
+    adjs = mb.get_adjacencies(verts[0],3)
+    CHECK_EQ(len(adjs),1)
+
+    # too few vertices for the element type
+    try:
+        mb.create_elements(types.MBHEX,conn[:,0:4])
+    except RuntimeError:
+        pass
+    else:
+        raise AssertionError("Shouldn't be able to create hexes with four vertices")
+    all_hexes = mb.get_entities_by_type(mb.get_root_set(),types.MBHEX)
+    CHECK_EQ(len(all_hexes),n)
+
+    # nothing to create
+    CHECK_EQ(len(mb.create_elements(types.MBHEX,np.empty((0,8),dtype='uint64'))),0)
+
 def test_tag_root_set():
     # make sure that the root set can be tagged with data
     mb = core.Core()
@@ -1108,6 +1139,89 @@ def test_entity_handle_tags():
     dbl_val = mb.tag_get_data(dbl_tag, eh, flat = True)[0]
     CHECK_EQ(dbl_val, val)
 
+def test_coords_iterate():
+    mb = core.Core()
+    coords = np.array((0,0,0,1,0,0,1,1,1),dtype='float64')
+    verts = mb.create_vertices(coords)
+
+    blocks = mb.coords_iterate(verts)
+    CHECK_EQ(len(blocks), 1)
+    ents, (x, y, z) = blocks[0]
+    CHECK_ITER_EQ(ents, verts)
+    CHECK_ITER_EQ(x, coords[0::3])
+    CHECK_ITER_EQ(y, coords[1::3])
+    CHECK_ITER_EQ(z, coords[2::3])
+
+    # views are read-only by default
+    try:
+        x[0] = 5.0
+    except ValueError:
+        pass
+    else:
+        raise AssertionError("Read-only coordinate view was modified")
+
+    # writing through a writeable view moves the vertices
+    for ents, (x, y, z) in mb.coords_iterate(verts, writeable = True):
+        x += 1.0
+    ret_coords = mb.get_coords(verts)
+    CHECK_ITER_EQ(ret_coords[0::3], coords[0::3] + 1.0)
+
+    # views keep the instance alive
+    del mb
+    CHECK_ITER_EQ(x, coords[0::3] + 1.0)
+
+def test_connect_iterate():
+    mb = core.Core()
+    coords = np.array((0,0,0,1,0,0,1,1,0,0,1,0),dtype='float64')
+    verts = mb.create_vertices(coords)
+    conn = np.array(((verts[0],verts[1],verts[2]),
+                     (verts[0],verts[2],verts[3])),dtype='uint64')
+    tris = mb.create_elements(types.MBTRI,conn)
+
+    blocks = mb.connect_iterate(tris)
+    CHECK_EQ(len(blocks), 1)
+    ents, tri_conn = blocks[0]
+    CHECK_ITER_EQ(ents, tris)
+    CHECK_EQ(tri_conn.shape, (2,3))
+    CHECK_ITER_EQ(tri_conn, conn)
+
+    # writing through a writeable view changes the connectivity
+    for ents, tri_conn in mb.connect_iterate(tris, writeable = True):
+        tri_conn[1,2] = verts[1]
+    CHECK_ITER_EQ(mb.get_connectivity(tris[1]), (verts[0],verts[2],verts[1]))
+
+def test_tag_iterate():
+    mb = core.Core()
+    coords = np.array((0,0,0,1,0,0,1,1,1),dtype='float64')
+    verts = mb.create_vertices(coords)
+
+    dbl_tag = mb.tag_get_handle("Dbl", 2, types.MB_TYPE_DOUBLE, types.MB_TAG_DENSE, True)
+    data = np.array((1.0,2.0,3.0,4.0,5.0,6.0))
+    mb.tag_set_data(dbl_tag, verts, data)
+
+    blocks = mb.tag_iterate(dbl_tag, verts)
+    CHECK_EQ(len(blocks), 1)
+    ents, dbl_data = blocks[0]
+    CHECK_ITER_EQ(ents, verts)
+    CHECK_EQ(dbl_data.shape, (3,2))
+    CHECK_ITER_EQ(dbl_data.flatten(), data)
+
+    # storage is allocated for entities without values
+    int_tag = mb.tag_get_handle("Int", 1, types.MB_TYPE_INTEGER, types.MB_TAG_DENSE, True)
+    for ents, int_data in mb.tag_iterate(int_tag, verts, writeable = True):
+        CHECK_EQ(int_data.dtype, np.int32)
+        int_data[:,0] = np.arange(len(ents))
+    CHECK_ITER_EQ(mb.tag_get_data(int_tag, verts, flat = True), (0,1,2))
+
+    # sparse tag values are not contiguous, each block holds one entity
+    sparse_tag = mb.tag_get_handle("Sparse", 1, types.MB_TYPE_DOUBLE, types.MB_TAG_SPARSE, True)
+    mb.tag_set_data(sparse_tag, verts, data[0:3])
+    blocks = mb.tag_iterate(sparse_tag, verts)
+    CHECK_EQ(len(blocks), 3)
+    for (ents, sparse_data), val in zip(blocks, data[0:3]):
+        CHECK_EQ(len(ents), 1)
+        CHECK_EQ(sparse_data[0,0], val)
+
 
 
 if __name__ == "__main__":
@@ -1143,6 +1257,10 @@ if __name__ == "__main__":
              test_vec_tags,
              test_create_element_iterable,
              test_create_elements_iterable,
+             test_create_elements_bulk,
              test_tag_root_set,
-             test_entity_handle_tags]
+             test_entity_handle_tags,
+             test_coords_iterate,
+             test_connect_iterate,
+             test_tag_iterate]
     test_driver(tests)
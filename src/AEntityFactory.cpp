@@ -29,6 +29,7 @@
 
 #include <assert.h>
 #include <algorithm>
+#include <iterator>
 #include <set>
 
 namespace moab {
@@ -657,6 +658,125 @@ ErrorCode AEntityFactory::notify_create_entity(const EntityHandle entity,
   return result;
 }
 
+ErrorCode AEntityFactory::notify_create_entities(const EntityHandle start_handle,
+                                                   const int number_entities,
+                                                   const int number_nodes,
+                                                   const EntityHandle *node_array)
+{
+  if (!vert_elem_adjacencies() || number_entities < 1 || number_nodes < 1)
+    return MB_SUCCESS;
+
+    // polyhedron connectivity is faces; get vertices one entity at a time
+  if (TYPE_FROM_HANDLE(start_handle) == MBPOLYHEDRON) {
+    ErrorCode result = MB_SUCCESS, tmp_result;
+    for (int i = 0; i < number_entities; ++i) {
+      tmp_result = notify_create_entity(start_handle + i,
+                                        node_array + (size_t)i*number_nodes,
+                                        number_nodes);
+      if (MB_SUCCESS != tmp_result) result = tmp_result;
+    }
+    return result;
+  }
+
+    // Number the distinct vertices in handle order, and find the number
+    // of each vertex in the connectivity list.  When the vertices are
+    // close together in handle space, as for a block of vertices just
+    // read from a file, use a lookup table rather than a sort.
+  const long num_conn = (long)number_entities * number_nodes;
+  std::vector<EntityHandle> verts;
+  std::vector<size_t> vert_index(num_conn);
+  const EntityHandle min_vert = *std::min_element(node_array, node_array + num_conn);
+  const EntityHandle max_vert = *std::max_element(node_array, node_array + num_conn);
+  if (max_vert - min_vert < (EntityHandle)(2*num_conn)) {
+    std::vector<size_t> table(max_vert - min_vert + 1, 0);
+    for (long i = 0; i < num_conn; ++i)
+      table[node_array[i] - min_vert] = 1;
+    for (size_t j = 0; j < table.size(); ++j)
+      if (table[j]) {
+        verts.push_back(min_vert + j);
+        table[j] = verts.size() - 1;
+      }
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (long i = 0; i < num_conn; ++i)
+      vert_index[i] = table[node_array[i] - min_vert];
+  }
+  else {
+    verts.assign(node_array, node_array + num_conn);
+    std::sort(verts.begin(), verts.end());
+    verts.erase(std::unique(verts.begin(), verts.end()), verts.end());
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (long i = 0; i < num_conn; ++i)
+      vert_index[i] = std::lower_bound(verts.begin(), verts.end(), node_array[i])
+                    - verts.begin();
+  }
+  const long num_verts = verts.size();
+
+    // Count the new entities adjacent to each vertex, then fill a
+    // compressed list of them.  Entities are visited in handle order,
+    // so the list for each vertex is sorted.
+  std::vector<size_t> offsets(num_verts + 1, 0);
+  for (long i = 0; i < num_conn; ++i)
+    ++offsets[vert_index[i] + 1];
+  for (long j = 0; j < num_verts; ++j)
+    offsets[j + 1] += offsets[j];
+  std::vector<EntityHandle> adj_ents(num_conn);
+  std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+  for (long i = 0; i < num_conn; ++i)
+    adj_ents[fill[vert_index[i]]++] = start_handle + i/number_nodes;
+
+    // Get the adjacency list of each vertex, creating it if necessary.
+    // This allocates storage in the sequence data, so is not done in
+    // parallel.  Handles that are not in any sequence are skipped, as
+    // they are by notify_create_entity.
+  std::vector<AdjacencyVector*> adj_lists(num_verts, (AdjacencyVector*)0);
+  long j = 0;
+  while (j < num_verts) {
+    EntitySequence* seq;
+    if (MB_SUCCESS != thisMB->sequence_manager()->find(verts[j], seq)) {
+      ++j;
+      continue;
+    }
+    SequenceData* data = seq->data();
+    if (!data->get_adjacency_data() && !data->allocate_adjacency_data())
+      return MB_MEMORY_ALLOCATION_FAILED;
+    AdjacencyVector** adj_data = data->get_adjacency_data();
+    for ( ; j < num_verts && verts[j] <= seq->end_handle(); ++j) {
+      AdjacencyVector*& ptr = adj_data[verts[j] - data->start_handle()];
+      if (!ptr)
+        ptr = new AdjacencyVector;
+      adj_lists[j] = ptr;
+    }
+  }
+
+    // Merge the new entities into the adjacency list of each vertex
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+  for (long k = 0; k < num_verts; ++k) {
+    AdjacencyVector* list = adj_lists[k];
+    if (!list)
+      continue;
+    const EntityHandle* beg = &adj_ents[0] + offsets[k];
+    const EntityHandle* end = &adj_ents[0] + offsets[k + 1];
+    const size_t old_size = list->size();
+    if (list->empty() || list->back() < *beg) {
+      list->reserve(old_size + (end - beg));
+      std::unique_copy(beg, end, std::back_inserter(*list));
+    }
+    else {
+      list->insert(list->end(), beg, end);
+      std::inplace_merge(list->begin(), list->begin() + old_size, list->end());
+      list->erase(std::unique(list->begin(), list->end()), list->end());
+    }
+  }
+
+  return MB_SUCCESS;
+}
+
 ErrorCode AEntityFactory::get_zero_to_n_elements(EntityHandle source_entity,
                             const unsigned int target_dimension,
                             std::vector<EntityHandle> &target_entities,
@@ -147,6 +147,14 @@ public:
                                     const EntityHandle *node_array,
                                     const int number_nodes);
 
+  //! calling code notifying this of a block of new entities with
+  //! contiguous handles; equivalent to calling notify_create_entity
+  //! for each, but the adjacency list of each vertex is updated once
+  ErrorCode notify_create_entities(const EntityHandle start_handle,
+                                   const int number_entities,
+                                   const int number_nodes,
+                                   const EntityHandle *node_array);
+
   //! calling code notifying that an entity changed its connectivity
   ErrorCode notify_change_connectivity(EntityHandle entity,
                                           const EntityHandle* old_array,
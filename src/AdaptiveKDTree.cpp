@@ -34,7 +34,7 @@ namespace moab {
 
     AdaptiveKDTree::AdaptiveKDTree(Interface *iface)
     : Tree(iface), planeTag(0), axisTag(0), splitsPerDir(3), planeSet(SUBDIVISION_SNAP),
-      spherical(false), radius(1.0)
+      spherical(false), radius(1.0), flatTree(false)
     {
       boxTagName = treeName;
 
@@ -46,7 +46,7 @@ namespace moab {
     AdaptiveKDTree::AdaptiveKDTree(Interface* iface, const Range &entities,
                                    EntityHandle *tree_root_set, FileOptions *opts)
             : Tree(iface), planeTag(0), axisTag(0), splitsPerDir(3), planeSet(SUBDIVISION_SNAP),
-              spherical(false), radius(1.0)
+              spherical(false), radius(1.0), flatTree(false)
     {
       boxTagName = treeName;
 
@@ -88,6 +88,12 @@ namespace moab {
         if (!options->all_seen()) return MB_FAILURE;
       }
 
+        // any flat copy is of a previous tree
+      flatNodes.clear();
+      flatEnts.clear();
+      flatVerts.clear();
+      flatCoords.clear();
+
         // calculate bounding box of elements
       BoundBox box;
       rval = box.update(*moab(), entities, spherical, radius);
@@ -180,6 +186,8 @@ namespace moab {
           rval = iter.step();
           if (MB_ENTITY_NOT_FOUND == rval) {
             rval = treeStats.compute_stats(mbImpl, myRoot);
+            if (MB_SUCCESS == rval && flatTree)
+              rval = build_flat_tree();
             treeStats.initTime = cp.time_elapsed();
             return rval;  // at end
           }
@@ -223,6 +231,10 @@ namespace moab {
       else
         radius = tmp;
 
+        //  FLAT_TREE: also copy the tree to flat in-memory arrays; default = false
+      rval = opts.get_toggle_option("FLAT_TREE", false, flatTree);
+      if (MB_SUCCESS != rval) flatTree = false;
+
       return MB_SUCCESS;
     }
 
@@ -1360,6 +1372,19 @@ namespace moab {
 
       EntityHandle node = (start_node ? *start_node : myRoot);
 
+      if (!start_node && has_flat_tree()) {
+          // descend the flat copy of the tree instead of the sets
+        if (!boundBox.contains_point(point, iter_tol)) return MB_SUCCESS;
+        const unsigned leaf = flat_leaf(point);
+        treeStats.leavesVisited++;
+        node = flatNodes[leaf].handle;
+        if (myEval && params)
+          return myEval->find_containing_entity(node, point, iter_tol, inside_tol,
+                                                leaf_out, params->array(), &treeStats.traversalLeafObjectTests);
+        leaf_out = node;
+        return MB_SUCCESS;
+      }
+
       treeStats.nodesVisited++;
       ErrorCode rval = get_bounding_box(box, &node);
       if (MB_SUCCESS != rval) return rval;
@@ -1457,6 +1482,294 @@ namespace moab {
       return MB_SUCCESS;
     }
 
+    ErrorCode AdaptiveKDTree::build_flat_tree()
+    {
+      flatNodes.clear();
+      flatEnts.clear();
+      flatVerts.clear();
+      flatCoords.clear();
+      if (!myRoot)
+        MB_SET_ERR(MB_FAILURE, "No tree to copy to flat arrays");
+
+      FlatNode root = { 0.0, -1, 0, 0, 0, 0, 0, myRoot };
+      flatNodes.push_back(root);
+
+        // depth-first, left child first, so the leaves are stored in
+        // the same order as with AdaptiveKDTreeIter
+      std::vector<unsigned> stack(1, 0);
+      std::vector<EntityHandle> children, ents;
+      Plane plane;
+      ErrorCode rval;
+      while (!stack.empty()) {
+        const unsigned n = stack.back();
+        stack.pop_back();
+        const EntityHandle node = flatNodes[n].handle;
+
+        children.clear();
+        rval = moab()->get_child_meshsets(node, children);MB_CHK_ERR(rval);
+        if (children.empty()) {
+          ents.clear();
+          rval = moab()->get_entities_by_handle(node, ents);MB_CHK_ERR(rval);
+          flatNodes[n].firstEnt = flatEnts.size();
+          flatNodes[n].numEnts = ents.size();
+          flatEnts.insert(flatEnts.end(), ents.begin(), ents.end());
+
+          const size_t first_vert = flatVerts.size();
+          for (std::vector<EntityHandle>::const_iterator it = ents.begin(); it != ents.end(); ++it)
+            if (MBVERTEX == TYPE_FROM_HANDLE(*it))
+              flatVerts.push_back(*it);
+          flatNodes[n].firstVert = first_vert;
+          flatNodes[n].numVerts = flatVerts.size() - first_vert;
+          if (flatNodes[n].numVerts) {
+            flatCoords.resize(3*flatVerts.size());
+            rval = moab()->get_coords(&flatVerts[first_vert], flatNodes[n].numVerts,
+                                      &flatCoords[3*first_vert]);MB_CHK_ERR(rval);
+          }
+          continue;
+        }
+
+        if (2 != children.size())
+          MB_SET_ERR(MB_MULTIPLE_ENTITIES_FOUND, "Tree node does not have two children");
+        rval = get_split_plane(node, plane);MB_CHK_ERR(rval);
+
+        const unsigned child = flatNodes.size();
+        flatNodes[n].coord = plane.coord;
+        flatNodes[n].norm = plane.norm;
+        flatNodes[n].child = child;
+        for (int i = 0; i < 2; i++) {
+          FlatNode leaf = { 0.0, -1, 0, 0, 0, 0, 0, children[i] };
+          flatNodes.push_back(leaf);
+        }
+        stack.push_back(child + 1);
+        stack.push_back(child);
+      }
+
+      return MB_SUCCESS;
+    }
+
+    unsigned AdaptiveKDTree::flat_leaf(const double *point) const
+    {
+      unsigned n = 0;
+      while (flatNodes[n].norm >= 0)
+        n = flatNodes[n].child + (point[flatNodes[n].norm] > flatNodes[n].coord);
+      return n;
+    }
+
+      // Per-axis distance from a point to the box of a flat node, as for
+      // NodeDistance in distance_search; the square of its length is a lower
+      // bound on the squared distance to any vertex in the node.
+    struct FlatNodeDistance {
+      unsigned node;
+      CartVect dist;
+    };
+
+    void AdaptiveKDTree::flat_nearest(const double *point, unsigned k,
+                                      std::vector<std::pair<double,unsigned> >& result) const
+    {
+      result.clear();
+      if (!k)
+        return;
+
+      std::vector<FlatNodeDistance> stack(1);
+      stack[0].node = 0;
+      for (int d = 0; d < 3; d++)
+        stack[0].dist[d] = std::max(0.0, std::max(boundBox.bMin[d] - point[d], point[d] - boundBox.bMax[d]));
+
+        // result is a max-heap on the squared distance while searching
+      double worst = HUGE_VAL;
+      while (!stack.empty()) {
+        const FlatNodeDistance nd = stack.back();
+        stack.pop_back();
+        if (result.size() == k && nd.dist.length_squared() >= worst)
+          continue;
+
+        const FlatNode& node = flatNodes[nd.node];
+        if (node.norm < 0) {
+          for (unsigned i = node.firstVert; i < node.firstVert + node.numVerts; i++) {
+            const double *c = &flatCoords[3*i];
+            const double d2 = (c[0]-point[0])*(c[0]-point[0]) + (c[1]-point[1])*(c[1]-point[1])
+                            + (c[2]-point[2])*(c[2]-point[2]);
+            if (result.size() == k && d2 >= worst)
+              continue;
+              // vertices on a split plane may be in both children
+            bool dup = false;
+            for (size_t j = 0; j < result.size() && !dup; j++)
+              dup = (flatVerts[result[j].second] == flatVerts[i]);
+            if (dup)
+              continue;
+            if (result.size() == k) {
+              std::pop_heap(result.begin(), result.end());
+              result.pop_back();
+            }
+            result.push_back(std::make_pair(d2, i));
+            std::push_heap(result.begin(), result.end());
+            if (result.size() == k)
+              worst = result.front().first;
+          }
+          continue;
+        }
+
+          // visit the child on the side of the point first
+        const double d = point[node.norm] - node.coord;
+        FlatNodeDistance near_child = nd, far_child = nd;
+        near_child.node = node.child + (d > 0.0);
+        far_child.node = node.child + (d <= 0.0);
+        far_child.dist[node.norm] = fabs(d);
+        stack.push_back(far_child);
+        stack.push_back(near_child);
+      }
+
+      std::sort_heap(result.begin(), result.end());
+    }
+
+    void AdaptiveKDTree::flat_in_radius(const double *point, double distance,
+                                        std::vector<std::pair<double,unsigned> >& result) const
+    {
+      result.clear();
+      const double dist_sqr = distance * distance;
+
+      std::vector<FlatNodeDistance> stack(1);
+      stack[0].node = 0;
+      for (int d = 0; d < 3; d++)
+        stack[0].dist[d] = std::max(0.0, std::max(boundBox.bMin[d] - point[d], point[d] - boundBox.bMax[d]));
+
+      while (!stack.empty()) {
+        const FlatNodeDistance nd = stack.back();
+        stack.pop_back();
+        if (nd.dist.length_squared() > dist_sqr)
+          continue;
+
+        const FlatNode& node = flatNodes[nd.node];
+        if (node.norm < 0) {
+          for (unsigned i = node.firstVert; i < node.firstVert + node.numVerts; i++) {
+            const double *c = &flatCoords[3*i];
+            const double d2 = (c[0]-point[0])*(c[0]-point[0]) + (c[1]-point[1])*(c[1]-point[1])
+                            + (c[2]-point[2])*(c[2]-point[2]);
+            if (d2 <= dist_sqr)
+              result.push_back(std::make_pair(d2, i));
+          }
+          continue;
+        }
+
+        const double d = point[node.norm] - node.coord;
+        FlatNodeDistance near_child = nd, far_child = nd;
+        near_child.node = node.child + (d > 0.0);
+        far_child.node = node.child + (d <= 0.0);
+        far_child.dist[node.norm] = fabs(d);
+        stack.push_back(far_child);
+        stack.push_back(near_child);
+      }
+
+        // sort by distance, then drop the second copy of vertices on split
+        // planes; both copies have the same distance
+      std::sort(result.begin(), result.end());
+      size_t j = 0;
+      for (size_t i = 0; i < result.size(); i++) {
+        bool dup = false;
+        for (size_t l = j; l-- > 0 && result[l].first == result[i].first && !dup; )
+          dup = (flatVerts[result[l].second] == flatVerts[result[i].second]);
+        if (!dup)
+          result[j++] = result[i];
+      }
+      result.resize(j);
+    }
+
+    ErrorCode AdaptiveKDTree::point_search(const double *points,
+                                           unsigned num_points,
+                                           std::vector<EntityHandle>& leaves_out,
+                                           const double iter_tol) const
+    {
+      if (!has_flat_tree())
+        MB_SET_ERR(MB_FAILURE, "Flat tree not built");
+
+      leaves_out.resize(num_points);
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel for
+#endif
+      for (int i = 0; i < (int)num_points; i++) {
+        const double *point = points + 3*(size_t)i;
+        leaves_out[i] = boundBox.contains_point(point, iter_tol) ? flatNodes[flat_leaf(point)].handle : 0;
+      }
+
+      return MB_SUCCESS;
+    }
+
+    ErrorCode AdaptiveKDTree::nearest_vertices(const double *points,
+                                               unsigned num_points,
+                                               unsigned k,
+                                               std::vector<EntityHandle>& verts_out,
+                                               std::vector<double> *dists_out) const
+    {
+      if (!has_flat_tree())
+        MB_SET_ERR(MB_FAILURE, "Flat tree not built");
+
+      verts_out.clear();
+      verts_out.resize((size_t)num_points * k, 0);
+      if (dists_out) {
+        dists_out->clear();
+        dists_out->resize((size_t)num_points * k, HUGE_VAL);
+      }
+
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel
+#endif
+      {
+        std::vector<std::pair<double,unsigned> > result;
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp for
+#endif
+        for (int i = 0; i < (int)num_points; i++) {
+          flat_nearest(points + 3*(size_t)i, k, result);
+          const size_t first = (size_t)i * k;
+          for (size_t j = 0; j < result.size(); j++) {
+            verts_out[first + j] = flatVerts[result[j].second];
+            if (dists_out)
+              (*dists_out)[first + j] = sqrt(result[j].first);
+          }
+        }
+      }
+
+      return MB_SUCCESS;
+    }
+
+    ErrorCode AdaptiveKDTree::vertices_in_radius(const double *points,
+                                                 unsigned num_points,
+                                                 double distance,
+                                                 std::vector<EntityHandle>& verts_out,
+                                                 std::vector<unsigned>& offsets,
+                                                 std::vector<double> *dists_out) const
+    {
+      if (!has_flat_tree())
+        MB_SET_ERR(MB_FAILURE, "Flat tree not built");
+
+        // the number of vertices per point is not known in advance, so keep
+        // the results of each point and concatenate them afterwards
+      std::vector<std::vector<std::pair<double,unsigned> > > results(num_points);
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel for
+#endif
+      for (int i = 0; i < (int)num_points; i++)
+        flat_in_radius(points + 3*(size_t)i, distance, results[i]);
+
+      offsets.resize(num_points + 1);
+      offsets[0] = 0;
+      for (unsigned i = 0; i < num_points; i++)
+        offsets[i+1] = offsets[i] + results[i].size();
+
+      verts_out.resize(offsets[num_points]);
+      if (dists_out)
+        dists_out->resize(offsets[num_points]);
+      for (unsigned i = 0; i < num_points; i++) {
+        for (size_t j = 0; j < results[i].size(); j++) {
+          verts_out[offsets[i] + j] = flatVerts[results[i][j].second];
+          if (dists_out)
+            (*dists_out)[offsets[i] + j] = sqrt(results[i][j].first);
+        }
+      }
+
+      return MB_SUCCESS;
+    }
+
     struct NodeDistance {
       EntityHandle handle;
       CartVect dist; // from_point - closest_point_on_box
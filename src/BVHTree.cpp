@@ -4,10 +4,125 @@
 #include "moab/ReadUtilIface.hpp"
 #include "moab/CpuTimer.hpp"
 
+#include <math.h>
+
 namespace moab
 {
     const char *BVHTree::treeName = "BVHTree";
 
+    namespace {
+
+        // number of elements binned or partitioned by one thread at a time in the BINNED_SAH build
+      const size_t SAH_CHUNK_SIZE = 16384;
+
+        // subtrees of the BINNED_SAH build with fewer elements are built by a single thread
+      const size_t SAH_SUBTREE_SIZE = 16384;
+
+        // range of elements [begin, end) still to be split under node index
+      struct SAHRange {
+        unsigned int index;
+        size_t begin, end;
+        int depth;
+      };
+
+        // element count and bounding box of the elements whose centroid falls in a bin
+      struct SAHBin {
+        unsigned int count;
+        float bMin[3], bMax[3];
+      };
+
+        // round outwards, so the single precision box contains the double precision one
+      inline float round_down(const double x)
+      {
+        float f = (float)x;
+        return ((double)f > x) ? nextafterf(f, -FLT_MAX) : f;
+      }
+
+      inline float round_up(const double x)
+      {
+        float f = (float)x;
+        return ((double)f < x) ? nextafterf(f, FLT_MAX) : f;
+      }
+
+      inline void empty_box(float bmin[3], float bmax[3])
+      {
+        for (int d = 0; d < 3; d++) {
+          bmin[d] = FLT_MAX;
+          bmax[d] = -FLT_MAX;
+        }
+      }
+
+      inline void merge_box(float bmin[3], float bmax[3], const float omin[3], const float omax[3])
+      {
+        for (int d = 0; d < 3; d++) {
+          bmin[d] = std::min(bmin[d], omin[d]);
+          bmax[d] = std::max(bmax[d], omax[d]);
+        }
+      }
+
+        // half the surface area of a box
+      inline double half_area(const float bmin[3], const float bmax[3])
+      {
+        const double dx = (double)bmax[0] - bmin[0], dy = (double)bmax[1] - bmin[1], dz = (double)bmax[2] - bmin[2];
+        return dx*dy + dy*dz + dz*dx;
+      }
+
+      inline double box_distance_squared(const float bmin[3], const float bmax[3], const double *point)
+      {
+        double d_sqr = 0.0;
+        for (int d = 0; d < 3; d++) {
+          double diff = 0.0;
+          if (point[d] < bmin[d]) diff = bmin[d] - point[d];
+          else if (point[d] > bmax[d]) diff = point[d] - bmax[d];
+          d_sqr += diff*diff;
+        }
+        return d_sqr;
+      }
+
+        // set the box of an element from the coordinates of its num_verts vertices
+      template <class Prim>
+      inline void set_prim_box(Prim &prim, const double *coords, const int num_verts)
+      {
+        for (int d = 0; d < 3; d++) {
+          double vmin = coords[d], vmax = coords[d];
+          for (int j = 1; j < num_verts; j++) {
+            vmin = std::min(vmin, coords[3*j+d]);
+            vmax = std::max(vmax, coords[3*j+d]);
+          }
+          prim.bMin[d] = round_down(vmin);
+          prim.bMax[d] = round_up(vmax);
+        }
+      }
+
+      template <class Prim>
+      inline double prim_center(const Prim &prim, const int axis)
+      {
+        return 0.5 * ((double)prim.bMin[axis] + prim.bMax[axis]);
+      }
+
+        // bin of the centroid of an element along axis
+      template <class Prim>
+      inline int sah_bin(const Prim &prim, const int axis, const double cmin, const double scale, const int nbins)
+      {
+        const int b = (int)((prim_center(prim, axis) - cmin) * scale);
+        return (b < 0 ? 0 : (b >= nbins ? nbins-1 : b));
+      }
+
+        // predicate true for the elements left of a binned split
+      class SAHLeftOf
+      {
+      public:
+        SAHLeftOf(int a, double cm, double sc, int nb, int sp) : axis(a), cmin(cm), scale(sc), nbins(nb), split(sp) {}
+        template <class Prim>
+        bool operator()(const Prim &prim) const { return sah_bin(prim, axis, cmin, scale, nbins) <= split; }
+      private:
+        int axis;
+        double cmin, scale;
+        int nbins, split;
+      };
+
+    }
+
     ErrorCode BVHTree::build_tree(const Range& entities,
                                   EntityHandle *tree_root_set,
                                   FileOptions *options)
@@ -22,9 +137,18 @@ namespace moab
         if (!options->all_seen()) return MB_FAILURE;
       }
 
-        // calculate bounding box of elements
+      myTree.clear();
+      sahNodes.clear();
+      sahPrims.clear();
+
+        // calculate bounding box of elements; the BINNED_SAH build gets it along with
+        // the boxes of the elements
+      const bool sah_build = (binnedSAH || !entitySets);
       BoundBox box;
-      rval = box.update(*moab(), entities);
+      if (sah_build)
+        rval = construct_sah_prims(entities, sahPrims, box);
+      else
+        rval = box.update(*moab(), entities);
       if (MB_SUCCESS != rval)
         return rval;
 
@@ -38,6 +162,31 @@ namespace moab
       if (MB_SUCCESS != rval)
         return rval;
 
+      if (sah_build) {
+        rval = build_sah_tree();MB_CHK_ERR(rval);
+        treeStats.reset();
+
+        if (entitySets) {
+          rval = convert_sah_tree();MB_CHK_ERR(rval);
+          rval = treeStats.compute_stats(mbImpl, startSetHandle);
+          treeStats.initTime = cp.time_elapsed();
+          return rval;
+        }
+
+          // no sets to compute the stats from
+        treeStats.maxDepth = treeDepth + 1;
+        for (std::vector<SAHNode>::const_iterator it = sahNodes.begin(); it != sahNodes.end(); ++it) {
+          treeStats.numNodes++;
+          if (!it->count) continue;
+          treeStats.minObjPerLeaf = (treeStats.numLeaves ? std::min(treeStats.minObjPerLeaf, it->count) : it->count);
+          treeStats.maxObjPerLeaf = std::max(treeStats.maxObjPerLeaf, it->count);
+          treeStats.numLeaves++;
+        }
+        treeStats.avgObjPerLeaf = (treeStats.numLeaves ? (double)sahPrims.size()/treeStats.numLeaves : 0.0);
+        treeStats.initTime = cp.time_elapsed();
+        return MB_SUCCESS;
+      }
+
         //a fully balanced tree will have 2*_entities.size()
         //which is one doubling away..
       std::vector<Node> tree_nodes;
@@ -139,9 +288,435 @@ namespace moab
       rval = opts.get_int_option("SPLITS_PER_DIR", tmp_int);
       if (MB_SUCCESS == rval) splitsPerDir = tmp_int;
 
+        //  BINNED_SAH: split with the surface area heuristic over binned centroids; default = false
+      rval = opts.get_toggle_option("BINNED_SAH", false, binnedSAH);
+      if (MB_SUCCESS != rval) binnedSAH = false;
+
+        //  SAH_BINS: number of bins per direction for BINNED_SAH; default = 16
+      rval = opts.get_int_option("SAH_BINS", tmp_int);
+      if (MB_SUCCESS == rval) sahBins = std::max(tmp_int, 2);
+
+        //  ENTITY_SETS: store the tree in entity sets; default = true
+      rval = opts.get_toggle_option("ENTITY_SETS", true, entitySets);
+      if (MB_SUCCESS != rval) entitySets = true;
+
       return MB_SUCCESS;
     }
 
+    ErrorCode BVHTree::construct_sah_prims(const Range &elements, std::vector<SAHPrim> &prims,
+                                           BoundBox &box) const
+    {
+      box = BoundBox();
+      prims.resize(elements.size());
+      std::vector<double> coords;
+      std::vector<EntityHandle> verts;
+      ErrorCode rval;
+      size_t idx = 0;
+
+        // vertices come first in the range, get their coordinates by blocks
+      Range::const_iterator rit = elements.begin(), vend = elements.upper_bound(MBVERTEX);
+      while (rit != vend) {
+        verts.clear();
+        for (; rit != vend && verts.size() < SAH_CHUNK_SIZE; ++rit)
+          verts.push_back(*rit);
+        coords.resize(3*verts.size());
+        rval = mbImpl->get_coords(&verts[0], verts.size(), &coords[0]);MB_CHK_ERR(rval);
+        for (size_t j = 0; j < coords.size(); j += 3) {
+          box.update_min(&coords[j]);
+          box.update_max(&coords[j]);
+        }
+        const long nb = verts.size();
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel for
+#endif
+        for (long i = 0; i < nb; i++) {
+          set_prim_box(prims[idx+i], &coords[3*i], 1);
+          prims[idx+i].handle = verts[i];
+        }
+        idx += nb;
+      }
+
+      std::vector<EntityHandle> conn;
+      std::vector<int> offsets;
+      while (rit != elements.end()) {
+        if (MBPOLYHEDRON == mbImpl->type_from_handle(*rit)) {
+            // connectivity of polyhedra is faces, go through the adjacencies
+          verts.clear();
+          rval = mbImpl->get_adjacencies(&*rit, 1, 0, false, verts);MB_CHK_ERR(rval);
+          coords.resize(3*verts.size());
+          rval = mbImpl->get_coords(&verts[0], verts.size(), &coords[0]);MB_CHK_ERR(rval);
+          for (size_t j = 0; j < coords.size(); j += 3) {
+            box.update_min(&coords[j]);
+            box.update_max(&coords[j]);
+          }
+          set_prim_box(prims[idx], &coords[0], verts.size());
+          prims[idx].handle = *rit;
+          ++rit;
+          ++idx;
+          continue;
+        }
+
+          // block of elements, up to the next polyhedron
+        verts.clear();
+        for (; rit != elements.end() && verts.size() < SAH_CHUNK_SIZE &&
+                 MBPOLYHEDRON != mbImpl->type_from_handle(*rit); ++rit)
+          verts.push_back(*rit);
+        conn.clear();
+        offsets.clear();
+        rval = mbImpl->get_connectivity(&verts[0], verts.size(), conn, false, &offsets);MB_CHK_ERR(rval);
+        coords.resize(3*conn.size());
+        rval = mbImpl->get_coords(&conn[0], conn.size(), &coords[0]);MB_CHK_ERR(rval);
+        for (size_t j = 0; j < coords.size(); j += 3) {
+          box.update_min(&coords[j]);
+          box.update_max(&coords[j]);
+        }
+        const long nb = verts.size();
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel for
+#endif
+        for (long i = 0; i < nb; i++) {
+          set_prim_box(prims[idx+i], &coords[3*offsets[i]], offsets[i+1] - offsets[i]);
+          prims[idx+i].handle = verts[i];
+        }
+        idx += nb;
+      }
+
+      return MB_SUCCESS;
+    }
+
+    size_t BVHTree::sah_split(SAHPrim *begin, SAHPrim *end, SAHNode &left, SAHNode &right) const
+    {
+      const size_t n = end - begin;
+      const long nchunks = (n + SAH_CHUNK_SIZE - 1) / SAH_CHUNK_SIZE;
+      const int nbins = sahBins;
+
+        // bounds of the element centroids, by chunks
+      std::vector<double> cbox(6*nchunks);
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel for if (nchunks > 1)
+#endif
+      for (long k = 0; k < nchunks; k++) {
+        double *cb = &cbox[6*k];
+        for (int d = 0; d < 3; d++) {
+          cb[d] = DBL_MAX;
+          cb[3+d] = -DBL_MAX;
+        }
+        const SAHPrim *cend = begin + std::min(n, (k+1)*SAH_CHUNK_SIZE);
+        for (const SAHPrim *p = begin + k*SAH_CHUNK_SIZE; p != cend; ++p)
+          for (int d = 0; d < 3; d++) {
+            cb[d] = std::min(cb[d], prim_center(*p, d));
+            cb[3+d] = std::max(cb[3+d], prim_center(*p, d));
+          }
+      }
+      double cmin[3], cmax[3], scale[3];
+      bool spread = false;
+      for (int d = 0; d < 3; d++) {
+        cmin[d] = DBL_MAX;
+        cmax[d] = -DBL_MAX;
+        for (long k = 0; k < nchunks; k++) {
+          cmin[d] = std::min(cmin[d], cbox[6*k+d]);
+          cmax[d] = std::max(cmax[d], cbox[6*k+3+d]);
+        }
+        scale[d] = (cmax[d] > cmin[d] ? nbins / (cmax[d] - cmin[d]) : 0.0);
+        if (scale[d] > 0.0) spread = true;
+      }
+
+      if (!spread) {
+          // all centroids coincide, split in the middle
+        const size_t nl = n/2;
+        empty_box(left.bMin, left.bMax);
+        empty_box(right.bMin, right.bMax);
+        for (const SAHPrim *p = begin; p != begin + nl; ++p)
+          merge_box(left.bMin, left.bMax, p->bMin, p->bMax);
+        for (const SAHPrim *p = begin + nl; p != end; ++p)
+          merge_box(right.bMin, right.bMax, p->bMin, p->bMax);
+        left.child = right.child = 0;
+        left.count = right.count = 0;
+        return nl;
+      }
+
+        // bin the elements along all directions with spread centroids, by chunks,
+        // then merge the bins of all chunks into those of the first one
+      SAHBin empty_bin;
+      empty_bin.count = 0;
+      empty_box(empty_bin.bMin, empty_bin.bMax);
+      std::vector<SAHBin> bins(3*nbins*nchunks, empty_bin);
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel for if (nchunks > 1)
+#endif
+      for (long k = 0; k < nchunks; k++) {
+        SAHBin *kbins = &bins[3*nbins*k];
+        const SAHPrim *cend = begin + std::min(n, (k+1)*SAH_CHUNK_SIZE);
+        for (const SAHPrim *p = begin + k*SAH_CHUNK_SIZE; p != cend; ++p)
+          for (int d = 0; d < 3; d++) {
+            if (scale[d] == 0.0) continue;
+            SAHBin &bin = kbins[d*nbins + sah_bin(*p, d, cmin[d], scale[d], nbins)];
+            bin.count++;
+            merge_box(bin.bMin, bin.bMax, p->bMin, p->bMax);
+          }
+      }
+      for (long k = 1; k < nchunks; k++)
+        for (int i = 0; i < 3*nbins; i++) {
+          bins[i].count += bins[3*nbins*k+i].count;
+          merge_box(bins[i].bMin, bins[i].bMax, bins[3*nbins*k+i].bMin, bins[3*nbins*k+i].bMax);
+        }
+
+        // sweep the bins for the split with the lowest cost, the sum over both sides
+        // of the number of elements times the area of their box; the first and last
+        // bins of a direction with spread centroids are never empty
+      int axis = -1, split = 0;
+      double best_cost = HUGE_VAL;
+      std::vector<double> right_cost(nbins);
+      for (int d = 0; d < 3; d++) {
+        if (scale[d] == 0.0) continue;
+        const SAHBin *dbins = &bins[d*nbins];
+        float bmin[3], bmax[3];
+        unsigned int count = 0;
+        empty_box(bmin, bmax);
+        for (int i = nbins-1; i > 0; i--) {
+          count += dbins[i].count;
+          merge_box(bmin, bmax, dbins[i].bMin, dbins[i].bMax);
+          right_cost[i] = (count ? count*half_area(bmin, bmax) : 0.0);
+        }
+        count = 0;
+        empty_box(bmin, bmax);
+        for (int i = 0; i < nbins-1; i++) {
+          count += dbins[i].count;
+          merge_box(bmin, bmax, dbins[i].bMin, dbins[i].bMax);
+          if (!count || count == n) continue;
+          const double cost = count*half_area(bmin, bmax) + right_cost[i+1];
+          if (cost < best_cost) {
+            best_cost = cost;
+            axis = d;
+            split = i;
+          }
+        }
+      }
+      assert(axis >= 0);
+
+        // boxes of the children, from the bins
+      empty_box(left.bMin, left.bMax);
+      empty_box(right.bMin, right.bMax);
+      for (int i = 0; i < nbins; i++) {
+        SAHNode &side = (i <= split ? left : right);
+        merge_box(side.bMin, side.bMax, bins[axis*nbins+i].bMin, bins[axis*nbins+i].bMax);
+      }
+      left.child = right.child = 0;
+      left.count = right.count = 0;
+
+        // partition each chunk, then swap the right elements left of the final split
+        // position with the left elements right of it
+      const SAHLeftOf is_left(axis, cmin[axis], scale[axis], nbins, split);
+      std::vector<size_t> nleft(nchunks);
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel for if (nchunks > 1)
+#endif
+      for (long k = 0; k < nchunks; k++) {
+        SAHPrim *cbegin = begin + k*SAH_CHUNK_SIZE, *cend = begin + std::min(n, (k+1)*SAH_CHUNK_SIZE);
+        nleft[k] = std::partition(cbegin, cend, is_left) - cbegin;
+      }
+      size_t nl = 0;
+      for (long k = 0; k < nchunks; k++)
+        nl += nleft[k];
+
+      std::vector<std::pair<size_t, size_t> > wrong_right, wrong_left;
+      for (long k = 0; k < nchunks; k++) {
+        const size_t cbegin = k*SAH_CHUNK_SIZE, cmid = cbegin + nleft[k], cend = std::min(n, cbegin+SAH_CHUNK_SIZE);
+        if (cmid < nl)
+          wrong_right.push_back(std::make_pair(cmid, std::min(cend, nl)));
+        if (cmid > nl)
+          wrong_left.push_back(std::make_pair(std::max(cbegin, nl), cmid));
+      }
+      for (size_t i = 0, j = 0; i < wrong_right.size() && j < wrong_left.size(); ) {
+        std::pair<size_t, size_t> &r = wrong_right[i], &l = wrong_left[j];
+        const size_t len = std::min(r.second - r.first, l.second - l.first);
+        std::swap_ranges(begin + r.first, begin + r.first + len, begin + l.first);
+        r.first += len;
+        l.first += len;
+        if (r.first == r.second) i++;
+        if (l.first == l.second) j++;
+      }
+
+#ifndef NDEBUG
+      for (const SAHPrim *p = begin; p != end; ++p)
+        assert(is_left(*p) == (p < begin + nl));
+#endif
+      return nl;
+    }
+
+    int BVHTree::sah_build_subtree(std::vector<SAHNode> &nodes, const unsigned int index,
+                                   SAHPrim *begin, SAHPrim *end, const int depth) const
+    {
+      const size_t n = end - begin;
+      if ((int)n <= maxPerLeaf || depth >= maxDepth) {
+        nodes[index].child = begin - &sahPrims[0];
+        nodes[index].count = n;
+        return depth;
+      }
+
+      SAHNode left, right;
+      const size_t nl = sah_split(begin, end, left, right);
+      const unsigned int child = nodes.size();
+      nodes[index].child = child;
+      nodes[index].count = 0;
+      nodes.push_back(left);
+      nodes.push_back(right);
+      const int left_depth = sah_build_subtree(nodes, child, begin, begin+nl, depth+1);
+      const int right_depth = sah_build_subtree(nodes, child+1, begin+nl, end, depth+1);
+      return std::max(left_depth, right_depth);
+    }
+
+    ErrorCode BVHTree::build_sah_tree()
+    {
+      if (sahPrims.empty())
+        return MB_SUCCESS;
+
+      SAHNode root;
+      empty_box(root.bMin, root.bMax);
+      for (std::vector<SAHPrim>::const_iterator p = sahPrims.begin(); p != sahPrims.end(); ++p)
+        merge_box(root.bMin, root.bMax, p->bMin, p->bMax);
+      root.child = root.count = 0;
+      sahNodes.push_back(root);
+
+        // split the large nodes one after the other, each split using all threads;
+        // the small subtrees are built in a second pass
+      SAHPrim *base = &sahPrims[0];
+      int depth = 0;
+      SAHRange range = {0, 0, sahPrims.size(), 0};
+      std::vector<SAHRange> large(1, range), small;
+      while (!large.empty()) {
+        range = large.back();
+        large.pop_back();
+        const size_t n = range.end - range.begin;
+        if ((int)n <= maxPerLeaf || range.depth >= maxDepth) {
+          sahNodes[range.index].child = range.begin;
+          sahNodes[range.index].count = n;
+          depth = std::max(depth, range.depth);
+          continue;
+        }
+        if (n <= SAH_SUBTREE_SIZE) {
+          small.push_back(range);
+          continue;
+        }
+
+        SAHNode left, right;
+        const size_t nl = sah_split(base+range.begin, base+range.end, left, right);
+        const unsigned int child = sahNodes.size();
+        sahNodes[range.index].child = child;
+        sahNodes.push_back(left);
+        sahNodes.push_back(right);
+        SAHRange right_range = {child+1, range.begin+nl, range.end, range.depth+1};
+        SAHRange left_range = {child, range.begin, range.begin+nl, range.depth+1};
+        large.push_back(right_range);
+        large.push_back(left_range);
+      }
+
+        // build the small subtrees in parallel, each in its own vector
+      std::vector<std::vector<SAHNode> > subtrees(small.size());
+      std::vector<int> depths(small.size());
+      const long nsmall = small.size();
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (long i = 0; i < nsmall; i++) {
+        subtrees[i].push_back(sahNodes[small[i].index]);
+        depths[i] = sah_build_subtree(subtrees[i], 0, base+small[i].begin, base+small[i].end, small[i].depth);
+      }
+
+        // append them to the tree, the root of each replacing its node
+      for (long i = 0; i < nsmall; i++) {
+        std::vector<SAHNode> &sub = subtrees[i];
+        const unsigned int offset = sahNodes.size() - 1;
+        for (std::vector<SAHNode>::iterator it = sub.begin(); it != sub.end(); ++it)
+          if (!it->count) it->child += offset;
+        sahNodes[small[i].index] = sub[0];
+        sahNodes.insert(sahNodes.end(), sub.begin()+1, sub.end());
+        std::vector<SAHNode>().swap(sub);
+        depth = std::max(depth, depths[i]);
+      }
+
+      treeDepth = std::max(depth, treeDepth);
+      return MB_SUCCESS;
+    }
+
+    ErrorCode BVHTree::convert_sah_tree()
+    {
+      if (sahNodes.empty())
+        return MB_SUCCESS;
+
+        // first construct the proper number of entity sets
+      ReadUtilIface *read_util;
+      ErrorCode rval = mbImpl->query_interface(read_util);MB_CHK_ERR(rval);
+      {
+        std::vector<unsigned int> tmp_flags(sahNodes.size(), meshsetFlags);
+        rval = read_util->create_entity_sets(sahNodes.size(), &tmp_flags[0], 0, startSetHandle);MB_CHK_ERR(rval);
+        rval = mbImpl->release_interface(read_util);MB_CHK_ERR(rval);
+      }
+
+        // populate the sets and the TreeNode vector
+      myTree.reserve(sahNodes.size());
+      Range range;
+      for (size_t i = 0; i < sahNodes.size(); i++) {
+        const SAHNode &node = sahNodes[i];
+        BoundBox box(CartVect(node.bMin[0], node.bMin[1], node.bMin[2]),
+                     CartVect(node.bMax[0], node.bMax[1], node.bMax[2]));
+        if (node.count) {
+          range.clear();
+          for (unsigned int j = node.child; j < node.child + node.count; j++)
+            range.insert(sahPrims[j].handle);
+          rval = mbImpl->add_entities(startSetHandle+i, range);MB_CHK_ERR(rval);
+          myTree.push_back(TreeNode(3, UINT_MAX, -DBL_MAX, DBL_MAX, box));
+          continue;
+        }
+
+          // the children boxes are not ordered along a split direction; use the
+          // direction where they are furthest apart
+        const SAHNode &left = sahNodes[node.child], &right = sahNodes[node.child+1];
+        int dim = 0;
+        for (int d = 1; d < 3; d++)
+          if (right.bMin[d] - left.bMax[d] > right.bMin[dim] - left.bMax[dim])
+            dim = d;
+        myTree.push_back(TreeNode(dim, node.child, left.bMax[dim], right.bMin[dim], box));
+        rval = mbImpl->add_child_meshset(startSetHandle+i, startSetHandle+node.child);MB_CHK_ERR(rval);
+        rval = mbImpl->add_child_meshset(startSetHandle+i, startSetHandle+node.child+1);MB_CHK_ERR(rval);
+      }
+
+      std::vector<SAHNode>().swap(sahNodes);
+      std::vector<SAHPrim>().swap(sahPrims);
+
+      return MB_SUCCESS;
+    }
+
+    void BVHTree::sah_search(const double *point, const double distance,
+                             std::vector<std::pair<double, EntityHandle> > &result)
+    {
+      result.clear();
+      if (sahNodes.empty())
+        return;
+
+      const double dist_sqr = distance * distance;
+      std::vector<unsigned int> candidates(1, 0);
+      while (!candidates.empty()) {
+        const SAHNode &node = sahNodes[candidates.back()];
+        candidates.pop_back();
+        treeStats.nodesVisited++;
+        if (box_distance_squared(node.bMin, node.bMax, point) > dist_sqr)
+          continue;
+        if (!node.count) {
+          candidates.push_back(node.child+1);
+          candidates.push_back(node.child);
+          continue;
+        }
+
+        treeStats.leavesVisited++;
+        for (unsigned int j = node.child; j < node.child + node.count; j++) {
+          const double d_sqr = box_distance_squared(sahPrims[j].bMin, sahPrims[j].bMax, point);
+          if (d_sqr <= dist_sqr)
+            result.push_back(std::make_pair(d_sqr, sahPrims[j].handle));
+        }
+      }
+    }
+
     void BVHTree::establish_buckets(HandleDataVec::const_iterator begin,
                                     HandleDataVec::const_iterator end,
                                     const BoundBox &interval, std::vector<std::vector<Bucket> > &buckets) const
@@ -552,6 +1127,29 @@ namespace moab
     {
       treeStats.numTraversals++;
 
+      if (!entitySets) {
+        if (start_node && *start_node != myRoot)
+          MB_SET_ERR(MB_FAILURE, "Tree has no entity sets, searches start at its root");
+        leaf_out = 0;
+        if (multiple_leaves) *multiple_leaves = false;
+
+        std::vector<std::pair<double, EntityHandle> > candidates;
+        sah_search(point, iter_tol, candidates);
+        if (candidates.empty()) return MB_SUCCESS;
+
+        if (myEval && params) {
+          Range entities;
+          for (size_t i = 0; i < candidates.size(); i++)
+            entities.insert(candidates[i].second);
+          return myEval->find_containing_entity(entities, point, iter_tol, inside_tol,
+                                                leaf_out, params->array(), &treeStats.traversalLeafObjectTests);
+        }
+
+        leaf_out = candidates[0].second;
+        if (multiple_leaves && candidates.size() > 1) *multiple_leaves = true;
+        return MB_SUCCESS;
+      }
+
       EntityHandle this_set = (start_node ? *start_node : startSetHandle);
         // convoluted check because the root is different from startSetHandle
       if (this_set != myRoot &&
@@ -606,6 +1204,34 @@ namespace moab
                                        std::vector<CartVect> *result_params,
                                        EntityHandle *tree_root)
     {
+      if (!entitySets) {
+        if (tree_root && *tree_root != myRoot)
+          MB_SET_ERR(MB_FAILURE, "Tree has no entity sets, searches start at its root");
+        treeStats.numTraversals++;
+
+        std::vector<std::pair<double, EntityHandle> > candidates;
+        sah_search(from_point, distance, candidates);
+        for (size_t i = 0; i < candidates.size(); i++) {
+          if (myEval && result_params) {
+            CartVect params;
+            int is_inside;
+            treeStats.traversalLeafObjectTests++;
+            ErrorCode rval = myEval->set_ent_handle(candidates[i].second);MB_CHK_ERR(rval);
+            rval = myEval->reverse_eval(from_point, iter_tol, inside_tol, params.array(), &is_inside);MB_CHK_ERR(rval);
+            if (is_inside) {
+              result_list.push_back(candidates[i].second);
+              result_params->push_back(params);
+              if (result_dists) result_dists->push_back(0.0);
+            }
+          }
+          else {
+            result_list.push_back(candidates[i].second);
+            if (result_dists) result_dists->push_back(sqrt(candidates[i].first));
+          }
+        }
+        return MB_SUCCESS;
+      }
+
         // non-NULL root should be in tree
         // convoluted check because the root is different from startSetHandle
       EntityHandle this_set = (tree_root ? *tree_root : startSetHandle);
@@ -686,6 +1312,17 @@ namespace moab
 
     ErrorCode BVHTree::print()
     {
+      if (!entitySets) {
+        for (size_t j = 0; j < sahNodes.size(); j++) {
+          const SAHNode &node = sahNodes[j];
+          std::cout << "Node " << j << ": " << (node.count ? "elements " : "child ") << node.child;
+          if (node.count) std::cout << "-" << node.child + node.count - 1;
+          std::cout << ", box = (" << node.bMin[0] << "," << node.bMin[1] << "," << node.bMin[2] << ") - ("
+                    << node.bMax[0] << "," << node.bMax[1] << "," << node.bMax[2] << ")" << std::endl;
+        }
+        return MB_SUCCESS;
+      }
+
       int i;
       std::vector<TreeNode>::iterator it;
       for (it = myTree.begin(), i = 0; it != myTree.end(); ++it, i++) {
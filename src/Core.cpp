@@ -281,7 +281,6 @@ ErrorCode Core::initialize()
   ahfRep = new HalfFacetRep(this);
   if (!ahfRep)
     return MB_MEMORY_ALLOCATION_FAILED;
-  mesh_modified = false;
 #endif
 
   return MB_SUCCESS;
@@ -858,29 +857,24 @@ ErrorCode Core::get_vertex_coordinates(std::vector<double> &coords) const
   return MB_SUCCESS;
 }
 
-ErrorCode Core::coords_iterate(Range::const_iterator iter,
-                               Range::const_iterator end,
-                               double*& xcoords_ptr,
-                               double*& ycoords_ptr,
-                               double*& zcoords_ptr,
-                               int& count)
+/** Find the vertex sequence containing \c *iter, and the number of
+ *  vertices from \c iter to \c end in it */
+static ErrorCode coords_iterate_seq(SequenceManager* seqman,
+                                    Range::const_iterator iter,
+                                    Range::const_iterator end,
+                                    VertexSequence*& vseq,
+                                    int& count)
 {
   EntitySequence *seq;
-  ErrorCode rval = sequence_manager()->find(*iter, seq);
+  ErrorCode rval = seqman->find(*iter, seq);
   if (MB_SUCCESS != rval) {
-    xcoords_ptr = ycoords_ptr = zcoords_ptr = NULL;
     MB_SET_ERR(rval, "Couldn't find sequence for start handle");
   }
-  VertexSequence *vseq = dynamic_cast<VertexSequence*>(seq);
+  vseq = dynamic_cast<VertexSequence*>(seq);
   if (!vseq) {
     MB_SET_ERR(MB_ENTITY_NOT_FOUND, "Couldn't find sequence for start handle");
   }
 
-  unsigned int offset = *iter - vseq->data()->start_handle();
-  xcoords_ptr = reinterpret_cast<double*>(vseq->data()->get_sequence_data(0)) + offset;
-  ycoords_ptr = reinterpret_cast<double*>(vseq->data()->get_sequence_data(1)) + offset;
-  zcoords_ptr = reinterpret_cast<double*>(vseq->data()->get_sequence_data(2)) + offset;
-
   EntityHandle real_end = std::min(seq->end_handle(), *(iter.end_of_block()));
   if (*end) real_end = std::min(real_end, *end);
   count = real_end - *iter + 1;
@@ -888,6 +882,65 @@ ErrorCode Core::coords_iterate(Range::const_iterator iter,
   return MB_SUCCESS;
 }
 
+ErrorCode Core::coords_iterate(Range::const_iterator iter,
+                               Range::const_iterator end,
+                               double*& xcoords_ptr,
+                               double*& ycoords_ptr,
+                               double*& zcoords_ptr,
+                               int& count)
+{
+  xcoords_ptr = ycoords_ptr = zcoords_ptr = NULL;
+  VertexSequence *vseq;
+  ErrorCode rval = coords_iterate_seq(sequence_manager(), iter, end, vseq, count);MB_CHK_ERR(rval);
+
+  // Not an error for callers that try both precisions, do not call MB_SET_ERR
+  rval = vseq->get_coordinate_arrays(xcoords_ptr, ycoords_ptr, zcoords_ptr);
+  if (MB_SUCCESS != rval)
+    return rval;
+
+  unsigned int offset = *iter - vseq->start_handle();
+  xcoords_ptr += offset;
+  ycoords_ptr += offset;
+  zcoords_ptr += offset;
+
+  return MB_SUCCESS;
+}
+
+ErrorCode Core::coords_iterate(Range::const_iterator iter,
+                               Range::const_iterator end,
+                               float*& xcoords_ptr,
+                               float*& ycoords_ptr,
+                               float*& zcoords_ptr,
+                               int& count)
+{
+  xcoords_ptr = ycoords_ptr = zcoords_ptr = NULL;
+  VertexSequence *vseq;
+  ErrorCode rval = coords_iterate_seq(sequence_manager(), iter, end, vseq, count);MB_CHK_ERR(rval);
+
+  // Not an error for callers that try both precisions, do not call MB_SET_ERR
+  rval = vseq->get_coordinate_arrays(xcoords_ptr, ycoords_ptr, zcoords_ptr);
+  if (MB_SUCCESS != rval)
+    return rval;
+
+  unsigned int offset = *iter - vseq->start_handle();
+  xcoords_ptr += offset;
+  ycoords_ptr += offset;
+  zcoords_ptr += offset;
+
+  return MB_SUCCESS;
+}
+
+template <typename T>
+static inline void interleave_coords( const T* x, const T* y, const T* z,
+                                      EntityID count, double* coords )
+{
+  for (EntityID j = 0; j < count; ++j) {
+    coords[3*j] = x[j];
+    coords[3*j+1] = y[j];
+    coords[3*j+2] = z[j];
+  }
+}
+
 ErrorCode  Core::get_coords(const Range& entities, double *coords) const
 {
   const TypeSequenceManager& vert_data = sequence_manager()->entity_map( MBVERTEX );
@@ -915,15 +968,15 @@ ErrorCode  Core::get_coords(const Range& entities, double *coords) const
       first = vseq->end_handle()+1;
     }
 
-    double const *x, *y, *z;
-    ErrorCode rval = vseq->get_coordinate_arrays( x, y, z );MB_CHK_ERR(rval);
-    x += offset;
-    y += offset;
-    z += offset;
-    for (EntityID j = 0; j < count; ++j) {
-      coords[3*j] = x[j];
-      coords[3*j+1] = y[j];
-      coords[3*j+2] = z[j];
+    if (vseq->float_coordinates()) {
+      float const *x, *y, *z;
+      ErrorCode rval = vseq->get_coordinate_arrays( x, y, z );MB_CHK_ERR(rval);
+      interleave_coords( x + offset, y + offset, z + offset, count, coords );
+    }
+    else {
+      double const *x, *y, *z;
+      ErrorCode rval = vseq->get_coordinate_arrays( x, y, z );MB_CHK_ERR(rval);
+      interleave_coords( x + offset, y + offset, z + offset, count, coords );
     }
     coords=&coords[ 3*count ];
   }
@@ -969,6 +1022,24 @@ ErrorCode Core::get_coords( const Range& entities,
       first = vseq->end_handle()+1;
     }
 
+    if (vseq->float_coordinates()) {
+      float const *x, *y, *z;
+      ErrorCode rval = vseq->get_coordinate_arrays( x, y, z );MB_CHK_ERR(rval);
+      if (x_coords) {
+        std::copy( x + offset, x + offset + count, x_coords );
+        x_coords += count;
+      }
+      if (y_coords) {
+        std::copy( y + offset, y + offset + count, y_coords );
+        y_coords += count;
+      }
+      if (z_coords) {
+        std::copy( z + offset, z + offset + count, z_coords );
+        z_coords += count;
+      }
+      continue;
+    }
+
     double const *x, *y, *z;
     ErrorCode rval = vseq->get_coordinate_arrays( x, y, z );MB_CHK_ERR(rval);
     if (x_coords) {
@@ -1126,6 +1197,16 @@ ErrorCode  Core::set_coords(Range entity_handles, const double *coords)
 
 }
 
+bool Core::get_float_coordinates() const
+{
+  return sequenceManager->get_float_coordinates();
+}
+
+void Core::set_float_coordinates(bool flag)
+{
+  sequenceManager->set_float_coordinates(flag);
+}
+
 double Core::get_sequence_multiplier() const
 {
   return sequenceManager->get_sequence_multiplier();
@@ -1264,6 +1345,13 @@ ErrorCode  Core::set_connectivity(const EntityHandle entity_handle,
   int len;
   status = static_cast<ElementSequence*>(seq)->get_connectivity(entity_handle, old_conn, len);MB_CHK_ERR(status);
 
+#ifdef MOAB_HAVE_AHF
+  // the element is unlinked from the AHF maps with its old vertices before anything changes;
+  // a failed notification drops the maps, so there is nothing to undo then
+  status = ahfRep->notify_delete_entity(entity_handle);MB_CHK_ERR(status);
+  std::vector<EntityHandle> old_conn_copy(old_conn, old_conn + len);
+#endif
+
   aEntityFactory->notify_change_connectivity(
     entity_handle, old_conn, connect, num_connect);
 
@@ -1273,6 +1361,19 @@ ErrorCode  Core::set_connectivity(const EntityHandle entity_handle,
     aEntityFactory->notify_change_connectivity(
       entity_handle, connect, old_conn, num_connect);
 
+#ifdef MOAB_HAVE_AHF
+  // and linked again with the connectivity it has now; if that fails the old one is put back,
+  // so that AEntityFactory and the rebuilt maps agree
+  ErrorCode ahf_status = ahfRep->notify_create_entity(entity_handle);
+  if (MB_SUCCESS != ahf_status && MB_SUCCESS == status) {
+    static_cast<ElementSequence*>(seq)->set_connectivity(entity_handle,
+                                                         &old_conn_copy[0], num_connect);
+    aEntityFactory->notify_change_connectivity(
+      entity_handle, connect, &old_conn_copy[0], num_connect);
+  }
+  MB_CHK_ERR(ahf_status);
+#endif
+
   return status;
 }
 
@@ -1471,8 +1572,11 @@ ErrorCode get_adjacencies_intersection_ahf(Core *mb,
 
     if(to_dimension == 0 && type != MBPOLYHEDRON)
       result = mb->get_connectivity(&(*begin), 1, adj_entities);
-    else
+    else {
       result = mb->a_half_facet_rep()->get_adjacencies(*begin, to_dimension, adj_entities);
+        // sorted like the adjacency lists of AEntityFactory, which callers such as iMesh rely on
+      std::sort( adj_entities.begin(), adj_entities.end() );
+    }
     if (MB_SUCCESS != result)
       return result;
     ++begin;
@@ -1538,9 +1642,6 @@ ErrorCode Core::get_adjacencies( const EntityHandle *from_entities,
     if (mixed)
         can_handle = false;
 
-    if (mesh_modified) //NOT SUPPORTED: modified mesh
-        can_handle = false;
-
     if (can_handle)
     {
         ErrorCode result;
@@ -2317,6 +2418,9 @@ ErrorCode Core::tag_get_handle( const char* name,
     // user asked that we also match storage types
     if ((flags & MB_TAG_STORE) && tag_handle->get_storage_type() != storage)
       return MB_TYPE_OUT_OF_RANGE;
+    if ((flags & MB_TAG_STORE) && MB_TAG_DENSE == storage && !tag_handle->variable_length() &&
+        static_cast<DenseTag*>(tag_handle)->float_values() != !!(flags & MB_TAG_FLOAT))
+      return MB_TYPE_OUT_OF_RANGE;
     // check if data type matches
     const DataType extype = tag_handle->get_data_type();
     if (extype != type) {
@@ -2376,13 +2480,19 @@ ErrorCode Core::tag_get_handle( const char* name,
   if (type == MB_TYPE_BIT)
     flags &= ~(unsigned)(MB_TAG_DENSE|MB_TAG_SPARSE);
 
+    // values stored as float only for fixed-length dense double tags
+  if ((flags & MB_TAG_FLOAT) &&
+      (type != MB_TYPE_DOUBLE || (flags & (MB_TAG_DENSE|MB_TAG_SPARSE|MB_TAG_MESH|MB_TAG_VARLEN)) != MB_TAG_DENSE))
+    return MB_TYPE_OUT_OF_RANGE;
+
     // create the tag
   switch (flags & (MB_TAG_DENSE|MB_TAG_SPARSE|MB_TAG_MESH|MB_TAG_VARLEN)) {
     case MB_TAG_DENSE|MB_TAG_VARLEN:
       tag_handle = VarLenDenseTag::create_tag( sequenceManager, mError, name, type, default_value, size );
       break;
     case MB_TAG_DENSE:
-      tag_handle = DenseTag::create_tag( sequenceManager, mError, name, size, type, default_value );
+      tag_handle = DenseTag::create_tag( sequenceManager, mError, name, size, type, default_value,
+                                         0 != (flags & MB_TAG_FLOAT) );
       break;
     case MB_TAG_SPARSE|MB_TAG_VARLEN:
       tag_handle = new VarLenSparseTag( name, type, default_value, size );
@@ -2670,7 +2780,8 @@ ErrorCode Core::create_element(const EntityType type,
     status = aEntityFactory->notify_create_entity( handle, connectivity, num_nodes);
 
 #ifdef MOAB_HAVE_AHF
-  mesh_modified = true;
+  if (MB_SUCCESS == status)
+    status = ahfRep->notify_create_entity(handle);
 #endif
 
 
@@ -2688,6 +2799,22 @@ ErrorCode Core::create_vertices(const double *coordinates,
                                     const int nverts,
                                     Range &entity_handles )
 {
+  if (sequenceManager->get_float_coordinates()) {
+    // Readers fill double arrays, so create single precision vertices here
+    EntitySequence* seq;
+    EntityHandle start_handle;
+    ErrorCode result = sequenceManager->create_entity_sequence(MBVERTEX, nverts, 0, MB_START_ID,
+                                                               start_handle, seq, -1, true);MB_CHK_ERR(result);
+    VertexSequence* vseq = static_cast<VertexSequence*>(seq);
+    for (int i = 0; i < nverts; i++) {
+      result = vseq->set_coordinates(start_handle + i, coordinates + 3*i);MB_CHK_ERR(result);
+    }
+
+    entity_handles.clear();
+    entity_handles.insert(start_handle, start_handle+nverts-1);
+    return MB_SUCCESS;
+  }
+
     // Create vertices
   ReadUtilIface *read_iface;
   ErrorCode result = Interface::query_interface(read_iface);MB_CHK_ERR(result);
@@ -2789,6 +2916,12 @@ ErrorCode Core::delete_entities(const Range &range)
       continue;
     }
 
+#ifdef MOAB_HAVE_AHF
+    temp_result = ahfRep->notify_delete_entity(*rit);
+    if (MB_SUCCESS != temp_result)
+      result = temp_result;
+#endif
+
     if (TYPE_FROM_HANDLE(*rit) == MBENTITYSET) {
       if (MeshSet* ptr = get_mesh_set( sequence_manager(), *rit )) {
         int j, count;
@@ -2841,6 +2974,14 @@ ErrorCode Core::delete_entities(const EntityHandle *entities,
       failed = true;
     }
 
+#ifdef MOAB_HAVE_AHF
+    if (!failed) {
+      temp_result = ahfRep->notify_delete_entity(entities[i]);
+      if (MB_SUCCESS != temp_result)
+        result = temp_result;
+    }
+#endif
+
     if (TYPE_FROM_HANDLE(entities[i]) == MBENTITYSET) {
       if (MeshSet* ptr = get_mesh_set( sequence_manager(), entities[i] )) {
         int j, count;
@@ -54,11 +54,19 @@ DenseTag::DenseTag(int index,
                    const char* name,
                    int size,
                    DataType type,
-                   const void* default_value)
+                   const void* default_value,
+                   bool float_values)
   : TagInfo(name, size, type, default_value, size),
     mySequenceArray(index),
-    meshValue(0)
-  {}
+    meshValue(0),
+    floatValues(float_values),
+    valueBytes(float_values ? size / 2 : size)
+{
+  if (floatValues && default_value) {
+    storedDefault.resize(valueBytes);
+    copy_to_storage(&storedDefault[0], default_value, 1);
+  }
+}
 
 TagType DenseTag::get_storage_type() const
 {
@@ -70,16 +78,19 @@ DenseTag* DenseTag::create_tag(SequenceManager* seqman,
                                const char* name,
                                int bytes,
                                DataType type,
-                               const void* default_value)
+                               const void* default_value,
+                               bool float_values)
 {
   if (bytes < 1)
     return 0;
+  if (float_values && (MB_TYPE_DOUBLE != type || bytes % sizeof(double)))
+    return 0;
 
   int index;
-  if (MB_SUCCESS != seqman->reserve_tag_array(NULL, bytes, index))
+  if (MB_SUCCESS != seqman->reserve_tag_array(NULL, float_values ? bytes / 2 : bytes, index))
     return 0;
 
-  return new DenseTag(index, name, bytes, type, default_value);
+  return new DenseTag(index, name, bytes, type, default_value, float_values);
 }
 
 DenseTag::~DenseTag()
@@ -88,6 +99,49 @@ DenseTag::~DenseTag()
   delete [] meshValue;
 }
 
+void DenseTag::copy_from_storage(void* values,
+                                 const unsigned char* storage,
+                                 size_t count) const
+{
+  if (!floatValues) {
+    memcpy(values, storage, get_size() * count);
+    return;
+  }
+
+  const float* from = reinterpret_cast<const float*>(storage);
+  double* to = reinterpret_cast<double*>(values);
+  const size_t n = count * (get_size() / sizeof(double));
+  for (size_t i = 0; i < n; ++i)
+    to[i] = from[i];
+}
+
+void DenseTag::copy_to_storage(unsigned char* storage,
+                               const void* values,
+                               size_t count) const
+{
+  if (!floatValues) {
+    memcpy(storage, values, get_size() * count);
+    return;
+  }
+
+  const double* from = reinterpret_cast<const double*>(values);
+  float* to = reinterpret_cast<float*>(storage);
+  const size_t n = count * (get_size() / sizeof(double));
+  for (size_t i = 0; i < n; ++i)
+    to[i] = static_cast<float>(from[i]);
+}
+
+const void* DenseTag::stored_value(const void* value,
+                                   std::vector<unsigned char>& buffer) const
+{
+  if (!floatValues)
+    return value;
+
+  buffer.resize(valueBytes);
+  copy_to_storage(&buffer[0], value, 1);
+  return &buffer[0];
+}
+
 ErrorCode DenseTag::release_all_data(SequenceManager* seqman,
                                      Error* /* error */,
                                      bool delete_pending)
@@ -135,7 +189,7 @@ ErrorCode DenseTag::get_array_private(const SequenceManager* seqman,
   ptr = reinterpret_cast<const unsigned char*>(mem);
   count = seq->data()->end_handle() - h + 1;
   if (ptr)
-    ptr += get_size() * (h - seq->data()->start_handle());
+    ptr += valueBytes * (h - seq->data()->start_handle());
 
   return MB_SUCCESS;
 }
@@ -153,7 +207,7 @@ ErrorCode DenseTag::get_array_private(const EntitySequence* seq,
 {
   ptr = reinterpret_cast<const unsigned char*>(seq->data()->get_tag_data(mySequenceArray));
   if (ptr)
-    ptr += get_size() * (seq->start_handle() - seq->data()->start_handle());
+    ptr += valueBytes * (seq->start_handle() - seq->data()->start_handle());
 
   return MB_SUCCESS;
 }
@@ -170,7 +224,7 @@ ErrorCode DenseTag::get_array_private(SequenceManager* seqman,
   if (MB_SUCCESS != rval) {
     if (!h) { // Root set
       if (!meshValue && allocate)
-        meshValue = new unsigned char[get_size()];
+        meshValue = new unsigned char[valueBytes];
       ptr = meshValue;
       count = 1;
       return MB_SUCCESS;
@@ -184,19 +238,20 @@ ErrorCode DenseTag::get_array_private(SequenceManager* seqman,
 
   void* mem = seq->data()->get_tag_data(mySequenceArray);
   if (!mem && allocate) {
-    mem = seq->data()->allocate_tag_array(mySequenceArray, get_size(), get_default_value());
+    const void* default_value = floatValues ? (storedDefault.empty() ? 0 : &storedDefault[0]) : get_default_value();
+    mem = seq->data()->allocate_tag_array(mySequenceArray, valueBytes, default_value);
     if (!mem) {
       MB_SET_ERR(MB_MEMORY_ALLOCATION_FAILED, "Memory allocation for dense tag data failed");
     }
 
-    if (!get_default_value())
-      memset(mem, 0, get_size() * seq->data()->size());
+    if (!default_value)
+      memset(mem, 0, valueBytes * seq->data()->size());
   }
 
   ptr = reinterpret_cast<unsigned char*>(mem);
   count = seq->data()->end_handle() - h + 1;
   if (ptr)
-    ptr += get_size() * (h - seq->data()->start_handle());
+    ptr += valueBytes * (h - seq->data()->start_handle());
   return MB_SUCCESS;
 }
 
@@ -214,7 +269,7 @@ ErrorCode DenseTag::get_data(const SequenceManager* seqman,
     ErrorCode rval = get_array(seqman, NULL, *i, data, junk);MB_CHK_ERR(rval);
 
     if (data)
-      memcpy(ptr, data, get_size());
+      copy_from_storage(ptr, data, 1);
     else if (get_default_value())
       memcpy(ptr, get_default_value(), get_size());
     else
@@ -242,7 +297,7 @@ ErrorCode DenseTag::get_data(const SequenceManager* seqman,
 
       const size_t count = std::min<size_t>(p->second - start + 1, avail);
       if (array)
-        memcpy(data, array, get_size() * count);
+        copy_from_storage(data, array, count);
       else if (get_default_value())
         SysUtil::setmem(data, get_default_value(), get_size(), count);
       else
@@ -268,6 +323,10 @@ ErrorCode DenseTag::get_data(const SequenceManager* seqman,
   size_t junk = 0;
   const unsigned char* ptr = NULL; // Initialize to get rid of warning
 
+  // There are no double values to point to when they are stored as float
+  if (floatValues)
+    return MB_TYPE_OUT_OF_RANGE;
+
   if (data_lengths) {
     const int len = get_size();
     SysUtil::setmem(data_lengths, &len, sizeof(int), num_entities);
@@ -297,6 +356,10 @@ ErrorCode DenseTag::get_data(const SequenceManager* seqman,
   size_t avail = 0;
   const unsigned char* array = NULL;
 
+  // There are no double values to point to when they are stored as float
+  if (floatValues)
+    return MB_TYPE_OUT_OF_RANGE;
+
   if (data_lengths) {
     int len = get_size();
     SysUtil::setmem(data_lengths, &len, sizeof(int), entities.size());
@@ -345,7 +408,7 @@ ErrorCode DenseTag::set_data(SequenceManager* seqman,
   for (const EntityHandle* i = entities; i != end; ++i, ptr += get_size()) {
     rval = get_array_private(seqman, NULL, *i, array, junk, true);MB_CHK_ERR(rval);
 
-    memcpy(array, ptr, get_size());
+    copy_to_storage(array, ptr, 1);
   }
 
   return MB_SUCCESS;
@@ -368,7 +431,7 @@ ErrorCode DenseTag::set_data(SequenceManager* seqman,
       rval = get_array_private(seqman, NULL, start, array, avail, true);MB_CHK_ERR(rval);
 
       const size_t count = std::min<size_t>(p->second - start + 1, avail);
-      memcpy(array, data, get_size() * count);
+      copy_to_storage(array, data, count);
       data += get_size() * count;
       start += count;
     }
@@ -393,7 +456,7 @@ ErrorCode DenseTag::set_data(SequenceManager* seqman,
   for (const EntityHandle* i = entities; i != end; ++i, ++pointers) {
     rval = get_array_private(seqman, NULL, *i, array, junk, true);MB_CHK_ERR(rval);
 
-    memcpy(array, *pointers, get_size());
+    copy_to_storage(array, *pointers, 1);
   }
 
   return MB_SUCCESS;
@@ -417,10 +480,10 @@ ErrorCode DenseTag::set_data(SequenceManager* seqman,
 
       const EntityHandle end = std::min<EntityHandle>(p->second + 1, start + avail);
       while (start != end) {
-        memcpy(array, *pointers, get_size());
+        copy_to_storage(array, *pointers, 1);
         ++start;
         ++pointers;
-        array += get_size();
+        array += valueBytes;
       }
     }
   }
@@ -439,12 +502,14 @@ ErrorCode DenseTag::clear_data(bool allocate,
   const EntityHandle* const end = entities + num_entities;
   unsigned char* array = NULL;
   size_t junk = 0;
+  std::vector<unsigned char> buffer;
+  value_ptr = stored_value(value_ptr, buffer);
 
   for (const EntityHandle* i = entities; i != end; ++i) {
     rval = get_array_private(seqman, NULL, *i, array, junk, allocate);MB_CHK_ERR(rval);
 
     if (array) // Array should never be null if allocate == true
-      memcpy(array, value_ptr, get_size());
+      memcpy(array, value_ptr, valueBytes);
   }
 
   return MB_SUCCESS;
@@ -459,6 +524,8 @@ ErrorCode DenseTag::clear_data(bool allocate,
   ErrorCode rval;
   unsigned char* array = NULL;
   size_t avail = 0;
+  std::vector<unsigned char> buffer;
+  value_ptr = stored_value(value_ptr, buffer);
 
   for (Range::const_pair_iterator p = entities.const_pair_begin();
        p != entities.const_pair_end(); ++p) {
@@ -468,7 +535,7 @@ ErrorCode DenseTag::clear_data(bool allocate,
 
       const size_t count = std::min<size_t>(p->second - start + 1, avail);
       if (array) // Array should never be null if allocate == true
-        SysUtil::setmem(array, value_ptr, get_size(), count);
+        SysUtil::setmem(array, value_ptr, valueBytes, count);
       start += count;
     }
   }
@@ -541,6 +608,10 @@ ErrorCode DenseTag::tag_iterate(SequenceManager* seqman,
   if (iter == end)
     return MB_SUCCESS;
 
+  // The storage holds float, not the double values of the tag
+  if (floatValues)
+    return MB_TYPE_OUT_OF_RANGE;
+
   unsigned char* array = NULL;
   size_t avail = 0;
   ErrorCode rval = get_array_private(seqman, NULL, *iter, array, avail, allocate);MB_CHK_ERR(rval);
@@ -602,6 +673,10 @@ ErrorCode DenseTag::find_entities_with_value(const SequenceManager* seqman,
     MB_SET_ERR(MB_INVALID_SIZE, "Cannot compare data of size " << value_bytes << " with tag of size " << get_size());
   }
 
+  // Values stored as float are compared with the value rounded to float
+  std::vector<unsigned char> buffer;
+  value = stored_value(value, buffer);
+
   if (!intersect_entities) {
     std::pair<EntityType,EntityType> range = type_range(type);
     TypeSequenceManager::const_iterator i;
@@ -610,10 +685,13 @@ ErrorCode DenseTag::find_entities_with_value(const SequenceManager* seqman,
       for (i = map.begin(); i != map.end(); ++i) {
         const void* data = (*i)->data()->get_tag_data(mySequenceArray);
         if (data) {
-          ByteArrayIterator start((*i)->data()->start_handle(), data, *this);
+          ByteArrayIterator start((*i)->data()->start_handle(), data, valueBytes);
           ByteArrayIterator end((*i)->end_handle() + 1, 0, 0);
           start += (*i)->start_handle() - (*i)->data()->start_handle();
-          find_tag_values_equal(*this, value, get_size(), start, end, output_entities);
+          if (floatValues)
+            find_tag_values(TagBytesEqual(value, valueBytes), start, end, output_entities);
+          else
+            find_tag_values_equal(*this, value, get_size(), start, end, output_entities);
         }
       }
     }
@@ -640,9 +718,12 @@ ErrorCode DenseTag::find_entities_with_value(const SequenceManager* seqman,
           count = p->second - start + 1;
 
         if (array) {
-          ByteArrayIterator istart(start, array, *this);
+          ByteArrayIterator istart(start, array, valueBytes);
           ByteArrayIterator iend(start + count, 0, 0);
-          find_tag_values_equal(*this, value, get_size(), istart, iend, output_entities);
+          if (floatValues)
+            find_tag_values(TagBytesEqual(value, valueBytes), istart, iend, output_entities);
+          else
+            find_tag_values_equal(*this, value, get_size(), istart, iend, output_entities);
         }
         start += count;
       }
@@ -663,7 +744,7 @@ ErrorCode DenseTag::get_memory_use(const SequenceManager* seqman,
                                    unsigned long& total,
                                    unsigned long& per_entity) const
 {
-  per_entity = get_size();
+  per_entity = valueBytes;
   total = TagInfo::get_memory_use() + sizeof(*this);
   for (EntityType t = MBVERTEX; t <= MBENTITYSET; ++t) {
     const TypeSequenceManager& map = seqman->entity_map(t);
@@ -671,7 +752,7 @@ ErrorCode DenseTag::get_memory_use(const SequenceManager* seqman,
     for (TypeSequenceManager::const_iterator i = map.begin(); i != map.end(); ++i) {
       if ((*i)->data() != prev_data && (*i)->data()->get_tag_data(mySequenceArray)) {
         prev_data = (*i)->data();
-        total += get_size() * (*i)->data()->size();
+        total += valueBytes * (*i)->data()->size();
       }
     }
   }
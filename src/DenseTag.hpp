@@ -7,6 +7,7 @@
 #define DENSE_TAG_HPP
 
 #include "TagInfo.hpp"
+#include <vector>
 
 namespace moab {
 
@@ -14,7 +15,11 @@ class EntitySequence;
 
 /**\brief Dense storage of fixed-length tag data
  *
- * Implement normal dense tag.
+ * Implement normal dense tag.  The values of a tag created with
+ * MB_TAG_FLOAT are of type MB_TYPE_DOUBLE but are stored as float,
+ * and are converted when they are read or written.  Such a tag cannot
+ * hand out pointers to its storage: tag_iterate and the pointer
+ * variants of get_data return MB_TYPE_OUT_OF_RANGE for it.
  */
 class DenseTag : public TagInfo
 {
@@ -23,11 +28,16 @@ private:
 
   unsigned char* meshValue;
 
+  bool floatValues; //!< Values are stored as float rather than double
+  int valueBytes; //!< Bytes of storage per entity
+  std::vector<unsigned char> storedDefault; //!< Default value as stored, if float
+
   DenseTag( int array_index,
             const char * name,
             int size,
             DataType type,
-            const void * default_value );
+            const void * default_value,
+            bool float_values );
 
 public:
   static
@@ -36,10 +46,15 @@ public:
                         const char* name,
                         int bytes,
                         DataType type,
-                        const void* default_value );
+                        const void* default_value,
+                        bool float_values = false );
 
   virtual ~DenseTag();
 
+  //! True if the double values of the tag are stored as float
+  bool float_values() const
+    { return floatValues; }
+
   virtual TagType get_storage_type() const;
 
   /**\brief Remove/clear tag data for all entities
@@ -470,6 +485,15 @@ private:
   ErrorCode get_array_private( const EntitySequence* seq,
                        const unsigned char* & ptr) const;
 
+  //! Copy the values of count entities out of tag storage
+  void copy_from_storage( void* values, const unsigned char* storage, size_t count ) const;
+
+  //! Copy the values of count entities into tag storage
+  void copy_to_storage( unsigned char* storage, const void* values, size_t count ) const;
+
+  //! One value as stored, converted into buffer if needed
+  const void* stored_value( const void* value, std::vector<unsigned char>& buffer ) const;
+
   /**\brief Common implementation of public clear_data and remove_data */
   ErrorCode clear_data( bool allocate,
                         SequenceManager* seqman,
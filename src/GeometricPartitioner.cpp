@@ -0,0 +1,623 @@
+/**
+ * MOAB, a Mesh-Oriented datABase, is a software component for creating,
+ * storing and accessing finite element mesh data.
+ *
+ * Copyright 2004 Sandia Corporation.  Under the terms of Contract
+ * DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government
+ * retains certain rights in this software.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <string>
+#include <limits>
+#include <ctime>
+#include <cctype>
+#include <math.h>
+#include <stdint.h>
+
+#include "moab/GeometricPartitioner.hpp"
+#include "moab/Interface.hpp"
+#include "Internals.hpp"
+#include "moab/Range.hpp"
+#include "SpaceFillingCurve.hpp"
+
+using namespace moab;
+
+// elements handled per get_coords call when computing centroids
+const int CENTROID_BLOCK = 16384;
+
+// below this many elements the RCB recursion is not split into tasks
+const size_t RCB_TASK_SIZE = 16384;
+
+namespace {
+
+  // range of element indices [begin, end) still to be split among nparts parts
+  struct RCBNode { int begin, end, first_part, nparts; };
+
+  // comparator of element indices by one coordinate of their centroid
+  class CentroidLess
+  {
+  public:
+    CentroidLess(const double *c, int axis) : coords(c), dir(axis) {}
+    bool operator()(int a, int b) const { return coords[3*a+dir] < coords[3*b+dir]; }
+  private:
+    const double *coords;
+    int dir;
+  };
+
+  void subset_box(const double *centroids, const int *begin, const int *end,
+                  double bmin[3], double bmax[3])
+  {
+    for (int d = 0; d < 3; d++) {
+      bmin[d] = std::numeric_limits<double>::max();
+      bmax[d] = -std::numeric_limits<double>::max();
+    }
+    for (const int *it = begin; it != end; ++it)
+      for (int d = 0; d < 3; d++) {
+        bmin[d] = std::min(bmin[d], centroids[3*(*it)+d]);
+        bmax[d] = std::max(bmax[d], centroids[3*(*it)+d]);
+      }
+  }
+
+  int longest_axis(const double bmin[3], const double bmax[3])
+  {
+    int axis = 0;
+    for (int d = 1; d < 3; d++)
+      if (bmax[d]-bmin[d] > bmax[axis]-bmin[axis])
+        axis = d;
+    return axis;
+  }
+
+    // serial recursive bisection; parts [first_part, first_part+nparts) get
+    // the elements in [begin, end) proportionally to their number
+  void rcb_bisect(const double *centroids, int *begin, int *end,
+                  int first_part, int nparts, int *assignment)
+  {
+    if (nparts == 1) {
+      for (int *it = begin; it != end; ++it)
+        assignment[*it] = first_part;
+      return;
+    }
+
+    size_t n = end - begin;
+    int nleft = nparts/2;
+    int *mid = begin + (size_t)((double)n*nleft/nparts);
+    if (n) {
+      double bmin[3], bmax[3];
+      subset_box(centroids, begin, end, bmin, bmax);
+      std::nth_element(begin, mid, end, CentroidLess(centroids, longest_axis(bmin, bmax)));
+    }
+
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp task if (n > RCB_TASK_SIZE)
+#endif
+    rcb_bisect(centroids, begin, mid, first_part, nleft, assignment);
+    rcb_bisect(centroids, mid, end, first_part+nleft, nparts-nleft, assignment);
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp taskwait
+#endif
+  }
+
+}
+
+GeometricPartitioner::GeometricPartitioner( Interface *impl,
+                                            const bool use_coords)
+                                          : PartitionerBase<int>(impl,use_coords),
+                                            projectOnSphere(false)
+{
+}
+
+GeometricPartitioner::~GeometricPartitioner()
+{
+}
+
+ErrorCode GeometricPartitioner::partition_mesh(const int nparts,
+                                               const char *method,
+                                               const int part_dim,
+                                               const bool write_as_sets,
+                                               const bool write_as_tags,
+                                               const bool partition_tagged_sets,
+                                               const bool partition_tagged_ents,
+                                               const char *,
+                                               const bool print_time)
+{
+  if (partition_tagged_sets || partition_tagged_ents)
+    MB_SET_ERR(MB_NOT_IMPLEMENTED, "Geometric partitioner cannot partition tagged sets or entities");
+  if (nparts < 1)
+    MB_SET_ERR(MB_FAILURE, "Invalid number of parts " << nparts);
+
+  std::string mname(method ? method : "RCB");
+  std::transform(mname.begin(), mname.end(), mname.begin(), ::toupper);
+  if (mname != "RCB" && mname != "HILBERT" && mname != "MORTON")
+    MB_SET_ERR(MB_FAILURE, "Unknown geometric partition method " << mname << ", expected RCB, HILBERT or MORTON");
+
+  clock_t t = clock();
+  ErrorCode result;
+
+  Range elems;
+  result = mbImpl->get_entities_by_dimension(0, part_dim, elems);MB_CHK_ERR(result);
+
+  std::vector<double> centroids;
+  result = compute_centroids(elems, centroids);MB_CHK_ERR(result);
+
+  if (print_time)
+  {
+    std::cout << " time to compute centroids " << (clock() - t) / (double) CLOCKS_PER_SEC << "s. \n";
+    t = clock();
+  }
+
+  std::vector<int> assignment(elems.size(), 0);
+  if (mname == "RCB") {
+    result = rcb_partition(nparts, centroids, assignment);MB_CHK_ERR(result);
+  }
+  else {
+    result = sfc_partition(nparts, centroids, mname == "HILBERT", assignment);MB_CHK_ERR(result);
+  }
+
+  if (print_time)
+  {
+    std::cout << " time to partition " << (clock() - t) / (double) CLOCKS_PER_SEC << "s. \n";
+    t = clock();
+  }
+
+#ifdef MOAB_HAVE_MPI
+    // global ids, starting from one
+  if (assign_global_ids)
+  {
+    result = mbpc->assign_global_ids(0, 0, 1);MB_CHK_ERR(result);
+  }
+#endif
+
+  std::cout << "Saving partition information to MOAB..." << std::endl;
+  result = write_partition(nparts, elems, assignment.empty() ? NULL : &assignment[0],
+                           write_as_sets, write_as_tags);MB_CHK_ERR(result);
+
+  if (print_time)
+    std::cout << " time to write partition in memory " << (clock() - t) / (double) CLOCKS_PER_SEC << "s. \n";
+
+  return MB_SUCCESS;
+}
+
+ErrorCode GeometricPartitioner::compute_centroids(Range &elems,
+                                                  std::vector<double> &centroids)
+{
+  ErrorCode result;
+  centroids.resize(3*elems.size());
+  if (elems.empty())
+    return MB_SUCCESS;
+
+  if (TYPE_FROM_HANDLE(elems.front()) == MBVERTEX) {
+    result = mbImpl->get_coords(elems, &centroids[0]);MB_CHK_ERR(result);
+  }
+  else {
+    std::vector<double> vcoords;
+    std::vector<EntityHandle> verts;
+    size_t idx = 0;
+    Range::iterator rit = elems.begin();
+    while (rit != elems.end()) {
+      if (TYPE_FROM_HANDLE(*rit) == MBPOLYHEDRON) {
+          // connectivity of polyhedra is faces, go through the adjacencies
+        verts.clear();
+        result = mbImpl->get_adjacencies(&*rit, 1, 0, false, verts);MB_CHK_ERR(result);
+        vcoords.resize(3*verts.size());
+        result = mbImpl->get_coords(&verts[0], verts.size(), &vcoords[0]);MB_CHK_ERR(result);
+        double *c = &centroids[3*idx];
+        c[0] = c[1] = c[2] = 0.0;
+        for (size_t j = 0; j < verts.size(); j++)
+          for (int d = 0; d < 3; d++)
+            c[d] += vcoords[3*j+d]/verts.size();
+        ++rit;
+        ++idx;
+        continue;
+      }
+
+        // contiguous block of elements of the same type
+      EntityHandle *conn;
+      int nodes_per, count;
+      result = mbImpl->connect_iterate(rit, elems.end(), conn, nodes_per, count);MB_CHK_ERR(result);
+
+        // one thread team for the whole block; the coordinates of each chunk are
+        // gathered by a single thread, the barriers keep vcoords stable while in use
+      vcoords.resize(3*(size_t)nodes_per*std::min(CENTROID_BLOCK, count));
+      result = MB_SUCCESS;
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel
+#endif
+      for (int start = 0; start < count; start += CENTROID_BLOCK) {
+        int nb = std::min(CENTROID_BLOCK, count-start);
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp single
+#endif
+        result = mbImpl->get_coords(conn + (size_t)nodes_per*start, nodes_per*nb, &vcoords[0]);
+        if (MB_SUCCESS != result)
+          break;
+
+        double *c = &centroids[3*(idx+start)];
+        const double *vc = &vcoords[0];
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp for
+#endif
+        for (int i = 0; i < nb; i++) {
+          double sum[3] = {0.0, 0.0, 0.0};
+          for (int j = 0; j < nodes_per; j++)
+            for (int d = 0; d < 3; d++)
+              sum[d] += vc[3*(i*nodes_per+j)+d];
+          for (int d = 0; d < 3; d++)
+            c[3*i+d] = sum[d]/nodes_per;
+        }
+      }
+      MB_CHK_ERR(result);
+
+      rit += count;
+      idx += count;
+    }
+  }
+
+  if (projectOnSphere) {
+    long n = elems.size();
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (long i = 0; i < n; i++) {
+      double *c = &centroids[3*i];
+      double len = sqrt(c[0]*c[0] + c[1]*c[1] + c[2]*c[2]);
+      if (len > 0.0)
+        for (int d = 0; d < 3; d++)
+          c[d] /= len;
+    }
+  }
+
+  return MB_SUCCESS;
+}
+
+ErrorCode GeometricPartitioner::rcb_partition(const int nparts,
+                                              const std::vector<double> &centroids,
+                                              std::vector<int> &assignment)
+{
+  size_t n = assignment.size();
+  std::vector<int> perm(n);
+  for (size_t i = 0; i < n; i++)
+    perm[i] = i;
+  int *pbegin = perm.empty() ? NULL : &perm[0];
+  const double *cptr = centroids.empty() ? NULL : &centroids[0];
+
+#ifdef MOAB_HAVE_MPI
+  if (mbpc->size() > 1) {
+      // distributed bisection: all ranks walk the same tree, each cut is found by
+      // bisecting on the coordinate until the global count left of it is right
+    std::vector<RCBNode> stack;
+    RCBNode root = {0, (int)n, 0, nparts};
+    stack.push_back(root);
+    while (!stack.empty()) {
+      RCBNode nd = stack.back();
+      stack.pop_back();
+      int *begin = pbegin + nd.begin, *end = pbegin + nd.end;
+      if (nd.nparts == 1) {
+        for (int *it = begin; it != end; ++it)
+          assignment[*it] = nd.first_part;
+        continue;
+      }
+
+      double lmin[3], lmax[3], gmin[3], gmax[3];
+      subset_box(cptr, begin, end, lmin, lmax);
+      long lcount = end - begin, gcount = 0;
+      MPI_Allreduce(lmin, gmin, 3, MPI_DOUBLE, MPI_MIN, mbpc->comm());
+      MPI_Allreduce(lmax, gmax, 3, MPI_DOUBLE, MPI_MAX, mbpc->comm());
+      MPI_Allreduce(&lcount, &gcount, 1, MPI_LONG, MPI_SUM, mbpc->comm());
+
+      int nleft = nd.nparts/2;
+      int *mid = begin;
+      long target = (long)((double)gcount*nleft/nd.nparts);
+      if (target > 0) {
+        int axis = longest_axis(gmin, gmax);
+          // bisect for the smallest cut with at least target centroids at or below it,
+          // keeping fewer than target at or below lo
+        double lo = gmin[axis] - 1.0 - fabs(gmin[axis]), hi = gmax[axis];
+        for (;;) {
+          double cut = lo + 0.5*(hi - lo);
+          if (cut <= lo || cut >= hi)
+            break;
+          long lleft = 0, gleft = 0;
+          for (int *it = begin; it != end; ++it)
+            if (cptr[3*(*it)+axis] <= cut)
+              lleft++;
+          MPI_Allreduce(&lleft, &gleft, 1, MPI_LONG, MPI_SUM, mbpc->comm());
+          if (gleft < target)
+            lo = cut;
+          else
+            hi = cut;
+          if (gleft == target)
+            break;
+        }
+
+          // centroids below hi go left, and of those equal to it, as many as
+          // needed to reach the target, taken in rank order
+        long lcounts[2] = {0, 0}, gbelow = 0, offset = 0;
+        for (int *it = begin; it != end; ++it) {
+          if (cptr[3*(*it)+axis] < hi)
+            lcounts[0]++;
+          else if (cptr[3*(*it)+axis] == hi)
+            lcounts[1]++;
+        }
+        MPI_Allreduce(&lcounts[0], &gbelow, 1, MPI_LONG, MPI_SUM, mbpc->comm());
+        MPI_Exscan(&lcounts[1], &offset, 1, MPI_LONG, MPI_SUM, mbpc->comm());
+        if (0 == mbpc->rank())
+          offset = 0;
+        long take = std::min(std::max(target - gbelow - offset, 0L), lcounts[1]);
+        for (int *it = begin; it != end; ++it) {
+          double x = cptr[3*(*it)+axis];
+          if (x < hi || (x == hi && take-- > 0))
+            std::swap(*it, *mid++);
+        }
+      }
+
+      RCBNode right = {(int)(mid - pbegin), nd.end, nd.first_part+nleft, nd.nparts-nleft};
+      RCBNode left = {nd.begin, (int)(mid - pbegin), nd.first_part, nleft};
+      stack.push_back(right);
+      stack.push_back(left);
+    }
+    return MB_SUCCESS;
+  }
+#endif
+
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel
+#pragma omp single
+#endif
+  rcb_bisect(cptr, pbegin, pbegin + n, 0, nparts, assignment.empty() ? NULL : &assignment[0]);
+
+  return MB_SUCCESS;
+}
+
+ErrorCode GeometricPartitioner::sfc_partition(const int nparts,
+                                              const std::vector<double> &centroids,
+                                              const bool hilbert,
+                                              std::vector<int> &assignment)
+{
+  long n = assignment.size();
+
+    // bounding box of all centroids, the curve is laid over it
+  double bmin[3], bmax[3];
+  for (int d = 0; d < 3; d++) {
+    bmin[d] = std::numeric_limits<double>::max();
+    bmax[d] = -std::numeric_limits<double>::max();
+  }
+  for (long i = 0; i < n; i++)
+    for (int d = 0; d < 3; d++) {
+      bmin[d] = std::min(bmin[d], centroids[3*i+d]);
+      bmax[d] = std::max(bmax[d], centroids[3*i+d]);
+    }
+#ifdef MOAB_HAVE_MPI
+  if (mbpc->size() > 1) {
+    double lmin[3] = {bmin[0], bmin[1], bmin[2]}, lmax[3] = {bmax[0], bmax[1], bmax[2]};
+    MPI_Allreduce(lmin, bmin, 3, MPI_DOUBLE, MPI_MIN, mbpc->comm());
+    MPI_Allreduce(lmax, bmax, 3, MPI_DOUBLE, MPI_MAX, mbpc->comm());
+  }
+#endif
+
+  double scale[3];
+  SpaceFillingCurve::box_scale(bmin, bmax, scale);
+
+    // curve keys, paired with the element index for sorting
+  std::vector<std::pair<uint64_t, int> > keys(n);
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel for
+#endif
+  for (long i = 0; i < n; i++) {
+    unsigned int X[3];
+    SpaceFillingCurve::quantize(&centroids[3*i], bmin, scale, X);
+    uint64_t key = hilbert ? SpaceFillingCurve::hilbert_key(X) : SpaceFillingCurve::morton_key(X);
+    keys[i] = std::make_pair(key, (int)i);
+  }
+  std::sort(keys.begin(), keys.end());
+
+#ifdef MOAB_HAVE_MPI
+  if (mbpc->size() > 1) {
+      // bisect all nparts-1 splitter keys at once until the global number of
+      // keys below each matches its share
+    long gcount = 0;
+    MPI_Allreduce(&n, &gcount, 1, MPI_LONG, MPI_SUM, mbpc->comm());
+    int nsplit = nparts - 1;
+    std::vector<uint64_t> lo(nsplit, 0), hi(nsplit, (uint64_t)1 << (3*SpaceFillingCurve::BITS)), mid(nsplit);
+    std::vector<long> lcounts(nsplit), gcounts(nsplit);
+    for (int iter = 0; iter <= 3*SpaceFillingCurve::BITS && nsplit; iter++) {
+      for (int k = 0; k < nsplit; k++) {
+        mid[k] = lo[k] + (hi[k] - lo[k])/2;
+        lcounts[k] = std::lower_bound(keys.begin(), keys.end(), std::make_pair(mid[k], 0)) - keys.begin();
+      }
+      MPI_Allreduce(&lcounts[0], &gcounts[0], nsplit, MPI_LONG, MPI_SUM, mbpc->comm());
+      for (int k = 0; k < nsplit; k++) {
+        long target = (long)((double)gcount*(k+1)/nparts);
+        if (gcounts[k] < target)
+          lo[k] = mid[k];
+        else
+          hi[k] = mid[k];
+      }
+    }
+
+    int part = 0;
+    for (long j = 0; j < n; j++) {
+      while (part < nsplit && keys[j].first >= hi[part])
+        part++;
+      assignment[keys[j].second] = part;
+    }
+    return MB_SUCCESS;
+  }
+#endif
+
+    // cut the sorted curve in pieces of equal length
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel for
+#endif
+  for (long j = 0; j < n; j++)
+    assignment[keys[j].second] = (int)((double)j*nparts/n);
+
+  return MB_SUCCESS;
+}
+
+ErrorCode GeometricPartitioner::write_partition(const int nparts,
+                                                Range &elems,
+                                                const int *assignment,
+                                                const bool write_as_sets,
+                                                const bool write_as_tags)
+{
+  ErrorCode result;
+
+    // get the partition set tag
+  Tag part_set_tag;
+  int dum_id = -1, i;
+  result = mbImpl->tag_get_handle("PARALLEL_PARTITION", 1, MB_TYPE_INTEGER,
+                                  part_set_tag, MB_TAG_SPARSE|MB_TAG_CREAT, &dum_id);MB_CHK_ERR(result);
+
+    // get any sets already with this tag, and clear them
+  Range tagged_sets;
+  result = mbImpl->get_entities_by_type_and_tag(0, MBENTITYSET, &part_set_tag, NULL, 1,
+                                                tagged_sets, Interface::UNION);MB_CHK_ERR(result);
+  if (!tagged_sets.empty()) {
+    result = mbImpl->clear_meshset(tagged_sets);MB_CHK_ERR(result);
+    if (!write_as_sets) {
+      result = mbImpl->tag_delete_data(part_set_tag, tagged_sets);MB_CHK_ERR(result);
+    }
+  }
+
+  if (write_as_sets) {
+      // first, create partition sets and store in vector
+    partSets.clear();
+
+    if (nparts > (int) tagged_sets.size()) {
+        // too few partition sets - create missing ones
+      int num_new = nparts - tagged_sets.size();
+      for (i = 0; i < num_new; i++) {
+        EntityHandle new_set;
+        result = mbImpl->create_meshset(MESHSET_SET, new_set);MB_CHK_ERR(result);
+        tagged_sets.insert(new_set);
+      }
+    }
+    else if (nparts < (int) tagged_sets.size()) {
+        // too many partition sets - delete extras
+      int num_del = tagged_sets.size() - nparts;
+      for (i = 0; i < num_del; i++) {
+        EntityHandle old_set = tagged_sets.pop_back();
+        result = mbImpl->delete_entities(&old_set, 1);MB_CHK_ERR(result);
+      }
+    }
+
+      // assign partition sets to vector
+    partSets.swap(tagged_sets);
+
+      // write a tag to those sets denoting they're partition sets, with a value of the
+      // proc number
+    std::vector<int> dum_ids(nparts);
+    for (i = 0; i < nparts; i++) dum_ids[i] = i;
+    result = mbImpl->tag_set_data(part_set_tag, partSets, &dum_ids[0]);MB_CHK_ERR(result);
+
+      // group the entities by part (stable, so each group stays sorted) and add
+      // each group to its set in one call
+    std::vector<size_t> offsets(nparts+1, 0);
+    size_t nelems = elems.size();
+    for (size_t k = 0; k < nelems; k++)
+      offsets[assignment[k]+1]++;
+    for (i = 0; i < nparts; i++)
+      offsets[i+1] += offsets[i];
+    std::vector<EntityHandle> grouped(nelems);
+    std::vector<size_t> pos(offsets.begin(), offsets.end()-1);
+    Range::iterator rit = elems.begin();
+    for (size_t k = 0; k < nelems; k++, ++rit)
+      grouped[pos[assignment[k]]++] = *rit;
+
+    Range empty_sets;
+    for (i = 0, rit = partSets.begin(); rit != partSets.end(); ++rit, i++) {
+      size_t num_ents = offsets[i+1] - offsets[i];
+      if (!num_ents) {
+        empty_sets.insert(*rit);
+        continue;
+      }
+      result = mbImpl->add_entities(*rit, &grouped[offsets[i]], num_ents);MB_CHK_ERR(result);
+    }
+
+      // warn about empty sets
+    if (!empty_sets.empty()) {
+      std::cout << "WARNING: " << empty_sets.size() << " empty sets in partition: ";
+      for (rit = empty_sets.begin(); rit != empty_sets.end(); rit++)
+        std::cout << *rit << " ";
+      std::cout << std::endl;
+    }
+  }
+
+  if (write_as_tags) {
+    result = mbImpl->tag_set_data(part_set_tag, elems, assignment);MB_CHK_ERR(result);
+  }
+
+  return MB_SUCCESS;
+}
+
+
+ErrorCode GeometricPartitioner::include_closure()
+{
+  ErrorCode result;
+  Range ents;
+  Range adjs;
+  std::cout << "Adding closure..." << std::endl;
+
+  for (Range::iterator rit = partSets.begin(); rit != partSets.end(); ++rit) {
+
+      // get the top-dimensional entities in the part
+    result = mbImpl->get_entities_by_handle(*rit, ents, true);MB_CHK_ERR(result);
+
+    if (ents.empty()) continue;
+
+      // get intermediate-dimensional adjs and add to set
+    for (int d = mbImpl->dimension_from_handle(*ents.begin())-1; d >= 1; d--) {
+      adjs.clear();
+      result = mbImpl->get_adjacencies(ents, d, false, adjs, Interface::UNION);MB_CHK_ERR(result);
+      result = mbImpl->add_entities(*rit, adjs);MB_CHK_ERR(result);
+    }
+
+      // now get vertices and add to set; only need to do for ents, not for adjs
+    adjs.clear();
+    result = mbImpl->get_adjacencies(ents, 0, false, adjs, Interface::UNION);MB_CHK_ERR(result);
+    result = mbImpl->add_entities(*rit, adjs);MB_CHK_ERR(result);
+
+    ents.clear();
+  }
+
+    // now go over non-part entity sets, looking for contained entities
+  Range sets, part_ents;
+  result = mbImpl->get_entities_by_type(0, MBENTITYSET, sets);MB_CHK_ERR(result);
+  for (Range::iterator rit = sets.begin(); rit != sets.end(); ++rit) {
+      // skip parts
+    if (partSets.find(*rit) != partSets.end()) continue;
+
+      // get entities in this set, recursively
+    ents.clear();
+    result = mbImpl->get_entities_by_handle(*rit, ents, true);MB_CHK_ERR(result);
+
+      // now check over all parts
+    for (Range::iterator rit2 = partSets.begin(); rit2 != partSets.end(); ++rit2) {
+      part_ents.clear();
+      result = mbImpl->get_entities_by_handle(*rit2, part_ents, false);MB_CHK_ERR(result);
+      Range int_range = intersect(ents, part_ents);
+      if (!int_range.empty()) {
+          // non-empty intersection, add to part set
+        result = mbImpl->add_entities(*rit2, &(*rit), 1);MB_CHK_ERR(result);
+      }
+    }
+  }
+
+    // finally, mark all the part sets as having the closure
+  Tag closure_tag;
+  result = mbImpl->tag_get_handle("INCLUDES_CLOSURE", 1, MB_TYPE_INTEGER,
+                                  closure_tag, MB_TAG_SPARSE|MB_TAG_CREAT);MB_CHK_ERR(result);
+
+  std::vector<int> closure_vals(partSets.size(), 1);
+  result = mbImpl->tag_set_data(closure_tag, partSets, &closure_vals[0]);MB_CHK_ERR(result);
+
+  return MB_SUCCESS;
+}
@@ -20,6 +20,7 @@
 #include <assert.h>
 #include <vector>
 #include <map>
+#include <algorithm>
 #include "MBTagConventions.hpp"
 #include "moab/ScdInterface.hpp"
 #ifdef MOAB_HAVE_MPI
@@ -42,12 +43,42 @@ namespace moab {
     return static_cast<int> (handle >> MB_ID_WIDTH);
   }
 
+  //! Grow a map to exactly n entries; a plain resize may double the capacity, and
+  //! the maps are grown once per level when a mesh hierarchy is generated
+  static void resize_map_exact(std::vector<HFacet> &map, std::size_t n)
+  {
+    map.reserve(n);
+    map.resize(n, 0);
+  }
+
 
   HalfFacetRep::HalfFacetRep(Core *impl,   ParallelComm *comm, moab::EntityHandle rset, bool filter_ghosts)
     : thismeshtype(CURVE), mb(impl), pcomm(comm), _rset(rset), _filterghost(filter_ghosts)
   {
     assert(NULL != impl);
     mInitAHFmaps = false;
+    for (int i = 0; i < MBMAXTYPE; i++)
+      cell_index[i] = -1;
+    cell_index[MBTET] = 0;
+    cell_index[MBPYRAMID] = 1;
+    cell_index[MBPRISM] = 2;
+    cell_index[MBHEX] = 3;
+    for (int i = 0; i < MBMAXTYPE; i++)
+      {
+        sib_map[i] = NULL;
+        sib_nhf[i] = 0;
+      }
+    sib_map[MBEDGE] = &sibhvs;
+    sib_nhf[MBEDGE] = 2;
+    sib_map[MBTRI] = sib_map[MBQUAD] = &sibhes;
+    sib_nhf[MBTRI] = lConnMap2D[MBTRI-2].num_verts_in_face;
+    sib_nhf[MBQUAD] = lConnMap2D[MBQUAD-2].num_verts_in_face;
+    for (int i = MBTET; i <= MBHEX; i++)
+      if (cell_index[i] >= 0)
+        {
+          sib_map[i] = &sibhfs;
+          sib_nhf[i] = lConnMap3D[cell_index[i]].num_faces_in_cell;
+        }
     chk_mixed = false;
     is_mixed = false;
   }
@@ -270,6 +301,527 @@ namespace moab {
     return MB_SUCCESS;
   }
 
+  /*******************************************************
+   * Incremental updates under mesh modification         *
+   ******************************************************/
+
+  void HalfFacetRep::invalidate_maps()
+  {
+    mInitAHFmaps = false;
+    chk_mixed = false;
+    is_mixed = false;
+
+    _verts.clear(); _edges.clear(); _faces.clear(); _cells.clear();
+    std::vector<HFacet>().swap(sibhvs);
+    std::vector<HFacet>().swap(v2hv);
+    std::vector<HFacet>().swap(sibhes);
+    std::vector<HFacet>().swap(v2he);
+    std::vector<HFacet>().swap(sibhfs);
+    std::vector<HFacet>().swap(v2hf);
+    v2hes.clear();
+    v2hfs.clear();
+  }
+
+  ErrorCode HalfFacetRep::notify_create_entity(EntityHandle entity)
+  {
+    EntityType type = TYPE_FROM_HANDLE(entity);
+    if (type == MBVERTEX || type == MBENTITYSET)
+      return MB_SUCCESS;
+
+    //Nothing to patch before the maps are built, but the mixed type check may be stale now;
+    //a mesh found mixed stays mixed under creation
+    if (!mInitAHFmaps)
+      {
+        if (!is_mixed)
+          chk_mixed = false;
+        return MB_SUCCESS;
+      }
+
+    //Maps over a set or without the ghosts cannot tell whether the new entity belongs to them
+    if (_rset || pcomm)
+      {
+        invalidate_maps();
+        return MB_SUCCESS;
+      }
+
+    int dim = CN::Dimension(type);
+    Range &ents = (dim == 1) ? _edges : ((dim == 2) ? _faces : _cells);
+
+    //Mixed entity types are not supported; the check is settled until the maps are rebuilt
+    if (!sib_map[type] || (!ents.empty() && type != TYPE_FROM_HANDLE(*ents.begin())))
+      {
+        invalidate_maps();
+        chk_mixed = true;
+        is_mixed = true;
+        return MB_SUCCESS;
+      }
+
+    //Already in the maps, e.g. notified once when created and again by ReadUtilIface::update_adjacencies
+    if (ents.find(entity) != ents.end())
+      return MB_SUCCESS;
+
+    ErrorCode error;
+    const EntityHandle* conn;
+    int nconn = 0;
+    error = mb->get_connectivity(entity, conn, nconn, true);MB_CHK_ERR(error);
+
+    bool first = ents.empty();
+    ents.insert(entity);
+    for (int i = 0; i < nconn; i++)
+      _verts.insert(conn[i]);
+
+    //The first entity of its dimension starts the maps of that dimension
+    bool patched = true;
+    if (first)
+      {
+        thismeshtype = get_mesh_type(_verts.size(), _edges.size(), _faces.size(), _cells.size());
+        if (dim == 1)
+          error = init_curve();
+        else if (dim == 2)
+          error = init_surface();
+        else
+          error = init_volume();
+      }
+    else if (dim == 1)
+      error = add_edge_to_maps(entity);
+    else if (dim == 2)
+      error = add_face_to_maps(entity);
+    else
+      error = add_cell_to_maps(entity, patched);
+
+    //Half-patched maps are dropped, so that a failure never leaves them inconsistent with the mesh
+    if (MB_SUCCESS != error || !patched)
+      invalidate_maps();
+    MB_CHK_SET_ERR(error, "Failed to add the entity to the maps");
+
+    return MB_SUCCESS;
+  }
+
+  ErrorCode HalfFacetRep::notify_delete_entity(EntityHandle entity)
+  {
+    EntityType type = TYPE_FROM_HANDLE(entity);
+    if (type == MBENTITYSET)
+      return MB_SUCCESS;
+
+    if (!mInitAHFmaps)
+      {
+        chk_mixed = false;
+        return MB_SUCCESS;
+      }
+
+    //A vertex only goes away once no entity refers to it anymore
+    if (type == MBVERTEX)
+      {
+        std::size_t vidx = ID_FROM_HANDLE(entity)-1;
+        if (vidx < v2hv.size())
+          v2hv[vidx] = 0;
+        if (vidx < v2he.size())
+          v2he[vidx] = 0;
+        if (vidx < v2hf.size())
+          v2hf[vidx] = 0;
+        v2hes.erase(entity);
+        v2hfs.erase(entity);
+        _verts.erase(entity);
+        return MB_SUCCESS;
+      }
+
+    int dim = CN::Dimension(type);
+    Range &ents = (dim == 1) ? _edges : ((dim == 2) ? _faces : _cells);
+
+    if (_rset || pcomm || !sib_map[type] || ents.find(entity) == ents.end())
+      {
+        invalidate_maps();
+        return MB_SUCCESS;
+      }
+
+    ErrorCode error;
+    if (dim == 1)
+      error = remove_edge_from_maps(entity);
+    else if (dim == 2)
+      error = remove_face_from_maps(entity);
+    else
+      error = remove_cell_from_maps(entity);
+
+    ents.erase(entity);
+    if (MB_SUCCESS != error || ents.empty())
+      invalidate_maps();
+    MB_CHK_SET_ERR(error, "Failed to remove the entity from the maps");
+
+    return MB_SUCCESS;
+  }
+
+  ErrorCode HalfFacetRep::add_edge_to_maps(EntityHandle eid)
+  {
+    ErrorCode error;
+    const EntityHandle* conn;
+    int nconn = 0;
+    error = mb->get_connectivity(eid, conn, nconn, true);MB_CHK_ERR(error);
+
+    std::size_t eidx = ID_FROM_HANDLE(eid)-1;
+    if (2*(eidx+1) > sibhvs.size())
+      sibhvs.resize(2*(eidx+1), 0);
+
+    for (int lv = 0; lv < 2; lv++)
+      {
+        std::size_t vidx = ID_FROM_HANDLE(conn[lv])-1;
+        if (vidx >= v2hv.size())
+          v2hv.resize(vidx+1, 0);
+
+        HFacet nwhf = create_halffacet(eid, lv);
+        HFacet start = v2hv[vidx];
+        sibhvs[2*eidx+lv] = 0;
+        if (!start)
+          {
+            v2hv[vidx] = nwhf;
+            continue;
+          }
+
+        //The half-verts on a vertex form a cycle starting at v2hv, the new one goes last as in a fresh build
+        HFacet prev = start;
+        for (HFacet hf = sibhvs[2*(ID_FROM_HANDLE(fid_from_halfacet(prev, MBEDGE))-1)+lid_from_halffacet(prev)];
+             hf && hf != start;
+             hf = sibhvs[2*(ID_FROM_HANDLE(fid_from_halfacet(prev, MBEDGE))-1)+lid_from_halffacet(prev)])
+          prev = hf;
+
+        sibhvs[2*(ID_FROM_HANDLE(fid_from_halfacet(prev, MBEDGE))-1)+lid_from_halffacet(prev)] = nwhf;
+        sibhvs[2*eidx+lv] = start;
+      }
+
+    return MB_SUCCESS;
+  }
+
+  ErrorCode HalfFacetRep::remove_edge_from_maps(EntityHandle eid)
+  {
+    ErrorCode error;
+    const EntityHandle* conn;
+    int nconn = 0;
+    error = mb->get_connectivity(eid, conn, nconn, true);MB_CHK_ERR(error);
+
+    std::size_t eidx = ID_FROM_HANDLE(eid)-1;
+    for (int lv = 0; lv < 2; lv++)
+      {
+        HFacet curhf = create_halffacet(eid, lv);
+        HFacet next = sibhvs[2*eidx+lv];
+        sibhvs[2*eidx+lv] = 0;
+
+        if (next)
+          {
+            HFacet prev = next;
+            while (true)
+              {
+                HFacet &hf = sibhvs[2*(ID_FROM_HANDLE(fid_from_halfacet(prev, MBEDGE))-1)+lid_from_halffacet(prev)];
+                if (hf == curhf)
+                  {
+                    //A half-vert left alone on the vertex has no sibling
+                    hf = (prev == next) ? 0 : next;
+                    break;
+                  }
+                prev = hf;
+              }
+          }
+
+        std::size_t vidx = ID_FROM_HANDLE(conn[lv])-1;
+        if (v2hv[vidx] == curhf)
+          v2hv[vidx] = next;
+      }
+
+    return MB_SUCCESS;
+  }
+
+  ErrorCode HalfFacetRep::add_face_to_maps(EntityHandle fid)
+  {
+    ErrorCode error;
+    EntityType ftype = TYPE_FROM_HANDLE(fid);
+    int nepf = lConnMap2D[ftype-2].num_verts_in_face;
+
+    const EntityHandle* conn;
+    error = mb->get_connectivity(fid, conn, nepf, true);MB_CHK_ERR(error);
+
+    std::size_t fidx = ID_FROM_HANDLE(fid)-1;
+    if ((fidx+1)*nepf > sibhes.size())
+      sibhes.resize((fidx+1)*nepf, 0);
+    for (int k = 0; k < nepf; k++)
+      {
+        sibhes[nepf*fidx+k] = 0;
+        std::size_t nv = ID_FROM_HANDLE(conn[k]);
+        if (nv > v2he.size())
+          v2he.resize(nv, 0);
+      }
+
+    //Put each half-edge in the cycle of the half-edges on the same edge, found among the faces around its first vertex
+    std::vector<EntityHandle> adjents;
+    for (int k = 0; k < nepf; k++)
+      {
+        EntityHandle v = conn[k];
+        EntityHandle vn = conn[lConnMap2D[ftype-2].next[k]];
+
+        adjents.clear();
+        error = get_up_adjacencies_vert_2d(v, adjents);MB_CHK_ERR(error);
+
+        HFacet sibhf = 0;
+        for (std::size_t c = 0; c < adjents.size() && !sibhf; c++)
+          {
+            if (adjents[c] == fid)
+              continue;
+
+            const EntityHandle* sconn;
+            error = mb->get_connectivity(adjents[c], sconn, nepf, true);MB_CHK_ERR(error);
+
+            for (int l = 0; l < nepf; l++)
+              {
+                EntityHandle sv = sconn[l], svn = sconn[lConnMap2D[ftype-2].next[l]];
+                if ((sv == v && svn == vn) || (sv == vn && svn == v))
+                  {
+                    sibhf = create_halffacet(adjents[c], l);
+                    break;
+                  }
+              }
+          }
+        if (!sibhf)
+          continue;
+
+        HFacet &next = sibhes[nepf*(ID_FROM_HANDLE(fid_from_halfacet(sibhf, ftype))-1)+lid_from_halffacet(sibhf)];
+        sibhes[nepf*fidx+k] = next ? next : sibhf;
+        next = create_halffacet(fid, k);
+      }
+
+    //The new face may join components of the star of its vertices
+    std::vector<EntityHandle> starts;
+    for (int k = 0; k < nepf; k++)
+      {
+        starts.assign(1, fid);
+        error = reset_incident_halffacets(conn[k], ftype, 0, starts);MB_CHK_ERR(error);
+      }
+
+    return MB_SUCCESS;
+  }
+
+  ErrorCode HalfFacetRep::remove_face_from_maps(EntityHandle fid)
+  {
+    ErrorCode error;
+    EntityType ftype = TYPE_FROM_HANDLE(fid);
+    int nepf = lConnMap2D[ftype-2].num_verts_in_face;
+
+    const EntityHandle* conn;
+    error = mb->get_connectivity(fid, conn, nepf, true);MB_CHK_ERR(error);
+
+    //Cut each half-edge out of its cycle, keeping the faces across it
+    std::size_t fidx = ID_FROM_HANDLE(fid)-1;
+    std::vector<EntityHandle> ngbs[MAX_INCIDENT_HF];
+    for (int k = 0; k < nepf; k++)
+      {
+        HFacet curhf = create_halffacet(fid, k);
+        HFacet next = sibhes[nepf*fidx+k];
+        sibhes[nepf*fidx+k] = 0;
+        if (!next)
+          continue;
+
+        HFacet prev = next;
+        while (true)
+          {
+            ngbs[k].push_back(fid_from_halfacet(prev, ftype));
+            HFacet &hf = sibhes[nepf*(ID_FROM_HANDLE(fid_from_halfacet(prev, ftype))-1)+lid_from_halffacet(prev)];
+            if (hf == curhf)
+              {
+                hf = (prev == next) ? 0 : next;
+                break;
+              }
+            prev = hf;
+          }
+      }
+
+    //The rest of the star of a vertex is reached from the faces across the two edges on it
+    std::vector<EntityHandle> starts;
+    for (int k = 0; k < nepf; k++)
+      {
+        int kp = lConnMap2D[ftype-2].prev[k];
+        starts = ngbs[k];
+        starts.insert(starts.end(), ngbs[kp].begin(), ngbs[kp].end());
+        error = reset_incident_halffacets(conn[k], ftype, fid, starts);MB_CHK_ERR(error);
+      }
+
+    return MB_SUCCESS;
+  }
+
+  ErrorCode HalfFacetRep::add_cell_to_maps(EntityHandle cid, bool &patched)
+  {
+    ErrorCode error;
+    EntityType ctype = TYPE_FROM_HANDLE(cid);
+    int index = get_index_in_lmap(cid);
+    int nvpc = lConnMap3D[index].num_verts_in_cell;
+    int nfpc = lConnMap3D[index].num_faces_in_cell;
+
+    const EntityHandle* conn;
+    error = mb->get_connectivity(cid, conn, nvpc, true);MB_CHK_ERR(error);
+
+    std::size_t cidx = ID_FROM_HANDLE(cid)-1;
+    //Cells created one at a time grow the maps geometrically, unlike the per-level growth in resize_hf_maps
+    if ((cidx+1)*nfpc > sibhfs.size())
+      sibhfs.resize((cidx+1)*nfpc, 0);
+    for (int lfid = 0; lfid < nfpc; lfid++)
+      sibhfs[nfpc*cidx+lfid] = 0;
+    for (int i = 0; i < nvpc; i++)
+      {
+        std::size_t nv = ID_FROM_HANDLE(conn[i]);
+        if (nv > v2hf.size())
+          v2hf.resize(nv, 0);
+      }
+
+    //Match each local face with a face of the cells around its first vertex
+    std::vector<EntityHandle> adjents;
+    for (int lfid = 0; lfid < nfpc; lfid++)
+      {
+        int nvF = lConnMap3D[index].hf2v_num[lfid];
+        EntityHandle fverts[MAX_VERTS_HF];
+        for (int k = 0; k < nvF; k++)
+          fverts[k] = conn[lConnMap3D[index].hf2v[lfid][k]];
+
+        adjents.clear();
+        error = get_up_adjacencies_vert_3d(fverts[0], adjents);MB_CHK_ERR(error);
+
+        for (std::size_t c = 0; c < adjents.size(); c++)
+          {
+            if (adjents[c] == cid)
+              continue;
+
+            const EntityHandle* sconn;
+            error = mb->get_connectivity(adjents[c], sconn, nvpc, true);MB_CHK_ERR(error);
+
+            int slfid = -1;
+            for (int l = 0; l < nfpc && slfid < 0; l++)
+              {
+                if (lConnMap3D[index].hf2v_num[l] != nvF)
+                  continue;
+                int nmatch = 0;
+                for (int k = 0; k < nvF; k++)
+                  if (std::find(fverts, fverts+nvF, sconn[lConnMap3D[index].hf2v[l][k]]) != fverts+nvF)
+                    nmatch++;
+                if (nmatch == nvF)
+                  slfid = l;
+              }
+            if (slfid < 0)
+              continue;
+
+            std::size_t sidx = ID_FROM_HANDLE(adjents[c])-1;
+            if (sibhfs[nfpc*sidx+slfid] != 0)
+              {
+                //The face already has two cells, which the maps cannot hold
+                patched = false;
+                return MB_SUCCESS;
+              }
+            sibhfs[nfpc*sidx+slfid] = create_halffacet(cid, lfid);
+            sibhfs[nfpc*cidx+lfid] = create_halffacet(adjents[c], slfid);
+            break;
+          }
+      }
+
+    //The new cell may join components of the star of its vertices
+    std::vector<EntityHandle> starts;
+    for (int i = 0; i < nvpc; i++)
+      {
+        starts.assign(1, cid);
+        error = reset_incident_halffacets(conn[i], ctype, 0, starts);MB_CHK_ERR(error);
+      }
+
+    patched = true;
+    return MB_SUCCESS;
+  }
+
+  ErrorCode HalfFacetRep::remove_cell_from_maps(EntityHandle cid)
+  {
+    ErrorCode error;
+    EntityType ctype = TYPE_FROM_HANDLE(cid);
+    int index = get_index_in_lmap(cid);
+    int nvpc = lConnMap3D[index].num_verts_in_cell;
+    int nfpc = lConnMap3D[index].num_faces_in_cell;
+
+    const EntityHandle* conn;
+    error = mb->get_connectivity(cid, conn, nvpc, true);MB_CHK_ERR(error);
+
+    //Cut the cell out of the sibling map
+    std::size_t cidx = ID_FROM_HANDLE(cid)-1;
+    EntityHandle ngbs[MAX_FACES];
+    for (int lfid = 0; lfid < nfpc; lfid++)
+      {
+        HFacet hf = sibhfs[nfpc*cidx+lfid];
+        ngbs[lfid] = fid_from_halfacet(hf, ctype);
+        if (ngbs[lfid])
+          sibhfs[nfpc*(ID_FROM_HANDLE(ngbs[lfid])-1)+lid_from_halffacet(hf)] = 0;
+        sibhfs[nfpc*cidx+lfid] = 0;
+      }
+
+    //The rest of the star of a vertex is reached from the cells across the faces on it
+    std::vector<EntityHandle> starts;
+    for (int i = 0; i < nvpc; i++)
+      {
+        starts.clear();
+        for (int k = 0; k < lConnMap3D[index].v2hf_num[i]; k++)
+          if (ngbs[lConnMap3D[index].v2hf[i][k]])
+            starts.push_back(ngbs[lConnMap3D[index].v2hf[i][k]]);
+        error = reset_incident_halffacets(conn[i], ctype, cid, starts);MB_CHK_ERR(error);
+      }
+
+    return MB_SUCCESS;
+  }
+
+  ErrorCode HalfFacetRep::reset_incident_halffacets(EntityHandle vid, EntityType type, EntityHandle skip, std::vector<EntityHandle> &starts)
+  {
+    ErrorCode error;
+    bool surf = (type == MBTRI || type == MBQUAD);
+    std::vector<HFacet> &v2hfacet = surf ? v2he : v2hf;
+    std::multimap<EntityHandle, HFacet> &v2hfacets = surf ? v2hes : v2hfs;
+
+    //Every component of the star holds either one of the given starts or the current incident half-facet
+    int vidx = ID_FROM_HANDLE(vid)-1;
+    if (v2hfacet[vidx])
+      starts.push_back(fid_from_halfacet(v2hfacet[vidx], type));
+
+    std::pair <std::multimap<EntityHandle, HFacet>::iterator, std::multimap<EntityHandle, HFacet>::iterator> it_hfs;
+    it_hfs = v2hfacets.equal_range(vid);
+    for (std::multimap<EntityHandle, HFacet>::iterator it = it_hfs.first; it != it_hfs.second; ++it)
+      starts.push_back(fid_from_halfacet(it->second, type));
+    v2hfacets.erase(it_hfs.first, it_hfs.second);
+    v2hfacet[vidx] = 0;
+
+    std::multimap<EntityHandle, EntityHandle> comps;
+    std::vector<HFacet> hfs;
+    for (std::size_t i = 0; i < starts.size(); i++)
+      {
+        if (starts[i] == skip || find_cell_in_component(vid, starts[i], comps))
+          continue;
+
+        HFacet nwhf = 0;
+        if (surf)
+          {
+            error = add_faces_of_single_component(vid, starts[i], comps, nwhf);MB_CHK_ERR(error);
+          }
+        else
+          {
+            int index = get_index_in_lmap(starts[i]);
+            int nvpc = lConnMap3D[index].num_verts_in_cell;
+            const EntityHandle* conn;
+            error = mb->get_connectivity(starts[i], conn, nvpc, true);MB_CHK_ERR(error);
+
+            int lv = std::find(conn, conn+nvpc, vid) - conn;
+            if (lv == nvpc)
+              MB_SET_ERR(MB_FAILURE, "did not find local vertex ");
+            error = add_cells_of_single_component(vid, starts[i], lConnMap3D[index].v2hf[lv][0], comps, nwhf);MB_CHK_ERR(error);
+          }
+        hfs.push_back(nwhf);
+      }
+
+    //A star in several pieces makes the vertex non-manifold
+    if (hfs.size() == 1)
+      v2hfacet[vidx] = hfs[0];
+    else
+      {
+        for (std::size_t i = 0; i < hfs.size(); i++)
+          v2hfacets.insert(std::pair<EntityHandle, HFacet>(vid, hfs[i]));
+      }
+
+    return MB_SUCCESS;
+  }
+
   ErrorCode HalfFacetRep::init_curve()
   {
     ErrorCode error;
@@ -317,12 +869,6 @@ namespace moab {
   {
     ErrorCode error;
 
-    //Initialize std::map between cell-types and their index in lConnMap3D
-    cell_index[MBTET] = 0;
-    cell_index[MBPYRAMID] = 1;
-    cell_index[MBPRISM] = 2;
-    cell_index[MBHEX] = 3;
-
     int index = get_index_in_lmap(*_cells.begin());
     int nfpc = lConnMap3D[index].num_faces_in_cell;
     int nv = ID_FROM_HANDLE(*(_verts.end()-1));
@@ -1589,9 +2135,7 @@ namespace moab {
 
   int HalfFacetRep::get_index_in_lmap(EntityHandle cid)
   {
-    EntityType type = mb->type_from_handle(cid);
-    int index = cell_index.find(type)->second;
-    return index;
+    return cell_index[TYPE_FROM_HANDLE(cid)];
   }
 
    const HalfFacetRep::LocalMaps3D HalfFacetRep::lConnMap3D[4] =
@@ -1921,6 +2465,60 @@ namespace moab {
   }
 
 
+  /////////////////////////////////////////////////////////////////////////
+  ErrorCode HalfFacetRep::add_faces_of_single_component(EntityHandle vid, EntityHandle curfid, std::multimap<EntityHandle, EntityHandle> &comps, HFacet &hf)
+  {
+    ErrorCode error;
+    EntityType ftype = mb->type_from_handle(curfid);
+    int nepf = lConnMap2D[ftype-2].num_verts_in_face;
+
+    std::vector<EntityHandle> stkfaces(1, curfid);
+    comps.insert(std::pair<EntityHandle,EntityHandle>(vid, curfid));
+
+    hf = 0;
+    HFacet start_hf = 0;
+    while (!stkfaces.empty()){
+        EntityHandle cur_fid = stkfaces.back();
+        stkfaces.pop_back();
+
+        const EntityHandle* conn;
+        error = mb->get_connectivity(cur_fid, conn, nepf, true);MB_CHK_ERR(error);
+
+        int lv = std::find(conn, conn+nepf, vid) - conn;
+        if (lv == nepf)
+          MB_SET_ERR(MB_FAILURE, "did not find local vertex ");
+        if (!start_hf)
+          start_hf = create_halffacet(cur_fid, lv);
+
+        // The half-edges leaving and entering vid, and the faces on their siblings
+        int fidx = ID_FROM_HANDLE(cur_fid)-1;
+        int lids[2] = {lv, lConnMap2D[ftype-2].prev[lv]};
+        for (int i = 0; i < 2; i++){
+            HFacet cur_hf = create_halffacet(cur_fid, lids[i]);
+            HFacet sib_hf = sibhes[nepf*fidx+lids[i]];
+
+            // As in mark_halfedges, a boundary half-edge leaving vid is preferred
+            if (!sib_hf && i == 0)
+              hf = cur_hf;
+
+            while (sib_hf && sib_hf != cur_hf){
+                EntityHandle ngb = fid_from_halfacet(sib_hf, ftype);
+                if (!find_cell_in_component(vid, ngb, comps)){
+                    comps.insert(std::pair<EntityHandle,EntityHandle>(vid, ngb));
+                    stkfaces.push_back(ngb);
+                  }
+                sib_hf = sibhes[nepf*(ID_FROM_HANDLE(ngb)-1)+lid_from_halffacet(sib_hf)];
+              }
+          }
+      }
+
+    if (!hf)
+      hf = start_hf;
+
+    return MB_SUCCESS;
+  }
+
+
   bool HalfFacetRep::find_cell_in_component(EntityHandle vid, EntityHandle cell, std::multimap<EntityHandle, EntityHandle> &comps)
   {
     bool found = false;
@@ -1974,7 +2572,6 @@ namespace moab {
 
     int index = get_index_in_lmap(start_cells[0]);
     int nvpc = lConnMap3D[index].num_verts_in_cell;
-    int nfpc = lConnMap3D[index].num_faces_in_cell;
 
     for (int i=0; i<(int)start_cells.size(); i++)
       cellq[i] = start_cells[i];
@@ -2007,13 +2604,13 @@ namespace moab {
           MB_SET_ERR(MB_FAILURE, "did not find local vertex ");
         //Number of local half-faces incident on the current vertex
         int nhf_thisv = lConnMap3D[index].v2hf_num[lv];
-        int cidx = ID_FROM_HANDLE(cur_cid)-1;
+        const HFacet *sib_hfs = sibling_begin(cur_cid);
 
         // Add new cells into the stack
         EntityHandle ngb;
         for (int i = 0; i < nhf_thisv; ++i){
             int ind = lConnMap3D[index].v2hf[lv][i];
-            hf = sibhfs[nfpc*cidx+ind];
+            hf = sib_hfs[ind];
             ngb = fid_from_halfacet(hf, ctype);
 
             if (ngb) {
@@ -2787,14 +3384,10 @@ ErrorCode HalfFacetRep::get_up_adjacencies_edg_3d( EntityHandle eid,
   {
     adjents.reserve(20);
     EntityType ctype = mb->type_from_handle(cid);
-    int index = get_index_in_lmap(cid);
-    int nfpc = lConnMap3D[index].num_faces_in_cell;
-    int cidx = ID_FROM_HANDLE(cid)-1;
 
     if (cid != 0 ){
-      for (int lfid = 0; lfid < nfpc; ++lfid){
-          HFacet hf = sibhfs[nfpc*cidx+lfid];
-          EntityHandle sibcid = fid_from_halfacet(hf, ctype);
+      for (const HFacet *hf = sibling_begin(cid); hf != sibling_end(cid); ++hf){
+          EntityHandle sibcid = fid_from_halfacet(*hf, ctype);
           if (sibcid != 0)
             adjents.push_back(sibcid);
       }
@@ -3140,7 +3733,7 @@ ErrorCode HalfFacetRep::get_up_adjacencies_edg_3d( EntityHandle eid,
         else
           nwsz = nedges*2;
         insz = sibhvs.size();
-        sibhvs.resize(insz+nwsz,0);
+        resize_map_exact(sibhvs, insz+nwsz);
 
         if (v2hv.empty())
           {
@@ -3158,7 +3751,7 @@ ErrorCode HalfFacetRep::get_up_adjacencies_edg_3d( EntityHandle eid,
           nwsz = ID_FROM_HANDLE(start_vert)-ID_FROM_HANDLE(*_verts.end())+nverts;
         else
           nwsz = nverts;
-        v2hv.resize(insz+nwsz,0);
+        resize_map_exact(v2hv, insz+nwsz);
 
       }
 
@@ -3172,14 +3765,14 @@ ErrorCode HalfFacetRep::get_up_adjacencies_edg_3d( EntityHandle eid,
        else
          nwsz = nfaces*nepf;
        insz = sibhes.size();
-       sibhes.resize(insz+nwsz,0);
+       resize_map_exact(sibhes, insz+nwsz);
 
        if (ID_FROM_HANDLE(*(_verts.end()-1)+1) != ID_FROM_HANDLE(start_vert))
          nwsz = ID_FROM_HANDLE(start_vert)-ID_FROM_HANDLE(*_verts.end())+nverts;
        else
          nwsz = nverts;
        insz = v2he.size();
-       v2he.resize(insz+nwsz,0);
+       resize_map_exact(v2he, insz+nwsz);
      }
 
    if (ncells)
@@ -3192,14 +3785,14 @@ ErrorCode HalfFacetRep::get_up_adjacencies_edg_3d( EntityHandle eid,
        else
          nwsz = ncells*nfpc;
        insz = sibhfs.size();
-       sibhfs.resize(insz+nwsz,0);
+       resize_map_exact(sibhfs, insz+nwsz);
 
        if (ID_FROM_HANDLE(*(_verts.end()-1)+1) != ID_FROM_HANDLE(start_vert))
          nwsz = ID_FROM_HANDLE(start_vert)-ID_FROM_HANDLE(*_verts.end())+nverts;
        else
          nwsz = nverts;
        insz = v2hf.size();
-       v2hf.resize(insz+nwsz,0);
+       resize_map_exact(v2hf, insz+nwsz);
      }
 
    return MB_SUCCESS;
@@ -3227,145 +3820,61 @@ ErrorCode HalfFacetRep::get_up_adjacencies_edg_3d( EntityHandle eid,
     return status;
   }
 
-  ErrorCode HalfFacetRep::get_sibling_map(EntityType type, EntityHandle ent, EntityHandle *sib_entids, int *sib_lids,  int num_halffacets)
+  const HFacet* HalfFacetRep::sibling_begin(EntityHandle ent) const
   {
+    EntityType type = TYPE_FROM_HANDLE(ent);
+    if (!sib_map[type] || sib_map[type]->empty())
+      return NULL;
+    return &(*sib_map[type])[sib_nhf[type]*(ID_FROM_HANDLE(ent)-1)];
+  }
 
-    if (type == MBEDGE)
-      {
-        if (num_halffacets != 2)  MB_SET_ERR(MB_FAILURE, "Incorrect number of halfvertices.");
-
-        int eidx = ID_FROM_HANDLE(ent)-1;
-        for (int i=0; i<2; i++)
-          {
-            HFacet hf = sibhvs[2*eidx+i];
-            sib_entids[i] = fid_from_halfacet(hf, MBEDGE);
-            sib_lids[i] = lid_from_halffacet(hf);
-          }
-      }
-    else if (type == MBTRI || type == MBQUAD)
-      {
-       int nepf = lConnMap2D[type-2].num_verts_in_face;
+  const HFacet* HalfFacetRep::sibling_end(EntityHandle ent) const
+  {
+    const HFacet* begin = sibling_begin(ent);
+    return begin ? begin + sib_nhf[TYPE_FROM_HANDLE(ent)] : begin;
+  }
 
-       if(num_halffacets != nepf) MB_SET_ERR(MB_FAILURE, "Incorrect number of halfedges.");
+  ErrorCode HalfFacetRep::get_sibling_map(EntityType type, EntityHandle ent, EntityHandle *sib_entids, int *sib_lids,  int num_halffacets)
+  {
+    if (!sib_map[type]) MB_SET_ERR(MB_NOT_IMPLEMENTED, "No sibling map for entity type " << CN::EntityTypeName(type));
+    if (num_halffacets != sib_nhf[type]) MB_SET_ERR(MB_FAILURE, "Incorrect number of half-facets.");
 
-       int fidx = ID_FROM_HANDLE(ent)-1;
-        for (int i=0; i<nepf; i++)
-          {
-            HFacet hf = sibhes[nepf*fidx+i];
-            sib_entids[i] = fid_from_halfacet(hf, type);
-            sib_lids[i] = lid_from_halffacet(hf);
-          }
-      }
-    else
+    const HFacet *hf = &(*sib_map[type])[num_halffacets*(ID_FROM_HANDLE(ent)-1)];
+    for (int i=0; i<num_halffacets; i++)
       {
-        int idx = get_index_in_lmap(*_cells.begin());
-        int nfpc = lConnMap3D[idx].num_faces_in_cell;
-
-        if(num_halffacets != nfpc) MB_SET_ERR(MB_FAILURE, "Incorrect number of halffaces.");
-
-        int cidx = ID_FROM_HANDLE(ent)-1;
-        for (int i=0; i<nfpc; i++)
-          {
-            HFacet hf = sibhfs[nfpc*cidx+i];
-            sib_entids[i] = fid_from_halfacet(hf, type);
-            sib_lids[i] = lid_from_halffacet(hf);
-          }
-
+        sib_entids[i] = fid_from_halfacet(hf[i], type);
+        sib_lids[i] = lid_from_halffacet(hf[i]);
       }
     return MB_SUCCESS;
   }
 
   ErrorCode HalfFacetRep::get_sibling_map(EntityType type, EntityHandle ent, int lid,  EntityHandle &sib_entid, int &sib_lid)
   {
+    if (!sib_map[type]) MB_SET_ERR(MB_NOT_IMPLEMENTED, "No sibling map for entity type " << CN::EntityTypeName(type));
 
-    if (type == MBEDGE)
-      {
-        int eidx = ID_FROM_HANDLE(ent)-1;
-        HFacet hf = sibhvs[2*eidx+lid];
-        sib_entid = fid_from_halfacet(hf, MBEDGE);
-        sib_lid = lid_from_halffacet(hf);
-      }
-    else if (type == MBTRI || type == MBQUAD)
-      {
-       int nepf = lConnMap2D[type-2].num_verts_in_face;
-       int fidx = ID_FROM_HANDLE(ent)-1;
-       HFacet hf = sibhes[nepf*fidx+lid];
-       sib_entid = fid_from_halfacet(hf, type);
-       sib_lid = lid_from_halffacet(hf);
-      }
-    else
-      {
-        int idx = get_index_in_lmap(*_cells.begin());
-        int nfpc = lConnMap3D[idx].num_faces_in_cell;
-        int cidx = ID_FROM_HANDLE(ent)-1;
-        HFacet hf = sibhfs[nfpc*cidx+lid];
-        sib_entid = fid_from_halfacet(hf, type);
-        sib_lid = lid_from_halffacet(hf);
-      }
+    HFacet hf = (*sib_map[type])[sib_nhf[type]*(ID_FROM_HANDLE(ent)-1)+lid];
+    sib_entid = fid_from_halfacet(hf, type);
+    sib_lid = lid_from_halffacet(hf);
     return MB_SUCCESS;
   }
 
   ErrorCode HalfFacetRep::set_sibling_map(EntityType type, EntityHandle ent, EntityHandle *set_entids, int *set_lids, int num_halffacets)
   {
+    if (!sib_map[type]) MB_SET_ERR(MB_NOT_IMPLEMENTED, "No sibling map for entity type " << CN::EntityTypeName(type));
+    if (num_halffacets != sib_nhf[type]) MB_SET_ERR(MB_FAILURE, "Incorrect number of half-facets.");
 
-    if (type == MBEDGE)
-      {
-        if (num_halffacets != 2) MB_SET_ERR(MB_FAILURE, "Incorrect number of halfvertices");
-
-        int eidx = ID_FROM_HANDLE(ent)-1;
-        for (int i=0; i<2; i++)
-          {
-            sibhvs[2*eidx+i] = create_halffacet(set_entids[i], set_lids[i]);
-          }
-      }
-    else if (type == MBTRI || type == MBQUAD)
-      {
-        int nepf = lConnMap2D[type-2].num_verts_in_face;
-        if (num_halffacets != nepf) MB_SET_ERR(MB_FAILURE, "Incorrect number of halfedges.");
-
-        int fidx = ID_FROM_HANDLE(ent)-1;
-         for (int i=0; i<nepf; i++)
-           {
-             sibhes[nepf*fidx+i] = create_halffacet(set_entids[i], set_lids[i]);
-           }
-      }
-    else
-      {
-        int idx = get_index_in_lmap(*_cells.begin());
-        int nfpc = lConnMap3D[idx].num_faces_in_cell;
-        if (num_halffacets != nfpc) MB_SET_ERR(MB_FAILURE, "Incorrect number of halffaces.");
-
-        int cidx = ID_FROM_HANDLE(ent)-1;
-        for (int i=0; i<nfpc; i++)
-          {
-            sibhfs[nfpc*cidx+i] = create_halffacet(set_entids[i], set_lids[i]);
-          }
-      }
+    HFacet *hf = &(*sib_map[type])[num_halffacets*(ID_FROM_HANDLE(ent)-1)];
+    for (int i=0; i<num_halffacets; i++)
+      hf[i] = create_halffacet(set_entids[i], set_lids[i]);
 
     return MB_SUCCESS;
   }
 
   ErrorCode HalfFacetRep::set_sibling_map(EntityType type, EntityHandle ent, int lid, EntityHandle &set_entid, int &set_lid)
   {
+    if (!sib_map[type]) MB_SET_ERR(MB_NOT_IMPLEMENTED, "No sibling map for entity type " << CN::EntityTypeName(type));
 
-    if (type == MBEDGE)
-      {
-        int eidx = ID_FROM_HANDLE(ent)-1;
-        sibhvs[2*eidx+lid] = create_halffacet(set_entid, set_lid);
-      }
-    else if (type == MBTRI || type == MBQUAD)
-      {
-        int nepf = lConnMap2D[type-2].num_verts_in_face;
-        int fidx = ID_FROM_HANDLE(ent)-1;
-        sibhes[nepf*fidx+lid] = create_halffacet(set_entid, set_lid);
-      }
-    else
-      {
-        int idx = get_index_in_lmap(*_cells.begin());
-        int nfpc = lConnMap3D[idx].num_faces_in_cell;
-        int cidx = ID_FROM_HANDLE(ent)-1;
-        sibhfs[nfpc*cidx+lid] = create_halffacet(set_entid, set_lid);
-      }
+    (*sib_map[type])[sib_nhf[type]*(ID_FROM_HANDLE(ent)-1)+lid] = create_halffacet(set_entid, set_lid);
 
     return MB_SUCCESS;
   }
@@ -3530,13 +4039,13 @@ ErrorCode HalfFacetRep::get_up_adjacencies_edg_3d( EntityHandle eid,
 
   EntityHandle HalfFacetRep::fid_from_halfacet(const HFacet facet, EntityType type)
   {
+    //The maps only refer to existing entities, so the handle is built directly
+    //instead of being validated through a sequence lookup on every decode
     EntityID id = FID_FROM_HALFFACET(facet);
-    EntityHandle handle = 0;
     if (id == 0)
-      return handle;
+      return 0;
 
-    ErrorCode error = mb->handle_from_id(type, id, handle); MB_CHK_ERR(error);
-    return handle;
+    return CREATE_HANDLE(type, id);
   }
 
   int HalfFacetRep::lid_from_halffacet(const HFacet facet)
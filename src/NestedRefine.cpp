@@ -1390,151 +1390,261 @@ namespace moab{
   ErrorCode NestedRefine::subdivide_cells(EntityType type, int cur_level, int deg)
   {
     ErrorCode error;
-    int nverts_prev, nents_prev;
+    int nents_prev;
     if (cur_level)
-      {
-        nverts_prev = level_mesh[cur_level-1].num_verts;
-        nents_prev = level_mesh[cur_level-1].num_cells;
-      }
+      nents_prev = level_mesh[cur_level-1].num_cells;
     else
-      {
-        nverts_prev = _inverts.size();
-        nents_prev = _incells.size();
-      }
+      nents_prev = _incells.size();
 
-    //Create some book-keeping arrays over the parent mesh to avoid introducing duplicate vertices
     int cindex = type -1;
     int d = get_index_from_degree(deg);
     int ne = refTemplates[cindex][d].nv_edge;
     int nvf = refTemplates[cindex][d].nv_face;
     int nvtotal = refTemplates[cindex][d].total_new_verts;
+    int etotal = refTemplates[cindex][d].total_new_ents;
 
     int index = ahf->get_index_in_lmap(*(_incells.begin()));
     int nvpc = ahf->lConnMap3D[index].num_verts_in_cell;
     int nepc = ahf->lConnMap3D[index].num_edges_in_cell;
     int nfpc = ahf->lConnMap3D[index].num_faces_in_cell;
-
     int vtotal = nvpc + nvtotal;
-    std::vector<EntityHandle> vbuffer(vtotal);
 
     std::vector<EntityHandle> trackvertsC_edg(nepc*ne*nents_prev, 0);
     std::vector<EntityHandle> trackvertsC_face(nfpc*nvf*nents_prev, 0);
 
-    int cur_nverts = level_mesh[cur_level].num_verts;
-    std::vector<int> flag_verts(cur_nverts-nverts_prev, 0);
+    //Step 1: Number the new vertices of every cell and fill the tracking arrays
+    std::vector<const EntityHandle*> cell_conn;
+    std::vector<EntityHandle> vfirst;
+    error = get_cell_conn_pointers(cur_level, cell_conn); MB_CHK_ERR(error);
+    error = number_new_cell_verts(type, cur_level, deg, cell_conn, trackvertsC_edg, trackvertsC_face, vfirst); MB_CHK_ERR(error);
+
+    //Step 2: Create the subentities via refinement of the previous mesh. The children of a cell go to a fixed
+    //offset, and a new vertex is only written by the cell owning it, so the cells are refined concurrently.
+    std::vector<int> flag_verts;
+    ErrorCode result = MB_SUCCESS;
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel
+#endif
+    {
+      std::vector<EntityHandle> vbuffer(vtotal);
+      std::vector<EntityHandle> ent_buffer(etotal);
+      std::vector<double> corner_coords(nvpc*3);
 
-    int count_nverts = nverts_prev;
-    int count_ents = 0;
-    std::vector<EntityHandle> conn, cur_conn;
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp for schedule(static)
+#endif
+      for (int cid = 0; cid < nents_prev; cid++)
+        {
+          get_cell_vbuffer(type, cur_level, deg, cid, cell_conn[cid], trackvertsC_edg, trackvertsC_face, &vfirst[cid], &vbuffer[0]);
 
-    //Step 1: Create the subentities via refinement of the previous mesh
-    for (int cid = 0; cid < nents_prev; cid++)
+          //Connectivity of the children
+          for (int i = 0; i < etotal; i++)
+            {
+              for (int k = 0; k < nvpc; k++)
+                {
+                  int idx = refTemplates[cindex][d].ents_conn[i][k];
+                  level_mesh[cur_level].cell_conn[nvpc*(cid*etotal+i)+k] = vbuffer[idx];
+                }
+              ent_buffer[i] = level_mesh[cur_level].start_cell + cid*etotal + i;
+            }
+
+          //Local ahf maps and coordinates of the new vertices
+          ErrorCode rval = update_local_ahf(deg, type, &vbuffer[0], &ent_buffer[0], etotal, &vfirst[cid]);
+          if (MB_SUCCESS == rval)
+            rval = get_coordinates(&vbuffer[0], nvpc, cur_level+1, &corner_coords[0]);
+          if (MB_SUCCESS == rval)
+            rval = compute_coordinates(cur_level, deg, type, &vbuffer[0], vtotal, &corner_coords[0], flag_verts, 0, &vfirst[cid]);
+          if (MB_SUCCESS != rval)
+            {
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp critical
+#endif
+              result = rval;
+            }
+        }
+    }
+    MB_CHK_SET_ERR(result, "Failed to refine the cells of level " << cur_level);
+
+   // error = ahf->print_tags(3);
+
+    //Step 3: Update the global maps
+    error = update_global_ahf(type, cur_level, deg); MB_CHK_ERR(error);
+
+    //Step 4: If edges exists, refine them as well.
+    if (level_mesh[cur_level].num_edges != 0)
       {
-        conn.clear();
-        cur_conn.clear();
-        for (int i=0; i<vtotal; i++)
-          vbuffer[i] = 0;
+        error = construct_hm_1D(cur_level,deg, type, trackvertsC_edg); MB_CHK_ERR(error);
+      }
 
-        //EntityHandle of the working cell
-        EntityHandle cell;
-        if (cur_level)
-          cell = level_mesh[cur_level-1].start_cell + cid;
-        else
-          cell = _incells[cid];
+    //Step 5: If faces exists, refine them as well.
+    if (!_infaces.empty())
+      {
+        error = construct_hm_2D(cur_level, deg, type, trackvertsC_edg, trackvertsC_face); MB_CHK_ERR(error);
+      }
 
-        error = get_connectivity(cell, cur_level, conn);  MB_CHK_ERR(error);
+    //error = ahf->print_tags(3);
 
-        //Step 1: Add vertices from the current level for the working face that will be used for subdivision.
-        // Add the corners to vbuffer
-        for (int i=0; i<(int)conn.size(); i++)
-          {
-            if (cur_level)
-              vbuffer[i] =  level_mesh[cur_level].start_vertex + (conn[i]-level_mesh[cur_level-1].start_vertex);
-            else
-              vbuffer[i] = level_mesh[cur_level].start_vertex +  (conn[i]-*_inverts.begin());
+    return MB_SUCCESS;
+  }
 
-            cur_conn.push_back(vbuffer[i]);
-          }
+  ErrorCode NestedRefine::subdivide_tets(int cur_level, int deg)
+  {
+    ErrorCode error;
+    int nents_prev;
+    if (cur_level)
+      nents_prev = level_mesh[cur_level-1].num_cells;
+    else
+      nents_prev = _incells.size();
 
-        //Gather vertices already added to tracking array due to refinement of the sibling cells
-        for (int i=0; i<nepc; i++){
-            for (int j=0; j<ne; j++)
-              {
-                int idx = refTemplates[cindex][d].vert_on_edges[i][j];
-                vbuffer[idx] = trackvertsC_edg[cid*nepc*ne+ne*i+j];
-              }
-        }
+    EntityType type = MBTET;
+    int cindex = type -1;
+    int d = get_index_from_degree(deg);
+    int ne = refTemplates[cindex][d].nv_edge;
+    int nvf = refTemplates[cindex][d].nv_face;
+    int nvtotal = refTemplates[cindex][d].total_new_verts;
+    //All the tet patterns have the same number of children
+    int etotal = refTemplates[cindex][d].total_new_ents;
 
-        //Add remaining new vertex handles
-        for (int i=0; i<nfpc; i++){
-            for (int j=0; j<nvf; j++)
-              {
-                int idx = refTemplates[cindex][d].vert_on_faces[i][j];
-                vbuffer[idx] = trackvertsC_face[cid*nfpc*nvf+nvf*i+j];
-              }
-          }
+    int index = ahf->get_index_in_lmap(*(_incells.begin()));
+    int nvpc = ahf->lConnMap3D[index].num_verts_in_cell;
+    int nepc = ahf->lConnMap3D[index].num_edges_in_cell;
+    int nfpc = ahf->lConnMap3D[index].num_faces_in_cell;
+    int vtotal = nvpc + nvtotal;
 
-        //Add the remaining vertex handles to vbuffer for the current level for the working cell
-        for (int i=0; i<nvtotal; i++){
-            if (!vbuffer[i+nvpc]){
-                vbuffer[i+nvpc] = level_mesh[cur_level].start_vertex+count_nverts;
-                count_nverts += 1;
-              }
-          }
+    //Create book-keeping arrays over the parent mesh to avoid introducing duplicate vertices
+    std::vector<EntityHandle> trackvertsC_edg(nepc*ne*nents_prev, 0);
+    std::vector<EntityHandle> trackvertsC_face(nfpc*nvf*nents_prev, 0);
+    std::vector<int> cell_patterns(nents_prev,0);
 
-        //Step 2: Use the template to obtain the subentities. The coordinates and local ahf maps are also constructed.
-        //Connectivity of the children
-        int etotal = refTemplates[type-1][d].total_new_ents;
-        std::vector<EntityHandle> ent_buffer(etotal);
+    //Step 1: Number the new vertices of every cell and fill the tracking arrays
+    std::vector<const EntityHandle*> cell_conn;
+    std::vector<EntityHandle> vfirst;
+    error = get_cell_conn_pointers(cur_level, cell_conn); MB_CHK_ERR(error);
+    error = number_new_cell_verts(type, cur_level, deg, cell_conn, trackvertsC_edg, trackvertsC_face, vfirst); MB_CHK_ERR(error);
 
-        for (int i = 0; i < etotal; i++)
-          {
-            for (int k = 0; k < nvpc; k++)
-              {
-                int idx = refTemplates[type-1][d].ents_conn[i][k];
-                level_mesh[cur_level].cell_conn[nvpc*count_ents+k] = vbuffer[idx];
-              }
-            ent_buffer[i] =  level_mesh[cur_level].start_cell + count_ents;
-            count_ents += 1;
-          }
+    std::vector<int> flag_verts;
+    ErrorCode result = MB_SUCCESS;
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel
+#endif
+    {
+      std::vector<EntityHandle> vbuffer(vtotal);
+      std::vector<EntityHandle> ent_buffer(etotal);
+      std::vector<double> corner_coords(nvpc*3);
+
+      //Step 2: Coordinates of the new vertices, each written by the cell owning it. The refine pattern
+      //of a tet depends on the coordinates of vertices owned by its neighbors, so all of them are needed first.
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp for schedule(static)
+#endif
+      for (int cid = 0; cid < nents_prev; cid++)
+        {
+          get_cell_vbuffer(type, cur_level, deg, cid, cell_conn[cid], trackvertsC_edg, trackvertsC_face, &vfirst[cid], &vbuffer[0]);
 
-        //Step 3: Update local ahf maps
-        error = update_local_ahf(deg, type, &vbuffer[0], &ent_buffer[0], etotal);  MB_CHK_ERR(error);
+          ErrorCode rval = get_coordinates(&vbuffer[0], nvpc, cur_level+1, &corner_coords[0]);
+          if (MB_SUCCESS == rval)
+            rval = compute_coordinates(cur_level, deg, type, &vbuffer[0], vtotal, &corner_coords[0], flag_verts, 0, &vfirst[cid]);
+          if (MB_SUCCESS != rval)
+            {
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp critical
+#endif
+              result = rval;
+            }
+        }
 
-        //Step 4: Update tracking information
-        error = update_tracking_verts(cell, cur_level, deg, trackvertsC_edg, trackvertsC_face, &vbuffer[0]);  MB_CHK_ERR(error);
+      //Step 3: Choose the refine pattern of each tet and create its children and local ahf maps
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp for schedule(static)
+#endif
+      for (int cid = 0; cid < nents_prev; cid++)
+        {
+          get_cell_vbuffer(type, cur_level, deg, cid, cell_conn[cid], trackvertsC_edg, trackvertsC_face, &vfirst[cid], &vbuffer[0]);
 
-        //Step 5: Coordinates of the new vertices
-        std::vector<double> corner_coords(nvpc*3);
-        error = get_coordinates(&cur_conn[0], nvpc, cur_level+1, &corner_coords[0]); MB_CHK_ERR(error);
+          int diag = find_shortest_diagonal_octahedron(cur_level, deg, &vbuffer[0]);
+          int pat_id = diag + 2;
+          cell_patterns[cid] = pat_id;
 
-        error = compute_coordinates(cur_level, deg, type, &vbuffer[0], vtotal, &corner_coords[0], flag_verts, nverts_prev);  MB_CHK_ERR(error);
-      }
+          for (int i = 0; i < etotal; i++)
+            {
+              for (int k = 0; k < nvpc; k++)
+                {
+                  int idx = refTemplates[pat_id][d].ents_conn[i][k];
+                  level_mesh[cur_level].cell_conn[nvpc*(cid*etotal+i)+k] = vbuffer[idx];
+                }
+              ent_buffer[i] = level_mesh[cur_level].start_cell + cid*etotal + i;
+            }
 
-   // error = ahf->print_tags(3);
+          ErrorCode rval = update_local_ahf(deg, MBTET, pat_id, &vbuffer[0], &ent_buffer[0], etotal, &vfirst[cid]);
+          if (MB_SUCCESS != rval)
+            {
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp critical
+#endif
+              result = rval;
+            }
+        }
+    }
+    MB_CHK_SET_ERR(result, "Failed to refine the tets of level " << cur_level);
 
-    //Step 6: Update the global maps
-    error = update_global_ahf(type, cur_level, deg); MB_CHK_ERR(error);
+    //Step 4: Update the global maps
+    error = update_global_ahf(type, cur_level, deg, &cell_patterns); MB_CHK_ERR(error);
 
-    //Step 7: If edges exists, refine them as well.
+    //Step 5: If edges exists, refine them as well.
     if (level_mesh[cur_level].num_edges != 0)
       {
         error = construct_hm_1D(cur_level,deg, type, trackvertsC_edg); MB_CHK_ERR(error);
       }
 
-    //Step 8: If faces exists, refine them as well.
+    //Step 6: If faces exists, refine them as well.
     if (!_infaces.empty())
       {
         error = construct_hm_2D(cur_level, deg, type, trackvertsC_edg, trackvertsC_face); MB_CHK_ERR(error);
       }
 
-    //error = ahf->print_tags(3);
+    return MB_SUCCESS;
+  }
+
+  ErrorCode NestedRefine::get_cell_conn_pointers(int cur_level, std::vector<const EntityHandle*> &cell_conn)
+  {
+    //Direct pointers to the connectivity of the cells being refined, as the sequence lookups
+    //behind Interface::get_connectivity are not safe to use from several threads
+    int index = ahf->get_index_in_lmap(*(_incells.begin()));
+    int nvpc = ahf->lConnMap3D[index].num_verts_in_cell;
+
+    if (cur_level)
+      {
+        int nents_prev = level_mesh[cur_level-1].num_cells;
+        cell_conn.resize(nents_prev);
+        for (int cid = 0; cid < nents_prev; cid++)
+          cell_conn[cid] = level_mesh[cur_level-1].cell_conn + nvpc*cid;
+        return MB_SUCCESS;
+      }
+
+    cell_conn.clear();
+    cell_conn.reserve(_incells.size());
+    Range::const_iterator iter = _incells.begin();
+    while (iter != _incells.end())
+      {
+        EntityHandle *conn;
+        int verts_per_ent, count;
+        ErrorCode error = mbImpl->connect_iterate(iter, _incells.end(), conn, verts_per_ent, count); MB_CHK_ERR(error);
+        if (verts_per_ent != nvpc)
+          MB_SET_ERR(MB_FAILURE, "Cells with higher-order connectivity cannot be refined");
+
+        for (int i = 0; i < count; i++)
+          cell_conn.push_back(conn + nvpc*i);
+        iter += count;
+      }
 
     return MB_SUCCESS;
   }
 
-  ErrorCode NestedRefine::subdivide_tets(int cur_level, int deg)
+  ErrorCode NestedRefine::number_new_cell_verts(EntityType type, int cur_level, int deg, std::vector<const EntityHandle*> &cell_conn, std::vector<EntityHandle> &trackvertsC_edg, std::vector<EntityHandle> &trackvertsC_face, std::vector<EntityHandle> &vfirst)
   {
+    //A vertex on an edge or face shared by several cells is owned by the first cell that introduces it, and each
+    //cell numbers the vertices it owns consecutively starting at vfirst[cid]. This fixes the handles exactly as
+    //the sequential refinement does and is the only part of the cell refinement that has to run in order.
     ErrorCode error;
     int nverts_prev, nents_prev;
     if (cur_level)
@@ -1548,7 +1658,6 @@ namespace moab{
         nents_prev = _incells.size();
       }
 
-    EntityType type = MBTET;
     int cindex = type -1;
     int d = get_index_from_degree(deg);
     int ne = refTemplates[cindex][d].nv_edge;
@@ -1560,27 +1669,14 @@ namespace moab{
     int nepc = ahf->lConnMap3D[index].num_edges_in_cell;
     int nfpc = ahf->lConnMap3D[index].num_faces_in_cell;
 
-    // Create vertex buffer
     int vtotal = nvpc + nvtotal;
     std::vector<EntityHandle> vbuffer(vtotal);
 
-    //Create book-keeping arrays over the parent mesh to avoid introducing duplicate vertices
-    std::vector<EntityHandle> trackvertsC_edg(nepc*ne*nents_prev, 0);
-    std::vector<EntityHandle> trackvertsC_face(nfpc*nvf*nents_prev, 0);
+    EntityHandle vnext = level_mesh[cur_level].start_vertex + nverts_prev;
+    vfirst.resize(nents_prev+1);
 
-    int cur_nverts = level_mesh[cur_level].num_verts;
-    std::vector<int> flag_verts(cur_nverts-nverts_prev, 0);
-    std::vector<int> cell_patterns(nents_prev,0);
-
-    int count_nverts = nverts_prev;
-    int count_ents = 0;
-    std::vector<EntityHandle> conn, cur_conn;
-
-    //Step 1: Create the subentities via refinement of the previous mesh
     for (int cid = 0; cid < nents_prev; cid++)
       {
-        conn.clear();
-        cur_conn.clear();
         for (int i=0; i<vtotal; i++)
           vbuffer[i] = 0;
 
@@ -1591,18 +1687,13 @@ namespace moab{
         else
           cell = _incells[cid];
 
-        error = get_connectivity(cell, cur_level, conn);  MB_CHK_ERR(error);
-
-        //Step 1: Add vertices from the current level for the working face that will be used for subdivision.
-        // Add the corners to vbuffer
-        for (int i=0; i<(int)conn.size(); i++)
+        //Add the corners to vbuffer
+        for (int i=0; i<nvpc; i++)
           {
             if (cur_level)
-              vbuffer[i] =  level_mesh[cur_level].start_vertex + (conn[i]-level_mesh[cur_level-1].start_vertex);
+              vbuffer[i] =  level_mesh[cur_level].start_vertex + (cell_conn[cid][i]-level_mesh[cur_level-1].start_vertex);
             else
-              vbuffer[i] = level_mesh[cur_level].start_vertex +  (conn[i]-*_inverts.begin()) ;
-
-             cur_conn.push_back(vbuffer[i]);
+              vbuffer[i] = level_mesh[cur_level].start_vertex +  (cell_conn[cid][i]-*_inverts.begin());
           }
 
         //Gather vertices already added to tracking array due to refinement of the sibling cells
@@ -1614,7 +1705,6 @@ namespace moab{
               }
         }
 
-        //Add remaining new vertex handles
         for (int i=0; i<nfpc; i++){
             for (int j=0; j<nvf; j++)
               {
@@ -1624,68 +1714,65 @@ namespace moab{
           }
 
         //Add the remaining vertex handles to vbuffer for the current level for the working cell
+        vfirst[cid] = vnext;
         for (int i=0; i<nvtotal; i++){
-            if (!vbuffer[i+nvpc]){
-                vbuffer[i+nvpc] = level_mesh[cur_level].start_vertex+count_nverts;
-                count_nverts += 1;
-              }
+            if (!vbuffer[i+nvpc])
+              vbuffer[i+nvpc] = vnext++;
           }
 
-        //Step 2: Coordinates of the new vertices
-        std::vector<double> corner_coords(nvpc*3);
-        error = get_coordinates(&cur_conn[0], nvpc, cur_level+1, &corner_coords[0]);  MB_CHK_ERR(error);
-
-        error = compute_coordinates(cur_level, deg, type, &vbuffer[0], vtotal, &corner_coords[0], flag_verts, nverts_prev);  MB_CHK_ERR(error);
+        error = update_tracking_verts(cell, cur_level, deg, trackvertsC_edg, trackvertsC_face, &vbuffer[0]);  MB_CHK_ERR(error);
+      }
+    vfirst[nents_prev] = vnext;
 
-        //Step 3: Choose the tet refine pattern to be used for this tet
-        int diag = find_shortest_diagonal_octahedron(cur_level, deg, &vbuffer[0]);
-        int pat_id = diag + 2;
-        cell_patterns[cid] = pat_id;
+    return MB_SUCCESS;
+  }
 
-        //Step 4: Use the template to obtain the subentities. The coordinates and local ahf maps are also constructed.
-        //Connectivity of the children
-        int etotal = refTemplates[pat_id][d].total_new_ents;
-        std::vector<EntityHandle> ent_buffer(etotal);
+  void NestedRefine::get_cell_vbuffer(EntityType type, int cur_level, int deg, int cid, const EntityHandle *conn, const std::vector<EntityHandle> &trackvertsC_edg, const std::vector<EntityHandle> &trackvertsC_face, const EntityHandle *vown, EntityHandle *vbuffer)
+  {
+    //Rebuild the vertex buffer of a cell numbered by number_new_cell_verts. The tracking arrays hold every vertex on
+    //the edges and faces of the cell, the interior ones take the handles the cell did not spend on its owned vertices.
+    int cindex = type -1;
+    int d = get_index_from_degree(deg);
+    int ne = refTemplates[cindex][d].nv_edge;
+    int nvf = refTemplates[cindex][d].nv_face;
+    int nvtotal = refTemplates[cindex][d].total_new_verts;
 
-        for (int i = 0; i < etotal; i++)
-          {
-            for (int k = 0; k < nvpc; k++)
-              {
-                int idx = refTemplates[pat_id][d].ents_conn[i][k];
-                level_mesh[cur_level].cell_conn[nvpc*count_ents+k] = vbuffer[idx];
-              }
-            ent_buffer[i] =  level_mesh[cur_level].start_cell + count_ents;
-            count_ents += 1;
-          }
+    int index = ahf->get_index_in_lmap(*(_incells.begin()));
+    int nvpc = ahf->lConnMap3D[index].num_verts_in_cell;
+    int nepc = ahf->lConnMap3D[index].num_edges_in_cell;
+    int nfpc = ahf->lConnMap3D[index].num_faces_in_cell;
 
-        //Step 5: Update local ahf maps
-        error = update_local_ahf(deg, MBTET, pat_id, &vbuffer[0], &ent_buffer[0], etotal); MB_CHK_ERR(error);
+    for (int i=0; i<nvpc+nvtotal; i++)
+      vbuffer[i] = 0;
 
-        //Step 6: Update tracking information
-        error = update_tracking_verts(cell, cur_level, deg, trackvertsC_edg, trackvertsC_face, &vbuffer[0]);  MB_CHK_ERR(error);
+    for (int i=0; i<nvpc; i++)
+      {
+        if (cur_level)
+          vbuffer[i] =  level_mesh[cur_level].start_vertex + (conn[i]-level_mesh[cur_level-1].start_vertex);
+        else
+          vbuffer[i] = level_mesh[cur_level].start_vertex +  (conn[i]-*_inverts.begin());
       }
 
-    //Step 7: Update the global maps
-  //  error = update_global_ahf(cur_level, deg, cell_patterns); MB_CHK_ERR(error);
-       error = update_global_ahf(type, cur_level, deg, &cell_patterns); MB_CHK_ERR(error);
+    for (int i=0; i<nepc; i++)
+      for (int j=0; j<ne; j++)
+        vbuffer[refTemplates[cindex][d].vert_on_edges[i][j]] = trackvertsC_edg[cid*nepc*ne+ne*i+j];
 
-    //Step 8: If edges exists, refine them as well.
-    if (level_mesh[cur_level].num_edges != 0)
-      {
-        error = construct_hm_1D(cur_level,deg, type, trackvertsC_edg); MB_CHK_ERR(error);
-      }
+    for (int i=0; i<nfpc; i++)
+      for (int j=0; j<nvf; j++)
+        vbuffer[refTemplates[cindex][d].vert_on_faces[i][j]] = trackvertsC_face[cid*nfpc*nvf+nvf*i+j];
 
-    //Step 9: If faces exists, refine them as well.
-    if (!_infaces.empty())
+    //Handles owned by an earlier cell are below vown[0], the owned ones were handed out in template order
+    EntityHandle vnext = vown[0];
+    for (int i=0; i<nvtotal; i++)
       {
-        error = construct_hm_2D(cur_level, deg, type, trackvertsC_edg, trackvertsC_face); MB_CHK_ERR(error);
+        if (!vbuffer[i+nvpc])
+          vbuffer[i+nvpc] = vnext++;
+        else if (vbuffer[i+nvpc] == vnext)
+          vnext++;
       }
-
-    return MB_SUCCESS;
   }
 
-
-  ErrorCode NestedRefine::compute_coordinates(int cur_level, int deg, EntityType type, EntityHandle *vbuffer, int vtotal, double *corner_coords, std::vector<int> &vflag, int nverts_prev)
+  ErrorCode NestedRefine::compute_coordinates(int cur_level, int deg, EntityType type, EntityHandle *vbuffer, int vtotal, double *corner_coords, std::vector<int> &vflag, int nverts_prev, const EntityHandle *vown)
   {
     EntityHandle vstart = level_mesh[cur_level].start_vertex;
     int d = get_index_from_degree(deg);
@@ -1697,7 +1784,7 @@ namespace moab{
 
         for (int i=3; i<vtotal; i++)
           {
-            if  (vflag[vbuffer[i]-vstart - nverts_prev])
+            if (vown ? (vbuffer[i] < vown[0] || vbuffer[i] >= vown[1]) : vflag[vbuffer[i]-vstart - nverts_prev])
               continue;
 
             xi = refTemplates[findex][d].vert_nat_coord[i-3][0];
@@ -1715,7 +1802,8 @@ namespace moab{
             level_mesh[cur_level].coordinates[0][vbuffer[i]-vstart] = x;
             level_mesh[cur_level].coordinates[1][vbuffer[i]-vstart] = y;
             level_mesh[cur_level].coordinates[2][vbuffer[i]-vstart] = z;
-            vflag[vbuffer[i]-vstart - nverts_prev] = 1;
+            if (!vown)
+              vflag[vbuffer[i]-vstart - nverts_prev] = 1;
           }
       }
       else if (type == MBQUAD)
@@ -1725,7 +1813,7 @@ namespace moab{
 
         for (int i=4; i<vtotal; i++)
           {
-            if (vflag[vbuffer[i]-vstart-nverts_prev])
+            if (vown ? (vbuffer[i] < vown[0] || vbuffer[i] >= vown[1]) : vflag[vbuffer[i]-vstart-nverts_prev])
               continue;
 
             xi = refTemplates[findex][d].vert_nat_coord[i-4][0];
@@ -1743,7 +1831,8 @@ namespace moab{
             level_mesh[cur_level].coordinates[0][vbuffer[i]-vstart] = x;
             level_mesh[cur_level].coordinates[1][vbuffer[i]-vstart] = y;
             level_mesh[cur_level].coordinates[2][vbuffer[i]-vstart] = z;
-            vflag[vbuffer[i]-vstart-nverts_prev] = 1;
+            if (!vown)
+              vflag[vbuffer[i]-vstart-nverts_prev] = 1;
           }
 
       }
@@ -1754,7 +1843,7 @@ namespace moab{
 
         for (int i=4; i<vtotal; i++)
           {
-            if (vflag[vbuffer[i]-vstart-nverts_prev])
+            if (vown ? (vbuffer[i] < vown[0] || vbuffer[i] >= vown[1]) : vflag[vbuffer[i]-vstart-nverts_prev])
               continue;
 
             xi = refTemplates[cindex][d].vert_nat_coord[i-4][0];
@@ -1774,7 +1863,8 @@ namespace moab{
             level_mesh[cur_level].coordinates[0][vbuffer[i]-vstart] = x;
             level_mesh[cur_level].coordinates[1][vbuffer[i]-vstart] = y;
             level_mesh[cur_level].coordinates[2][vbuffer[i]-vstart] = z;
-            vflag[vbuffer[i]-vstart-nverts_prev] = 1;
+            if (!vown)
+              vflag[vbuffer[i]-vstart-nverts_prev] = 1;
           }
 
       }
@@ -1785,7 +1875,7 @@ namespace moab{
 
         for (int i=6; i<vtotal; i++)
           {
-            if (vflag[vbuffer[i]-vstart-nverts_prev])
+            if (vown ? (vbuffer[i] < vown[0] || vbuffer[i] >= vown[1]) : vflag[vbuffer[i]-vstart-nverts_prev])
               continue;
 
             xi = refTemplates[cindex][d].vert_nat_coord[i-6][0];
@@ -1805,7 +1895,8 @@ namespace moab{
             level_mesh[cur_level].coordinates[0][vbuffer[i]-vstart] = x;
             level_mesh[cur_level].coordinates[1][vbuffer[i]-vstart] = y;
             level_mesh[cur_level].coordinates[2][vbuffer[i]-vstart] = z;
-            vflag[vbuffer[i]-vstart-nverts_prev] = 1;
+            if (!vown)
+              vflag[vbuffer[i]-vstart-nverts_prev] = 1;
           }
 
       }
@@ -1818,7 +1909,7 @@ namespace moab{
         for (int i=8; i<vtotal; i++)
           {
 
-            if (vflag[vbuffer[i] - vstart - nverts_prev])
+            if (vown ? (vbuffer[i] < vown[0] || vbuffer[i] >= vown[1]) : vflag[vbuffer[i] - vstart - nverts_prev])
               continue;
 
             xi = refTemplates[cindex][d].vert_nat_coord[i-8][0];
@@ -1841,9 +1932,8 @@ namespace moab{
             level_mesh[cur_level].coordinates[0][vbuffer[i]-vstart] = x;
             level_mesh[cur_level].coordinates[1][vbuffer[i]-vstart] = y;
             level_mesh[cur_level].coordinates[2][vbuffer[i]-vstart] = z;
-
-
-            vflag[vbuffer[i]-vstart-nverts_prev] = 1;
+            if (!vown)
+              vflag[vbuffer[i]-vstart-nverts_prev] = 1;
           }
       }
     return MB_SUCCESS;
@@ -2872,7 +2962,7 @@ namespace moab{
    *          Update AHF maps           *
    * ********************************/
 
-ErrorCode NestedRefine::update_local_ahf(int deg, EntityType type, int pat_id, EntityHandle *vbuffer, EntityHandle *ent_buffer, int etotal)
+ErrorCode NestedRefine::update_local_ahf(int deg, EntityType type, int pat_id, EntityHandle *vbuffer, EntityHandle *ent_buffer, int etotal, const EntityHandle *vown)
 {
   ErrorCode error;
   int nhf = 0, nv = 0, total_new_verts = 0;
@@ -2907,10 +2997,21 @@ ErrorCode NestedRefine::update_local_ahf(int deg, EntityType type, int pat_id, E
     {
       ent.clear();lid.clear();
       EntityHandle vid = vbuffer[i+nv];
-      error = ahf->get_incident_map(type, vid, ent, lid);  MB_CHK_ERR(error);
+      if (vown)
+        {
+          //Only the cell owning the vertex sets its map, the maps of the new level start out empty
+          if (vid < vown[0] || vid >= vown[1])
+            continue;
+          ent.resize(1);
+          lid.resize(1);
+        }
+      else
+        {
+          error = ahf->get_incident_map(type, vid, ent, lid);  MB_CHK_ERR(error);
 
-      if (ent[0])
-        continue;
+          if (ent[0])
+            continue;
+        }
 
       int id = refTemplates[pat_id][d].v2hf[i+nv][0]-1;
       ent[0] = ent_buffer[id];
@@ -2925,6 +3026,20 @@ ErrorCode NestedRefine::update_local_ahf(int deg, EntityType type, int pat_id, E
       std::vector<EntityHandle> sib_entids(nhf);
       std::vector<int> sib_lids(nhf);
 
+      if (vown)
+        {
+          //The children of the cell are fresh and the template is symmetric, so their maps
+          //can be set from the template alone without reading back any half-facet
+          for (int l=0; l< nhf; l++)
+            {
+              int id = refTemplates[pat_id][d].ents_opphfs[i][2*l];
+              sib_entids[l] = id ? ent_buffer[id-1] : 0;
+              sib_lids[l] = id ? refTemplates[pat_id][d].ents_opphfs[i][2*l+1] : 0;
+            }
+          error = ahf->set_sibling_map(type, ent_buffer[i], &sib_entids[0], &sib_lids[0], nhf); MB_CHK_ERR(error);
+          continue;
+        }
+
       error = ahf->get_sibling_map(type, ent_buffer[i], &sib_entids[0], &sib_lids[0], nhf);  MB_CHK_ERR(error);
 
       for (int l=0; l< nhf; l++)
@@ -2962,11 +3077,11 @@ ErrorCode NestedRefine::update_local_ahf(int deg, EntityType type, int pat_id, E
   return MB_SUCCESS;
 }
 
-ErrorCode NestedRefine::update_local_ahf(int deg, EntityType type, EntityHandle *vbuffer, EntityHandle *ent_buffer, int etotal)
+ErrorCode NestedRefine::update_local_ahf(int deg, EntityType type, EntityHandle *vbuffer, EntityHandle *ent_buffer, int etotal, const EntityHandle *vown)
 {
   ErrorCode error;
   assert(type != MBTET);
-  error = update_local_ahf(deg, type, type-1, vbuffer, ent_buffer, etotal); MB_CHK_ERR(error);
+  error = update_local_ahf(deg, type, type-1, vbuffer, ent_buffer, etotal, vown); MB_CHK_ERR(error);
 
   return MB_SUCCESS;
 }
@@ -28,6 +28,9 @@
 #include "SequenceManager.hpp"
 #include "VertexSequence.hpp"
 #include "ElementSequence.hpp"
+#ifdef MOAB_HAVE_AHF
+#include "moab/HalfFacetRep.hpp"
+#endif
 
 namespace moab {
 
@@ -153,19 +156,22 @@ ErrorCode ReadUtil::update_adjacencies(const EntityHandle start_handle,
                                        const int number_vertices_per_element,
                                        const EntityHandle* conn_array)
 {
-  EntityHandle tmp_hndl = start_handle;
   AEntityFactory* adj_fact = mMB->a_entity_factory();
 
-  // Iterate over the elements and update adjacency information
+  // Update the adjacency information of all vertices at once
   if (adj_fact != NULL && adj_fact->vert_elem_adjacencies()) {
-    int j = 0;
-    for (int i = 0; i < number_elements; i++) {
-      adj_fact->notify_create_entity(tmp_hndl, (conn_array + j), number_vertices_per_element);
-      tmp_hndl++;
-      j += number_vertices_per_element;
-    }
+    ErrorCode result = adj_fact->notify_create_entities(start_handle, number_elements,
+                                                        number_vertices_per_element, conn_array);MB_CHK_ERR(result);
   }
 
+#ifdef MOAB_HAVE_AHF
+  // Patch or invalidate the half-facet maps, as create_element does
+  HalfFacetRep* ahf = mMB->a_half_facet_rep();
+  for (int i = 0; ahf != NULL && i < number_elements; ++i) {
+    ErrorCode result = ahf->notify_create_entity(start_handle + i);MB_CHK_ERR(result);
+  }
+#endif
+
   return MB_SUCCESS;
 }
 
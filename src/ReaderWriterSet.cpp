@@ -39,6 +39,10 @@
 
 #include "WriteAns.hpp"
 #include "WriteVtk.hpp"
+#include "WriteVtu.hpp"
+#ifdef MOAB_HAVE_MPI
+#  include "WriteVtuParallel.hpp"
+#endif
 #include "WriteGMV.hpp"
 #include "WriteSTL.hpp"
 #include "WriteGmsh.hpp"
@@ -124,6 +128,13 @@ ReaderWriterSet::ReaderWriterSet(Core* mdb)
 
   register_factory( ReadVtk::factory, WriteVtk::factory, "Kitware VTK", "vtk", "VTK" );
 
+#ifdef MOAB_HAVE_MPI
+  const char* vtu_sufxs[] = { "vtu", "pvtu", NULL };
+  register_factory( NULL, WriteVtuParallel::factory, "Kitware VTK XML unstructured grid", vtu_sufxs, "VTU" );
+#else
+  register_factory( NULL, WriteVtu::factory, "Kitware VTK XML unstructured grid", "vtu", "VTU" );
+#endif
+
   register_factory( ReadOBJ::factory, NULL, "OBJ mesh format", "obj", "OBJ mesh" );
 
   register_factory( ReadSms::factory, NULL, "RPI SMS", "sms", "SMS" );
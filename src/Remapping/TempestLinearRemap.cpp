@@ -22,11 +22,19 @@
 
 #include "netcdfcpp.h"
 
+#ifdef MOAB_HAVE_MPI
+#include "moab/TupleList.hpp"
+#endif
+
 #ifdef MOAB_HAVE_EIGEN
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
 #endif
 
 #include <fstream>
+#include <algorithm>
+#include <map>
+#include <functional>
 #include <cmath>
 #include <cstdlib>
 #include <sstream>
@@ -619,6 +627,382 @@ void moab::TempestOnlineMap::WriteParallelWeightsToFile(std::string strFilename)
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Rank owning the 0-based DoF \p idof when \p ndofs DoFs are block-partitioned over \p nprocs ranks
+static int BlockPartitionOwner ( int idof, int ndofs, int nprocs )
+{
+    const int nblk = ndofs / nprocs, nrem = ndofs % nprocs;
+    return ( idof < ( nblk + 1 ) * nrem ) ? idof / ( nblk + 1 ) : nrem + ( idof - ( nblk + 1 ) * nrem ) / nblk;
+}
+
+moab::ErrorCode moab::TempestOnlineMap::ReadParallelMap (const char* strSource, const std::vector<int>& owned_dof_ids,
+                                                         const std::vector<int>& owned_src_dof_ids)
+{
+    NcError error ( NcError::silent_nonfatal );
+
+    NcFile ncMap ( strSource, NcFile::ReadOnly );
+    if ( !ncMap.is_valid() ) { MB_CHK_SET_ERR ( moab::MB_FILE_DOES_NOT_EXIST, "Unable to open input map file " << strSource ); }
+
+    // Map dimensions: source DoFs, target DoFs and the number of nonzero entries
+    NcDim* dimNA = ncMap.get_dim ( "n_a" );
+    NcDim* dimNB = ncMap.get_dim ( "n_b" );
+    NcDim* dimNS = ncMap.get_dim ( "n_s" );
+    if ( dimNA == NULL || dimNB == NULL || dimNS == NULL ) { MB_CHK_SET_ERR ( moab::MB_FAILURE, "Map file " << strSource << " is missing n_a, n_b or n_s dimensions" ); }
+    const int nA = dimNA->size();
+    const int nB = dimNB->size();
+    const int nS = dimNS->size();
+
+    NcVar* varRow = ncMap.get_var ( "row" );
+    NcVar* varCol = ncMap.get_var ( "col" );
+    NcVar* varS = ncMap.get_var ( "S" );
+    if ( varRow == NULL || varCol == NULL || varS == NULL ) { MB_CHK_SET_ERR ( moab::MB_FAILURE, "Map file " << strSource << " is missing row, col or S variables" ); }
+
+    // Each rank reads a contiguous slab of the nonzero entries (hyperslab [offset, offset+localNS) )
+    const int localNS = nS / size + ( rank < nS % size ? 1 : 0 );
+    const long offsetNS = (long)rank * ( nS / size ) + std::min ( rank, nS % size );
+
+    std::vector<int> vecRow ( localNS ), vecCol ( localNS );
+    std::vector<double> vecS ( localNS );
+    if ( localNS )
+    {
+        if ( !varRow->set_cur ( offsetNS ) || !varRow->get ( &vecRow[0], localNS ) ) { MB_CHK_SET_ERR ( moab::MB_FAILURE, "Failed to read row entries" ); }
+        if ( !varCol->set_cur ( offsetNS ) || !varCol->get ( &vecCol[0], localNS ) ) { MB_CHK_SET_ERR ( moab::MB_FAILURE, "Failed to read col entries" ); }
+        if ( !varS->set_cur ( offsetNS ) || !varS->get ( &vecS[0], localNS ) ) { MB_CHK_SET_ERR ( moab::MB_FAILURE, "Failed to read S entries" ); }
+    }
+    ncMap.close();
+
+    // The rows (1-based target DoF IDs) owned by this rank; default to a block partition of n_b
+    std::vector<int> ownedRows ( owned_dof_ids );
+    if ( ownedRows.empty() )
+    {
+        const int nlocrows = nB / size + ( rank < nB % size ? 1 : 0 );
+        const int rowoffset = rank * ( nB / size ) + std::min ( rank, nB % size );
+        ownedRows.resize ( nlocrows );
+        for ( int i = 0; i < nlocrows; ++i )
+            ownedRows[i] = rowoffset + i + 1;
+    }
+
+#ifdef MOAB_HAVE_MPI
+    if ( is_parallel && size > 1 )
+    {
+        moab::gs_data::crystal_data* cr = m_pcomm->proc_config().crystal_router();
+
+        // Tuples: to proc, row, col; value
+        moab::TupleList tlEntries;
+        tlEntries.initialize ( 3, 0, 0, 1, localNS );
+        tlEntries.enableWriteAccess();
+
+        if ( owned_dof_ids.empty() )
+        {
+            // Block partition: the owner of every row is known without any lookup
+            for ( int i = 0; i < localNS; ++i )
+            {
+                int n = tlEntries.get_n();
+                tlEntries.vi_wr[3 * n] = BlockPartitionOwner ( vecRow[i] - 1, nB, size );
+                tlEntries.vi_wr[3 * n + 1] = vecRow[i];
+                tlEntries.vi_wr[3 * n + 2] = vecCol[i];
+                tlEntries.vr_wr[n] = vecS[i];
+                tlEntries.inc_n();
+            }
+            cr->gs_transfer ( 1, tlEntries, 0 );
+        }
+        else
+        {
+            // Arbitrary ownership: build a distributed directory where rank (gid-1)%size knows the owner of gid
+            moab::TupleList tlDir;
+            tlDir.initialize ( 2, 0, 0, 0, ownedRows.size() );
+            tlDir.enableWriteAccess();
+            for ( size_t i = 0; i < ownedRows.size(); ++i )
+            {
+                int n = tlDir.get_n();
+                tlDir.vi_wr[2 * n] = ( ownedRows[i] - 1 ) % size;
+                tlDir.vi_wr[2 * n + 1] = ownedRows[i];
+                tlDir.inc_n();
+            }
+            cr->gs_transfer ( 1, tlDir, 0 );
+
+            // After the transfer, the proc field holds the rank that sent the request, i.e. the owner
+            std::map<int, int> rowOwner;
+            for ( unsigned i = 0; i < tlDir.get_n(); ++i )
+                rowOwner[tlDir.vi_rd[2 * i + 1]] = tlDir.vi_rd[2 * i];
+
+            for ( int i = 0; i < localNS; ++i )
+            {
+                int n = tlEntries.get_n();
+                tlEntries.vi_wr[3 * n] = ( vecRow[i] - 1 ) % size;
+                tlEntries.vi_wr[3 * n + 1] = vecRow[i];
+                tlEntries.vi_wr[3 * n + 2] = vecCol[i];
+                tlEntries.vr_wr[n] = vecS[i];
+                tlEntries.inc_n();
+            }
+            cr->gs_transfer ( 1, tlEntries, 0 );
+
+            // Forward the entries from the directory rank to the row owner; drop rows nobody owns
+            unsigned nkeep = 0;
+            tlEntries.enableWriteAccess();
+            for ( unsigned i = 0; i < tlEntries.get_n(); ++i )
+            {
+                std::map<int, int>::iterator it = rowOwner.find ( tlEntries.vi_rd[3 * i + 1] );
+                if ( it == rowOwner.end() ) continue;
+                tlEntries.vi_wr[3 * nkeep] = it->second;
+                tlEntries.vi_wr[3 * nkeep + 1] = tlEntries.vi_rd[3 * i + 1];
+                tlEntries.vi_wr[3 * nkeep + 2] = tlEntries.vi_rd[3 * i + 2];
+                tlEntries.vr_wr[nkeep] = tlEntries.vr_rd[i];
+                ++nkeep;
+            }
+            tlEntries.set_n ( nkeep );
+            cr->gs_transfer ( 1, tlEntries, 0 );
+        }
+
+        const unsigned nrecv = tlEntries.get_n();
+        vecRow.resize ( nrecv );
+        vecCol.resize ( nrecv );
+        vecS.resize ( nrecv );
+        for ( unsigned i = 0; i < nrecv; ++i )
+        {
+            vecRow[i] = tlEntries.vi_rd[3 * i + 1];
+            vecCol[i] = tlEntries.vi_rd[3 * i + 2];
+            vecS[i] = tlEntries.vr_rd[i];
+        }
+    }
+#endif
+
+    // Local row numbering follows the order of the owned DoFs
+    std::map<int, int> rowIndex;
+    row_dofmap.resize ( ownedRows.size() );
+    row_ldofmap.resize ( ownedRows.size() );
+    row_gdofmap.resize ( ownedRows.size() );
+    for ( size_t i = 0; i < ownedRows.size(); ++i )
+    {
+        row_dofmap[i] = i;
+        row_ldofmap[i] = i;
+        row_gdofmap[i] = ownedRows[i] - 1;
+        rowIndex[ownedRows[i]] = i;
+    }
+
+    // Local column numbering: sorted unique source DoFs referenced by the local rows
+    std::vector<int> uniqueCols;
+    std::vector<Eigen::Triplet<double> > triplets;
+    triplets.reserve ( vecS.size() );
+    for ( size_t i = 0; i < vecS.size(); ++i )
+    {
+        if ( rowIndex.find ( vecRow[i] ) == rowIndex.end() ) continue;
+        uniqueCols.push_back ( vecCol[i] );
+    }
+    std::sort ( uniqueCols.begin(), uniqueCols.end() );
+    uniqueCols.erase ( std::unique ( uniqueCols.begin(), uniqueCols.end() ), uniqueCols.end() );
+
+    col_dofmap.resize ( uniqueCols.size() );
+    col_ldofmap.resize ( uniqueCols.size() );
+    col_gdofmap.resize ( uniqueCols.size() );
+    for ( size_t i = 0; i < uniqueCols.size(); ++i )
+    {
+        col_dofmap[i] = i;
+        col_ldofmap[i] = i;
+        col_gdofmap[i] = uniqueCols[i] - 1;
+    }
+
+    for ( size_t i = 0; i < vecS.size(); ++i )
+    {
+        std::map<int, int>::iterator rit = rowIndex.find ( vecRow[i] );
+        if ( rit == rowIndex.end() ) continue;
+        const int lcol = std::lower_bound ( uniqueCols.begin(), uniqueCols.end(), vecCol[i] ) - uniqueCols.begin();
+        triplets.push_back ( Eigen::Triplet<double> ( rit->second, lcol, vecS[i] ) );
+    }
+
+    m_nTotDofs_Dest = ownedRows.size();
+    m_nTotDofs_SrcCov = uniqueCols.size();
+
+    // Communication graph for the source field: for every rank, the positions in owned_src_dof_ids
+    // of the source DoFs it needs (col_gdofmap), so that ExchangeSourceValues only moves those
+    moab::ErrorCode rval = SetupSourceCommGraph ( nA, uniqueCols, owned_src_dof_ids ); MB_CHK_ERR ( rval );
+
+    // The source DoFs owned here: the given ones, or this rank's block of the n_a map columns
+    m_nTotDofs_Src = m_srcOwnedDofs.size();
+
+    // Build the local CSR operator in one shot; duplicated (row, col) entries are summed
+    m_weightMatrix.resize ( m_nTotDofs_Dest, m_nTotDofs_SrcCov );
+    m_weightMatrix.setFromTriplets ( triplets.begin(), triplets.end() );
+    m_weightMatrix.makeCompressed();
+    if ( m_weightMatrix.rows() && m_weightMatrix.cols() ) InitVectors();
+
+    if ( is_root )
+        std::cout << "  " << rank << "  Read remap weights with size [" << nB << " X " << nA << "] and NNZ = " << nS << " from " << strSource << std::endl;
+
+    return moab::MB_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+moab::ErrorCode moab::TempestOnlineMap::SetupSourceCommGraph ( int nA, const std::vector<int>& neededCols, const std::vector<int>& owned_src_dof_ids )
+{
+    // The source DoFs (1-based) owned by this rank; default to a block partition of n_a
+    m_srcOwnedDofs = owned_src_dof_ids;
+    if ( m_srcOwnedDofs.empty() )
+    {
+        const int nloccols = nA / size + ( rank < nA % size ? 1 : 0 );
+        const int coloffset = rank * ( nA / size ) + std::min ( rank, nA % size );
+        m_srcOwnedDofs.resize ( nloccols );
+        for ( int i = 0; i < nloccols; ++i )
+            m_srcOwnedDofs[i] = coloffset + i + 1;
+    }
+
+    std::map<int, int> ownedIndex;
+    for ( size_t i = 0; i < m_srcOwnedDofs.size(); ++i )
+        ownedIndex[m_srcOwnedDofs[i]] = i;
+
+    m_srcSendGraph.clear();
+    if ( !is_parallel || size == 1 )
+    {
+        std::vector<int>& sendList = m_srcSendGraph[rank];
+        sendList.resize ( neededCols.size() );
+        for ( size_t i = 0; i < neededCols.size(); ++i )
+        {
+            std::map<int, int>::iterator it = ownedIndex.find ( neededCols[i] );
+            if ( it == ownedIndex.end() ) { MB_CHK_SET_ERR ( moab::MB_FAILURE, "Source DoF " << neededCols[i] << " is not owned by any rank" ); }
+            sendList[i] = it->second;
+        }
+        return moab::MB_SUCCESS;
+    }
+
+#ifdef MOAB_HAVE_MPI
+    moab::gs_data::crystal_data* cr = m_pcomm->proc_config().crystal_router();
+
+    // Requests: to proc, source DoF; after a transfer the proc field holds the requesting rank
+    moab::TupleList tlReq;
+    tlReq.initialize ( 2, 0, 0, 0, neededCols.size() );
+    tlReq.enableWriteAccess();
+    if ( owned_src_dof_ids.empty() )
+    {
+        // Block partition: send the requests straight to the owners
+        for ( size_t i = 0; i < neededCols.size(); ++i )
+        {
+            int n = tlReq.get_n();
+            tlReq.vi_wr[2 * n] = BlockPartitionOwner ( neededCols[i] - 1, nA, size );
+            tlReq.vi_wr[2 * n + 1] = neededCols[i];
+            tlReq.inc_n();
+        }
+        cr->gs_transfer ( 1, tlReq, 0 );
+
+        for ( unsigned i = 0; i < tlReq.get_n(); ++i )
+        {
+            std::map<int, int>::iterator it = ownedIndex.find ( tlReq.vi_rd[2 * i + 1] );
+            if ( it == ownedIndex.end() ) { MB_CHK_SET_ERR ( moab::MB_FAILURE, "Source DoF " << tlReq.vi_rd[2 * i + 1] << " is not owned by rank " << rank ); }
+            m_srcSendGraph[tlReq.vi_rd[2 * i]].push_back ( it->second );
+        }
+    }
+    else
+    {
+        // Arbitrary ownership: rank (gid-1)%size learns the owner of gid, and forwards the requests
+        moab::TupleList tlDir;
+        tlDir.initialize ( 2, 0, 0, 0, m_srcOwnedDofs.size() );
+        tlDir.enableWriteAccess();
+        for ( size_t i = 0; i < m_srcOwnedDofs.size(); ++i )
+        {
+            int n = tlDir.get_n();
+            tlDir.vi_wr[2 * n] = ( m_srcOwnedDofs[i] - 1 ) % size;
+            tlDir.vi_wr[2 * n + 1] = m_srcOwnedDofs[i];
+            tlDir.inc_n();
+        }
+        cr->gs_transfer ( 1, tlDir, 0 );
+
+        std::map<int, int> colOwner;
+        for ( unsigned i = 0; i < tlDir.get_n(); ++i )
+            colOwner[tlDir.vi_rd[2 * i + 1]] = tlDir.vi_rd[2 * i];
+
+        for ( size_t i = 0; i < neededCols.size(); ++i )
+        {
+            int n = tlReq.get_n();
+            tlReq.vi_wr[2 * n] = ( neededCols[i] - 1 ) % size;
+            tlReq.vi_wr[2 * n + 1] = neededCols[i];
+            tlReq.inc_n();
+        }
+        cr->gs_transfer ( 1, tlReq, 0 );
+
+        // Keep the requesting rank in a third slot while routing the request on to the owner
+        moab::TupleList tlFwd;
+        tlFwd.initialize ( 3, 0, 0, 0, tlReq.get_n() );
+        tlFwd.enableWriteAccess();
+        for ( unsigned i = 0; i < tlReq.get_n(); ++i )
+        {
+            std::map<int, int>::iterator it = colOwner.find ( tlReq.vi_rd[2 * i + 1] );
+            if ( it == colOwner.end() ) { MB_CHK_SET_ERR ( moab::MB_FAILURE, "Source DoF " << tlReq.vi_rd[2 * i + 1] << " is not owned by any rank" ); }
+            int n = tlFwd.get_n();
+            tlFwd.vi_wr[3 * n] = it->second;
+            tlFwd.vi_wr[3 * n + 1] = tlReq.vi_rd[2 * i + 1];
+            tlFwd.vi_wr[3 * n + 2] = tlReq.vi_rd[2 * i];
+            tlFwd.inc_n();
+        }
+        cr->gs_transfer ( 1, tlFwd, 0 );
+
+        // Every received request is (owner, source DoF owned here, requesting rank)
+        for ( unsigned i = 0; i < tlFwd.get_n(); ++i )
+        {
+            std::map<int, int>::iterator it = ownedIndex.find ( tlFwd.vi_rd[3 * i + 1] );
+            if ( it == ownedIndex.end() ) { MB_CHK_SET_ERR ( moab::MB_FAILURE, "Source DoF " << tlFwd.vi_rd[3 * i + 1] << " is not owned by rank " << rank ); }
+            m_srcSendGraph[tlFwd.vi_rd[3 * i + 2]].push_back ( it->second );
+        }
+    }
+#endif
+
+    return moab::MB_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+moab::ErrorCode moab::TempestOnlineMap::ExchangeSourceValues ( const std::vector<double>& ownedSrcVals, std::vector<double>& srcVals )
+{
+    if ( ownedSrcVals.size() != m_srcOwnedDofs.size() ) { MB_CHK_SET_ERR ( moab::MB_INVALID_SIZE, "Expected " << m_srcOwnedDofs.size() << " owned source values, got " << ownedSrcVals.size() ); }
+
+    // Received values are placed by a binary search of their global DoF in col_gdofmap, which
+    // ReadParallelMap numbers in increasing order
+    if ( std::adjacent_find ( col_gdofmap.begin(), col_gdofmap.end(), std::greater_equal<unsigned>() ) != col_gdofmap.end() )
+    { MB_CHK_SET_ERR ( moab::MB_FAILURE, "Source DoFs are not sorted; ExchangeSourceValues needs a map read with ReadParallelMap" ); }
+    srcVals.assign ( col_gdofmap.size(), 0.0 );
+
+    if ( !is_parallel || size == 1 )
+    {
+        const std::vector<int>& sendList = m_srcSendGraph[rank];
+        for ( size_t i = 0; i < sendList.size(); ++i )
+            srcVals[i] = ownedSrcVals[sendList[i]];
+        return moab::MB_SUCCESS;
+    }
+
+#ifdef MOAB_HAVE_MPI
+    unsigned nsend = 0;
+    for ( std::map<int, std::vector<int> >::const_iterator it = m_srcSendGraph.begin(); it != m_srcSendGraph.end(); ++it )
+        nsend += it->second.size();
+
+    // Tuples: to proc, source DoF; value
+    moab::TupleList tlVals;
+    tlVals.initialize ( 2, 0, 0, 1, nsend );
+    tlVals.enableWriteAccess();
+    for ( std::map<int, std::vector<int> >::const_iterator it = m_srcSendGraph.begin(); it != m_srcSendGraph.end(); ++it )
+    {
+        for ( size_t i = 0; i < it->second.size(); ++i )
+        {
+            int n = tlVals.get_n();
+            tlVals.vi_wr[2 * n] = it->first;
+            tlVals.vi_wr[2 * n + 1] = m_srcOwnedDofs[it->second[i]];
+            tlVals.vr_wr[n] = ownedSrcVals[it->second[i]];
+            tlVals.inc_n();
+        }
+    }
+    m_pcomm->proc_config().crystal_router()->gs_transfer ( 1, tlVals, 0 );
+
+    for ( unsigned i = 0; i < tlVals.get_n(); ++i )
+    {
+        const unsigned gdof = tlVals.vi_rd[2 * i + 1] - 1;
+        std::vector<unsigned>::iterator it = std::lower_bound ( col_gdofmap.begin(), col_gdofmap.end(), gdof );
+        if ( it == col_gdofmap.end() || *it != gdof ) { MB_CHK_SET_ERR ( moab::MB_FAILURE, "Received unexpected source DoF " << gdof + 1 ); }
+        srcVals[it - col_gdofmap.begin()] = tlVals.vr_rd[i];
+    }
+#endif
+
+    return moab::MB_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 moab::ErrorCode moab::TempestOnlineMap::ApplyWeights (std::vector<double>& srcVals, std::vector<double>& tgtVals, bool transpose)
 {
     // Reset the source and target data first
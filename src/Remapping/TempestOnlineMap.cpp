@@ -99,10 +99,15 @@ moab::TempestOnlineMap::TempestOnlineMap ( moab::TempestRemapper* remapper ) : O
     std::vector<int> dimSizes(1);
     dimNames[0] = "num_elem";
 
-    dimSizes[0] = m_meshInputCov->faces.size();
-    this->InitializeSourceDimensions(dimNames, dimSizes);
-    dimSizes[0] = m_meshOutput->faces.size();
-    this->InitializeTargetDimensions(dimNames, dimSizes);
+    // The meshes may not be available when the map is only read from file (ReadParallelMap)
+    if ( m_meshInputCov ) {
+        dimSizes[0] = m_meshInputCov->faces.size();
+        this->InitializeSourceDimensions(dimNames, dimSizes);
+    }
+    if ( m_meshOutput ) {
+        dimSizes[0] = m_meshOutput->faces.size();
+        this->InitializeTargetDimensions(dimNames, dimSizes);
+    }
 
     m_weightMapGlobal = NULL;
 
@@ -10,6 +10,7 @@
 #include "SequenceManager.hpp"
 #include "TypeSequenceManager.hpp"
 #include "EntitySequence.hpp"
+#include "SpaceFillingCurve.hpp"
 
 #include <algorithm>
 #include <numeric>
@@ -403,6 +404,296 @@ ErrorCode ReorderTool::get_new_handles( Tag tag,
   return MB_SUCCESS;
 }
 
+ErrorCode ReorderTool::handle_order_from_positions( const std::vector<EntityHandle>& entities,
+                                                    const std::vector<int>& positions,
+                                                    Tag& handle_tag )
+{
+  ErrorCode rval;
+
+  Tag order_tag;
+  const int negone = -1;
+  rval = mMB->tag_get_handle( 0, 1, MB_TYPE_INTEGER, order_tag,
+                              MB_TAG_DENSE|MB_TAG_CREAT|MB_TAG_EXCL, &negone );
+  CHKERR;
+
+  if (!entities.empty())
+    rval = mMB->tag_set_data( order_tag, &entities[0], entities.size(), &positions[0] );
+  if (MB_SUCCESS == rval)
+    rval = handle_order_from_int_tag( order_tag, negone, handle_tag );
+  if (MB_SUCCESS != rval) {
+    mMB->tag_delete( order_tag );
+    return error(rval);
+  }
+
+  rval = mMB->tag_delete( order_tag );
+  CHKERR;
+
+  return MB_SUCCESS;
+}
+
+ErrorCode ReorderTool::get_element_vertices( EntityHandle elem,
+                                             std::vector<EntityHandle>& verts,
+                                             std::vector<EntityHandle>& storage )
+{
+  ErrorCode rval;
+  verts.clear();
+  if (MBPOLYHEDRON == mMB->type_from_handle( elem ))
+    return mMB->get_adjacencies( &elem, 1, 0, false, verts );
+
+  const EntityHandle* conn;
+  int len;
+  rval = mMB->get_connectivity( elem, conn, len, true, &storage );
+  CHKERR;
+  verts.assign( conn, conn + len );
+  return MB_SUCCESS;
+}
+
+    // Breadth-first level structure of the component containing start.
+    // Returns the number of levels and passes back the node of least
+    // degree in the last level.
+static int bfs_last_level( int start,
+                           const std::vector<size_t>& offs,
+                           const std::vector<int>& adj,
+                           std::vector<int>& mark, int stamp,
+                           std::vector<int>& queue,
+                           int& last_node )
+{
+  queue.clear();
+  queue.push_back( start );
+  mark[start] = stamp;
+  int nlevels = 0;
+  size_t level_begin = 0;
+  while (level_begin < queue.size()) {
+    size_t level_end = queue.size();
+    last_node = queue[level_begin];
+    for (size_t i = level_begin; i < level_end; ++i) {
+      int e = queue[i];
+      if (offs[e+1]-offs[e] < offs[last_node+1]-offs[last_node])
+        last_node = e;
+      for (size_t j = offs[e]; j < offs[e+1]; ++j)
+        if (mark[adj[j]] != stamp) {
+          mark[adj[j]] = stamp;
+          queue.push_back( adj[j] );
+        }
+    }
+    level_begin = level_end;
+    ++nlevels;
+  }
+  return nlevels;
+}
+
+    // Compare graph nodes by degree
+struct CompDegree {
+  const std::vector<size_t>& offs;
+  CompDegree( const std::vector<size_t>& o ) : offs(o) {}
+  bool operator()( int a, int b ) const
+    { return offs[a+1]-offs[a] < offs[b+1]-offs[b]; }
+};
+
+ErrorCode ReorderTool::handle_order_rcm( int dim, Tag& handle_tag )
+{
+  ErrorCode rval;
+
+  if (dim < 0) {
+    for (dim = 3; dim > 0; --dim) {
+      int count = 0;
+      rval = mMB->get_number_entities_by_dimension( 0, dim, count );
+      CHKERR;
+      if (count)
+        break;
+    }
+  }
+  if (dim < 1 || dim > 3)
+    return error(MB_ENTITY_NOT_FOUND);
+
+  Range elems;
+  rval = mMB->get_entities_by_dimension( 0, dim, elems );
+  CHKERR;
+  const size_t num_elem = elems.size();
+
+    // element vertices, stored as CSR
+  std::vector<size_t> conn_offs( 1, 0 );
+  std::vector<EntityHandle> conn, verts, storage;
+  conn_offs.reserve( num_elem + 1 );
+  for (Range::iterator i = elems.begin(); i != elems.end(); ++i) {
+    rval = get_element_vertices( *i, verts, storage );
+    CHKERR;
+    conn.insert( conn.end(), verts.begin(), verts.end() );
+    conn_offs.push_back( conn.size() );
+  }
+
+    // replace vertex handles by indices into the sorted list of vertices
+  std::vector<EntityHandle> vert_list( conn );
+  std::sort( vert_list.begin(), vert_list.end() );
+  vert_list.erase( std::unique( vert_list.begin(), vert_list.end() ), vert_list.end() );
+  const size_t num_vert = vert_list.size();
+  std::vector<int> conn_idx( conn.size() );
+  for (size_t i = 0; i < conn.size(); ++i)
+    conn_idx[i] = std::lower_bound( vert_list.begin(), vert_list.end(), conn[i] ) - vert_list.begin();
+  std::vector<EntityHandle>().swap( conn );
+
+    // elements adjacent to each vertex
+  std::vector<size_t> vert_offs( num_vert + 1, 0 );
+  for (size_t i = 0; i < conn_idx.size(); ++i)
+    ++vert_offs[conn_idx[i]+1];
+  std::partial_sum( vert_offs.begin(), vert_offs.end(), vert_offs.begin() );
+  std::vector<int> vert_elems( conn_idx.size() );
+  std::vector<size_t> fill( vert_offs.begin(), vert_offs.end() - 1 );
+  for (size_t e = 0; e < num_elem; ++e)
+    for (size_t j = conn_offs[e]; j < conn_offs[e+1]; ++j)
+      vert_elems[fill[conn_idx[j]]++] = e;
+  std::vector<size_t>().swap( fill );
+
+    // dual graph: elements sharing at least dim vertices share a side
+  std::vector<size_t> graph_offs( 1, 0 );
+  std::vector<int> graph_adj, shared( num_elem, 0 ), touched;
+  graph_offs.reserve( num_elem + 1 );
+  for (size_t e = 0; e < num_elem; ++e) {
+    touched.clear();
+    for (size_t j = conn_offs[e]; j < conn_offs[e+1]; ++j) {
+      int v = conn_idx[j];
+      for (size_t k = vert_offs[v]; k < vert_offs[v+1]; ++k) {
+        int f = vert_elems[k];
+        if ((size_t)f != e && !shared[f]++)
+          touched.push_back( f );
+      }
+    }
+    for (size_t k = 0; k < touched.size(); ++k) {
+      if (shared[touched[k]] >= dim)
+        graph_adj.push_back( touched[k] );
+      shared[touched[k]] = 0;
+    }
+    graph_offs.push_back( graph_adj.size() );
+  }
+  std::vector<int>().swap( vert_elems );
+  std::vector<size_t>().swap( vert_offs );
+
+    // Cuthill-McKee from a pseudo-peripheral node of each component,
+    // visiting neighbors by increasing degree
+  std::vector<int> by_degree( num_elem ), order, queue, mark( num_elem, -1 );
+  for (size_t e = 0; e < num_elem; ++e)
+    by_degree[e] = e;
+  std::stable_sort( by_degree.begin(), by_degree.end(), CompDegree( graph_offs ) );
+  std::vector<char> visited( num_elem, 0 );
+  order.reserve( num_elem );
+  int stamp = 0;
+  for (size_t s = 0; s < num_elem; ++s) {
+    int start = by_degree[s];
+    if (visited[start])
+      continue;
+
+    int last, nlevels = bfs_last_level( start, graph_offs, graph_adj, mark, stamp++, queue, last );
+    for (int iter = 0; iter < 8 && last != start; ++iter) {
+      int next_last, next_levels = bfs_last_level( last, graph_offs, graph_adj, mark, stamp++, queue, next_last );
+      if (next_levels <= nlevels)
+        break;
+      start = last;
+      last = next_last;
+      nlevels = next_levels;
+    }
+
+    size_t head = order.size();
+    order.push_back( start );
+    visited[start] = 1;
+    for (; head < order.size(); ++head) {
+      int e = order[head];
+      size_t first = order.size();
+      for (size_t j = graph_offs[e]; j < graph_offs[e+1]; ++j)
+        if (!visited[graph_adj[j]]) {
+          visited[graph_adj[j]] = 1;
+          order.push_back( graph_adj[j] );
+        }
+      std::stable_sort( order.begin() + first, order.end(), CompDegree( graph_offs ) );
+    }
+  }
+  std::reverse( order.begin(), order.end() );
+
+    // new positions of elements, then of vertices by first use
+  std::vector<EntityHandle> entities( elems.begin(), elems.end() );
+  std::vector<int> positions( num_elem + num_vert, -1 );
+  for (size_t p = 0; p < num_elem; ++p)
+    positions[order[p]] = p;
+  int next = 0;
+  for (size_t p = 0; p < num_elem; ++p)
+    for (size_t j = conn_offs[order[p]]; j < conn_offs[order[p]+1]; ++j)
+      if (positions[num_elem + conn_idx[j]] < 0)
+        positions[num_elem + conn_idx[j]] = next++;
+  entities.insert( entities.end(), vert_list.begin(), vert_list.end() );
+
+  return handle_order_from_positions( entities, positions, handle_tag );
+}
+
+    // Compare sort keys paired with entity indices
+struct CompSFCKey {
+  bool operator()( const std::pair<uint64_t,int>& a,
+                   const std::pair<uint64_t,int>& b ) const
+    { return a.first < b.first || (a.first == b.first && a.second < b.second); }
+};
+
+ErrorCode ReorderTool::handle_order_sfc( bool hilbert, Tag& handle_tag )
+{
+  ErrorCode rval;
+
+  Range verts, elems;
+  rval = mMB->get_entities_by_type( 0, MBVERTEX, verts );
+  CHKERR;
+  for (int dim = 1; dim <= 3; ++dim) {
+    rval = mMB->get_entities_by_dimension( 0, dim, elems );
+    CHKERR;
+  }
+
+    // vertex coordinates followed by element centroids
+  std::vector<double> points( 3*(verts.size() + elems.size()) );
+  if (!verts.empty()) {
+    rval = mMB->get_coords( verts, &points[0] );
+    CHKERR;
+  }
+  std::vector<EntityHandle> conn, storage;
+  std::vector<double> coords;
+  double* centroid = points.empty() ? NULL : &points[0] + 3*verts.size();
+  for (Range::iterator i = elems.begin(); i != elems.end(); ++i, centroid += 3) {
+    rval = get_element_vertices( *i, conn, storage );
+    CHKERR;
+    coords.resize( 3*conn.size() );
+    rval = mMB->get_coords( &conn[0], conn.size(), &coords[0] );
+    CHKERR;
+    centroid[0] = centroid[1] = centroid[2] = 0.0;
+    for (size_t j = 0; j < conn.size(); ++j)
+      for (int d = 0; d < 3; ++d)
+        centroid[d] += coords[3*j+d] / conn.size();
+  }
+
+    // curve over the bounding box of the vertices (which contains the centroids)
+  double bmin[3] = { 0.0, 0.0, 0.0 }, bmax[3] = { 0.0, 0.0, 0.0 }, scale[3];
+  for (size_t i = 0; i < verts.size(); ++i)
+    for (int d = 0; d < 3; ++d) {
+      if (!i || points[3*i+d] < bmin[d])
+        bmin[d] = points[3*i+d];
+      if (!i || points[3*i+d] > bmax[d])
+        bmax[d] = points[3*i+d];
+    }
+  SpaceFillingCurve::box_scale( bmin, bmax, scale );
+
+  const size_t num_ents = verts.size() + elems.size();
+  std::vector<std::pair<uint64_t,int> > keys( num_ents );
+  for (size_t i = 0; i < num_ents; ++i) {
+    unsigned int X[3];
+    SpaceFillingCurve::quantize( &points[3*i], bmin, scale, X );
+    keys[i].first = hilbert ? SpaceFillingCurve::hilbert_key( X )
+                            : SpaceFillingCurve::morton_key( X );
+    keys[i].second = i;
+  }
+  std::sort( keys.begin(), keys.end(), CompSFCKey() );
+
+  std::vector<EntityHandle> entities( verts.begin(), verts.end() );
+  entities.insert( entities.end(), elems.begin(), elems.end() );
+  std::vector<int> positions( num_ents );
+  for (size_t p = 0; p < num_ents; ++p)
+    positions[keys[p].second] = p;
+
+  return handle_order_from_positions( entities, positions, handle_tag );
+}
+
 ErrorCode ReorderTool::reorder_entities( Tag new_handles )
 {
   ErrorCode rval;
@@ -170,20 +170,21 @@ ErrorCode SequenceManager::create_vertex(const double coords[3],
   const EntityHandle start = CREATE_HANDLE(MBVERTEX, MB_START_ID);
   const EntityHandle   end = CREATE_HANDLE(MBVERTEX,   MB_END_ID);
   bool append;
-  TypeSequenceManager::iterator seq = typeData[MBVERTEX].find_free_handle(start, end, append);
+  const int precision = floatCoords ? (int)VertexSequence::FLOAT_COORDS : 0;
+  TypeSequenceManager::iterator seq = typeData[MBVERTEX].find_free_handle(start, end, append, precision);
   VertexSequence* vseq;
 
   if (seq == typeData[MBVERTEX].end()) {
     SequenceData* seq_data = 0;
     EntityID seq_data_size = 0;
-    handle = typeData[MBVERTEX].find_free_sequence(DEFAULT_VERTEX_SEQUENCE_SIZE, start, end, seq_data, seq_data_size);
+    handle = typeData[MBVERTEX].find_free_sequence(DEFAULT_VERTEX_SEQUENCE_SIZE, start, end, seq_data, seq_data_size, precision);
     if (!handle)
       return MB_FAILURE;
 
     if (seq_data)
       vseq = new VertexSequence(handle, 1, seq_data);
     else
-      vseq = new VertexSequence(handle, 1, DEFAULT_VERTEX_SEQUENCE_SIZE);
+      vseq = new VertexSequence(handle, 1, DEFAULT_VERTEX_SEQUENCE_SIZE, floatCoords);
 
     ErrorCode rval = typeData[MBVERTEX].insert_sequence(vseq);
     if (MB_SUCCESS != rval) {
@@ -443,11 +444,14 @@ ErrorCode SequenceManager::create_entity_sequence(EntityType type,
                                                   EntityID start,
                                                   EntityHandle& handle,
                                                   EntitySequence*& sequence,
-                                                  int sequence_size)
+                                                  int sequence_size,
+                                                  bool float_coords)
 {
   SequenceData* data = NULL;
   EntityID data_size = 0;
-  handle = sequence_start_handle(type, count, size, start, data, data_size);
+    // Vertices only go in unused space of data with the same precision
+  const int values_per_ent = (MBVERTEX == type && float_coords) ? (int)VertexSequence::FLOAT_COORDS : size;
+  handle = sequence_start_handle(type, count, values_per_ent, start, data, data_size);
 
   if (!handle)
     return MB_MEMORY_ALLOCATION_FAILED;
@@ -466,7 +470,7 @@ ErrorCode SequenceManager::create_entity_sequence(EntityType type,
     else {
       if (!data_size)
         data_size = new_sequence_size(handle, count, sequence_size);
-      sequence = new VertexSequence(handle, count, data_size);
+      sequence = new VertexSequence(handle, count, data_size, float_coords);
     }
     break;
 
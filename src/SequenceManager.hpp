@@ -14,7 +14,8 @@ class SequenceManager
 {
   public:
 
-    SequenceManager(double default_seq_multiplier = 1.0) : sequence_multiplier(default_seq_multiplier)
+    SequenceManager(double default_seq_multiplier = 1.0) : sequence_multiplier(default_seq_multiplier),
+      floatCoords(false)
     { }
 
     ~SequenceManager();
@@ -142,6 +143,10 @@ class SequenceManager
        *                    NOTE: first_handle_out may not be first handle in
        *                    sequence.
        *\param sequence_size If specified, allocate this sequence size instead of DEFAULT_***_SEQUENCE_SIZE
+       *\param float_coords For MBVERTEX, store coordinates in single
+       *                    precision.  Unused space of an existing
+       *                    SequenceData is only reused if it has the
+       *                    same precision.
        */
     ErrorCode create_entity_sequence( EntityType type,
                                       EntityID num_entities,
@@ -149,7 +154,8 @@ class SequenceManager
                                       EntityID start_id_hint,
                                       EntityHandle& first_handle_out,
                                       EntitySequence*& sequence_out,
-                                      int sequence_size);
+                                      int sequence_size,
+                                      bool float_coords = false );
 
        /**\brief Allocate a block of consecutive mesh sets
        *
@@ -298,6 +304,14 @@ class SequenceManager
     void set_sequence_multiplier(double factor)
     { sequence_multiplier = factor; }
 
+    /**\brief Store coordinates of vertices created by create_vertex in
+     *        new sequences in single precision */
+    void set_float_coordinates(bool flag)
+    { floatCoords = flag; }
+
+    bool get_float_coordinates() const
+    { return floatCoords; }
+
     /**\brief Default allocation size for vertices */
   static const EntityID DEFAULT_VERTEX_SEQUENCE_SIZE;
 
@@ -349,6 +363,9 @@ class SequenceManager
      /**\brief The over-allocation factor for entities in a sequence (strictly >= 1.0) */
     double sequence_multiplier;
 
+     /**\brief Precision of coordinates in new vertex sequences */
+    bool floatCoords;
+
 };
 
 } // namespace moab
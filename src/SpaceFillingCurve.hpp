@@ -0,0 +1,83 @@
+#ifndef MB_SPACE_FILLING_CURVE_HPP
+#define MB_SPACE_FILLING_CURVE_HPP
+
+#include <stdint.h>
+
+namespace moab {
+
+namespace SpaceFillingCurve
+{
+
+/**\brief Number of bits per coordinate in a curve key (3*21 = 63 bits) */
+const int BITS = 21;
+
+/**\brief Quantize a point to integer cell coordinates
+ *
+ *\param pt     Point coordinates
+ *\param bmin   Lower corner of the box covered by the curve
+ *\param scale  Per-direction (2^BITS-1)/extent, zero for a flat direction
+ *\param X      Output cell coordinates in [0, 2^BITS)
+ */
+inline void quantize( const double pt[3], const double bmin[3],
+                      const double scale[3], unsigned int X[3] )
+{
+  for (int d = 0; d < 3; d++)
+    X[d] = (unsigned int)((pt[d] - bmin[d])*scale[d]);
+}
+
+/**\brief Compute scale factors for \c quantize from a bounding box */
+inline void box_scale( const double bmin[3], const double bmax[3], double scale[3] )
+{
+  const double maxq = (double)((1u << BITS) - 1);
+  for (int d = 0; d < 3; d++)
+    scale[d] = (bmax[d] > bmin[d]) ? maxq/(bmax[d]-bmin[d]) : 0.0;
+}
+
+/**\brief Morton (Z-order) key of quantized coordinates */
+inline uint64_t morton_key( const unsigned int X[3] )
+{
+  uint64_t key = 0;
+  for (int b = BITS-1; b >= 0; b--)
+    for (int i = 0; i < 3; i++)
+      key = (key << 1) | ((X[i] >> b) & 1u);
+  return key;
+}
+
+/**\brief Hilbert key of quantized coordinates
+ *
+ * Skilling's transform to the transposed Hilbert index, followed by bit
+ * interleaving (J. Skilling, "Programming the Hilbert curve",
+ * AIP Conf. Proc. 707, 2004).
+ */
+inline uint64_t hilbert_key( const unsigned int Xin[3] )
+{
+  unsigned int X[3] = {Xin[0], Xin[1], Xin[2]};
+  unsigned int M = 1u << (BITS-1), P, Q, t;
+  for (Q = M; Q > 1; Q >>= 1) {
+    P = Q - 1;
+    for (int i = 0; i < 3; i++) {
+      if (X[i] & Q)
+        X[0] ^= P;
+      else {
+        t = (X[0] ^ X[i]) & P;
+        X[0] ^= t;
+        X[i] ^= t;
+      }
+    }
+  }
+  for (int i = 1; i < 3; i++)
+    X[i] ^= X[i-1];
+  t = 0;
+  for (Q = M; Q > 1; Q >>= 1)
+    if (X[2] & Q)
+      t ^= Q - 1;
+  for (int i = 0; i < 3; i++)
+    X[i] ^= t;
+  return morton_key(X);
+}
+
+} // namespace SpaceFillingCurve
+
+} // namespace moab
+
+#endif
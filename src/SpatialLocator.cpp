@@ -208,7 +208,7 @@ namespace moab
         //TLforw_req_i: Tuples to forward to corresponding procs (forwarding requests)
         //TL (sourceProc, OriginalSourceProc, targetIndex, X,Y,Z)
 
-      TLquery_o.initialize(3,0,0,3,0);
+      TLquery_o.initialize(3,0,0,3,num_points);
 
       int iargs[3];
 
@@ -235,10 +235,11 @@ namespace moab
         //TLforward_o: query messages forwarded to corresponding procs
         //TL (toProc, OriginalSourceProc, targetIndex, X,Y,Z)
 
-      TLforward_o.initialize(3,0,0,3,0);
-
       int NN = TLquery_o.get_n();
 
+        // the number of forwarded queries is not known beforehand; most queries go to one proc
+      TupleList::builder forward_builder(3,0,0,3,NN);
+
       for (int i=0; i < NN; i++) {
         iargs[1] = TLquery_o.vi_rd[3*i+1];	//get OriginalSourceProc
         iargs[2] = TLquery_o.vi_rd[3*i+2];	//targetIndex
@@ -248,11 +249,12 @@ namespace moab
         for (std::map<int, BoundBox>::iterator mit = srcProcBoxes.begin(); mit != srcProcBoxes.end(); ++mit) {
           if ((*mit).second.contains_point(tmp_pnt.array(), abs_iter_tol)) {
             iargs[0] = (*mit).first;
-            TLforward_o.push_back(iargs, NULL, NULL, tmp_pnt.array());
+            forward_builder.push_back(iargs, NULL, NULL, tmp_pnt.array());
           }
         }
 
       }
+      forward_builder.finalize(TLforward_o);
 
       myTimes.slTimes[SpatialLocatorTimes::INTMED_SEARCH] = myTimer.time_elapsed();
 
@@ -272,10 +274,6 @@ namespace moab
 							
       NN = TLforward_o.get_n();
 
-        //TLsearch_results_o
-        //TL: (OriginalSourceProc, targetIndex, sourceIndex, U,V,W);
-      TLsearch_results_o.initialize(3,0,0,0,0);
-
         //step 13 is done in test_local_box
 
       std::vector<double> params(3*NN);
@@ -288,20 +286,23 @@ namespace moab
       if (MB_SUCCESS != rval)
         return rval;
 
-      locTable.initialize(1, 0, 1, 3, 0);
-      locTable.enableWriteAccess();
+        //TLsearch_results_o
+        //TL: (OriginalSourceProc, targetIndex, sourceIndex, U,V,W);
+        //at most NN points are found here
+      TupleList::builder results_builder(3,0,0,0,NN), loc_builder(1,0,1,3,NN);
       for (int i = 0; i < NN; i++) {
         if (is_inside[i]) {
           iargs[0] = TLforward_o.vi_rd[3*i+1];
           iargs[1] = TLforward_o.vi_rd[3*i+2];
-          iargs[2] = locTable.get_n();
-          TLsearch_results_o.push_back(iargs, NULL, NULL, NULL);
+          iargs[2] = loc_builder.get_n();
+          results_builder.push_back(iargs, NULL, NULL, NULL);
           Ulong ent_ulong=(Ulong)ents[i];
           sint forward= (sint)TLforward_o.vi_rd[3*i+1];
-          locTable.push_back(&forward, NULL, &ent_ulong, &params[3*i]);
+          loc_builder.push_back(&forward, NULL, &ent_ulong, &params[3*i]);
         }
       }
-      locTable.disableWriteAccess();
+      results_builder.finalize(TLsearch_results_o);
+      loc_builder.finalize(locTable);
 
       myTimes.slTimes[SpatialLocatorTimes::SRC_SEARCH] =  myTimer.time_since_birth() - tstart;
       myTimer.time_elapsed(); // call this to reset last time called
@@ -317,10 +318,12 @@ namespace moab
       parLocTable.enableWriteAccess();
       std::fill(parLocTable.vi_wr, parLocTable.vi_wr + 2*num_points, -1);
 
-      for (unsigned int i = 0; i < TLsearch_results_o.get_n(); i++) {
-        int idx = TLsearch_results_o.vi_rd[3*i+1];
-        parLocTable.vi_wr[2*idx] = TLsearch_results_o.vi_rd[3*i];
-        parLocTable.vi_wr[2*idx+1] = TLsearch_results_o.vi_rd[3*i+2];
+      TupleList::column<const sint> res_procs = TLsearch_results_o.vi_column(0),
+          res_targets = TLsearch_results_o.vi_column(1), res_sources = TLsearch_results_o.vi_column(2);
+      for (unsigned int i = 0; i < res_targets.size(); i++) {
+        int idx = res_targets[i];
+        parLocTable.vi_wr[2*idx] = res_procs[i];
+        parLocTable.vi_wr[2*idx+1] = res_sources[i];
       }
 
       if (debug) {
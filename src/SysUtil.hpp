@@ -44,23 +44,23 @@ long filesize( std::ifstream& str );
 /**\brief Check if platform is little-endian
  *
  * Check if platform is little-endian (least significant
- * byte at highest memory address.)
+ * byte at lowest memory address.)
  */
 inline bool little_endian()
 {
   const unsigned one = 1;
-  return !*((char*)&one);
+  return 0 != *((char*)&one);
 }
 
 /**\brief Check if platform is big-endian
  *
  * Check if platform is big-endian (least significant
- * byte at lowest memory address.)
+ * byte at highest memory address.)
  */
 inline bool big_endian()
 {
   const unsigned one = 1;
-  return !(((char*)&one)[sizeof(unsigned)-1]);
+  return 0 != ((char*)&one)[sizeof(unsigned)-1];
 }
 
 /**\brief Swap byte order (e.g. change from big-endian to little-endian)
@@ -5,9 +5,16 @@
 #include <stdarg.h>
 #include <iostream>
 #include <fstream>
+#include <vector>
+#include <algorithm>
+#include <stdint.h>
 
 #include "moab/TupleList.hpp"
 
+#ifdef MOAB_HAVE_OPENMP
+#include <omp.h>
+#endif
+
 namespace moab {
 
 void fail(const char *fmt, ...)
@@ -64,6 +71,122 @@ void TupleList::buffer::reset()
   buffSize = 0;
 }
 
+// Segments of a builder after the first one hold up to that many tuples
+#define BUILDER_MAX_SEGMENT (1u << 20)
+
+TupleList::builder::builder(uint p_mi, uint p_ml, uint p_mul, uint p_mr,
+    uint first_size)
+: mi(p_mi), ml(p_ml), mul(p_mul), mr(p_mr),
+  n(0), firstSize(first_size ? first_size : 1), segLeft(0)
+{
+}
+
+// Allocates count*m values of type T, or returns NULL if m is 0
+template<class T>
+static T *builder_alloc(T *ptr, uint m, size_t count)
+{
+  if (!m)
+    return NULL;
+  size_t sz = count * m * sizeof(T);
+  void *res = realloc(ptr, sz);
+  if (!res && sz > 0)
+    fail("%s: allocation of %lu bytes failed\n", __FILE__, (unsigned long) sz);
+  return (T*) res;
+}
+
+void TupleList::builder::new_segment()
+{
+  segment seg;
+  seg.max = segments.empty() ? firstSize :
+      (n < BUILDER_MAX_SEGMENT ? n : BUILDER_MAX_SEGMENT);
+  seg.n = 0;
+  seg.vi = builder_alloc((sint*) NULL, mi, seg.max);
+  seg.vl = builder_alloc((slong*) NULL, ml, seg.max);
+  seg.vul = builder_alloc((Ulong*) NULL, mul, seg.max);
+  seg.vr = builder_alloc((realType*) NULL, mr, seg.max);
+  segments.push_back(seg);
+  segLeft = seg.max;
+}
+
+void TupleList::builder::push_back(const sint *sp, const slong *ip,
+    const Ulong *lp, const realType *dp)
+{
+  sint *si;
+  slong *sl;
+  Ulong *sul;
+  realType *sr;
+  append(si, sl, sul, sr);
+  if (mi)
+    memcpy(si, sp, mi * sizeof(sint));
+  if (ml)
+    memcpy(sl, ip, ml * sizeof(slong));
+  if (mul)
+    memcpy(sul, lp, mul * sizeof(Ulong));
+  if (mr)
+    memcpy(sr, dp, mr * sizeof(realType));
+}
+
+void TupleList::builder::finalize(TupleList &tl)
+{
+  tl.reset();
+  tl.initialize(mi, ml, mul, mr, 0);
+  if (0 == n)
+  {
+    reset();
+    return;
+  }
+
+  // the first segment, resized, becomes the storage of tl
+  segment &first = segments[0];
+  tl.vi = builder_alloc(first.vi, mi, n);
+  tl.vl = builder_alloc(first.vl, ml, n);
+  tl.vul = builder_alloc(first.vul, mul, n);
+  tl.vr = builder_alloc(first.vr, mr, n);
+  first.vi = NULL, first.vl = NULL, first.vul = NULL, first.vr = NULL;
+
+  size_t done = first.n;
+  for (size_t s = 1; s < segments.size(); s++)
+  {
+    segment &seg = segments[s];
+    if (mi)
+      memcpy(tl.vi + done * mi, seg.vi, (size_t) seg.n * mi * sizeof(sint));
+    if (ml)
+      memcpy(tl.vl + done * ml, seg.vl, (size_t) seg.n * ml * sizeof(slong));
+    if (mul)
+      memcpy(tl.vul + done * mul, seg.vul, (size_t) seg.n * mul * sizeof(Ulong));
+    if (mr)
+      memcpy(tl.vr + done * mr, seg.vr, (size_t) seg.n * mr * sizeof(realType));
+    done += seg.n;
+    // release each segment right away, to keep one copy of the list
+    free(seg.vi), free(seg.vl), free(seg.vul), free(seg.vr);
+    seg.vi = NULL, seg.vl = NULL, seg.vul = NULL, seg.vr = NULL;
+  }
+
+  tl.n = tl.max = n;
+  tl.vi_rd = tl.vi;
+  tl.vl_rd = tl.vl;
+  tl.vul_rd = tl.vul;
+  tl.vr_rd = tl.vr;
+  tl.last_sorted = -1;
+  reset();
+}
+
+void TupleList::builder::reset()
+{
+  for (size_t s = 0; s < segments.size(); s++)
+  {
+    free(segments[s].vi);
+    free(segments[s].vl);
+    free(segments[s].vul);
+    free(segments[s].vr);
+  }
+  segments.clear();
+  n = 0;
+  segLeft = 0;
+}
+
+#undef BUILDER_MAX_SEGMENT
+
 TupleList::TupleList(uint p_mi, uint p_ml, uint p_mul, uint p_mr, uint p_max)
 : vi(NULL), vl(NULL), vul(NULL), vr(NULL),
   last_sorted(-1)
@@ -534,49 +657,212 @@ void TupleList::print_to_file(const char * filename) const
 
   ofs.close();
 }
-void TupleList::permute(uint *perm, void *work)
+
+namespace {
+
+// A sort key with the index of its tuple
+struct KeyIndex { uint64_t v; uint i; };
+
+const unsigned KEY_DIGIT_BITS = 8;
+const unsigned KEY_DIGIT_VALUES = 1u << KEY_DIGIT_BITS;
+const uint64_t KEY_DIGIT_MASK = KEY_DIGIT_VALUES - 1;
+const unsigned KEY_DIGITS = 64 / KEY_DIGIT_BITS;
+
+// sort(key, buf) hands lists with at least that many tuples to the
+// multithreaded radix sort
+const uint PARALLEL_SORT_MIN = 1u << 16;
+
+// each thread counts and scatters at least that many keys
+const uint KEY_CHUNK_MIN = 1u << 12;
+
+// permute writes its gathered columns behind the permutation, aligned
+const size_t PERM_ALIGN = 16;
+
+int key_chunks(uint n)
 {
-  const unsigned int_size = mi * sizeof(sint), long_size = ml * sizeof(slong),
-      Ulong_size = mul * sizeof(Ulong), real_size = mr * sizeof(realType);
-  if (mi)
+  int nchunks = 1;
+#ifdef MOAB_HAVE_OPENMP
+  nchunks = omp_get_max_threads();
+#endif
+  if ((uint) nchunks > n / KEY_CHUNK_MIN)
+    nchunks = n / KEY_CHUNK_MIN;
+  return nchunks > 1 ? nchunks : 1;
+}
+
+unsigned bit_length(uint64_t v)
+{
+  unsigned bits = 0;
+  for (; v; v >>= 1)
+    ++bits;
+  return bits;
+}
+
+// Bitwise or of all values of a key column
+template<class Value>
+uint64_t key_column_or(const Value *A, uint stride, uint n)
+{
+  Value bitorkey = 0;
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel for reduction(|:bitorkey) if (n >= PARALLEL_SORT_MIN)
+#endif
+  for (long i = 0; i < (long) n; i++)
+    bitorkey |= A[i * (size_t) stride];
+  return bitorkey;
+}
+
+// Stores the keys of a column, shifted by sh, in out (first column), or
+// merges them with the keys already there
+template<class Value>
+void key_column_gather(const Value *A, uint stride, uint n, unsigned sh,
+    bool first, KeyIndex *out)
+{
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel for if (n >= PARALLEL_SORT_MIN)
+#endif
+  for (long i = 0; i < (long) n; i++)
   {
-    uint *p = perm, *pe = p + n;
-    char *sorted = (char *) work;
-    while (p != pe)
-      memcpy((void *) sorted, &vi[mi * (*p++)], int_size), sorted += int_size;
-    memcpy(vi, work, int_size * n);
+    uint64_t v = (uint64_t) A[i * (size_t) stride] << sh;
+    if (first)
+      out[i].v = v, out[i].i = (uint) i;
+    else
+      out[i].v |= v;
   }
-  if (ml)
+}
+
+// Counts the values of the lowest ndigits digits of the keys, in
+// count[digit][value]
+void key_digit_counts(const KeyIndex *src, uint n, unsigned ndigits,
+    int nchunks, std::vector<uint> &count)
+{
+  const uint chunk = (n + nchunks - 1) / nchunks;
+  std::vector<uint> chunk_count(nchunks * KEY_DIGITS * KEY_DIGIT_VALUES, 0);
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel for if (nchunks > 1)
+#endif
+  for (int c = 0; c < nchunks; c++)
   {
-    uint *p = perm, *pe = p + n;
-    char *sorted = (char *) work;
-    while (p != pe)
-      memcpy((void *) sorted, &vl[ml * (*p++)], long_size), sorted += long_size;
-    memcpy(vl, work, long_size * n);
+    uint *cnt = &chunk_count[c * KEY_DIGITS * KEY_DIGIT_VALUES];
+    const KeyIndex *p = src + (size_t) c * chunk;
+    const KeyIndex *pe = src + std::min((size_t) (c + 1) * chunk, (size_t) n);
+    for (; p < pe; ++p)
+    {
+      uint64_t v = p->v;
+      for (unsigned d = 0; d < ndigits; d++, v >>= KEY_DIGIT_BITS)
+        cnt[d * KEY_DIGIT_VALUES + (v & KEY_DIGIT_MASK)]++;
+    }
   }
-  if (mul)
+  count.assign(KEY_DIGITS * KEY_DIGIT_VALUES, 0);
+  for (int c = 0; c < nchunks; c++)
+    for (unsigned j = 0; j < KEY_DIGITS * KEY_DIGIT_VALUES; j++)
+      count[j] += chunk_count[c * KEY_DIGITS * KEY_DIGIT_VALUES + j];
+}
+
+// One stable counting sort pass on the digit at bit sh.  The keys are split
+// in nchunks contiguous chunks, counted and scattered by one thread each;
+// the offsets run over (digit, chunk), so that equal digits keep the order
+// of their chunks.  A single chunk uses the counts of the digit, digit_count,
+// without counting again.  Writes the keys to dst, or only their indices to
+// idx when dst is NULL.
+void key_radix_pass(const KeyIndex *src, uint n, unsigned sh, int nchunks,
+    const uint *digit_count, std::vector<uint> &count, KeyIndex *dst, uint *idx)
+{
+  const uint chunk = (n + nchunks - 1) / nchunks;
+  if (1 == nchunks)
+    count.assign(digit_count, digit_count + KEY_DIGIT_VALUES);
+  else
   {
-    uint *p = perm, *pe = p + n;
-    char *sorted = (char *) work;
-    while (p != pe)
-      memcpy((void *) sorted, &vul[mul * (*p++)], Ulong_size), sorted +=
-          Ulong_size;
-    memcpy(vul, work, Ulong_size * n);
+    count.assign(nchunks * KEY_DIGIT_VALUES, 0);
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int c = 0; c < nchunks; c++)
+    {
+      uint *cnt = &count[c * KEY_DIGIT_VALUES];
+      const KeyIndex *p = src + (size_t) c * chunk;
+      const KeyIndex *pe = src + std::min((size_t) (c + 1) * chunk, (size_t) n);
+      for (; p < pe; ++p)
+        cnt[(p->v >> sh) & KEY_DIGIT_MASK]++;
+    }
   }
-  if (mr)
+  uint sum = 0;
+  for (unsigned d = 0; d < KEY_DIGIT_VALUES; d++)
+    for (int c = 0; c < nchunks; c++)
+    {
+      uint t = count[c * KEY_DIGIT_VALUES + d];
+      count[c * KEY_DIGIT_VALUES + d] = sum;
+      sum += t;
+    }
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel for if (nchunks > 1)
+#endif
+  for (int c = 0; c < nchunks; c++)
   {
-    uint *p = perm, *pe = p + n;
-    char *sorted = (char *) work;
-    while (p != pe)
-      memcpy((void *) sorted, &vr[mr * (*p++)], real_size), sorted += real_size;
-    memcpy(vr, work, real_size * n);
+    uint *off = &count[c * KEY_DIGIT_VALUES];
+    const KeyIndex *p = src + (size_t) c * chunk;
+    const KeyIndex *pe = src + std::min((size_t) (c + 1) * chunk, (size_t) n);
+    if (dst)
+      for (; p < pe; ++p)
+        dst[off[(p->v >> sh) & KEY_DIGIT_MASK]++] = *p;
+    else
+      for (; p < pe; ++p)
+        idx[off[(p->v >> sh) & KEY_DIGIT_MASK]++] = p->i;
   }
 }
 
+// Gathers the m-wide records of v in the order of perm, then copies them
+// back; each record type is moved as such, not with a memcpy per tuple
+template<class T>
+void permute_column(T *v, uint m, uint n, const uint *perm, T *work)
+{
+  if (1 == m)
+  {
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel for if (n >= PARALLEL_SORT_MIN)
+#endif
+    for (long i = 0; i < (long) n; i++)
+      work[i] = v[perm[i]];
+  }
+  else
+  {
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel for if (n >= PARALLEL_SORT_MIN)
+#endif
+    for (long i = 0; i < (long) n; i++)
+    {
+      const T *src = v + (size_t) perm[i] * m;
+      T *dst = work + (size_t) i * m;
+      for (uint j = 0; j < m; j++)
+        dst[j] = src[j];
+    }
+  }
+  memcpy(v, work, (size_t) n * m * sizeof(T));
+}
+
+} // namespace
+
+void TupleList::permute(uint *perm, void *work)
+{
+  if (mi)
+    permute_column(vi, mi, n, perm, (sint*) work);
+  if (ml)
+    permute_column(vl, ml, n, perm, (slong*) work);
+  if (mul)
+    permute_column(vul, mul, n, perm, (Ulong*) work);
+  if (mr)
+    permute_column(vr, mr, n, perm, (realType*) work);
+}
+
 # define umax_2(a, b) (((a)>(b)) ? (a):(b))
 
 ErrorCode TupleList::sort(uint key, TupleList::buffer *buf)
 {
+  if (key >= mi + ml + mul)
+    return MB_NOT_IMPLEMENTED;
+#ifdef MOAB_HAVE_OPENMP
+  if (n >= PARALLEL_SORT_MIN && omp_get_max_threads() > 1)
+    return sort(key, key, buf);
+#endif
+
   const unsigned int_size = mi * sizeof(sint);
   const unsigned long_size = ml * sizeof(slong);
   const unsigned Ulong_size = mul * sizeof(Ulong);
@@ -590,7 +876,8 @@ ErrorCode TupleList::sort(uint key, TupleList::buffer *buf)
     data_size = sizeof(SortData<Ulong> );
 #endif
 
-  uint work_min = n * umax_2(2*data_size,sizeof(sint)+width);
+  const size_t perm_size = (n * sizeof(uint) + PERM_ALIGN - 1) / PERM_ALIGN * PERM_ALIGN;
+  size_t work_min = umax_2((size_t) n * 2 * data_size, perm_size + (size_t) n * width);
   uint *work;
   buf->buffer_reserve(work_min);
   work = (uint *) buf->ptr;
@@ -598,19 +885,122 @@ ErrorCode TupleList::sort(uint key, TupleList::buffer *buf)
     index_sort((uint *) &vi[key], n, mi, work, (SortData<uint>*) work);
   else if (key < mi + ml)
     index_sort((long*) &vl[key - mi], n, ml, work, (SortData<long>*) work);
-  else if (key < mi + ml + mul)
+  else
     index_sort((Ulong*) &vul[key - mi - ml], n, mul, work,
         (SortData<Ulong>*) work);
-  else
-    return MB_NOT_IMPLEMENTED;
 
-  permute(work, work + n);
+  permute(work, buf->ptr + perm_size);
 
   if (!writeEnabled)
     last_sorted = key;
   return MB_SUCCESS;
 }
 
+ErrorCode TupleList::sort(uint key1, uint key2, TupleList::buffer *buf)
+{
+  if (key1 >= mi + ml + mul || key2 >= mi + ml + mul)
+    return MB_NOT_IMPLEMENTED;
+  ErrorCode rval = radix_sort64(key1, key2, buf);
+  if (MB_SUCCESS != rval)
+    return rval;
+
+  if (!writeEnabled)
+    last_sorted = key1;
+  return MB_SUCCESS;
+}
+
+/* LSD radix sort on 64 bit keys: the significant bits of key1 are put above
+ * those of key2 (key1 alone if key1 == key2), and the combined key is sorted
+ * with 8 bit digits, skipping the digits that are equal in all keys.  The
+ * pairs (key, index) ping-pong between the two halves of buf, and the last
+ * pass writes the permutation only, which is then applied to each column. */
+ErrorCode TupleList::radix_sort64(uint key1, uint key2, TupleList::buffer *buf)
+{
+  if (n == 0)
+    return MB_SUCCESS;
+
+  uint keys[2] = { key2, key1 };
+  const int nkeys = key1 == key2 ? 1 : 2;
+  unsigned bits[2];
+  for (int k = 0; k < nkeys; k++)
+  {
+    if (keys[k] < mi)
+      bits[k] = bit_length(key_column_or((uint*) &vi[keys[k]], mi, n));
+    else if (keys[k] < mi + ml)
+      bits[k] = bit_length(key_column_or((unsigned long*) &vl[keys[k] - mi], ml, n));
+    else
+      bits[k] = bit_length(key_column_or(&vul[keys[k] - mi - ml], mul, n));
+  }
+  // keys too wide to be packed: two stable sorts
+  if (2 == nkeys && bits[0] + bits[1] > 64)
+  {
+    ErrorCode rval = radix_sort64(key2, key2, buf);
+    if (MB_SUCCESS != rval)
+      return rval;
+    return radix_sort64(key1, key1, buf);
+  }
+
+  const unsigned width = umax_2(umax_2(mi * sizeof(sint), ml * sizeof(slong)),
+      umax_2(mul * sizeof(Ulong), mr * sizeof(realType)));
+  const size_t perm_size = (n * sizeof(uint) + PERM_ALIGN - 1) / PERM_ALIGN * PERM_ALIGN;
+  buf->buffer_reserve(umax_2((size_t) n * 2 * sizeof(KeyIndex),
+      perm_size + (size_t) n * width));
+  KeyIndex *src = (KeyIndex*) buf->ptr, *dst = src + n;
+
+  unsigned sh = 0;
+  for (int k = 0; k < nkeys; k++)
+  {
+    // an all zero key1 adds nothing, and may not be shifted by 64 bits
+    if (k && !bits[k])
+      continue;
+    if (keys[k] < mi)
+      key_column_gather((uint*) &vi[keys[k]], mi, n, sh, 0 == k, src);
+    else if (keys[k] < mi + ml)
+      key_column_gather((unsigned long*) &vl[keys[k] - mi], ml, n, sh, 0 == k, src);
+    else
+      key_column_gather(&vul[keys[k] - mi - ml], mul, n, sh, 0 == k, src);
+    sh += bits[k];
+  }
+
+  // skip the digits above the highest bit, and those equal in all keys
+  const int nchunks = key_chunks(n);
+  const unsigned ndigits = (sh + KEY_DIGIT_BITS - 1) / KEY_DIGIT_BITS;
+  std::vector<uint> digit_count;
+  key_digit_counts(src, n, ndigits, nchunks, digit_count);
+  unsigned pass_digit[KEY_DIGITS], digits = 0;
+  for (unsigned d = 0; d < ndigits; d++)
+  {
+    const uint *dc = &digit_count[d * KEY_DIGIT_VALUES];
+    if (*std::max_element(dc, dc + KEY_DIGIT_VALUES) != n)
+      pass_digit[digits++] = d;
+  }
+
+  uint *perm = (uint*) buf->ptr;
+  if (0 == digits)
+  {
+    for (uint i = 0; i < n; i++)
+      perm[i] = i;
+  }
+  else
+  {
+    std::vector<uint> count;
+    for (unsigned d = 0; d + 1 < digits; d++)
+    {
+      key_radix_pass(src, n, pass_digit[d] * KEY_DIGIT_BITS, nchunks,
+          &digit_count[pass_digit[d] * KEY_DIGIT_VALUES], count, dst, NULL);
+      std::swap(src, dst);
+    }
+    const unsigned d = pass_digit[digits - 1];
+    key_radix_pass(src, n, d * KEY_DIGIT_BITS, nchunks,
+        &digit_count[d * KEY_DIGIT_VALUES], count, NULL, (uint*) dst);
+    if ((char*) dst != buf->ptr)
+      memcpy(perm, dst, n * sizeof(uint));
+  }
+
+  permute(perm, buf->ptr + perm_size);
+  return MB_SUCCESS;
+}
+
 #undef umax_2
 
 #define DIGIT_BITS   8
@@ -10,6 +10,11 @@ EntitySequence* VertexSequence::split( EntityHandle here )
 SequenceData* VertexSequence::create_data_subset( EntityHandle start,
                                                   EntityHandle end ) const
 {
+  if (floatCoords) {
+    const int sizes[] = { sizeof(float), sizeof(float), sizeof(float) };
+    return new FloatVertexData(static_cast<const FloatVertexData*>(data()), start, end, sizes);
+  }
+
   const int sizes[] = { sizeof(double), sizeof(double), sizeof(double) };
   return data()->subset(start, end, sizes );
 }
@@ -22,7 +27,7 @@ ErrorCode VertexSequence::push_front( EntityID count )
 
 void VertexSequence::get_const_memory_use( unsigned long& per_ent, unsigned long& seq ) const
 {
-  per_ent = 3 * sizeof(double);
+  per_ent = 3 * (floatCoords ? sizeof(float) : sizeof(double));
   seq = sizeof(*this);
 }
 
@@ -6,6 +6,35 @@
 
 namespace moab {
 
+/**\brief Vertex coordinate arrays stored in single precision */
+class FloatVertexData : public SequenceData
+{
+public:
+
+  FloatVertexData( EntityHandle start, EntityHandle end )
+    : SequenceData( 3, start, end )
+    {
+      create_sequence_data( 0, sizeof(float) );
+      create_sequence_data( 1, sizeof(float) );
+      create_sequence_data( 2, sizeof(float) );
+    }
+
+  FloatVertexData( const FloatVertexData* subset_from,
+                   EntityHandle start,
+                   EntityHandle end,
+                   const int* sequence_data_sizes )
+    : SequenceData( subset_from, start, end, sequence_data_sizes )
+    {}
+};
+
+/**\brief Vertices, with coordinates stored as three arrays
+ *
+ * Coordinates are stored in double precision, or in single precision
+ * if the SequenceData is a FloatVertexData.  Accessors taking and
+ * returning values convert between the two; accessors returning
+ * pointers to the arrays fail with MB_TYPE_OUT_OF_RANGE if the
+ * storage is not of the requested type.
+ */
 class VertexSequence : public EntitySequence
 {
 public:
@@ -13,21 +42,40 @@ public:
   VertexSequence( EntityHandle start,
                   EntityID count,
                   SequenceData* dat )
-    : EntitySequence( start, count, dat )
+    : EntitySequence( start, count, dat ),
+      floatCoords( 0 != dynamic_cast<FloatVertexData*>(dat) )
     {}
 
   VertexSequence( EntityHandle start,
                   EntityID count,
-                  EntityID data_size )
-    : EntitySequence( start, count, new SequenceData( 3, start, start+data_size-1 ) )
+                  EntityID data_size,
+                  bool float_coords = false )
+    : EntitySequence( start, count, float_coords ?
+                        new FloatVertexData( start, start+data_size-1 ) :
+                        new SequenceData( 3, start, start+data_size-1 ) ),
+      floatCoords( float_coords )
     {
-      data()->create_sequence_data( X, sizeof(double) );
-      data()->create_sequence_data( Y, sizeof(double) );
-      data()->create_sequence_data( Z, sizeof(double) );
+      if (!float_coords) {
+        data()->create_sequence_data( X, sizeof(double) );
+        data()->create_sequence_data( Y, sizeof(double) );
+        data()->create_sequence_data( Z, sizeof(double) );
+      }
     }
 
   virtual ~VertexSequence();
 
+    //! Value of values_per_entity() for sequences storing coordinates in
+    //! single precision, so that vertices are only allocated in unused
+    //! space of SequenceData with the same precision
+  enum { FLOAT_COORDS = 1 };
+
+    //! True if coordinates are stored in single precision
+  bool float_coordinates() const
+    { return floatCoords; }
+
+  int values_per_entity() const
+    { return floatCoords ? (int)FLOAT_COORDS : 0; }
+
   inline ErrorCode get_coordinates( EntityHandle handle,
                                       double& x,
                                       double& y,
@@ -57,6 +105,14 @@ public:
                                             const double*& y,
                                             const double*& z ) const;
 
+  inline ErrorCode get_coordinate_arrays( float*& x,
+                                            float*& y,
+                                            float*& z );
+
+  inline ErrorCode get_coordinate_arrays( const float*& x,
+                                            const float*& y,
+                                            const float*& z ) const;
+
   EntitySequence* split( EntityHandle here );
 
   SequenceData* create_data_subset( EntityHandle start, EntityHandle end ) const;
@@ -81,6 +137,16 @@ private:
     return reinterpret_cast<const double*>(data()->get_sequence_data( coord ));
   }
 
+  inline float* float_array( Coord coord )
+  {
+    return reinterpret_cast<float*>(data()->get_sequence_data( coord ));
+  }
+
+  inline const float* float_array( Coord coord ) const
+  {
+    return reinterpret_cast<const float*>(data()->get_sequence_data( coord ));
+  }
+
   inline double* x_array() { return array(X); }
   inline double* y_array() { return array(Y); }
   inline double* z_array() { return array(Z); }
@@ -90,8 +156,11 @@ private:
   inline const double* z_array() const { return array(Z); }
 
   VertexSequence( VertexSequence& split_from, EntityHandle here )
-    : EntitySequence( split_from, here )
+    : EntitySequence( split_from, here ),
+      floatCoords( split_from.floatCoords )
     {}
+
+  bool floatCoords;
 };
 
 
@@ -101,6 +170,12 @@ ErrorCode VertexSequence::get_coordinates( EntityHandle handle,
                                              double& z ) const
 {
   EntityID offset = handle - data()->start_handle();
+  if (floatCoords) {
+    x = float_array(X)[offset];
+    y = float_array(Y)[offset];
+    z = float_array(Z)[offset];
+    return MB_SUCCESS;
+  }
   x = x_array()[offset];
   y = y_array()[offset];
   z = z_array()[offset];
@@ -110,11 +185,7 @@ ErrorCode VertexSequence::get_coordinates( EntityHandle handle,
 ErrorCode VertexSequence::get_coordinates( EntityHandle handle,
                                              double coords[3] ) const
 {
-  EntityID offset = handle - data()->start_handle();
-  coords[X] = x_array()[offset];
-  coords[Y] = y_array()[offset];
-  coords[Z] = z_array()[offset];
-  return MB_SUCCESS;
+  return get_coordinates( handle, coords[X], coords[Y], coords[Z] );
 }
 
 
@@ -123,6 +194,8 @@ ErrorCode VertexSequence::get_coordinates_ref( EntityHandle handle,
                                                  const double*& y,
                                                  const double*& z ) const
 {
+  if (floatCoords)
+    return MB_TYPE_OUT_OF_RANGE;
   EntityID offset = handle - data()->start_handle();
   x = x_array()+offset;
   y = y_array()+offset;
@@ -136,6 +209,12 @@ ErrorCode VertexSequence::set_coordinates( EntityHandle entity,
                                              double z )
 {
   EntityID offset = entity - data()->start_handle();
+  if (floatCoords) {
+    float_array(X)[offset] = (float)x;
+    float_array(Y)[offset] = (float)y;
+    float_array(Z)[offset] = (float)z;
+    return MB_SUCCESS;
+  }
   x_array()[offset] = x;
   y_array()[offset] = y;
   z_array()[offset] = z;
@@ -145,17 +224,15 @@ ErrorCode VertexSequence::set_coordinates( EntityHandle entity,
 ErrorCode VertexSequence::set_coordinates( EntityHandle entity,
                                              const double* xyz )
 {
-  EntityID offset = entity - data()->start_handle();
-  x_array()[offset] = xyz[0];
-  y_array()[offset] = xyz[1];
-  z_array()[offset] = xyz[2];
-  return MB_SUCCESS;
+  return set_coordinates( entity, xyz[0], xyz[1], xyz[2] );
 }
 
 ErrorCode VertexSequence::get_coordinate_arrays( double*& x,
                                                    double*& y,
                                                    double*& z )
 {
+  if (floatCoords)
+    return MB_TYPE_OUT_OF_RANGE;
   EntityID offset = start_handle() - data()->start_handle();
   x = x_array()+offset;
   y = y_array()+offset;
@@ -170,6 +247,32 @@ ErrorCode VertexSequence::get_coordinate_arrays( const double*& x,
   return get_coordinates_ref( start_handle(), x, y, z );
 }
 
+ErrorCode VertexSequence::get_coordinate_arrays( float*& x,
+                                                   float*& y,
+                                                   float*& z )
+{
+  if (!floatCoords)
+    return MB_TYPE_OUT_OF_RANGE;
+  EntityID offset = start_handle() - data()->start_handle();
+  x = float_array(X)+offset;
+  y = float_array(Y)+offset;
+  z = float_array(Z)+offset;
+  return MB_SUCCESS;
+}
+
+ErrorCode VertexSequence::get_coordinate_arrays( const float*& x,
+                                                   const float*& y,
+                                                   const float*& z ) const
+{
+  if (!floatCoords)
+    return MB_TYPE_OUT_OF_RANGE;
+  EntityID offset = start_handle() - data()->start_handle();
+  x = float_array(X)+offset;
+  y = float_array(Y)+offset;
+  z = float_array(Z)+offset;
+  return MB_SUCCESS;
+}
+
 } // namespace moab
 
 #endif
@@ -33,6 +33,7 @@
 #include <errno.h>
 #include <assert.h>
 #include <iostream>
+#include <algorithm>
 
 #ifdef WIN32
   #define stat _stat
@@ -137,6 +138,24 @@ ErrorCode WriteUtil::get_node_coords(const int num_arrays,
   return result;
 }
 
+//! Copy one coordinate array, or all three interleaved, to \c output
+template <typename T>
+static void copy_coords(T* const coord_array[3], int which_array,
+                        size_t offset, size_t count, double* output)
+{
+  if (-1 != which_array) {
+    std::copy(coord_array[which_array] + offset,
+              coord_array[which_array] + offset + count, output);
+    return;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    *output = coord_array[0][i + offset]; output++;
+    *output = coord_array[1][i + offset]; output++;
+    *output = coord_array[2][i + offset]; output++;
+  }
+}
+
 ErrorCode WriteUtil::get_node_coords(const int which_array, /* 0->X, 1->Y, 2->Z, -1->all */
                                      Range::const_iterator iter,
                                      const Range::const_iterator& end,
@@ -186,27 +205,22 @@ ErrorCode WriteUtil::get_node_coords(const int which_array, /* 0->X, 1->Y, 2->Z,
     assert(*iter >= (*seq_iter)->start_handle());
     EntityHandle offset = *iter - (*seq_iter)->start_handle();
 
-    // Get coordinate arrays from sequence
-    double* coord_array[3];
-    static_cast<VertexSequence*>(*seq_iter)
-      ->get_coordinate_arrays(coord_array[0], coord_array[1], coord_array[2]);
-
-    // Copy data to output buffer
-    if (-1 != which_array) {
-      if (output_iter + count > output_end)
-        return MB_FAILURE;
-      memcpy(output_iter, coord_array[which_array] + offset, count * sizeof(double));
-      output_iter += count;
+    // Copy data from the coordinate arrays of the sequence to the output buffer
+    const size_t num_values = (-1 == which_array ? 3 : 1) * count;
+    if (output_iter + num_values > output_end)
+      return MB_FAILURE;
+    VertexSequence* vseq = static_cast<VertexSequence*>(*seq_iter);
+    if (vseq->float_coordinates()) {
+      float* coord_array[3];
+      vseq->get_coordinate_arrays(coord_array[0], coord_array[1], coord_array[2]);
+      copy_coords(coord_array, which_array, offset, count, output_iter);
     }
     else {
-      if (output_iter + 3*count > output_end)
-        return MB_FAILURE;
-      for (unsigned int i = 0; i < count; i++) {
-        *output_iter = coord_array[0][i + offset]; output_iter++;
-        *output_iter = coord_array[1][i + offset]; output_iter++;
-        *output_iter = coord_array[2][i + offset]; output_iter++;
-      }
+      double* coord_array[3];
+      vseq->get_coordinate_arrays(coord_array[0], coord_array[1], coord_array[2]);
+      copy_coords(coord_array, which_array, offset, count, output_iter);
     }
+    output_iter += num_values;
 
     // Iterate
     iter += count;
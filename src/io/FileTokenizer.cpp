@@ -318,10 +318,12 @@ void FileTokenizer::unget_token()
   --nextToken;
   *nextToken = lastChar;
   --nextToken;
-  while (nextToken > buffer && *nextToken)
+    // Stop at the whitespace preceding the token rather than at the
+    // terminator of the previous token: binary data may lie between them.
+  while (nextToken > buffer && *nextToken && !isspace(static_cast<unsigned char>(*nextToken)))
     --nextToken;
 
-  if (!*nextToken)
+  if (!*nextToken || isspace(static_cast<unsigned char>(*nextToken)))
     ++nextToken;
 
   lastChar = '\0';
@@ -430,7 +432,7 @@ bool FileTokenizer::get_binary(size_t size, void* mem)
   if (nextToken != bufferEnd) {
     // If requested size is less than buffer contents,
     // just pass back part of the buffer
-    if (bufferEnd - nextToken <= (int)size) {
+    if ((size_t)(bufferEnd - nextToken) >= size) {
       memcpy(mem, nextToken, size);
       nextToken += size;
       return true;
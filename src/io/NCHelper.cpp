@@ -6,6 +6,7 @@
 #include "NCHelperGCRM.hpp"
 
 #include <sstream>
+#include <algorithm>
 
 #include "MBTagConventions.hpp"
 
@@ -637,6 +638,132 @@ ErrorCode NCHelper::get_tag_to_nonset(ReadNC::VarData& var_data, int tstep_num,
   return rval;
 }
 
+ErrorCode NCHelper::read_timestep(ReadNC::VarData& var_data, int tstep_num, Range* localGid, int gid_dim,
+                                  double* buffer)
+{
+  int success;
+
+  // Set readStart for this timestep along time dimension
+  var_data.readStarts[0] = tstep_num;
+
+  if (NULL == localGid) {
+    // The local part of a scd mesh is read as one block
+    success = NCFUNCAG(_vara_double)(_fileId, var_data.varId, &var_data.readStarts[0], &var_data.readCounts[0], buffer);
+    if (success)
+      MB_SET_ERR(MB_FAILURE, "Failed to read float/double data for variable " << var_data.varName);
+
+    return MB_SUCCESS;
+  }
+
+  // For ucd mesh, we need one read per subrange of the local global ids
+  size_t indexInDoubleArray = 0;
+  for (Range::pair_iterator pair_iter = localGid->pair_begin();
+      pair_iter != localGid->pair_end();
+      ++pair_iter) {
+    EntityHandle starth = pair_iter->first;
+    EntityHandle endh = pair_iter->second; // Inclusive
+    var_data.readStarts[gid_dim] = (NCDF_SIZE) (starth - 1);
+    var_data.readCounts[gid_dim] = (NCDF_SIZE) (endh - starth + 1);
+
+    success = NCFUNCAG(_vara_double)(_fileId, var_data.varId,
+        &(var_data.readStarts[0]), &(var_data.readCounts[0]),
+                    buffer + indexInDoubleArray);
+    if (success)
+      MB_SET_ERR(MB_FAILURE, "Failed to read double data in a loop for variable " << var_data.varName);
+    // We need to increment the index in double array for the
+    // next subrange
+    indexInDoubleArray += (endh - starth + 1) * 1 * var_data.numLev;
+  }
+
+  return MB_SUCCESS;
+}
+
+#ifdef MOAB_HAVE_PNETCDF
+ErrorCode NCHelper::post_timestep_reads(ReadNC::VarData& var_data, int tstep_num, Range* localGid, int gid_dim,
+                                        double* buffer, std::vector<int>& requests)
+{
+  int success;
+
+  // Set readStart for this timestep along time dimension
+  var_data.readStarts[0] = tstep_num;
+
+  if (NULL == localGid) {
+    // The local part of a scd mesh is read as one block
+    requests.push_back(NC_REQ_NULL);
+    success = NCFUNCREQG(_vara_double)(_fileId, var_data.varId, &var_data.readStarts[0], &var_data.readCounts[0],
+                                      buffer, &requests.back());
+    if (success)
+      MB_SET_ERR(MB_FAILURE, "Failed to post read of float/double data for variable " << var_data.varName);
+
+    return MB_SUCCESS;
+  }
+
+  // For ucd mesh, we need one read per subrange of the local global ids
+  size_t indexInDoubleArray = 0;
+  size_t idxReq = requests.size();
+  requests.resize(idxReq + localGid->psize());
+  for (Range::pair_iterator pair_iter = localGid->pair_begin();
+      pair_iter != localGid->pair_end();
+      ++pair_iter) {
+    EntityHandle starth = pair_iter->first;
+    EntityHandle endh = pair_iter->second; // Inclusive
+    var_data.readStarts[gid_dim] = (NCDF_SIZE) (starth - 1);
+    var_data.readCounts[gid_dim] = (NCDF_SIZE) (endh - starth + 1);
+
+    success = NCFUNCREQG(_vara_double)(_fileId, var_data.varId,
+        &(var_data.readStarts[0]), &(var_data.readCounts[0]),
+                    buffer + indexInDoubleArray, &requests[idxReq++]);
+    if (success)
+      MB_SET_ERR(MB_FAILURE, "Failed to read double data in a loop for variable " << var_data.varName);
+    // We need to increment the index in double array for the
+    // next subrange
+    indexInDoubleArray += (endh - starth + 1) * 1 * var_data.numLev;
+  }
+
+  return MB_SUCCESS;
+}
+
+ErrorCode NCHelper::wait_timestep_reads(std::vector<int>& requests)
+{
+  // Every process has to participate, even with no pending requests
+  std::vector<int> statuss(requests.size());
+  int success = NCFUNC(wait_all)(_fileId, requests.size(), requests.empty() ? NULL : &requests[0],
+                                 statuss.empty() ? NULL : &statuss[0]);
+  if (success)
+    MB_SET_ERR(MB_FAILURE, "Failed on wait_all");
+  requests.clear();
+
+  return MB_SUCCESS;
+}
+#endif
+
+void NCHelper::report_read_buffers(const std::vector<ReadNC::VarData>& vdatas, std::size_t peak_bytes)
+{
+  DebugOutput& dbgOut = _readNC->dbgOut;
+
+  std::size_t copy_bytes = 0;
+  for (unsigned int i = 0; i < vdatas.size(); i++) {
+    // Element size of the tag the variable is read into
+    std::size_t elem_size;
+    switch (vdatas[i].varDataType) {
+      case NC_BYTE:
+      case NC_CHAR:
+        elem_size = 1;
+        break;
+      case NC_SHORT:
+      case NC_INT:
+        elem_size = sizeof(int);
+        break;
+      default:
+        elem_size = sizeof(double);
+    }
+    copy_bytes = std::max(copy_bytes, vdatas[i].sz * elem_size);
+  }
+
+  dbgOut.tprintf(1, "Peak temporary buffer for reading variables: %lu bytes, instead of %lu bytes for a copy of one timestep\n",
+                 (unsigned long) peak_bytes, (unsigned long) copy_bytes);
+}
+
 ErrorCode NCHelper::create_attrib_string(const std::map<std::string, ReadNC::AttData>& attMap, std::string& attVal, std::vector<int>& attLen)
 {
   int success;
@@ -1097,17 +1224,36 @@ ErrorCode ScdNCHelper::read_scd_variables_to_nonset(std::vector<ReadNC::VarData>
 
   ErrorCode rval = read_scd_variables_to_nonset_allocate(vdatas, tstep_nums);MB_CHK_SET_ERR(rval, "Trouble allocating space to read non-set variables");
 
-  // Finally, read into that space
+  // Finally, read into that space; every timestep is read as one block straight into tag storage,
+  // and transposed there, so no temporary copy of the variable is needed
   int success;
+  std::vector<bool> visited;
+  std::size_t peak_bytes = 0;
   for (unsigned int i = 0; i < vdatas.size(); i++) {
-    std::size_t sz = vdatas[i].sz;
-
     // A typical supported variable: float T(time, lev, lat, lon)
     // For tag values, need transpose (lev, lat, lon) to (lat, lon, lev)
     size_t ni = vdatas[i].readCounts[3]; // lon or slon
     size_t nj = vdatas[i].readCounts[2]; // lat or slat
     size_t nk = vdatas[i].readCounts[1]; // lev
 
+#ifdef MOAB_HAVE_PNETCDF
+    if (_readNC->prefetchTimesteps && (NC_FLOAT == vdatas[i].varDataType || NC_DOUBLE == vdatas[i].varDataType)) {
+      // The reads of all timesteps are posted into tag storage first, so that PnetCDF services
+      // them in one collective wait instead of one per timestep
+      std::vector<int> requests;
+      for (unsigned int t = 0; t < tstep_nums.size(); t++) {
+        rval = post_timestep_reads(vdatas[i], tstep_nums[t], NULL, 0, (double*) vdatas[i].varDatas[t], requests);MB_CHK_SET_ERR(rval, "Trouble posting reads for variable " << vdatas[i].varName);
+      }
+      rval = wait_timestep_reads(requests);MB_CHK_SET_ERR(rval, "Trouble waiting for reads of variable " << vdatas[i].varName);
+
+      // Transpose (lev, lat, lon) to (lat, lon, lev)
+      for (unsigned int t = 0; t < tstep_nums.size(); t++)
+        peak_bytes = std::max(peak_bytes, transpose_in_place((double*) vdatas[i].varDatas[t], nk, ni * nj, visited));
+
+      continue;
+    }
+#endif
+
     for (unsigned int t = 0; t < tstep_nums.size(); t++) {
       // Tag data for this timestep
       void* data = vdatas[i].varDatas[t];
@@ -1118,50 +1264,29 @@ ErrorCode ScdNCHelper::read_scd_variables_to_nonset(std::vector<ReadNC::VarData>
       switch (vdatas[i].varDataType) {
         case NC_BYTE:
         case NC_CHAR: {
-          std::vector<char> tmpchardata(sz);
           success = NCFUNCAG(_vara_text)(_fileId, vdatas[i].varId, &vdatas[i].readStarts[0], &vdatas[i].readCounts[0],
-                                        &tmpchardata[0]);
+                                        (char*) data);
           if (success)
             MB_SET_ERR(MB_FAILURE, "Failed to read byte/char data for variable " << vdatas[i].varName);
-          if (vdatas[i].numLev > 1)
-            // Transpose (lev, lat, lon) to (lat, lon, lev)
-            kji_to_jik(ni, nj, nk, data, &tmpchardata[0]);
-          else {
-            for (std::size_t idx = 0; idx != tmpchardata.size(); idx++)
-              ((char*) data)[idx] = tmpchardata[idx];
-          }
+          // Transpose (lev, lat, lon) to (lat, lon, lev)
+          peak_bytes = std::max(peak_bytes, transpose_in_place((char*) data, nk, ni * nj, visited));
           break;
         }
         case NC_SHORT:
         case NC_INT: {
-          std::vector<int> tmpintdata(sz);
           success = NCFUNCAG(_vara_int)(_fileId, vdatas[i].varId, &vdatas[i].readStarts[0], &vdatas[i].readCounts[0],
-                                        &tmpintdata[0]);
+                                        (int*) data);
           if (success)
             MB_SET_ERR(MB_FAILURE, "Failed to read short/int data for variable " << vdatas[i].varName);
-          if (vdatas[i].numLev > 1)
-            // Transpose (lev, lat, lon) to (lat, lon, lev)
-            kji_to_jik(ni, nj, nk, data, &tmpintdata[0]);
-          else {
-            for (std::size_t idx = 0; idx != tmpintdata.size(); idx++)
-              ((int*) data)[idx] = tmpintdata[idx];
-          }
+          // Transpose (lev, lat, lon) to (lat, lon, lev)
+          peak_bytes = std::max(peak_bytes, transpose_in_place((int*) data, nk, ni * nj, visited));
           break;
         }
         case NC_FLOAT:
         case NC_DOUBLE: {
-          std::vector<double> tmpdoubledata(sz);
-          success = NCFUNCAG(_vara_double)(_fileId, vdatas[i].varId, &vdatas[i].readStarts[0], &vdatas[i].readCounts[0],
-                                          &tmpdoubledata[0]);
-          if (success)
-            MB_SET_ERR(MB_FAILURE, "Failed to read float/double data for variable " << vdatas[i].varName);
-          if (vdatas[i].numLev > 1)
-            // Transpose (lev, lat, lon) to (lat, lon, lev)
-            kji_to_jik(ni, nj, nk, data, &tmpdoubledata[0]);
-          else {
-            for (std::size_t idx = 0; idx != tmpdoubledata.size(); idx++)
-              ((double*) data)[idx] = tmpdoubledata[idx];
-          }
+          rval = read_timestep(vdatas[i], tstep_nums[t], NULL, 0, (double*) data);MB_CHK_SET_ERR(rval, "Trouble reading variable " << vdatas[i].varName);
+          // Transpose (lev, lat, lon) to (lat, lon, lev)
+          peak_bytes = std::max(peak_bytes, transpose_in_place((double*) data, nk, ni * nj, visited));
           break;
         }
         default:
@@ -1177,6 +1302,7 @@ ErrorCode ScdNCHelper::read_scd_variables_to_nonset(std::vector<ReadNC::VarData>
       dbgOut.printf(1, ", %s ", vdatas[i].varName.c_str());
     dbgOut.tprintf(1, "\n");
   }
+  report_read_buffers(vdatas, peak_bytes);
 
   return rval;
 }
@@ -11,6 +11,8 @@
 
 #include "ReadNC.hpp"
 
+#include <algorithm>
+
 #ifdef WIN32
 #ifdef size_t
 #undef size_t
@@ -61,6 +63,97 @@ protected:
 
   ErrorCode get_tag_to_nonset(ReadNC::VarData& var_data, int tstep_num, Tag& tagh, int num_lev);
 
+  //! Read a float/double non-set variable for one timestep into buffer (of var_data.sz values),
+  //! one read per subrange of localGid along dimension gid_dim, or a single read for the whole
+  //! local block if localGid is NULL (scd mesh); when the file ordering matches the tag layout,
+  //! buffer can be the tag storage itself, which avoids a temporary copy
+  ErrorCode read_timestep(ReadNC::VarData& var_data, int tstep_num, Range* localGid, int gid_dim,
+                          double* buffer);
+
+#ifdef MOAB_HAVE_PNETCDF
+  //! Nonblocking version of read_timestep(); the requests are appended to requests, so that the
+  //! reads of several timesteps are serviced by one wait_timestep_reads(), which is where PnetCDF
+  //! does the actual I/O; buffer must stay valid until then
+  ErrorCode post_timestep_reads(ReadNC::VarData& var_data, int tstep_num, Range* localGid, int gid_dim,
+                                double* buffer, std::vector<int>& requests);
+
+  //! Wait for the requests posted by post_timestep_reads() (collective)
+  ErrorCode wait_timestep_reads(std::vector<int>& requests);
+#endif
+
+  //! Transpose in place the nrows x ncols row-major block in data, e.g. (lev, ncol) read from the
+  //! file to the (ncol, lev) tag layout, so that the block can be read straight into tag storage;
+  //! columns are moved in chunks sized so that an nrows-high tile of them fits a small scratch
+  //! buffer, where it is transposed; visited keeps one bit per chunk. Returns the bytes of
+  //! temporary storage used
+  template <typename T> static std::size_t transpose_in_place(T* data, std::size_t nrows, std::size_t ncols,
+                                                              std::vector<bool>& visited)
+  {
+    if (nrows < 2 || ncols < 2)
+      return 0;
+    const std::size_t tile_bytes = 32768;
+    std::size_t nb = std::max((std::size_t) 1, std::min(ncols, tile_bytes / (sizeof(T) * nrows)));
+    std::size_t nc = ncols / nb, rem = ncols - nc * nb;
+    std::vector<T> tile(nrows * nb);
+
+    // Columns that do not fill a chunk go to an nrows x rem block after the chunks
+    if (rem)
+      split_rows(data, nrows, nc * nb, rem);
+
+    // Transpose the nrows x nc matrix of chunks; the chunk at position p moves to
+    // p * nrows mod (n - 1), the first and last ones stay
+    std::size_t n = nrows * nc;
+    visited.assign(n, false);
+    if (nc > 1) {
+      T* val = &tile[0];
+      for (std::size_t start = 1; start < n - 1; start++) {
+        if (visited[start])
+          continue;
+        std::copy(data + start * nb, data + (start + 1) * nb, val);
+        std::size_t p = start;
+        do {
+          p = (p * nrows) % (n - 1);
+          std::swap_ranges(val, val + nb, data + p * nb);
+          visited[p] = true;
+        } while (p != start);
+      }
+    }
+
+    // Every nrows x nb tile of chunks is now contiguous, transpose it through the scratch buffer
+    for (std::size_t b = 0; b < nc; b++)
+      transpose_tile(data + b * nrows * nb, nrows, nb, &tile[0]);
+    if (rem)
+      transpose_tile(data + n * nb, nrows, rem, &tile[0]);
+
+    return tile.capacity() * sizeof(T) + visited.capacity() / 8;
+  }
+
+  //! Reorder nrows rows of na then nt values, [a0 t0 a1 t1 ...], to [a0 a1 ... t0 t1 ...]
+  template <typename T> static void split_rows(T* data, std::size_t nrows, std::size_t na, std::size_t nt)
+  {
+    if (nrows < 2)
+      return;
+    std::size_t h = nrows / 2;
+    split_rows(data, h, na, nt);
+    split_rows(data + h * (na + nt), nrows - h, na, nt);
+    // [A1 T1 A2 T2] to [A1 A2 T1 T2]
+    std::rotate(data + h * na, data + h * (na + nt), data + h * (na + nt) + (nrows - h) * na);
+  }
+
+  //! Transpose the nrows x ncols row-major block in data through scratch, of at least nrows * ncols values
+  template <typename T> static void transpose_tile(T* data, std::size_t nrows, std::size_t ncols, T* scratch)
+  {
+    std::copy(data, data + nrows * ncols, scratch);
+    for (std::size_t j = 0; j < ncols; j++)
+      for (std::size_t i = 0; i < nrows; i++)
+        data[j * nrows + i] = scratch[i * ncols + j];
+  }
+
+  //! Debug output of the largest temporary buffer used to read non-set variables, next to the
+  //! copy of one timestep of the largest variable, in its tag element size, that reading through
+  //! a buffer would need
+  void report_read_buffers(const std::vector<ReadNC::VarData>& vdatas, std::size_t peak_bytes);
+
   //! Create a character string attString of attMap. with '\0'
   //! terminating each attribute name, ';' separating the data type
   //! and value, and ';' separating one name/data type/value from
@@ -230,6 +323,21 @@ protected:
     }
   }
 
+  //! In-place version of kji_to_jik_stride(), for data read straight into tag storage: the
+  //! (lev, subrange) block of each subrange of localGid is transposed to (subrange, lev); returns
+  //! the bytes of temporary storage used
+  template <typename T> std::size_t kji_to_jik_stride_in_place(size_t nk, T* data, Range& localGid, std::vector<bool>& visited)
+  {
+    std::size_t idxInData = 0, bytes = 0;
+    for (Range::pair_iterator pair_iter = localGid.pair_begin();
+        pair_iter != localGid.pair_end(); ++pair_iter) {
+      std::size_t size_range = pair_iter->second - pair_iter->first + 1;
+      bytes = std::max(bytes, transpose_in_place(data + idxInData, nk, size_range, visited));
+      idxInData += size_range * nk;
+    }
+    return bytes;
+  }
+
   //! Dimensions of global grid in file
   int nCells;
   int nEdges;
@@ -9,6 +9,7 @@
 #endif
 
 #include <cmath>
+#include <algorithm>
 
 namespace moab {
 
@@ -510,7 +511,7 @@ ErrorCode NCHelperGCRM::read_ucd_variables_to_nonset_async(std::vector<ReadNC::V
   ErrorCode rval = read_ucd_variables_to_nonset_allocate(vdatas, tstep_nums);MB_CHK_SET_ERR(rval, "Trouble allocating space to read non-set variables");
 
   // Finally, read into that space
-  int success;
+  bool& prefetchTimesteps = _readNC->prefetchTimesteps;
   Range* pLocalGid = NULL;
 
   for (unsigned int i = 0; i < vdatas.size(); i++) {
@@ -532,64 +533,20 @@ ErrorCode NCHelperGCRM::read_ucd_variables_to_nonset_async(std::vector<ReadNC::V
         MB_SET_ERR(MB_FAILURE, "Unexpected entity location type for variable " << vdatas[i].varName);
     }
 
-    std::size_t sz = vdatas[i].sz;
+    // Read float as double
+    if (NC_FLOAT != vdatas[i].varDataType && NC_DOUBLE != vdatas[i].varDataType)
+      MB_SET_ERR(MB_FAILURE, "Unexpected data type for variable " << vdatas[i].varName);
 
+    // The file layout (time, cells, layers) matches the tag layout, so the data is read
+    // straight into tag storage; with PREFETCH_TIMESTEPS, the reads of all timesteps are
+    // posted before the one wait that services them
+    std::vector<int> requests;
     for (unsigned int t = 0; t < tstep_nums.size(); t++) {
-      // We will synchronize all these reads with the other processors,
-      // so the wait will be inside this double loop; is it too much?
-      size_t nb_reads = pLocalGid->psize();
-      std::vector<int> requests(nb_reads), statuss(nb_reads);
-      size_t idxReq = 0;
+      rval = post_timestep_reads(vdatas[i], tstep_nums[t], pLocalGid, 1, (double*) vdatas[i].varDatas[t], requests);MB_CHK_SET_ERR(rval, "Trouble posting reads for variable " << vdatas[i].varName);
 
-      // Set readStart for each timestep along time dimension
-      vdatas[i].readStarts[0] = tstep_nums[t];
-
-      switch (vdatas[i].varDataType) {
-        case NC_FLOAT:
-        case NC_DOUBLE: {
-          // Read float as double
-          std::vector<double> tmpdoubledata(sz);
-
-          // In the case of ucd mesh, and on multiple proc,
-          // we need to read as many times as subranges we have in the
-          // localGid range;
-          // basically, we have to give a different point
-          // for data to start, for every subrange :(
-          size_t indexInDoubleArray = 0;
-          size_t ic = 0;
-          for (Range::pair_iterator pair_iter = pLocalGid->pair_begin();
-              pair_iter != pLocalGid->pair_end();
-              ++pair_iter, ic++) {
-            EntityHandle starth = pair_iter->first;
-            EntityHandle endh = pair_iter->second; // inclusive
-            vdatas[i].readStarts[1] = (NCDF_SIZE) (starth - 1);
-            vdatas[i].readCounts[1] = (NCDF_SIZE) (endh - starth + 1);
-
-            // Do a partial read, in each subrange
-            // wait outside this loop
-            success = NCFUNCREQG(_vara_double)(_fileId, vdatas[i].varId,
-                &(vdatas[i].readStarts[0]), &(vdatas[i].readCounts[0]),
-                            &(tmpdoubledata[indexInDoubleArray]), &requests[idxReq++]);
-            if (success)
-              MB_SET_ERR(MB_FAILURE, "Failed to read double data in a loop for variable " << vdatas[i].varName);
-            // We need to increment the index in double array for the
-            // next subrange
-            indexInDoubleArray += (endh - starth + 1) * 1 * vdatas[i].numLev;
-          }
-          assert(ic == pLocalGid->psize());
-
-          success = NCFUNC(wait_all)(_fileId, requests.size(), &requests[0], &statuss[0]);
-          if (success)
-            MB_SET_ERR(MB_FAILURE, "Failed on wait_all");
-
-          void* data = vdatas[i].varDatas[t];
-          for (std::size_t idx = 0; idx != tmpdoubledata.size(); idx++)
-            ((double*) data)[idx] = tmpdoubledata[idx];
-
-          break;
-        }
-        default:
-          MB_SET_ERR(MB_FAILURE, "Unexpected data type for variable " << vdatas[i].varName);
+      // We will synchronize these reads with the other processors
+      if (!prefetchTimesteps || t + 1 == tstep_nums.size()) {
+        rval = wait_timestep_reads(requests);MB_CHK_SET_ERR(rval, "Trouble waiting for reads of variable " << vdatas[i].varName);
       }
     }
   }
@@ -601,6 +558,7 @@ ErrorCode NCHelperGCRM::read_ucd_variables_to_nonset_async(std::vector<ReadNC::V
       dbgOut.printf(1, ", %s ", vdatas[i].varName.c_str());
     dbgOut.tprintf(1, "\n");
   }
+  report_read_buffers(vdatas, 0);
 
   return rval;
 }
@@ -613,7 +571,6 @@ ErrorCode NCHelperGCRM::read_ucd_variables_to_nonset(std::vector<ReadNC::VarData
   ErrorCode rval = read_ucd_variables_to_nonset_allocate(vdatas, tstep_nums);MB_CHK_SET_ERR(rval, "Trouble allocating space to read non-set variables");
 
   // Finally, read into that space
-  int success;
   Range* pLocalGid = NULL;
 
   for (unsigned int i = 0; i < vdatas.size(); i++) {
@@ -635,48 +592,13 @@ ErrorCode NCHelperGCRM::read_ucd_variables_to_nonset(std::vector<ReadNC::VarData
         MB_SET_ERR(MB_FAILURE, "Unexpected entity location type for variable " << vdatas[i].varName);
     }
 
-    std::size_t sz = vdatas[i].sz;
-
     for (unsigned int t = 0; t < tstep_nums.size(); t++) {
-      // Set readStart for each timestep along time dimension
-      vdatas[i].readStarts[0] = tstep_nums[t];
-
       switch (vdatas[i].varDataType) {
         case NC_FLOAT:
         case NC_DOUBLE: {
-          // Read float as double
-          std::vector<double> tmpdoubledata(sz);
-
-          // In the case of ucd mesh, and on multiple proc,
-          // we need to read as many times as subranges we have in the
-          // localGid range;
-          // basically, we have to give a different point
-          // for data to start, for every subrange :(
-          size_t indexInDoubleArray = 0;
-          size_t ic = 0;
-          for (Range::pair_iterator pair_iter = pLocalGid->pair_begin();
-              pair_iter != pLocalGid->pair_end();
-              ++pair_iter, ic++) {
-            EntityHandle starth = pair_iter->first;
-            EntityHandle endh = pair_iter->second; // Inclusive
-            vdatas[i].readStarts[1] = (NCDF_SIZE) (starth - 1);
-            vdatas[i].readCounts[1] = (NCDF_SIZE) (endh - starth + 1);
-
-            success = NCFUNCAG(_vara_double)(_fileId, vdatas[i].varId,
-                &(vdatas[i].readStarts[0]), &(vdatas[i].readCounts[0]),
-                            &(tmpdoubledata[indexInDoubleArray]));
-            if (success)
-              MB_SET_ERR(MB_FAILURE, "Failed to read double data in a loop for variable " << vdatas[i].varName);
-            // We need to increment the index in double array for the
-            // next subrange
-            indexInDoubleArray += (endh - starth + 1) * 1 * vdatas[i].numLev;
-          }
-          assert(ic == pLocalGid->psize());
-
-          void* data = vdatas[i].varDatas[t];
-          for (std::size_t idx = 0; idx != tmpdoubledata.size(); idx++)
-            ((double*) data)[idx] = tmpdoubledata[idx];
-
+          // Read float as double, straight into tag storage: the file layout
+          // (time, cells, layers) is the same as the tag layout
+          rval = read_timestep(vdatas[i], tstep_nums[t], pLocalGid, 1, (double*) vdatas[i].varDatas[t]);MB_CHK_SET_ERR(rval, "Trouble reading variable " << vdatas[i].varName);
           break;
         }
         default:
@@ -692,6 +614,7 @@ ErrorCode NCHelperGCRM::read_ucd_variables_to_nonset(std::vector<ReadNC::VarData
       dbgOut.printf(1, ", %s ", vdatas[i].varName.c_str());
     dbgOut.tprintf(1, "\n");
   }
+  report_read_buffers(vdatas, 0);
 
   return rval;
 }
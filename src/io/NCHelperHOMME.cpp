@@ -4,6 +4,7 @@
 #include "moab/SpectralMeshTool.hpp"
 
 #include <cmath>
+#include <algorithm>
 
 namespace moab {
 
@@ -626,81 +627,34 @@ ErrorCode NCHelperHOMME::read_ucd_variables_to_nonset_async(std::vector<ReadNC::
   ErrorCode rval = read_ucd_variables_to_nonset_allocate(vdatas, tstep_nums);MB_CHK_SET_ERR(rval, "Trouble allocating space to read non-set variables");
 
   // Finally, read into that space
-  int success;
+  bool& prefetchTimesteps = _readNC->prefetchTimesteps;
+  std::vector<bool> visited;
+  std::size_t peak_bytes = 0;
 
   for (unsigned int i = 0; i < vdatas.size(); i++) {
-    std::size_t sz = vdatas[i].sz;
-
     // A typical supported variable: float T(time, lev, ncol)
     // For tag values, need transpose (lev, ncol) to (ncol, lev)
-    size_t ni = vdatas[i].readCounts[2]; // ncol
-    size_t nj = 1; // Here we should just set nj to 1
     size_t nk = vdatas[i].readCounts[1]; // lev
 
-    for (unsigned int t = 0; t < tstep_nums.size(); t++) {
-      // We will synchronize all these reads with the other processors,
-      // so the wait will be inside this double loop; is it too much?
-      size_t nb_reads = localGidVerts.psize();
-      std::vector<int> requests(nb_reads), statuss(nb_reads);
-      size_t idxReq = 0;
+    // Read float as double
+    if (NC_FLOAT != vdatas[i].varDataType && NC_DOUBLE != vdatas[i].varDataType)
+      MB_SET_ERR(MB_FAILURE, "Unexpected data type for variable " << vdatas[i].varName);
 
-      // Tag data for this timestep
-      void* data = vdatas[i].varDatas[t];
-
-      // Set readStart for each timestep along time dimension
-      vdatas[i].readStarts[0] = tstep_nums[t];
+    // The data is read straight into tag storage and transposed there; with PREFETCH_TIMESTEPS,
+    // the reads of all timesteps are posted before the one wait that services them
+    std::vector<int> requests;
+    unsigned int first = 0;
+    for (unsigned int t = 0; t < tstep_nums.size(); t++) {
+      rval = post_timestep_reads(vdatas[i], tstep_nums[t], &localGidVerts, 2, (double*) vdatas[i].varDatas[t], requests);MB_CHK_SET_ERR(rval, "Trouble posting reads for variable " << vdatas[i].varName);
+      if (prefetchTimesteps && t + 1 < tstep_nums.size())
+        continue;
 
-      switch (vdatas[i].varDataType) {
-        case NC_FLOAT:
-        case NC_DOUBLE: {
-          // Read float as double
-          std::vector<double> tmpdoubledata(sz);
-
-          // In the case of ucd mesh, and on multiple proc,
-          // we need to read as many times as subranges we have in the
-          // localGidVerts range;
-          // basically, we have to give a different point
-          // for data to start, for every subrange :(
-          size_t indexInDoubleArray = 0;
-          size_t ic = 0;
-          for (Range::pair_iterator pair_iter = localGidVerts.pair_begin();
-              pair_iter != localGidVerts.pair_end();
-              ++pair_iter, ic++) {
-            EntityHandle starth = pair_iter->first;
-            EntityHandle endh = pair_iter->second; // Inclusive
-            vdatas[i].readStarts[2] = (NCDF_SIZE) (starth - 1);
-            vdatas[i].readCounts[2] = (NCDF_SIZE) (endh - starth + 1);
-
-            // Do a partial read, in each subrange
-            // Wait outside this loop
-            success = NCFUNCREQG(_vara_double)(_fileId, vdatas[i].varId,
-                            &(vdatas[i].readStarts[0]), &(vdatas[i].readCounts[0]),
-                            &(tmpdoubledata[indexInDoubleArray]), &requests[idxReq++]);
-            if (success)
-              MB_SET_ERR(MB_FAILURE, "Failed to read double data in a loop for variable " << vdatas[i].varName);
-            // We need to increment the index in double array for the
-            // next subrange
-            indexInDoubleArray += (endh - starth + 1) * 1 * vdatas[i].numLev;
-          }
-          assert(ic == localGidVerts.psize());
-
-          success = ncmpi_wait_all(_fileId, requests.size(), &requests[0], &statuss[0]);
-          if (success)
-            MB_SET_ERR(MB_FAILURE, "Failed on wait_all");
-
-          if (vdatas[i].numLev > 1)
-            // Transpose (lev, ncol) to (ncol, lev)
-            kji_to_jik_stride(ni, nj, nk, data, &tmpdoubledata[0], localGidVerts);
-          else {
-            for (std::size_t idx = 0; idx != tmpdoubledata.size(); idx++)
-              ((double*) data)[idx] = tmpdoubledata[idx];
-          }
+      // We will synchronize these reads with the other processors
+      rval = wait_timestep_reads(requests);MB_CHK_SET_ERR(rval, "Trouble waiting for reads of variable " << vdatas[i].varName);
 
-          break;
-        }
-        default:
-          MB_SET_ERR(MB_FAILURE, "Unexpected data type for variable " << vdatas[i].varName);
-      }
+      // Transpose (lev, ncol) to (ncol, lev)
+      for (; first <= t; first++)
+        peak_bytes = std::max(peak_bytes, kji_to_jik_stride_in_place(nk, (double*) vdatas[i].varDatas[first], localGidVerts, visited));
     }
   }
 
@@ -711,6 +665,7 @@ ErrorCode NCHelperHOMME::read_ucd_variables_to_nonset_async(std::vector<ReadNC::
       dbgOut.printf(1, ", %s ", vdatas[i].varName.c_str());
     dbgOut.tprintf(1, "\n");
   }
+  report_read_buffers(vdatas, peak_bytes);
 
   return rval;
 }
@@ -721,64 +676,27 @@ ErrorCode NCHelperHOMME::read_ucd_variables_to_nonset(std::vector<ReadNC::VarDat
 
   ErrorCode rval = read_ucd_variables_to_nonset_allocate(vdatas, tstep_nums);MB_CHK_SET_ERR(rval, "Trouble allocating space to read non-set variables");
 
-  // Finally, read into that space
-  int success;
+  // Finally, read into that space; every timestep is read straight into tag storage, one
+  // block per subrange of localGidVerts, and each block is transposed there
+  std::vector<bool> visited;
+  std::size_t peak_bytes = 0;
   for (unsigned int i = 0; i < vdatas.size(); i++) {
-    std::size_t sz = vdatas[i].sz;
-
     // A typical supported variable: float T(time, lev, ncol)
     // For tag values, need transpose (lev, ncol) to (ncol, lev)
-    size_t ni = vdatas[i].readCounts[2]; // ncol
-    size_t nj = 1; // Here we should just set nj to 1
-    size_t nk = vdatas[i].readCounts[1]; // lev
+    size_t nk = vdatas[i].numLev; // lev
 
     for (unsigned int t = 0; t < tstep_nums.size(); t++) {
       // Tag data for this timestep
-      void* data = vdatas[i].varDatas[t];
-
-      // Set readStart for each timestep along time dimension
-      vdatas[i].readStarts[0] = tstep_nums[t];
+      double* data = (double*) vdatas[i].varDatas[t];
 
       switch (vdatas[i].varDataType) {
         case NC_FLOAT:
         case NC_DOUBLE: {
           // Read float as double
-          std::vector<double> tmpdoubledata(sz);
-
-          // In the case of ucd mesh, and on multiple proc,
-          // we need to read as many times as subranges we have in the
-          // localGidVerts range;
-          // basically, we have to give a different point
-          // for data to start, for every subrange :(
-          size_t indexInDoubleArray = 0;
-          size_t ic = 0;
-          for (Range::pair_iterator pair_iter = localGidVerts.pair_begin();
-              pair_iter != localGidVerts.pair_end();
-              ++pair_iter, ic++) {
-            EntityHandle starth = pair_iter->first;
-            EntityHandle endh = pair_iter->second; // Inclusive
-            vdatas[i].readStarts[2] = (NCDF_SIZE) (starth - 1);
-            vdatas[i].readCounts[2] = (NCDF_SIZE) (endh - starth + 1);
-
-            success = NCFUNCAG(_vara_double)(_fileId, vdatas[i].varId,
-                            &(vdatas[i].readStarts[0]), &(vdatas[i].readCounts[0]),
-                            &(tmpdoubledata[indexInDoubleArray]));
-            if (success)
-              MB_SET_ERR(MB_FAILURE, "Failed to read double data in a loop for variable " << vdatas[i].varName);
-            // We need to increment the index in double array for the
-            // next subrange
-            indexInDoubleArray += (endh - starth + 1) * 1 * vdatas[i].numLev;
-          }
-          assert(ic == localGidVerts.psize());
-
-          if (vdatas[i].numLev > 1)
-            // Transpose (lev, ncol) to (ncol, lev)
-            kji_to_jik_stride(ni, nj, nk, data, &tmpdoubledata[0], localGidVerts);
-          else {
-            for (std::size_t idx = 0; idx != tmpdoubledata.size(); idx++)
-              ((double*) data)[idx] = tmpdoubledata[idx];
-          }
+          rval = read_timestep(vdatas[i], tstep_nums[t], &localGidVerts, 2, data);MB_CHK_SET_ERR(rval, "Trouble reading variable " << vdatas[i].varName);
 
+          // Transpose (lev, ncol) to (ncol, lev)
+          peak_bytes = std::max(peak_bytes, kji_to_jik_stride_in_place(nk, data, localGidVerts, visited));
           break;
         }
         default:
@@ -794,6 +712,7 @@ ErrorCode NCHelperHOMME::read_ucd_variables_to_nonset(std::vector<ReadNC::VarDat
       dbgOut.printf(1, ", %s ", vdatas[i].varName.c_str());
     dbgOut.tprintf(1, "\n");
   }
+  report_read_buffers(vdatas, peak_bytes);
 
   return rval;
 }
@@ -652,15 +652,15 @@ ErrorCode NCHelperMPAS::read_ucd_variables_to_nonset_allocate(std::vector<ReadNC
 #ifdef MOAB_HAVE_PNETCDF
 ErrorCode NCHelperMPAS::read_ucd_variables_to_nonset_async(std::vector<ReadNC::VarData>& vdatas, std::vector<int>& tstep_nums)
 {
-  Interface*& mbImpl = _readNC->mbImpl;
   bool& noEdges = _readNC->noEdges;
   DebugOutput& dbgOut = _readNC->dbgOut;
 
   ErrorCode rval = read_ucd_variables_to_nonset_allocate(vdatas, tstep_nums);MB_CHK_SET_ERR(rval, "Trouble allocating space to read non-set variables");
 
   // Finally, read into that space
-  int success;
+  bool& prefetchTimesteps = _readNC->prefetchTimesteps;
   Range* pLocalGid = NULL;
+  std::size_t peak_bytes = 0;
 
   for (unsigned int i = 0; i < vdatas.size(); i++) {
     // Skip edge variables, if specified by the read options
@@ -681,87 +681,43 @@ ErrorCode NCHelperMPAS::read_ucd_variables_to_nonset_async(std::vector<ReadNC::V
         MB_SET_ERR(MB_FAILURE, "Unexpected entity location type for variable " << vdatas[i].varName);
     }
 
-    std::size_t sz = vdatas[i].sz;
+    // Read float as double
+    if (NC_FLOAT != vdatas[i].varDataType && NC_DOUBLE != vdatas[i].varDataType)
+      MB_SET_ERR(MB_FAILURE, "Unexpected data type for variable " << vdatas[i].varName);
+
+    // The file layout (Time, nCells, nVertLevels) matches the tag layout, so unless the cells
+    // are split into several groups, the data is read straight into tag storage
+    bool direct_read = !(vdatas[i].entLoc == ReadNC::ENTLOCFACE && numCellGroups > 1);
+
+    // With PREFETCH_TIMESTEPS, the reads of several timesteps are posted before the one wait that
+    // services them: all of them when reading into tag storage, two at a time otherwise, as each
+    // timestep in a batch needs its own buffer
+    std::size_t batch = 1;
+    if (prefetchTimesteps)
+      batch = direct_read ? tstep_nums.size() : 2;
+    std::vector<std::vector<double> > tmpdoubledata;
+    if (!direct_read) {
+      tmpdoubledata.resize(std::min(batch, tstep_nums.size()), std::vector<double>(vdatas[i].sz));
+      peak_bytes = std::max(peak_bytes, tmpdoubledata.size() * vdatas[i].sz * sizeof(double));
+    }
 
+    std::vector<int> requests;
+    unsigned int first = 0;
     for (unsigned int t = 0; t < tstep_nums.size(); t++) {
-      // We will synchronize all these reads with the other processors,
-      // so the wait will be inside this double loop; is it too much?
-      size_t nb_reads = pLocalGid->psize();
-      std::vector<int> requests(nb_reads), statuss(nb_reads);
-      size_t idxReq = 0;
+      double* target = direct_read ? (double*) vdatas[i].varDatas[t] : &tmpdoubledata[t - first][0];
+      rval = post_timestep_reads(vdatas[i], tstep_nums[t], pLocalGid, 1, target, requests);MB_CHK_SET_ERR(rval, "Trouble posting reads for variable " << vdatas[i].varName);
+      if (t + 1 - first < batch && t + 1 < tstep_nums.size())
+        continue;
 
-      // Set readStart for each timestep along time dimension
-      vdatas[i].readStarts[0] = tstep_nums[t];
-
-      switch (vdatas[i].varDataType) {
-        case NC_FLOAT:
-        case NC_DOUBLE: {
-          // Read float as double
-          std::vector<double> tmpdoubledata(sz);
-
-          // In the case of ucd mesh, and on multiple proc,
-          // we need to read as many times as subranges we have in the
-          // localGid range;
-          // basically, we have to give a different point
-          // for data to start, for every subrange :(
-          size_t indexInDoubleArray = 0;
-          size_t ic = 0;
-          for (Range::pair_iterator pair_iter = pLocalGid->pair_begin();
-              pair_iter != pLocalGid->pair_end();
-              ++pair_iter, ic++) {
-            EntityHandle starth = pair_iter->first;
-            EntityHandle endh = pair_iter->second; // Inclusive
-            vdatas[i].readStarts[1] = (NCDF_SIZE) (starth - 1);
-            vdatas[i].readCounts[1] = (NCDF_SIZE) (endh - starth + 1);
-
-            // Do a partial read, in each subrange
-            // Wait outside this loop
-            success = NCFUNCREQG(_vara_double)(_fileId, vdatas[i].varId,
-                &(vdatas[i].readStarts[0]), &(vdatas[i].readCounts[0]),
-                            &(tmpdoubledata[indexInDoubleArray]), &requests[idxReq++]);
-            if (success)
-              MB_SET_ERR(MB_FAILURE, "Failed to read double data in a loop for variable " << vdatas[i].varName);
-            // We need to increment the index in double array for the
-            // next subrange
-            indexInDoubleArray += (endh - starth + 1) * 1 * vdatas[i].numLev;
-          }
-          assert(ic == pLocalGid->psize());
-
-          success = NCFUNC(wait_all)(_fileId, requests.size(), &requests[0], &statuss[0]);
-          if (success)
-            MB_SET_ERR(MB_FAILURE, "Failed on wait_all");
-
-          if (vdatas[i].entLoc == ReadNC::ENTLOCFACE && numCellGroups > 1) {
-            // For a cell variable that is NOT on one contiguous chunk of faces, allocate tag space for
-            // each cell group, and utilize cellHandleToGlobalID map to read tag data
-            Range::iterator iter = facesOwned.begin();
-            while (iter != facesOwned.end()) {
-              int count;
-              void* ptr;
-              rval = mbImpl->tag_iterate(vdatas[i].varTags[t], iter, facesOwned.end(), count, ptr);MB_CHK_SET_ERR(rval, "Failed to iterate tag on owned faces");
-
-              for (int j = 0; j < count; j++) {
-                int global_cell_idx = cellHandleToGlobalID[*(iter + j)]; // Global cell index, 1 based
-                int local_cell_idx = localGidCells.index(global_cell_idx); // Local cell index, 0 based
-                assert(local_cell_idx != -1);
-                for (int level = 0; level < vdatas[i].numLev; level++)
-                  ((double*) ptr)[j * vdatas[i].numLev + level] = tmpdoubledata[local_cell_idx * vdatas[i].numLev + level];
-              }
-
-              iter += count;
-            }
-          }
-          else {
-            void* data = vdatas[i].varDatas[t];
-            for (std::size_t idx = 0; idx != tmpdoubledata.size(); idx++)
-              ((double*) data)[idx] = tmpdoubledata[idx];
-          }
+      // We will synchronize these reads with the other processors
+      rval = wait_timestep_reads(requests);MB_CHK_SET_ERR(rval, "Trouble waiting for reads of variable " << vdatas[i].varName);
 
-          break;
+      if (!direct_read) {
+        for (unsigned int s = first; s <= t; s++) {
+          rval = scatter_cell_groups(vdatas[i], vdatas[i].varTags[s], &tmpdoubledata[s - first][0]);MB_CHK_SET_ERR(rval, "Trouble unpacking variable " << vdatas[i].varName);
         }
-        default:
-          MB_SET_ERR(MB_FAILURE, "Unexpected data type for variable " << vdatas[i].varName);
       }
+      first = t + 1;
     }
   }
 
@@ -772,21 +728,21 @@ ErrorCode NCHelperMPAS::read_ucd_variables_to_nonset_async(std::vector<ReadNC::V
       dbgOut.printf(1, ", %s ", vdatas[i].varName.c_str());
     dbgOut.tprintf(1, "\n");
   }
+  report_read_buffers(vdatas, peak_bytes);
 
   return rval;
 }
 #else
 ErrorCode NCHelperMPAS::read_ucd_variables_to_nonset(std::vector<ReadNC::VarData>& vdatas, std::vector<int>& tstep_nums)
 {
-  Interface*& mbImpl = _readNC->mbImpl;
   bool& noEdges = _readNC->noEdges;
   DebugOutput& dbgOut = _readNC->dbgOut;
 
   ErrorCode rval = read_ucd_variables_to_nonset_allocate(vdatas, tstep_nums);MB_CHK_SET_ERR(rval, "Trouble allocating space to read non-set variables");
 
   // Finally, read into that space
-  int success;
   Range* pLocalGid = NULL;
+  std::size_t peak_bytes = 0;
 
   for (unsigned int i = 0; i < vdatas.size(); i++) {
     // Skip edge variables, if specified by the read options
@@ -807,70 +763,25 @@ ErrorCode NCHelperMPAS::read_ucd_variables_to_nonset(std::vector<ReadNC::VarData
         MB_SET_ERR(MB_FAILURE, "Unexpected entity location type for variable " << vdatas[i].varName);
     }
 
-    std::size_t sz = vdatas[i].sz;
+    // The file layout (Time, nCells, nVertLevels) matches the tag layout, so unless the cells
+    // are split into several groups, the data is read straight into tag storage
+    bool direct_read = !(vdatas[i].entLoc == ReadNC::ENTLOCFACE && numCellGroups > 1);
+    std::vector<double> tmpdoubledata;
 
     for (unsigned int t = 0; t < tstep_nums.size(); t++) {
-      // Set readStart for each timestep along time dimension
-      vdatas[i].readStarts[0] = tstep_nums[t];
-
       switch (vdatas[i].varDataType) {
         case NC_FLOAT:
         case NC_DOUBLE: {
           // Read float as double
-          std::vector<double> tmpdoubledata(sz);
-
-          // In the case of ucd mesh, and on multiple proc,
-          // we need to read as many times as subranges we have in the
-          // localGid range;
-          // basically, we have to give a different point
-          // for data to start, for every subrange :(
-          size_t indexInDoubleArray = 0;
-          size_t ic = 0;
-          for (Range::pair_iterator pair_iter = pLocalGid->pair_begin();
-              pair_iter != pLocalGid->pair_end();
-              ++pair_iter, ic++) {
-            EntityHandle starth = pair_iter->first;
-            EntityHandle endh = pair_iter->second; // Inclusive
-            vdatas[i].readStarts[1] = (NCDF_SIZE) (starth - 1);
-            vdatas[i].readCounts[1] = (NCDF_SIZE) (endh - starth + 1);
-
-            success = NCFUNCAG(_vara_double)(_fileId, vdatas[i].varId,
-                &(vdatas[i].readStarts[0]), &(vdatas[i].readCounts[0]),
-                            &(tmpdoubledata[indexInDoubleArray]));
-            if (success)
-              MB_SET_ERR(MB_FAILURE, "Failed to read double data in a loop for variable " << vdatas[i].varName);
-            // We need to increment the index in double array for the
-            // next subrange
-            indexInDoubleArray += (endh - starth + 1) * 1 * vdatas[i].numLev;
-          }
-          assert(ic == pLocalGid->psize());
-
-          if (vdatas[i].entLoc == ReadNC::ENTLOCFACE && numCellGroups > 1) {
-            // For a cell variable that is NOT on one contiguous chunk of faces, allocate tag space for
-            // each cell group, and utilize cellHandleToGlobalID map to read tag data
-            Range::iterator iter = facesOwned.begin();
-            while (iter != facesOwned.end()) {
-              int count;
-              void* ptr;
-              rval = mbImpl->tag_iterate(vdatas[i].varTags[t], iter, facesOwned.end(), count, ptr);MB_CHK_SET_ERR(rval, "Failed to iterate tag on owned faces");
-
-              for (int j = 0; j < count; j++) {
-                int global_cell_idx = cellHandleToGlobalID[*(iter + j)]; // Global cell index, 1 based
-                int local_cell_idx = localGidCells.index(global_cell_idx); // Local cell index, 0 based
-                assert(local_cell_idx != -1);
-                for (int level = 0; level < vdatas[i].numLev; level++)
-                  ((double*) ptr)[j * vdatas[i].numLev + level] = tmpdoubledata[local_cell_idx * vdatas[i].numLev + level];
-              }
-
-              iter += count;
-            }
+          if (direct_read) {
+            rval = read_timestep(vdatas[i], tstep_nums[t], pLocalGid, 1, (double*) vdatas[i].varDatas[t]);MB_CHK_SET_ERR(rval, "Trouble reading variable " << vdatas[i].varName);
           }
           else {
-            void* data = vdatas[i].varDatas[t];
-            for (std::size_t idx = 0; idx != tmpdoubledata.size(); idx++)
-              ((double*) data)[idx] = tmpdoubledata[idx];
+            tmpdoubledata.resize(vdatas[i].sz);
+            peak_bytes = std::max(peak_bytes, tmpdoubledata.size() * sizeof(double));
+            rval = read_timestep(vdatas[i], tstep_nums[t], pLocalGid, 1, &tmpdoubledata[0]);MB_CHK_SET_ERR(rval, "Trouble reading variable " << vdatas[i].varName);
+            rval = scatter_cell_groups(vdatas[i], vdatas[i].varTags[t], &tmpdoubledata[0]);MB_CHK_SET_ERR(rval, "Trouble unpacking variable " << vdatas[i].varName);
           }
-
           break;
         }
         default:
@@ -886,11 +797,38 @@ ErrorCode NCHelperMPAS::read_ucd_variables_to_nonset(std::vector<ReadNC::VarData
       dbgOut.printf(1, ", %s ", vdatas[i].varName.c_str());
     dbgOut.tprintf(1, "\n");
   }
+  report_read_buffers(vdatas, peak_bytes);
 
   return rval;
 }
 #endif
 
+ErrorCode NCHelperMPAS::scatter_cell_groups(ReadNC::VarData& var_data, Tag tagh, const double* data)
+{
+  Interface*& mbImpl = _readNC->mbImpl;
+
+  // For a cell variable that is NOT on one contiguous chunk of faces, allocate tag space for
+  // each cell group, and utilize cellHandleToGlobalID map to read tag data
+  Range::iterator iter = facesOwned.begin();
+  while (iter != facesOwned.end()) {
+    int count;
+    void* ptr;
+    ErrorCode rval = mbImpl->tag_iterate(tagh, iter, facesOwned.end(), count, ptr);MB_CHK_SET_ERR(rval, "Failed to iterate tag on owned faces");
+
+    for (int j = 0; j < count; j++) {
+      int global_cell_idx = cellHandleToGlobalID[*(iter + j)]; // Global cell index, 1 based
+      int local_cell_idx = localGidCells.index(global_cell_idx); // Local cell index, 0 based
+      assert(local_cell_idx != -1);
+      std::copy(data + local_cell_idx * var_data.numLev, data + (local_cell_idx + 1) * var_data.numLev,
+                (double*) ptr + j * var_data.numLev);
+    }
+
+    iter += count;
+  }
+
+  return MB_SUCCESS;
+}
+
 #ifdef MOAB_HAVE_MPI
 ErrorCode NCHelperMPAS::redistribute_local_cells(int start_cell_idx)
 {
@@ -43,6 +43,10 @@ private:
                                                 std::vector<int>& tstep_nums);
 #endif
 
+  //! Copy cell data read in local global id order into the tag storage of owned faces,
+  //! when the faces are split into several cell groups
+  ErrorCode scatter_cell_groups(ReadNC::VarData& var_data, Tag tagh, const double* data);
+
 #ifdef MOAB_HAVE_MPI
   //! Redistribute local cells after trivial partition (e.g. Zoltan partition, if applicable)
   ErrorCode redistribute_local_cells(int start_cell_index);
@@ -374,9 +374,8 @@ ErrorCode ReadGmsh::create_elements(const GmshElemType& type,
 
   // Copy passed element connectivity into entity sequence data.
   if (type.node_order) {
-    for (unsigned long i = 0; i < num_elem; ++i)
-      for (int j = 0; j < node_per_elem; ++j)
-        conn_array[i*node_per_elem + type.node_order[j]] = connectivity[i*node_per_elem + j];
+    ReadUtilIface::set_element_connect(conn_array, 0, num_elem, node_per_elem,
+                                       &connectivity[0], 0, type.node_order);
   }
   else {
     memcpy(conn_array, &connectivity[0], connectivity.size() * sizeof(EntityHandle));
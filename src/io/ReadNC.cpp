@@ -18,7 +18,7 @@ ReadNC::ReadNC(Interface* impl) :
 #ifdef MOAB_HAVE_MPI
   myPcomm(NULL),
 #endif
-  noMesh(false), noVars(false), spectralMesh(false), noMixedElements(false), noEdges(false),
+  noMesh(false), noVars(false), spectralMesh(false), noMixedElements(false), noEdges(false), prefetchTimesteps(false),
   gatherSetRank(-1), tStepBase(-1), trivialPartitionShift(0), myHelper(NULL)
 {
   assert(impl != NULL);
@@ -224,6 +224,10 @@ ErrorCode ReadNC::parse_options(const FileOptions& opts, std::vector<std::string
   if (MB_SUCCESS == rval)
     noEdges = true;
 
+  rval = opts.get_null_option("PREFETCH_TIMESTEPS");
+  if (MB_SUCCESS == rval)
+    prefetchTimesteps = true;
+
   if (2 <= dbgOut.get_verbosity()) {
     if (!var_names.empty()) {
       std::cerr << "Variables requested: ";
@@ -207,6 +207,7 @@ private:
   bool spectralMesh;
   bool noMixedElements;
   bool noEdges;
+  bool prefetchTimesteps;
   int gatherSetRank;
   int tStepBase;
   int trivialPartitionShift;
@@ -41,6 +41,7 @@
 #include "moab/FileOptions.hpp"
 #include "moab/AdaptiveKDTree.hpp"
 #include "moab/CartVect.hpp"
+#include "moab/CpuTimer.hpp"
 
 namespace moab {
 
@@ -127,7 +128,8 @@ ReaderIface* ReadNCDF::factory(Interface* iface)
 }
 
 ReadNCDF::ReadNCDF(Interface* impl)
-  : mdbImpl(impl), max_line_length(-1), max_str_length(-1)
+  : mdbImpl(impl), max_line_length(-1), max_str_length(-1),
+    timer(0), cputime(false)
 {
   assert(impl != NULL);
   reset();
@@ -200,6 +202,7 @@ void ReadNCDF::reset()
 ReadNCDF::~ReadNCDF()
 {
   mdbImpl->release_interface(readMeshIface);
+  delete timer;
 }
 
 ErrorCode ReadNCDF::read_tag_values(const char* file_name,
@@ -299,6 +302,15 @@ ErrorCode ReadNCDF::load_file(const char *exodus_file_name,
 
   reset();
 
+  // See if we need to report times
+  delete timer;
+  timer = 0;
+  cputime = (MB_SUCCESS == opts.get_null_option("CPUTIME"));
+  if (cputime) {
+    timer = new CpuTimer;
+    std::fill(_times, _times + NUM_TIMES, 0.0);
+  }
+
   // 0. Open the file.
 
   // open netcdf/exodus file
@@ -316,11 +328,17 @@ ErrorCode ReadNCDF::load_file(const char *exodus_file_name,
   if (MB_FAILURE == status)
     return status;
 
+  if (cputime)
+    _times[HEADER_TIME] = timer->time_elapsed();
+
   // 2. Read the nodes unless they've already been read before
   status = read_nodes(file_id_tag);
   if (MB_FAILURE == status)
     return status;
 
+  if (cputime)
+    _times[NODES_TIME] = timer->time_elapsed();
+
   // 3.
   // extra for polyhedra blocks
   if (numberFaceBlocks_loading>0)
@@ -345,17 +363,26 @@ ErrorCode ReadNCDF::load_file(const char *exodus_file_name,
   if (MB_FAILURE == status)
     return status;
 
+  if (cputime)
+    _times[ELEMENTS_TIME] = timer->time_elapsed();
+
   // 5. Read global ids
   status = read_global_ids();
   if (MB_FAILURE == status)
     return status;
 
+  if (cputime)
+    _times[GLOBAL_IDS_TIME] = timer->time_elapsed();
+
   // 6. Read nodesets
   status = read_nodesets();
   if (MB_FAILURE == status)
     return status;
 
-  // 7. Read sidesets
+  if (cputime)
+    _times[NODESETS_TIME] = timer->time_elapsed();
+
+  // 7. Read sidesets; their phases are timed separately
   status = read_sidesets();
   if (MB_FAILURE == status)
     return status;
@@ -376,9 +403,30 @@ ErrorCode ReadNCDF::load_file(const char *exodus_file_name,
   }
 
   ncFile = 0;
+
+  if (cputime) {
+    _times[TOTAL_TIME] = timer->time_since_birth();
+    print_times();
+  }
+
   return MB_SUCCESS;
 }
 
+void ReadNCDF::print_times()
+{
+  std::cout << "ReadNCDF:             " << _times[TOTAL_TIME] << std::endl
+            << "  header              " << _times[HEADER_TIME] << std::endl
+            << "  nodes               " << _times[NODES_TIME] << std::endl
+            << "  elements            " << _times[ELEMENTS_TIME] << std::endl
+            << "  global ids          " << _times[GLOBAL_IDS_TIME] << std::endl
+            << "  nodesets            " << _times[NODESETS_TIME] << std::endl
+            << "  sideset read        " << _times[SIDESET_READ_TIME] << std::endl
+            << "  sideset connect     " << _times[SIDESET_CONN_TIME] << std::endl
+            << "  sideset match       " << _times[SIDESET_MATCH_TIME] << std::endl
+            << "  sideset create      " << _times[SIDESET_CREATE_TIME] << std::endl
+            << "  sideset sets        " << _times[SIDESET_SETS_TIME] << std::endl;
+}
+
 ErrorCode ReadNCDF::read_exodus_header()
 {
   CPU_WORD_SIZE = sizeof(double); // With ExodusII version 2, all floats
@@ -1039,6 +1087,12 @@ ErrorCode ReadNCDF::read_nodesets()
   // Use a vector of ints to read node handles
   std::vector<int> node_handles;
 
+  // Maybe there are already nodesets meshsets here we can append to
+  Range child_meshsets;
+  if (mdbImpl->get_entities_by_type(0, MBENTITYSET, child_meshsets) != MB_SUCCESS)
+    return MB_FAILURE;
+  child_meshsets = subtract(child_meshsets, initRange);
+
   int i;
   std::vector<char> temp_string_storage(max_str_length + 1);
   char *temp_string = &temp_string_storage[0];
@@ -1075,13 +1129,6 @@ ErrorCode ReadNCDF::read_nodesets()
       MB_SET_ERR(MB_FAILURE, "ReadNCDF:: Problem getting nodeset node variable");
     }
 
-    // Maybe there is already a nodesets meshset here we can append to
-    Range child_meshsets;
-    if (mdbImpl->get_entities_by_handle(0, child_meshsets) != MB_SUCCESS)
-      return MB_FAILURE;
-
-    child_meshsets = subtract(child_meshsets, initRange);
-
     Range::iterator iter, end_iter;
     iter = child_meshsets.begin();
     end_iter = child_meshsets.end();
@@ -1099,10 +1146,13 @@ ErrorCode ReadNCDF::read_nodesets()
       }
     }
 
+    // Sorted, for lookup of the nodes already in the nodeset
     std::vector< EntityHandle > nodes_of_nodeset;
-    if (ns_handle)
+    if (ns_handle) {
       if (mdbImpl->get_entities_by_handle(ns_handle, nodes_of_nodeset, true) != MB_SUCCESS)
         return MB_FAILURE;
+      std::sort(nodes_of_nodeset.begin(), nodes_of_nodeset.end());
+    }
 
     // Make these into entity handles
     // TODO: could we have read it into EntityHandle sized array in the first place?
@@ -1115,7 +1165,7 @@ ErrorCode ReadNCDF::read_nodesets()
         // Make sure that it already isn't in a nodeset
         unsigned int node_id = CREATE_HANDLE(MBVERTEX, node_handles[j] + vertexOffset, temp);
         if (!ns_handle ||
-            std::find(nodes_of_nodeset.begin(), nodes_of_nodeset.end(), node_id) == nodes_of_nodeset.end()) {
+            !std::binary_search(nodes_of_nodeset.begin(), nodes_of_nodeset.end(), (EntityHandle)node_id)) {
           nodes.push_back(node_id);
 
           if (number_dist_factors_in_set != 0)
@@ -1237,6 +1287,8 @@ ErrorCode ReadNCDF::read_sidesets()
     if (create_ss_elements(&element_list[0], &side_list[0], number_sides_in_set, number_dist_factors_in_set,
                            entities_to_add, reverse_entities, temp_dist_factor_vector, i + 1) != MB_SUCCESS)
       return MB_FAILURE;
+    if (cputime)
+      timer->time_elapsed();
 
     // If there are elements to add
     if (!entities_to_add.empty() || !reverse_entities.empty()) {
@@ -1319,6 +1371,8 @@ ErrorCode ReadNCDF::read_sidesets()
           return MB_FAILURE;
       }
     }
+    if (cputime)
+      _times[SIDESET_SETS_TIME] += timer->time_elapsed();
   }
 
   return MB_SUCCESS;
@@ -1333,7 +1387,7 @@ ErrorCode ReadNCDF::create_ss_elements(int *element_ids,
                                        std::vector<double> &dist_factor_vector,
                                        int ss_seq_id)
 {
-  // Determine entity type from element id
+  ErrorCode rval;
 
   // If there are dist. factors, create a vector to hold the array
   // and place this array as a tag onto the sideset meshset
@@ -1351,14 +1405,19 @@ ErrorCode ReadNCDF::create_ss_elements(int *element_ids,
     }
   }
 
-  EntityType subtype;
-  int num_side_nodes, num_elem_nodes;
+  if (cputime)
+    _times[SIDESET_READ_TIME] += timer->time_elapsed();
+
+  // Get the connectivity of all sides from the connectivity of their
+  // elements and the canonical numbering.  Faces of shells and of
+  // triangles in 3D are the elements themselves.
+  std::vector<SideEntry> sides;
+  std::vector<EntityHandle> side_conn;
+  sides.reserve(num_sides);
   const EntityHandle* nodes;
-  std::vector<EntityHandle> connectivity;
+  int num_elem_nodes;
   int side_node_idx[32];
-
   int df_index = 0;
-  int sense = 0;
   for (int i = 0; i < num_sides; i++) {
     ExoIIElementType exoii_type;
     ReadBlockData block_data;
@@ -1367,270 +1426,267 @@ ErrorCode ReadNCDF::create_ss_elements(int *element_ids,
     if (find_side_element_type(element_ids[i], exoii_type, block_data, df_index, side_list[i]) != MB_SUCCESS)
       continue; // Isn't being read in this time
 
-    EntityType type = ExoIIUtil::ExoIIElementMBEntity[exoii_type];
+    const EntityType type = ExoIIUtil::ExoIIElementMBEntity[exoii_type];
 
-    EntityHandle ent_handle = element_ids[i] - block_data.startExoId + block_data.startMBId;
+    SideEntry side;
+    side.handle = element_ids[i] - block_data.startExoId + block_data.startMBId;
+    side.type = MBMAXTYPE;
+    side.numNodes = 0;
+    side.connOffset = side_conn.size();
+    side.sense = 1;
+    side.dfBegin = df_index;
 
-    const int side_num = side_list[i] - 1;
+    // Dimension and index of the side, 0 if the side is the element itself
+    int side_dim, side_num = side_list[i] - 1;
     if (type == MBHEX) {
-      // Get the nodes of the element
-      if (mdbImpl->get_connectivity(ent_handle, nodes, num_elem_nodes) != MB_SUCCESS)
-        return MB_FAILURE;
-
-      CN::SubEntityNodeIndices(type, num_elem_nodes, 2, side_num, subtype, num_side_nodes, side_node_idx);
-      if (num_side_nodes <= 0)
-        return MB_FAILURE;
-
-      connectivity.resize(num_side_nodes);
-      for (int k = 0; k < num_side_nodes; ++k)
-        connectivity[k] = nodes[side_node_idx[k]];
-
-      if (MB_SUCCESS != create_sideset_element(connectivity, subtype, ent_handle, sense))
-        return MB_FAILURE;
-      if (1 == sense)
-        entities_to_add.push_back(ent_handle);
-      else
-        reverse_entities.push_back(ent_handle);
-
-      // Read in distribution factor array
-      if (num_dist_factors) {
-        for (int k = 0; k < 4; k++)
-          dist_factor_vector.push_back(temp_dist_factor_vector[df_index++]);
-      }
+      side_dim = 2;
+      side.numDf = 4;
     }
-
-    // If it is a Tet
     else if (type == MBTET) {
-      // Get the nodes of the element
-      if (mdbImpl->get_connectivity(ent_handle, nodes, num_elem_nodes) != MB_SUCCESS)
-        return MB_FAILURE;
-
-      CN::SubEntityNodeIndices(type, num_elem_nodes, 2, side_num, subtype, num_side_nodes, side_node_idx);
-      if (num_side_nodes <= 0)
-        return MB_FAILURE;
-
-      connectivity.resize(num_side_nodes);
-      for (int k = 0; k < num_side_nodes; ++k)
-        connectivity[k] = nodes[side_node_idx[k]];
-
-      if (MB_SUCCESS != create_sideset_element(connectivity, subtype, ent_handle, sense))
-        return MB_FAILURE;
-      if (1 == sense)
-        entities_to_add.push_back(ent_handle);
-      else
-        reverse_entities.push_back(ent_handle);
-
-      // Read in distribution factor array
-      if (num_dist_factors) {
-        for (int k = 0; k < 3; k++)
-          dist_factor_vector.push_back(temp_dist_factor_vector[df_index++]);
-      }
+      side_dim = 2;
+      side.numDf = 3;
     }
     else if (type == MBQUAD &&
              exoii_type >= EXOII_SHELL && exoii_type <= EXOII_SHELL9) {
-      //ent_handle = CREATE_HANDLE(MBQUAD, base_id, error);
-
-      // Just use this quad
-      if (side_list[i] == 1) {
-        if (1 == sense)
-          entities_to_add.push_back(ent_handle);
-        else
-          reverse_entities.push_back(ent_handle);
-
-        if (num_dist_factors) {
-          for (int k = 0; k < 4; k++)
-            dist_factor_vector.push_back(temp_dist_factor_vector[df_index++]);
-        }
-
-        continue;
-      }
-      else if (side_list[i] == 2) {
-        reverse_entities.push_back(ent_handle);
-
-        if (num_dist_factors) {
-          for (int k = 0; k < 4; k++)
-            dist_factor_vector.push_back(temp_dist_factor_vector[df_index++]);
-        }
-
-        continue;
+      if (side_list[i] <= 2) {
+        // Just use this quad
+        side_dim = 0;
+        side.sense = (side_list[i] == 1) ? 1 : -1;
+        side.numDf = 4;
       }
       else {
-        // Get the nodes of the element
-        if (mdbImpl->get_connectivity(ent_handle, nodes, num_elem_nodes) != MB_SUCCESS)
-          return MB_FAILURE;
-
-        CN::SubEntityNodeIndices(type, num_elem_nodes, 1, side_num - 2, subtype, num_side_nodes, side_node_idx);
-        if (num_side_nodes <= 0)
-          return MB_FAILURE;
-
-        connectivity.resize(num_side_nodes);
-        for (int k = 0; k < num_side_nodes; ++k)
-          connectivity[k] = nodes[side_node_idx[k]];
-
-        if (MB_SUCCESS != create_sideset_element(connectivity, subtype, ent_handle, sense))
-          return MB_FAILURE;
-        if (1 == sense)
-          entities_to_add.push_back(ent_handle);
-        else
-          reverse_entities.push_back(ent_handle);
-
-        if (num_dist_factors) {
-          for (int k = 0; k < 2; k++)
-            dist_factor_vector.push_back(temp_dist_factor_vector[df_index++]);
-        }
+        side_dim = 1;
+        side_num -= 2;
+        side.numDf = 2;
       }
     }
-    // If it is a Quad
     else if (type == MBQUAD) {
-      // Get the nodes of the element
-      if (mdbImpl->get_connectivity(ent_handle, nodes, num_elem_nodes) != MB_SUCCESS)
-        return MB_FAILURE;
-
-      CN::SubEntityNodeIndices(type, num_elem_nodes, 1, side_num, subtype, num_side_nodes, side_node_idx);
-      if (num_side_nodes <= 0)
-        return MB_FAILURE;
-
-      connectivity.resize(num_side_nodes);
-      for (int k = 0; k < num_side_nodes; ++k)
-        connectivity[k] = nodes[side_node_idx[k]];
-
-      if (MB_SUCCESS != create_sideset_element(connectivity, subtype, ent_handle, sense))
-        return MB_FAILURE;
-      if (1 == sense)
-        entities_to_add.push_back(ent_handle);
-      else
-        reverse_entities.push_back(ent_handle);
-
-      // Read in distribution factor array
-      if (num_dist_factors) {
-        for (int k = 0; k < 2; k++)
-          dist_factor_vector.push_back(temp_dist_factor_vector[df_index++]);
-      }
+      side_dim = 1;
+      side.numDf = 2;
     }
     else if (type == MBTRI) {
-      int side_offset = 0;
       if (number_dimensions() == 3 && side_list[i] <= 2) {
-        if (1 == sense)
-          entities_to_add.push_back(ent_handle);
-        else
-          reverse_entities.push_back(ent_handle);
-        if (num_dist_factors) {
-          for (int k = 0; k < 3; k++)
-            dist_factor_vector.push_back(temp_dist_factor_vector[df_index++]);
-        }
+        side_dim = 0;
+        side.sense = (side_list[i] == 1) ? 1 : -1;
+        side.numDf = 3;
       }
       else {
-        if (number_dimensions() == 3) {
-          if (side_list[i] > 2)
-            side_offset = 2;
-        }
+        side_dim = 1;
+        if (number_dimensions() == 3)
+          side_num -= 2;
+        side.numDf = 2;
+      }
+    }
+    else
+      continue;
 
-        // Get the nodes of the element
-        if (mdbImpl->get_connectivity(ent_handle, nodes, num_elem_nodes) != MB_SUCCESS)
-          return MB_FAILURE;
+    if (side_dim) {
+      // Get the nodes of the element
+      rval = mdbImpl->get_connectivity(side.handle, nodes, num_elem_nodes);MB_CHK_ERR(rval);
 
-        CN::SubEntityNodeIndices(type, num_elem_nodes, 1, side_num-side_offset, subtype, num_side_nodes, side_node_idx);
-        if (num_side_nodes <= 0)
-          return MB_FAILURE;
+      CN::SubEntityNodeIndices(type, num_elem_nodes, side_dim, side_num, side.type, side.numNodes, side_node_idx);
+      if (side.numNodes <= 0)
+        return MB_FAILURE;
 
-        connectivity.resize(num_side_nodes);
-        for (int k = 0; k < num_side_nodes; ++k)
-          connectivity[k] = nodes[side_node_idx[k]];
+      for (int k = 0; k < side.numNodes; ++k)
+        side_conn.push_back(nodes[side_node_idx[k]]);
+    }
 
-        if (MB_SUCCESS != create_sideset_element(connectivity, subtype, ent_handle, sense))
-          return MB_FAILURE;
-        if (1 == sense)
-          entities_to_add.push_back(ent_handle);
-        else
-          reverse_entities.push_back(ent_handle);
+    df_index += side.numDf;
+    sides.push_back(side);
+  }
 
-        if (num_dist_factors) {
-          for (int k = 0; k < 2; k++)
-            dist_factor_vector.push_back(temp_dist_factor_vector[df_index++]);
-        }
-      }
-    }
+  if (cputime)
+    _times[SIDESET_CONN_TIME] += timer->time_elapsed();
+
+  rval = create_side_elements(sides, side_conn);MB_CHK_ERR(rval);
+
+  for (std::vector<SideEntry>::const_iterator s = sides.begin(); s != sides.end(); ++s) {
+    if (1 == s->sense)
+      entities_to_add.push_back(s->handle);
+    else
+      reverse_entities.push_back(s->handle);
+
+    // Read in distribution factor array
+    if (num_dist_factors)
+      dist_factor_vector.insert(dist_factor_vector.end(),
+                                temp_dist_factor_vector.begin() + s->dfBegin,
+                                temp_dist_factor_vector.begin() + s->dfBegin + s->numDf);
   }
 
   return MB_SUCCESS;
 }
 
-ErrorCode ReadNCDF::create_sideset_element(const std::vector<EntityHandle>& connectivity,
-                                           EntityType type, EntityHandle& handle, int &sense)
+namespace {
+
+// Sort key of a side element: sides with the same type, number of nodes
+// and corner vertices are the same side element.  Sides sort in the order
+// they are read within a group.
+struct SideKey {
+  EntityType type;
+  int numNodes;
+  EntityHandle corners[4];    // Sorted corner vertices, zero-padded
+  const EntityHandle* conn;   // Connectivity, in order
+  size_t side;                // Index of the side being read
+
+  SideKey( EntityType t, int num_nodes, const EntityHandle* c, size_t s )
+    : type(t), numNodes(num_nodes), conn(c), side(s)
+  {
+    const int num_corners = CN::VerticesPerEntity(type);
+    std::fill(corners, corners + 4, 0);
+    std::copy(conn, conn + num_corners, corners);
+    std::sort(corners, corners + num_corners);
+  }
+
+  bool same_side( const SideKey& other ) const
+  {
+    return type == other.type && numNodes == other.numNodes &&
+           std::equal(corners, corners + 4, other.corners);
+  }
+
+  bool operator<( const SideKey& other ) const
+  {
+    if (type != other.type)
+      return type < other.type;
+    if (numNodes != other.numNodes)
+      return numNodes < other.numNodes;
+    for (int i = 0; i < 4; ++i)
+      if (corners[i] != other.corners[i])
+        return corners[i] < other.corners[i];
+    return side < other.side;
+  }
+};
+
+// Sense of side connectivity relative to that of an element with the
+// same corners: 1 if it is a rotation, -1 if it is reversed, 0 if neither
+int side_sense( const EntityHandle* conn, const EntityHandle* ref, int num_corners )
 {
-  // Get adjacent entities
-  ErrorCode error = MB_SUCCESS;
-  int to_dim = CN::Dimension(type);
-  // for matching purposes , consider only corner nodes
-  // basically, assume everything is matching if the corner nodes are matching, and
-  // the number of total nodes is the same
-  int nb_corner_nodes = CN::VerticesPerEntity(type);
-  std::vector<EntityHandle> adj_ent;
-  mdbImpl->get_adjacencies(&(connectivity[0]), 1, to_dim, false, adj_ent);
-
-  // For each entity, see if we can find a match
-  // If we find a match, return it
-  bool match_found = false;
-  std::vector<EntityHandle> match_conn;
-  // By default, assume positive sense
-  sense = 1;
-  for (unsigned int i = 0; i < adj_ent.size() && match_found == false; i++) {
-    // Get the connectivity
-    error = mdbImpl->get_connectivity(&(adj_ent[i]), 1, match_conn);
-    if (error != MB_SUCCESS)
-      continue;
+  const EntityHandle* first = std::find(ref, ref + num_corners, conn[0]);
+  if (first == ref + num_corners)
+    return 0;
+  const int offset = first - ref;
 
-    // Make sure they have the same number of vertices (higher order elements ?)
-    if (match_conn.size() != connectivity.size())
-      continue;
+  bool forward = true, reverse = true;
+  for (int j = 1; j < num_corners; ++j) {
+    forward = forward && (conn[j] == ref[(offset + j) % num_corners]);
+    reverse = reverse && (conn[j] == ref[(offset + num_corners - j) % num_corners]);
+  }
+  return forward ? 1 : (reverse ? -1 : 0);
+}
 
-    // Find a matching node
-    std::vector<EntityHandle>::iterator iter;
-    std::vector<EntityHandle>::iterator end_corner=match_conn.begin()+nb_corner_nodes;
-    iter = std::find(match_conn.begin(), end_corner, connectivity[0]);
-    if (iter == end_corner)
-      continue;
+} // namespace
+
+ErrorCode ReadNCDF::create_side_elements(std::vector<SideEntry>& sides,
+                                         const std::vector<EntityHandle>& side_conn)
+{
+  ErrorCode rval;
 
-    // Rotate to match connectivity
-    // rotate only corner nodes, ignore the rest from now on
-    std::rotate(match_conn.begin(), iter, end_corner);
+  // Keys of the sides being read; equal sides are adjacent once sorted
+  std::vector<SideKey> keys;
+  for (size_t i = 0; i < sides.size(); ++i)
+    if (MBMAXTYPE != sides[i].type)
+      keys.push_back(SideKey(sides[i].type, sides[i].numNodes, &side_conn[sides[i].connOffset], i));
+  if (keys.empty())
+    return MB_SUCCESS;
 
-    bool they_match = true;
-    for (int j = 1; j < nb_corner_nodes; j++) {
-      if (connectivity[j] != match_conn[j]) {
-        they_match = false;
+  std::sort(keys.begin(), keys.end());
+
+  // Match each group of equal sides to an existing element adjacent to
+  // its corners, or to the first side of the group; sides that match
+  // neither get a new element.  Elements created for earlier sidesets
+  // are found through the same vertex adjacencies.
+  std::vector<size_t> to_create;
+  std::vector<size_t> source(sides.size(), (size_t)-1);
+  std::vector<EntityHandle> adj;
+  std::vector<SideKey>::const_iterator group = keys.begin();
+  while (group != keys.end()) {
+    std::vector<SideKey>::const_iterator group_end = group + 1;
+    while (group_end != keys.end() && group->same_side(*group_end))
+      ++group_end;
+
+    const int num_corners = CN::VerticesPerEntity(group->type);
+    adj.clear();
+    rval = mdbImpl->get_adjacencies(group->corners, num_corners, CN::Dimension(group->type),
+                                    false, adj);MB_CHK_ERR(rval);
+    EntityHandle existing = 0;
+    const EntityHandle* ref_conn = 0;
+    size_t ref_side = 0;
+    for (std::vector<EntityHandle>::const_iterator a = adj.begin(); a != adj.end(); ++a) {
+      int num_nodes;
+      if (TYPE_FROM_HANDLE(*a) != group->type)
+        continue;
+      rval = mdbImpl->get_connectivity(*a, ref_conn, num_nodes);MB_CHK_ERR(rval);
+      if (num_nodes == group->numNodes) {
+        existing = *a;
         break;
       }
+      ref_conn = 0;
     }
 
-    // If we didn't get a match
-    if (!they_match) {
-      // Try the opposite sense
-      they_match = true;
-
-      int k = nb_corner_nodes - 1;
-      for (int j = 1; j < nb_corner_nodes; ) {
-        if (connectivity[j] != match_conn[k]) {
-          they_match = false;
-          break;
+    for (std::vector<SideKey>::const_iterator k = group; k != group_end; ++k) {
+      SideEntry& side = sides[k->side];
+      const int sense = ref_conn ? side_sense(k->conn, ref_conn, num_corners) : 0;
+      if (!sense) {
+        // New element, with the connectivity of this side
+        side.sense = 1;
+        source[k->side] = k->side;
+        to_create.push_back(k->side);
+        if (!ref_conn) {
+          ref_conn = k->conn;
+          ref_side = k->side;
         }
-        ++j;
-        --k;
       }
-      // If they matched here, sense is reversed
-      if (they_match)
-        sense = -1;
+      else {
+        side.sense = sense;
+        if (existing)
+          side.handle = existing;
+        else
+          source[k->side] = ref_side;
+      }
+    }
+    group = group_end;
+  }
+
+  if (cputime)
+    _times[SIDESET_MATCH_TIME] += timer->time_elapsed();
+
+  // Create the new elements, a single allocation for each type
+  std::sort(to_create.begin(), to_create.end());
+  std::vector<size_t> remaining;
+  while (!to_create.empty()) {
+    const EntityType type = sides[to_create.front()].type;
+    const int num_nodes = sides[to_create.front()].numNodes;
+    std::vector<size_t> batch;
+    remaining.clear();
+    for (std::vector<size_t>::const_iterator i = to_create.begin(); i != to_create.end(); ++i) {
+      if (sides[*i].type == type && sides[*i].numNodes == num_nodes)
+        batch.push_back(*i);
+      else
+        remaining.push_back(*i);
+    }
+
+    EntityHandle start_handle, *conn = 0;
+    rval = readMeshIface->get_element_connect(batch.size(), num_nodes, type, MB_START_ID,
+                                              start_handle, conn);MB_CHK_ERR(rval);
+    for (size_t j = 0; j < batch.size(); ++j) {
+      const SideEntry& side = sides[batch[j]];
+      std::copy(side_conn.begin() + side.connOffset,
+                side_conn.begin() + side.connOffset + num_nodes, conn + j * num_nodes);
+      sides[batch[j]].handle = start_handle + j;
     }
-    match_found = they_match;
-    if (match_found)
-      handle = adj_ent[i];
+    rval = readMeshIface->update_adjacencies(start_handle, batch.size(), num_nodes, conn);MB_CHK_ERR(rval);
+
+    to_create.swap(remaining);
   }
 
-  // If we didn't find a match, create an element
-  if (!match_found)
-    error = mdbImpl->create_element(type, &connectivity[0], connectivity.size(), handle);
+  for (size_t i = 0; i < sides.size(); ++i)
+    if (source[i] != (size_t)-1 && source[i] != i)
+      sides[i].handle = sides[source[i]].handle;
 
-  return error;
+  if (cputime)
+    _times[SIDESET_CREATE_TIME] += timer->time_elapsed();
+
+  return MB_SUCCESS;
 }
 
 ErrorCode ReadNCDF::find_side_element_type(const int exodus_id, ExoIIElementType &elem_type,
@@ -45,6 +45,7 @@
 namespace moab {
 
 class ReadUtilIface;
+class CpuTimer;
 
 struct ReadBlockData
 {
@@ -105,8 +106,36 @@ public:
                      const int num_blocks, const int *blocks_to_load,
                      const EntityHandle file_set );
 
+    //! Phases of a read timed with the CPUTIME option
+  enum ReadTimingValues {
+    TOTAL_TIME = 0,
+    HEADER_TIME,
+    NODES_TIME,
+    ELEMENTS_TIME,
+    GLOBAL_IDS_TIME,
+    NODESETS_TIME,
+    SIDESET_READ_TIME,
+    SIDESET_CONN_TIME,
+    SIDESET_MATCH_TIME,
+    SIDESET_CREATE_TIME,
+    SIDESET_SETS_TIME,
+    NUM_TIMES
+  };
+
+  void print_times();
+
 private:
 
+    //! A side in a sideset, and the entity it is read into
+  struct SideEntry {
+    EntityHandle handle;  //!< Side element, or the element itself
+    EntityType type;      //!< Side element type, MBMAXTYPE if handle is the element
+    int numNodes;         //!< Number of nodes of the side element
+    size_t connOffset;    //!< Offset of the side connectivity in the list of all sides
+    int sense;            //!< Sense of the side relative to \c handle
+    int dfBegin, numDf;   //!< Distribution factors of this side
+  };
+
   ReadUtilIface* readMeshIface;
 
   bool dimension_exists(const char *attrib_name);
@@ -181,8 +210,11 @@ private:
                                          MB_MeshSet *ss_mesh_set);
                                          */
 
-  //! creates an element with the given connectivity
-  ErrorCode create_sideset_element( const std::vector<EntityHandle>&, EntityType, EntityHandle&, int&);
+  //! Find or create the side elements for all passed sides at once.
+  //! Sides are matched to existing elements and to each other by their
+  //! corner vertices; missing elements are created in bulk.
+  ErrorCode create_side_elements( std::vector<SideEntry>& sides,
+                                  const std::vector<EntityHandle>& side_conn );
 
   int get_number_nodes( EntityHandle handle );
 
@@ -251,6 +283,10 @@ private:
 
   int max_line_length, max_str_length;
 
+  double _times[NUM_TIMES];
+  CpuTimer* timer;
+  bool cputime;
+
     //! range of entities in initial mesh, before this read
   Range initRange;
 };
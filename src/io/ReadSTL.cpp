@@ -275,7 +275,7 @@ ErrorCode ReadSTL::binary_read_triangles(const char* name,
   // Allow user setting for byte order, default to little endian
   const bool want_big_endian = (byte_order == STL_BIG_ENDIAN);
   const bool am_big_endian = !SysUtil::little_endian();
-  bool swap_bytes = (want_big_endian == am_big_endian);
+  bool swap_bytes = (want_big_endian != am_big_endian);
 
   // Compare the number of triangles to the length of the file.
   // The file must contain an 80-byte description, a 4-byte
@@ -32,6 +32,10 @@
 #include "FileTokenizer.hpp"
 #include "moab/VtkUtil.hpp"
 #include "MBTagConventions.hpp"
+#include "SysUtil.hpp"
+
+#include <stdint.h>
+#include <algorithm>
 
 // #define MB_VTK_MATERIAL_SETS
 #ifdef MB_VTK_MATERIAL_SETS
@@ -158,7 +162,7 @@ ReaderIface* ReadVtk::factory(Interface* iface)
 }
 
 ReadVtk::ReadVtk(Interface* impl)
-  : mdbImpl(impl), mPartitionTagName(MATERIAL_SET_TAG_NAME)
+  : mdbImpl(impl), mPartitionTagName(MATERIAL_SET_TAG_NAME), binaryFile(false)
 {
   mdbImpl->query_interface(readMeshIface);
 }
@@ -185,6 +189,98 @@ const char* const vtk_type_names[] = {"bit",
                                       "vtkIdType",
                                       0};
 
+// Size in bytes of each of the above types in a binary legacy file.
+// Bit arrays are packed and handled separately; vtkIdType is written
+// as a 32-bit integer.
+static const size_t vtk_type_sizes[] = {0, 0, 1, 1, 2, 2, 4, 4, 8, 8, 4, 8, 4};
+
+// Number of values converted at a time when reading binary data
+const size_t BINARY_CHUNK = 65536;
+
+template <typename S, typename T>
+static void convert_big_endian(unsigned char* raw, size_t count, T* array)
+{
+  S* values = reinterpret_cast<S*>(raw);
+  if (SysUtil::little_endian())
+    SysUtil::byteswap(values, count);
+  for (size_t i = 0; i < count; ++i)
+    array[i] = static_cast<T>(values[i]);
+}
+
+template <typename T>
+static bool read_binary_values(FileTokenizer& tokens, int type,
+                               size_t count, T* array)
+{
+  if (type < 2 || type > 12)
+    return false;
+
+  const size_t size = vtk_type_sizes[type];
+  std::vector<uint64_t> buffer((std::min(count, BINARY_CHUNK)*size + 7)/8 + 1);
+  unsigned char* raw = reinterpret_cast<unsigned char*>(&buffer[0]);
+  while (count) {
+    const size_t n = std::min(count, BINARY_CHUNK);
+    if (!tokens.get_binary(n*size, raw))
+      return false;
+
+    switch (type) {
+      case 2:  convert_big_endian<int8_t>  (raw, n, array); break;
+      case 3:  convert_big_endian<uint8_t> (raw, n, array); break;
+      case 4:  convert_big_endian<int16_t> (raw, n, array); break;
+      case 5:  convert_big_endian<uint16_t>(raw, n, array); break;
+      case 6:  convert_big_endian<int32_t> (raw, n, array); break;
+      case 7:  convert_big_endian<uint32_t>(raw, n, array); break;
+      case 8:  convert_big_endian<int64_t> (raw, n, array); break;
+      case 9:  convert_big_endian<uint64_t>(raw, n, array); break;
+      case 10: convert_big_endian<float>   (raw, n, array); break;
+      case 11: convert_big_endian<double>  (raw, n, array); break;
+      case 12: convert_big_endian<int32_t> (raw, n, array); break;
+    }
+    array += n;
+    count -= n;
+  }
+
+  return true;
+}
+
+bool ReadVtk::read_values(FileTokenizer& tokens, int type,
+                          size_t count, double* array)
+{
+  if (binaryFile)
+    return read_binary_values(tokens, type, count, array);
+  return tokens.get_doubles(count, array);
+}
+
+bool ReadVtk::read_values(FileTokenizer& tokens, int type,
+                          size_t count, long* array)
+{
+  if (binaryFile)
+    return read_binary_values(tokens, type, count, array);
+  return tokens.get_long_ints(count, array);
+}
+
+bool ReadVtk::read_values(FileTokenizer& tokens, int type,
+                          size_t count, int* array)
+{
+  if (binaryFile)
+    return read_binary_values(tokens, type, count, array);
+  return tokens.get_integers(count, array);
+}
+
+bool ReadVtk::read_booleans(FileTokenizer& tokens, size_t count, bool* array)
+{
+  if (!binaryFile)
+    return tokens.get_booleans(count, array);
+
+  // Bits are packed most significant bit first
+  std::vector<unsigned char> bytes((count + 7)/8 + 1);
+  if (!tokens.get_binary((count + 7)/8, &bytes[0]))
+    return false;
+  for (size_t i = 0; i < count; ++i)
+    array[i] = ((bytes[i/8] >> (7 - i%8)) & 1) != 0;
+
+  return true;
+}
+
 ErrorCode ReadVtk::read_tag_values(const char* /* file_name */,
                                    const char* /* tag_name */,
                                    const FileOptions& /* opts */,
@@ -218,7 +314,7 @@ ErrorCode ReadVtk::load_file(const char *filename,
   if (result == MB_SUCCESS)
     mPartitionTagName = partition_tag_name;
 
-  FILE* file = fopen(filename, "r");
+  FILE* file = fopen(filename, "rb");
   if (!file)
     return MB_FILE_DOES_NOT_EXIST;
 
@@ -253,10 +349,12 @@ ErrorCode ReadVtk::load_file(const char *filename,
   int filetype = tokens.match_token(file_type_names);
   switch (filetype) {
     case 2:  // BINARY
-      MB_SET_ERR(MB_FAILURE, "Cannot read BINARY VTK files");
+      binaryFile = true;
+      break;
     default: // ERROR
       return MB_FAILURE;
     case 1:  // ASCII
+      binaryFile = false;
       break;
   }
 
@@ -348,6 +446,7 @@ ErrorCode ReadVtk::allocate_vertices(long num_verts,
 
 ErrorCode ReadVtk::read_vertices(FileTokenizer& tokens,
                                  long num_verts,
+                                 int type,
                                  EntityHandle& start_handle_out)
 {
   ErrorCode result;
@@ -357,6 +456,24 @@ ErrorCode ReadVtk::read_vertices(FileTokenizer& tokens,
   if (MB_SUCCESS != result)
     return result;
 
+  // Read binary coordinates a block at a time and scatter them
+  // directly into the coordinate arrays
+  if (binaryFile) {
+    std::vector<double> xyz(3*std::min((size_t)num_verts, BINARY_CHUNK));
+    std::vector<double*> arrays(3);
+    arrays[0] = x;
+    arrays[1] = y;
+    arrays[2] = z;
+    for (long vtx = 0; vtx < num_verts; ) {
+      const long n = std::min((long)BINARY_CHUNK, num_verts - vtx);
+      if (!read_values(tokens, type, 3*n, &xyz[0]))
+        return MB_FAILURE;
+      ReadUtilIface::set_node_coords(arrays, vtx, n, &xyz[0]);
+      vtx += n;
+    }
+    return MB_SUCCESS;
+  }
+
   // Read vertex coordinates
   for (long vtx = 0; vtx < num_verts; ++vtx) {
     if (!tokens.get_doubles(1, x++) ||
@@ -469,6 +586,7 @@ ErrorCode ReadVtk::vtk_read_structured_grid(FileTokenizer& tokens,
                                             std::vector<Range>& elem_list)
 {
   long num_verts, dims[3];
+  int type;
   ErrorCode result;
 
   if (!tokens.match_token("DIMENSIONS") ||
@@ -482,7 +600,7 @@ ErrorCode ReadVtk::vtk_read_structured_grid(FileTokenizer& tokens,
 
   if (!tokens.match_token("POINTS") ||
       !tokens.get_long_ints(1, &num_verts) ||
-      !tokens.match_token(vtk_type_names) ||
+      !(type = tokens.match_token(vtk_type_names)) ||
       !tokens.get_newline())
     return MB_FAILURE;
 
@@ -492,7 +610,7 @@ ErrorCode ReadVtk::vtk_read_structured_grid(FileTokenizer& tokens,
 
   // Create and read vertices
   EntityHandle start_handle = 0;
-  result = read_vertices(tokens, num_verts, start_handle);
+  result = read_vertices(tokens, num_verts, type, start_handle);
   if (MB_SUCCESS != result)
     return result;
   vertex_list.insert(start_handle, start_handle + num_verts - 1);
@@ -521,9 +639,10 @@ ErrorCode ReadVtk::vtk_read_rectilinear_grid(FileTokenizer& tokens,
 
   for (i = 0; i < 3; i++) {
     long count;
+    int type;
     if (!tokens.match_token(labels[i]) ||
         !tokens.get_long_ints(1, &count) ||
-        !tokens.match_token(vtk_type_names))
+        !(type = tokens.match_token(vtk_type_names)))
       return MB_FAILURE;
 
     if (count != dims[i]) {
@@ -531,7 +650,7 @@ ErrorCode ReadVtk::vtk_read_rectilinear_grid(FileTokenizer& tokens,
     }
 
     coords[i].resize(count);
-    if (!tokens.get_doubles(count, &coords[i][0]))
+    if (!read_values(tokens, type, count, &coords[i][0]))
       return MB_FAILURE;
   }
 
@@ -562,6 +681,7 @@ ErrorCode ReadVtk::vtk_read_polydata(FileTokenizer& tokens,
 {
   ErrorCode result;
   long num_verts;
+  int type;
   const char* const poly_data_names[] = {"VERTICES",
                                          "LINES",
                                          "POLYGONS",
@@ -570,7 +690,7 @@ ErrorCode ReadVtk::vtk_read_polydata(FileTokenizer& tokens,
 
   if (!tokens.match_token("POINTS") ||
       !tokens.get_long_ints(1, &num_verts) ||
-      !tokens.match_token(vtk_type_names) ||
+      !(type = tokens.match_token(vtk_type_names)) ||
       !tokens.get_newline())
     return MB_FAILURE;
 
@@ -580,7 +700,7 @@ ErrorCode ReadVtk::vtk_read_polydata(FileTokenizer& tokens,
 
   // Create vertices and read coordinates
   EntityHandle start_handle = 0;
-  result = read_vertices(tokens, num_verts, start_handle);
+  result = read_vertices(tokens, num_verts, type, start_handle);
   if (MB_SUCCESS != result)
     return result;
   vertex_list.insert(start_handle, start_handle + num_verts - 1);
@@ -620,21 +740,24 @@ ErrorCode ReadVtk::vtk_read_polygons(FileTokenizer& tokens,
       !tokens.get_newline())
     return MB_FAILURE;
 
+  // Read the vertex count and vertex indices of all polygons
+  std::vector<long> conn_idx(size[1]);
+  if (size[1] && !read_values(tokens, 6, size[1], &conn_idx[0]))
+    return MB_FAILURE;
+
   const Range empty;
   std::vector<EntityHandle> conn_hdl;
-  std::vector<long> conn_idx;
+  std::vector<long>::const_iterator idx = conn_idx.begin();
   EntityHandle first = 0, prev = 0, handle;
   for (int i = 0; i < size[0]; ++i) {
-    long count;
-    if (!tokens.get_long_ints(1, &count))
+    if (idx == conn_idx.end())
       return MB_FAILURE;
-    conn_idx.resize(count);
-    conn_hdl.resize(count);
-    if (!tokens.get_long_ints(count, &conn_idx[0]))
+    long count = *idx++;
+    if (count < 1 || count > conn_idx.end() - idx)
       return MB_FAILURE;
-
+    conn_hdl.resize(count);
     for (long j = 0; j < count; ++j)
-      conn_hdl[j] = first_vtx + conn_idx[j];
+      conn_hdl[j] = first_vtx + *idx++;
 
     result = mdbImpl->create_element(MBPOLYGON, &conn_hdl[0], count, handle);
     if (MB_SUCCESS != result)
@@ -665,6 +788,7 @@ ErrorCode ReadVtk::vtk_read_unstructured_grid(FileTokenizer& tokens,
 {
   ErrorCode result;
   long i, num_verts, num_elems[2];
+  int point_type;
   EntityHandle tmp_conn_list[27];
 
   // Poorly formatted VTK legacy format document seems to
@@ -683,7 +807,7 @@ ErrorCode ReadVtk::vtk_read_unstructured_grid(FileTokenizer& tokens,
     return MB_FAILURE;
 
   if (!tokens.get_long_ints(1, &num_verts) ||
-      !tokens.match_token(vtk_type_names) ||
+      !(point_type = tokens.match_token(vtk_type_names)) ||
       !tokens.get_newline())
     return MB_FAILURE;
 
@@ -693,7 +817,7 @@ ErrorCode ReadVtk::vtk_read_unstructured_grid(FileTokenizer& tokens,
 
   // Create vertices and read coordinates
   EntityHandle first_vertex = 0;
-  result = read_vertices(tokens, num_verts, first_vertex);
+  result = read_vertices(tokens, num_verts, point_type, first_vertex);
   if (MB_SUCCESS != result)
     return result;
   vertex_list.insert(first_vertex, first_vertex + num_verts - 1);
@@ -712,8 +836,9 @@ ErrorCode ReadVtk::vtk_read_unstructured_grid(FileTokenizer& tokens,
     return MB_FAILURE;
 
   // Read element connectivity for all elements
+  // (stored as 32-bit integers in binary files)
   std::vector<long> connectivity(num_elems[1]);
-  if (!tokens.get_long_ints(num_elems[1], &connectivity[0]))
+  if (!read_values(tokens, 6, num_elems[1], &connectivity[0]))
     return MB_FAILURE;
 
   if (!tokens.match_token("CELL_TYPES") ||
@@ -723,7 +848,7 @@ ErrorCode ReadVtk::vtk_read_unstructured_grid(FileTokenizer& tokens,
 
   // Read element types
   std::vector<long> types(num_elems[0]);
-  if (!tokens.get_long_ints(num_elems[0], &types[0]))
+  if (!read_values(tokens, 6, num_elems[0], &types[0]))
     return MB_FAILURE;
 
   // Create elements in blocks of the same type
@@ -980,12 +1105,29 @@ ErrorCode ReadVtk::vtk_read_field(FileTokenizer& tokens)
     /*const char* name =*/ tokens.get_string();
 
     long dims[2];
+    int type;
     if (!tokens.get_long_ints(2, dims) ||
-        !tokens.match_token(vtk_type_names))
+        !(type = tokens.match_token(vtk_type_names)))
       return MB_FAILURE;
 
     long num_vals = dims[0] * dims[1];
 
+    if (binaryFile) {
+      bool ok;
+      if (type == 1) {
+        bool* junk = new bool[num_vals + 1];
+        ok = read_booleans(tokens, num_vals, junk);
+        delete [] junk;
+      }
+      else {
+        std::vector<double> junk(num_vals + 1);
+        ok = read_values(tokens, type, num_vals, &junk[0]);
+      }
+      if (!ok)
+        return MB_FAILURE;
+      continue;
+    }
+
     for (long j = 0; j < num_vals; j++) {
       double junk;
       if (!tokens.get_doubles(1, &junk))
@@ -1032,7 +1174,8 @@ ErrorCode ReadVtk::vtk_read_tag_data(FileTokenizer& tokens,
                                      int type,
                                      size_t per_elem,
                                      std::vector<Range>& entities,
-                                     const char* name)
+                                     const char* name,
+                                     bool byte_colors)
 {
   ErrorCode result;
   DataType mb_type;
@@ -1081,14 +1224,19 @@ ErrorCode ReadVtk::vtk_read_tag_data(FileTokenizer& tokens,
   std::vector<Range>::iterator iter;
 
   if (type == 1) {
-    for (iter = entities.begin(); iter != entities.end(); ++iter) {
-      bool *data = new bool[iter->size() * per_elem];
-      if (!tokens.get_booleans(per_elem*iter->size(), data)) {
-        delete [] data;
-        return MB_FAILURE;
-      }
+    // Bits are packed across the whole array in binary files,
+    // so read the values for all entities at once
+    size_t total = 0;
+    for (iter = entities.begin(); iter != entities.end(); ++iter)
+      total += iter->size() * per_elem;
+    bool *data = new bool[total + 1];
+    if (!read_booleans(tokens, total, data)) {
+      delete [] data;
+      return MB_FAILURE;
+    }
 
-      bool* data_iter = data;
+    bool* data_iter = data;
+    for (iter = entities.begin(); iter != entities.end(); ++iter) {
       Range::iterator ent_iter = iter->begin();
       for ( ; ent_iter != iter->end(); ++ent_iter) {
         unsigned char bits = 0;
@@ -1104,14 +1252,14 @@ ErrorCode ReadVtk::vtk_read_tag_data(FileTokenizer& tokens,
           return result;
         }
       }
-      delete [] data;
     }
+    delete [] data;
   }
   else if ((type >= 2 && type <= 9) || type == 12) {
     std::vector<int> data;
     for (iter = entities.begin(); iter != entities.end(); ++iter) {
       data.resize(iter->size() * per_elem);
-      if (!tokens.get_integers(iter->size() * per_elem, &data[0]))
+      if (!read_values(tokens, type, iter->size() * per_elem, &data[0]))
         return MB_FAILURE;
 #ifdef MB_VTK_MATERIAL_SETS
       if (isMaterial)
@@ -1126,7 +1274,14 @@ ErrorCode ReadVtk::vtk_read_tag_data(FileTokenizer& tokens,
     std::vector<double> data;
     for (iter = entities.begin(); iter != entities.end(); ++iter) {
       data.resize(iter->size() * per_elem);
-      if (!tokens.get_doubles(iter->size() * per_elem, &data[0]))
+      // Binary color scalars are unsigned bytes scaled to [0,1]
+      if (byte_colors) {
+        if (!read_values(tokens, 3, iter->size() * per_elem, &data[0]))
+          return MB_FAILURE;
+        for (std::vector<double>::iterator d = data.begin(); d != data.end(); ++d)
+          *d /= 255.0;
+      }
+      else if (!read_values(tokens, type, iter->size() * per_elem, &data[0]))
         return MB_FAILURE;
 #ifdef MB_VTK_MATERIAL_SETS
       if (isMaterial)
@@ -1181,7 +1336,7 @@ ErrorCode ReadVtk::vtk_read_color_attrib(FileTokenizer& tokens,
   if (!tokens.get_long_ints(1, &size) || size < 1)
     return MB_FAILURE;
 
-  return vtk_read_tag_data(tokens, 10, size, entities, name);
+  return vtk_read_tag_data(tokens, 10, size, entities, name, binaryFile);
 }
 
 ErrorCode ReadVtk::vtk_read_vector_attrib(FileTokenizer& tokens,
@@ -62,8 +62,19 @@ protected:
 
   ErrorCode read_vertices( FileTokenizer& tokens,
                              long num_verts,
+                             int type,
                              EntityHandle& start_handle_out );
 
+    //! Read values stored in the file as VTK type \c type (an index into
+    //! the list of VTK type names), either as ASCII text or as big-endian
+    //! binary data depending on the type of the file being read.
+  bool read_values( FileTokenizer& tokens, int type, size_t count, double* array );
+  bool read_values( FileTokenizer& tokens, int type, size_t count, long* array );
+  bool read_values( FileTokenizer& tokens, int type, size_t count, int* array );
+
+    //! Read bit values, packed eight to a byte in binary files
+  bool read_booleans( FileTokenizer& tokens, size_t count, bool* array );
+
   ErrorCode allocate_elements( long num_elements,
                                  int vert_per_element,
                                  EntityType type,
@@ -112,7 +123,8 @@ protected:
                                  int type,
                                  size_t per_elem,
                                  std::vector<Range>& entities,
-                                 const char* name );
+                                 const char* name,
+                                 bool byte_colors = false );
 
   ErrorCode vtk_read_scalar_attrib( FileTokenizer& tokens,
                                       std::vector<Range>& entities,
@@ -153,6 +165,9 @@ private:
 
     //! A field which, if present and having a single integer for storage, should be used to partition the mesh by range. Defaults to MATERIAL_SET_TAG_NAME
   std::string mPartitionTagName;
+
+    //! True if reading a BINARY (rather than ASCII) legacy file
+  bool binaryFile;
 };
 
 } // namespace moab
@@ -34,6 +34,7 @@
 #include "exodus_order.h"
 
 #include <sstream>
+#include <algorithm>
 #include <assert.h>
 #include <string.h>
 
@@ -1097,6 +1098,8 @@ ErrorCode Tqdcfr::read_block(const unsigned int blindex,
   Core *mbcore = dynamic_cast<Core*>(mdbImpl);
   assert(mbcore != NULL);
   HigherOrderFactory ho_fact(mbcore, 0);
+  for (EntityType t = MBEDGE; t < MBMAXTYPE; t++)
+    elemIdMaps[t].valid = false;
   return ho_fact.convert(entities, !!blockh->hasMidNodes[1], !!blockh->hasMidNodes[2],
                          !!blockh->hasMidNodes[3]);
 }
@@ -1238,8 +1241,11 @@ ErrorCode Tqdcfr::put_into_set(EntityHandle set_handle,
                                std::vector<EntityHandle> &entities,
                                std::vector<EntityHandle> &excl_entities)
 {
-  // And put entities into this block's set
-  ErrorCode result = mdbImpl->add_entities(set_handle, &entities[0], entities.size());
+  // And put entities into this block's set; adding them as a range
+  // keeps this linear in the number of contiguous handle blocks
+  Range ents;
+  std::copy(entities.rbegin(), entities.rend(), range_inserter(ents));
+  ErrorCode result = mdbImpl->add_entities(set_handle, ents);
   if (MB_SUCCESS != result)
     return result;
 
@@ -1271,13 +1277,16 @@ ErrorCode Tqdcfr::get_entities(const unsigned int *mem_types,
 {
   ErrorCode tmp_result, result = MB_SUCCESS;
 
-  for (unsigned int i = 0; i < id_buf_size; i++) {
+  // Convert runs of entities of the same type together
+  unsigned int i = 0, j;
+  for (; i < id_buf_size; i = j) {
+    for (j = i + 1; j < id_buf_size && mem_types[j] == mem_types[i]; j++);
     if (is_group)
-      tmp_result = get_entities(mem_types[i], id_buf + i, 1, entities, entities);
+      tmp_result = get_entities(mem_types[i], id_buf + i, j - i, entities, entities);
     else
       // For blocks/nodesets/sidesets, use CSOEntityType, which is 2 greater than
       // group entity types
-      tmp_result = get_entities(mem_types[i] + 2, id_buf + i, 1, entities, entities);
+      tmp_result = get_entities(mem_types[i] + 2, id_buf + i, j - i, entities, entities);
     if (MB_SUCCESS != tmp_result)
       result = tmp_result;
   }
@@ -1350,26 +1359,18 @@ ErrorCode Tqdcfr::get_mesh_entities(const unsigned int this_type,
     }
   }
   else {
-    Range tmp_ents;
-    result = mdbImpl->get_entities_by_type(0, this_ent_type, tmp_ents);
+    const ElemIdMap* id_map;
+    result = get_elem_id_map(this_ent_type, id_map);
     if (MB_SUCCESS != result)
       return result;
-    if (tmp_ents.empty() && 0 != id_buf_size)
+    if (id_map->dense.empty() && id_map->sorted.empty() && 0 != id_buf_size)
       return MB_FAILURE;
 
-    std::vector<int> cub_ids(tmp_ents.size());
-    result = mdbImpl->tag_get_data(globalIdTag, tmp_ents, &cub_ids[0]);
-    if (MB_SUCCESS != result && MB_TAG_NOT_FOUND != result)
-      return result;
-
     // Now go through id list, finding each entity by id
     for (unsigned int i = 0; i < id_buf_size; i++) {
-      std::vector<int>::iterator vit =
-        std::find(cub_ids.begin(), cub_ids.end(), id_buf[i]);
-      if (vit != cub_ids.end()) {
-        EntityHandle this_ent = tmp_ents[vit - cub_ids.begin()];
-        if (mdbImpl->type_from_handle(this_ent) != MBMAXTYPE) ent_list->push_back(this_ent);
-      }
+      EntityHandle this_ent = id_map->find(id_buf[i]);
+      if (this_ent)
+        ent_list->push_back(this_ent);
       else {
         std::cout << "Warning: didn't find " << CN::EntityTypeName(this_ent_type)
                   << " " << id_buf[i] << std::endl;
@@ -1380,6 +1381,66 @@ ErrorCode Tqdcfr::get_mesh_entities(const unsigned int this_type,
   return result;
 }
 
+EntityHandle Tqdcfr::ElemIdMap::find(int id) const
+{
+  if (!dense.empty()) {
+    if (id < minId || id - minId >= (int)dense.size())
+      return 0;
+    return dense[id - minId];
+  }
+
+  std::vector<std::pair<int, EntityHandle> >::const_iterator it =
+    std::lower_bound(sorted.begin(), sorted.end(), std::pair<int, EntityHandle>(id, 0));
+  if (it == sorted.end() || it->first != id)
+    return 0;
+  return it->second;
+}
+
+ErrorCode Tqdcfr::get_elem_id_map(EntityType type, const ElemIdMap*& id_map)
+{
+  ElemIdMap& map = elemIdMaps[type];
+  id_map = &map;
+  if (map.valid)
+    return MB_SUCCESS;
+
+  map.dense.clear();
+  map.sorted.clear();
+
+  Range ents;
+  ErrorCode result = mdbImpl->get_entities_by_type(0, type, ents);
+  if (MB_SUCCESS != result)
+    return result;
+
+  std::vector<int> cub_ids(ents.size());
+  if (!ents.empty()) {
+    result = mdbImpl->tag_get_data(globalIdTag, ents, &cub_ids[0]);
+    if (MB_SUCCESS != result && MB_TAG_NOT_FOUND != result)
+      return result;
+  }
+
+  if (!ents.empty()) {
+    // Where entities share an id, the one with the lowest handle wins
+    std::vector<int>::const_iterator id_it = cub_ids.begin();
+    map.sorted.reserve(ents.size());
+    for (Range::const_iterator rit = ents.begin(); rit != ents.end(); ++rit, ++id_it)
+      map.sorted.push_back(std::pair<int, EntityHandle>(*id_it, *rit));
+    std::sort(map.sorted.begin(), map.sorted.end());
+
+    const int min_id = map.sorted.front().first, max_id = map.sorted.back().first;
+    if ((unsigned long)((long)max_id - min_id) < 2 * map.sorted.size()) {
+      map.minId = min_id;
+      map.dense.resize(max_id - min_id + 1, 0);
+      for (std::vector<std::pair<int, EntityHandle> >::reverse_iterator it = map.sorted.rbegin();
+           it != map.sorted.rend(); ++it)
+        map.dense[it->first - min_id] = it->second;
+      std::vector<std::pair<int, EntityHandle> >().swap(map.sorted);
+    }
+  }
+
+  map.valid = true;
+  return MB_SUCCESS;
+}
+
 ErrorCode Tqdcfr::read_nodes(const unsigned int gindex,
                              Tqdcfr::ModelEntry *model,
                              Tqdcfr::GeomHeader *entity)
@@ -1635,37 +1696,38 @@ ErrorCode Tqdcfr::read_elements(Tqdcfr::ModelEntry *model,
       FREADI(num_elem); // We need to skip num_elem in advance, it looks like
     FREADI(total_conn);
 
-    // Post-process connectivity into handles
-    EntityHandle new_handle;
-    int j = 0;
-    for (int e = 0; e < num_elem; ++e) {
-      for (int k = 0; k < nodes_per_elem; ++k, ++j) {
-        if (debug) {
-          if (0 == j) std::cout << "Conn=";
-          std::cout << ", " << uint_buf[j];
-        }
-        if (NULL == cubMOABVertexMap)
-          new_handle = (EntityHandle) currVHandleOffset + uint_buf[j];
-        else {
-          assert(uint_buf[j] < cubMOABVertexMap->size() &&
-                 0 != (*cubMOABVertexMap)[uint_buf[j]]);
-          new_handle = (*cubMOABVertexMap)[uint_buf[j]];
+    // Post-process connectivity into handles, through the vertex
+    // offset or map for the whole block at once
+    if (debug) {
+      std::cout << "Conn=";
+      for (unsigned int j = 0; j < total_conn; ++j)
+        std::cout << ", " << uint_buf[j];
+    }
+    const unsigned int *cub_conn = &uint_buf[0];
+    if (NULL == cubMOABVertexMap) {
+      const EntityHandle offset = (EntityHandle) currVHandleOffset;
+      for (int e = 0; e < num_elem; ++e, cub_conn += nodes_per_elem, conn += nodes_per_elem)
+        for (int k = 0; k < nodes_per_elem; ++k)
+          conn[node_order[k]] = offset + cub_conn[k];
+    }
+    else {
+      const EntityHandle *vmap = &(*cubMOABVertexMap)[0];
+      for (int e = 0; e < num_elem; ++e, cub_conn += nodes_per_elem, conn += nodes_per_elem)
+        for (int k = 0; k < nodes_per_elem; ++k) {
+          assert(cub_conn[k] < cubMOABVertexMap->size() && 0 != vmap[cub_conn[k]]);
+          conn[node_order[k]] = vmap[cub_conn[k]];
         }
-  #ifndef NDEBUG
-        EntityHandle dum_handle;
-        assert(MB_SUCCESS ==
-               mdbImpl->handle_from_id(MBVERTEX, mdbImpl->id_from_handle(new_handle),
-                                       dum_handle));
-  #endif
-        conn[e*nodes_per_elem + node_order[k]] = new_handle;
-      }
     }
+    conn -= total_conn;
 
     // Add these elements into the entity's set
     result = mdbImpl->add_entities(entity->setHandle, dum_range);
     if (MB_SUCCESS != result)
       return result;
 
+    // Id lookups of this type need to see the new elements
+    elemIdMaps[elem_type].valid = false;
+
     // Notify MOAB of the new elements
     result = readUtilIface->update_adjacencies(start_handle, num_elem,
                                                nodes_per_elem, conn);
@@ -370,6 +370,22 @@ private:
     // map between cub ids and MOAB handles
   std::vector<EntityHandle> *cubMOABVertexMap;
 
+    // map between cub ids and handles of all elements of one type, built
+    // on first lookup: a dense array indexed by id - minId if the ids are
+    // dense enough, otherwise (id, handle) pairs sorted by id
+  struct ElemIdMap {
+    bool valid;
+    int minId;
+    std::vector<EntityHandle> dense;
+    std::vector<std::pair<int, EntityHandle> > sorted;
+    ElemIdMap() : valid(false), minId(0) {}
+    EntityHandle find(int id) const;
+  };
+  ElemIdMap elemIdMaps[MBMAXTYPE];
+
+    //! get the id map for elements of a type, building it if needed
+  ErrorCode get_elem_id_map(EntityType type, const ElemIdMap*& id_map);
+
     // enum used to identify element/entity type in groups
   enum {GROUP = 0, BODY, VOLUME, SURFACE, CURVE, VERTEX, HEX, TET, PYRAMID, QUAD, TRI, EDGE, NODE};
   static const EntityType group_type_to_mb_type[];
@@ -314,7 +314,7 @@ ErrorCode WriteSTL::binary_write_triangles(FILE* file,
   // Default to little endian if byte_order == UNKNOWN_BYTE_ORDER
   const bool want_big_endian = (byte_order == STL_BIG_ENDIAN);
   const bool am_big_endian = !SysUtil::little_endian();
-  const bool swap_bytes = (want_big_endian == am_big_endian);
+  const bool swap_bytes = (want_big_endian != am_big_endian);
 
   if (triangles.size() > INT_MAX) // Can't write that many triangles
     return MB_FAILURE;
@@ -0,0 +1,801 @@
+/**
+ * MOAB, a Mesh-Oriented datABase, is a software component for creating,
+ * storing and accessing finite element mesh data.
+ *
+ * Copyright 2004 Sandia Corporation.  Under the terms of Contract
+ * DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government
+ * retains certain rights in this software.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ */
+
+#include "WriteVtu.hpp"
+#include "moab/VtkUtil.hpp"
+#include "SysUtil.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+#include <algorithm>
+#include <set>
+#include <iterator>
+
+#include "moab/Interface.hpp"
+#include "moab/Range.hpp"
+#include "moab/CN.hpp"
+#include "moab/WriteUtilIface.hpp"
+#include "Internals.hpp"
+#include "moab/FileOptions.hpp"
+
+#ifdef MOAB_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace moab {
+
+const bool DEFAULT_STRICT = true;
+
+// Number of values staged in memory at a time when an array has to be
+// converted (interleaved coordinates, vertex indices, ...) before writing
+const size_t CHUNK_SIZE = 65536;
+
+// Uncompressed size of a zlib-compressed block of appended data
+const size_t COMPRESS_BLOCK_SIZE = 1 << 20;
+
+// Width of the placeholder written for an array offset in the XML header
+const int OFFSET_WIDTH = 20;
+
+/**\brief Raw appended data section of a VTK XML file
+ *
+ * Arrays are declared in the XML header with a fixed-width placeholder
+ * for their offset, which is filled in once the array is written.  Each
+ * array is preceded by a UInt64 byte count or, when compressing, by the
+ * vtkZLibDataCompressor block header.
+ */
+class WriteVtu::AppendedData
+{
+public:
+
+  AppendedData( std::ostream& stream, int level )
+    : str(stream), compressLevel(level), base(0), nextArray(0),
+      arrayBytes(0), bytesLeft(0)
+    {}
+
+    //! Write the offset attribute for the next array declared in the header
+  void declare_array()
+  {
+    str << " format=\"appended\" offset=\"";
+    offsetPos.push_back(str.tellp());
+    str << std::string(OFFSET_WIDTH, '0') << "\"";
+  }
+
+    //! Start the appended data section
+  void start()
+  {
+    str << "  <AppendedData encoding=\"raw\">" << std::endl << "   _";
+    base = str.tellp();
+  }
+
+    //! Start writing the next declared array, of \c nbytes uncompressed bytes
+  void begin_array( uint64_t nbytes );
+
+    //! Append data to the current array
+  void write( const void* data, size_t nbytes );
+
+    //! Finish the current array
+  ErrorCode end_array();
+
+    //! Close the appended data section and the file
+  ErrorCode finish();
+
+private:
+
+  void patch( std::streampos pos, const void* data, size_t nbytes );
+
+  void flush_block();
+
+  std::ostream& str;
+  int compressLevel;
+  std::streampos base;                     //!< Start of the appended data
+  std::vector<std::streampos> offsetPos;   //!< Offset placeholders in header
+  size_t nextArray;                        //!< Next array to write
+  uint64_t arrayBytes;                     //!< Uncompressed size of current array
+  uint64_t bytesLeft;                      //!< Bytes left to write in current array
+  std::streampos headerPos;                //!< Compression header of current array
+  std::vector<uint64_t> header;            //!< Compression header of current array
+  std::vector<unsigned char> block, packed;
+};
+
+void WriteVtu::AppendedData::patch( std::streampos pos, const void* data, size_t nbytes )
+{
+  std::streampos end = str.tellp();
+  str.seekp(pos);
+  str.write(reinterpret_cast<const char*>(data), nbytes);
+  str.seekp(end);
+}
+
+void WriteVtu::AppendedData::begin_array( uint64_t nbytes )
+{
+  assert(nextArray < offsetPos.size());
+
+  char offset[OFFSET_WIDTH + 1];
+  sprintf(offset, "%0*llu", OFFSET_WIDTH, (unsigned long long)(str.tellp() - base));
+  patch(offsetPos[nextArray++], offset, OFFSET_WIDTH);
+
+  arrayBytes = bytesLeft = nbytes;
+  if (compressLevel < 0) {
+    str.write(reinterpret_cast<const char*>(&nbytes), sizeof(nbytes));
+    return;
+  }
+
+  // Header: number of blocks, block size, size of the last (partial) block,
+  // then the compressed size of each block
+  const uint64_t num_blocks = (nbytes + COMPRESS_BLOCK_SIZE - 1) / COMPRESS_BLOCK_SIZE;
+  header.clear();
+  header.resize(3 + num_blocks, 0);
+  header[0] = num_blocks;
+  header[1] = COMPRESS_BLOCK_SIZE;
+  header[2] = nbytes % COMPRESS_BLOCK_SIZE;
+  headerPos = str.tellp();
+  str.write(reinterpret_cast<const char*>(&header[0]), header.size() * sizeof(uint64_t));
+  block.clear();
+}
+
+void WriteVtu::AppendedData::flush_block()
+{
+#ifdef MOAB_HAVE_ZLIB
+  uLongf len = compressBound(block.size());
+  packed.resize(len);
+  if (Z_OK != compress2(&packed[0], &len, &block[0], block.size(), compressLevel)) {
+    str.setstate(std::ios::failbit);
+    return;
+  }
+  const uint64_t block_num = (arrayBytes - bytesLeft - 1) / COMPRESS_BLOCK_SIZE;
+  header[3 + block_num] = len;
+  str.write(reinterpret_cast<const char*>(&packed[0]), len);
+#endif
+  block.clear();
+}
+
+void WriteVtu::AppendedData::write( const void* data, size_t nbytes )
+{
+  assert(nbytes <= bytesLeft);
+  if (compressLevel < 0) {
+    str.write(reinterpret_cast<const char*>(data), nbytes);
+    bytesLeft -= nbytes;
+    return;
+  }
+
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+  while (nbytes) {
+    size_t n = std::min(nbytes, COMPRESS_BLOCK_SIZE - block.size());
+    block.insert(block.end(), bytes, bytes + n);
+    bytes += n;
+    nbytes -= n;
+    bytesLeft -= n;
+    if (block.size() == COMPRESS_BLOCK_SIZE || !bytesLeft)
+      flush_block();
+  }
+}
+
+ErrorCode WriteVtu::AppendedData::end_array()
+{
+  if (bytesLeft) {
+    MB_SET_ERR(MB_FAILURE, "Appended data array is short " << bytesLeft << " bytes");
+  }
+  if (compressLevel >= 0)
+    patch(headerPos, &header[0], header.size() * sizeof(uint64_t));
+  if (!str) {
+    MB_SET_ERR(MB_FILE_WRITE_ERROR, "Error writing appended data");
+  }
+  return MB_SUCCESS;
+}
+
+ErrorCode WriteVtu::AppendedData::finish()
+{
+  assert(nextArray == offsetPos.size());
+  str << std::endl << "  </AppendedData>" << std::endl << "</VTKFile>" << std::endl;
+  if (!str) {
+    MB_SET_ERR(MB_FILE_WRITE_ERROR, "Error writing VTU file");
+  }
+  return MB_SUCCESS;
+}
+
+namespace {
+
+// Position of each vertex in the list of points written to the file
+class NodeIndex
+{
+public:
+
+  NodeIndex( const Range& nodes )
+  {
+    int64_t idx = 0;
+    for (Range::const_pair_iterator p = nodes.const_pair_begin(); p != nodes.const_pair_end(); ++p) {
+      starts.push_back(p->first);
+      bases.push_back(idx);
+      idx += p->second - p->first + 1;
+    }
+  }
+
+  int64_t operator()( EntityHandle h ) const
+  {
+    if (starts.size() == 1)
+      return h - starts[0];
+    size_t i = std::upper_bound(starts.begin(), starts.end(), h) - starts.begin() - 1;
+    return bases[i] + (int64_t)(h - starts[i]);
+  }
+
+private:
+
+  std::vector<EntityHandle> starts;
+  std::vector<int64_t> bases;
+};
+
+// A run of elements with the same type and number of vertices,
+// for which the connectivity is stored contiguously
+struct CellBlock {
+  const EntityHandle* conn;
+  int vpe;
+  int count;
+  const VtkElemType* vtk_type;
+  int num_nodes;
+};
+
+} // namespace
+
+WriterIface *WriteVtu::factory(Interface* iface)
+{
+  return new WriteVtu(iface);
+}
+
+WriteVtu::WriteVtu(Interface* impl)
+  : mbImpl(impl), writeTool(0), mStrict(DEFAULT_STRICT), compressLevel(-1)
+{
+  assert(impl != NULL);
+  impl->query_interface(writeTool);
+}
+
+WriteVtu::~WriteVtu()
+{
+  mbImpl->release_interface(writeTool);
+}
+
+ErrorCode WriteVtu::write_file(const char *file_name,
+                               const bool overwrite,
+                               const FileOptions& opts,
+                               const EntityHandle *output_list,
+                               const int num_sets,
+                               const std::vector<std::string>& /* qa_list */,
+                               const Tag* tag_list,
+                               int num_tags,
+                               int /* export_dimension */)
+{
+  ErrorCode rval;
+
+  rval = parse_options(opts);MB_CHK_ERR(rval);
+
+  // Get entities to write
+  Range nodes, elems;
+  rval = gather_mesh(output_list, num_sets, nodes, elems);MB_CHK_ERR(rval);
+  if (nodes.empty()) {
+    MB_SET_ERR(MB_ENTITY_NOT_FOUND, "Nothing to write");
+  }
+
+  std::vector<TagArray> node_tags, elem_tags;
+  rval = gather_tags(nodes, tag_list, num_tags, node_tags);MB_CHK_ERR(rval);
+  rval = gather_tags(elems, tag_list, num_tags, elem_tags);MB_CHK_ERR(rval);
+
+  // Honor overwrite flag
+  if (!overwrite) {
+    rval = writeTool->check_doesnt_exist(file_name);
+    if (MB_SUCCESS != rval)
+      return rval;
+  }
+
+  return write_vtu(file_name, nodes, elems, node_tags, elem_tags);
+}
+
+ErrorCode WriteVtu::parse_options(const FileOptions& opts)
+{
+  if (MB_SUCCESS == opts.get_null_option("STRICT"))
+    mStrict = true;
+  else if (MB_SUCCESS == opts.get_null_option("RELAXED"))
+    mStrict = false;
+  else
+    mStrict = DEFAULT_STRICT;
+
+  compressLevel = -1;
+  if (MB_SUCCESS == opts.get_int_option("COMPRESS", 6, compressLevel)) {
+#ifndef MOAB_HAVE_ZLIB
+    MB_SET_ERR(MB_NOT_IMPLEMENTED, "Cannot COMPRESS VTU data: MOAB was built without zlib");
+#endif
+    if (compressLevel < 0 || compressLevel > 9) {
+      MB_SET_ERR(MB_TYPE_OUT_OF_RANGE, "Invalid compression level: " << compressLevel);
+    }
+  }
+
+  return MB_SUCCESS;
+}
+
+ErrorCode WriteVtu::gather_mesh(const EntityHandle* set_list,
+                                int num_sets,
+                                Range& nodes,
+                                Range& elems)
+{
+  ErrorCode rval;
+
+  if (!set_list || !num_sets) {
+    rval = mbImpl->get_entities_by_type(0, MBVERTEX, nodes);MB_CHK_ERR(rval);
+    for (EntityType t = MBEDGE; t < MBENTITYSET; ++t) {
+      rval = mbImpl->get_entities_by_type(0, t, elems);MB_CHK_ERR(rval);
+    }
+  }
+  else {
+    std::set<EntityHandle> visited;
+    std::vector<EntityHandle> sets(set_list, set_list + num_sets);
+    while (!sets.empty()) {
+      EntityHandle set = sets.back();
+      sets.pop_back();
+      if (!visited.insert(set).second)
+        continue;
+
+      Range a;
+      rval = mbImpl->get_entities_by_handle(set, a);MB_CHK_ERR(rval);
+      Range::iterator elem_i = a.lower_bound(MBEDGE);
+      Range::iterator set_i = a.lower_bound(MBENTITYSET);
+      nodes.merge(a.begin(), elem_i);
+      elems.merge(elem_i, set_i);
+      std::copy(set_i, a.end(), std::back_inserter(sets));
+
+      a.clear();
+      rval = mbImpl->get_child_meshsets(set, a);MB_CHK_ERR(rval);
+      std::copy(a.begin(), a.end(), std::back_inserter(sets));
+    }
+  }
+
+  // Filter out element types that VTK cannot represent
+  for (EntityType t = MBEDGE; t < MBENTITYSET; ++t) {
+    if (!VtkUtil::get_vtk_type(t, CN::VerticesPerEntity(t)))
+      elems.erase(elems.lower_bound(t), elems.upper_bound(t));
+  }
+
+  // Add the vertices of the elements
+  if (set_list && num_sets) {
+    rval = get_vertex_closure(elems, nodes);MB_CHK_ERR(rval);
+  }
+
+  return MB_SUCCESS;
+}
+
+ErrorCode WriteVtu::get_vertex_closure(const Range& elems, Range& nodes)
+{
+  // Vertices of the elements, and of the faces of polyhedra
+  Range conn;
+  ErrorCode rval = mbImpl->get_connectivity(elems, conn);MB_CHK_ERR(rval);
+  Range faces = subtract(conn, conn.subset_by_type(MBVERTEX));
+  nodes.merge(conn.subset_by_type(MBVERTEX));
+  if (!faces.empty()) {
+    conn.clear();
+    rval = mbImpl->get_connectivity(faces, conn);MB_CHK_ERR(rval);
+    nodes.merge(conn);
+  }
+  return MB_SUCCESS;
+}
+
+ErrorCode WriteVtu::gather_tags(const Range& entities,
+                                const Tag* tag_list,
+                                int num_tags,
+                                std::vector<TagArray>& arrays)
+{
+  ErrorCode rval;
+
+  arrays.clear();
+  if (entities.empty())
+    return MB_SUCCESS;
+
+  std::vector<Tag> tags;
+  rval = writeTool->get_tag_list(tags, tag_list, num_tags, false);MB_CHK_ERR(rval);
+
+  for (std::vector<Tag>::iterator i = tags.begin(); i != tags.end(); ++i) {
+    TagArray arr;
+    rval = get_tag_array(*i, entities, arr);MB_CHK_ERR(rval);
+
+    // Skip tags holding entity handles -- no way to save them
+    if (MB_TYPE_HANDLE == arr.type)
+      continue;
+
+    // If in strict mode, don't write tags that do not fit in any attribute type
+    if (mStrict && (arr.length < 1 || (arr.length > 4 && arr.length != 9)))
+      continue;
+
+    // Skip tags not set on any of the entities
+    if (arr.tagged.empty())
+      continue;
+
+    if (arr.dense)
+      arr.tagged.clear();
+    arrays.push_back(arr);
+  }
+
+  return MB_SUCCESS;
+}
+
+ErrorCode WriteVtu::get_tag_array(Tag tag, const Range& entities, TagArray& arr)
+{
+  ErrorCode rval;
+
+  arr.tag = tag;
+  TagType storage;
+  if (MB_SUCCESS != mbImpl->tag_get_name(tag, arr.name) ||
+      MB_SUCCESS != mbImpl->tag_get_data_type(tag, arr.type) ||
+      MB_SUCCESS != mbImpl->tag_get_length(tag, arr.length) ||
+      MB_SUCCESS != mbImpl->tag_get_type(tag, storage))
+    return MB_FAILURE;
+  arr.dense = (MB_TAG_DENSE == storage && MB_TYPE_BIT != arr.type);
+
+  arr.tagged.clear();
+  if (entities.empty())
+    return MB_SUCCESS;
+  const EntityType low_type = TYPE_FROM_HANDLE(entities.front());
+  const EntityType high_type = TYPE_FROM_HANDLE(entities.back());
+  for (EntityType t = low_type; t <= high_type; ++t) {
+    rval = mbImpl->get_entities_by_type_and_tag(0, t, &tag, 0, 1, arr.tagged, Interface::UNION);MB_CHK_ERR(rval);
+  }
+  arr.tagged = intersect(arr.tagged, entities);
+
+  // Tags storing their values in another precision cannot be written
+  // from the tag storage; read them a value at a time
+  if (arr.dense && !arr.tagged.empty()) {
+    int count;
+    void* ptr;
+    if (MB_TYPE_OUT_OF_RANGE == mbImpl->tag_iterate(tag, arr.tagged.begin(), arr.tagged.end(), count, ptr, false))
+      arr.dense = false;
+  }
+
+  return MB_SUCCESS;
+}
+
+const char* WriteVtu::vtk_xml_type(DataType type)
+{
+  switch (type) {
+    case MB_TYPE_INTEGER: return "Int32";
+    case MB_TYPE_DOUBLE:  return "Float64";
+    default:              return "UInt8";
+  }
+}
+
+int WriteVtu::vtk_value_size(DataType type)
+{
+  switch (type) {
+    case MB_TYPE_INTEGER: return sizeof(int);
+    case MB_TYPE_DOUBLE:  return sizeof(double);
+    default:              return 1;
+  }
+}
+
+std::string WriteVtu::xml_escape(const std::string& str)
+{
+  std::string result;
+  for (std::string::const_iterator i = str.begin(); i != str.end(); ++i) {
+    switch (*i) {
+      case '&':  result += "&amp;";  break;
+      case '<':  result += "&lt;";   break;
+      case '>':  result += "&gt;";   break;
+      case '"':  result += "&quot;"; break;
+      default:   result += *i;       break;
+    }
+  }
+  return result;
+}
+
+ErrorCode WriteVtu::write_vtu(const char* file_name,
+                              const Range& nodes,
+                              const Range& elems,
+                              const std::vector<TagArray>& node_tags,
+                              const std::vector<TagArray>& elem_tags)
+{
+  ErrorCode rval;
+
+  std::ofstream file(file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file) {
+    MB_SET_ERR(MB_FILE_WRITE_ERROR, "Could not open file: " << file_name);
+  }
+
+  AppendedData data(file, compressLevel);
+  bool polyhedra = !elems.empty() && TYPE_FROM_HANDLE(elems.back()) == MBPOLYHEDRON;
+
+  // Write the XML header, declaring the arrays in the order they
+  // are written to the appended data section
+  file << "<?xml version=\"1.0\"?>" << std::endl;
+  file << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\""
+       << (SysUtil::little_endian() ? "LittleEndian" : "BigEndian")
+       << "\" header_type=\"UInt64\"";
+  if (compressLevel >= 0)
+    file << " compressor=\"vtkZLibDataCompressor\"";
+  file << ">" << std::endl;
+  file << "  <UnstructuredGrid>" << std::endl;
+  file << "    <Piece NumberOfPoints=\"" << nodes.size()
+       << "\" NumberOfCells=\"" << elems.size() << "\">" << std::endl;
+
+  const char* data_names[] = {"PointData", "CellData"};
+  const std::vector<TagArray>* tag_arrays[] = {&node_tags, &elem_tags};
+  for (int i = 0; i < 2; ++i) {
+    if (tag_arrays[i]->empty())
+      continue;
+    file << "      <" << data_names[i] << ">" << std::endl;
+    for (std::vector<TagArray>::const_iterator t = tag_arrays[i]->begin(); t != tag_arrays[i]->end(); ++t) {
+      file << "        <DataArray type=\"" << vtk_xml_type(t->type) << "\" Name=\""
+           << xml_escape(t->name) << "\" NumberOfComponents=\"" << t->length << "\"";
+      data.declare_array();
+      file << "/>" << std::endl;
+    }
+    file << "      </" << data_names[i] << ">" << std::endl;
+  }
+
+  file << "      <Points>" << std::endl;
+  file << "        <DataArray type=\"Float64\" NumberOfComponents=\"3\"";
+  data.declare_array();
+  file << "/>" << std::endl;
+  file << "      </Points>" << std::endl;
+
+  const char* cell_arrays[][2] = { {"connectivity", "Int64"},
+                                   {"offsets", "Int64"},
+                                   {"types", "UInt8"},
+                                   {"faces", "Int64"},
+                                   {"faceoffsets", "Int64"} };
+  file << "      <Cells>" << std::endl;
+  for (int i = 0; i < (polyhedra ? 5 : 3); ++i) {
+    file << "        <DataArray type=\"" << cell_arrays[i][1] << "\" Name=\"" << cell_arrays[i][0] << "\"";
+    data.declare_array();
+    file << "/>" << std::endl;
+  }
+  file << "      </Cells>" << std::endl;
+  file << "    </Piece>" << std::endl;
+  file << "  </UnstructuredGrid>" << std::endl;
+
+  // Write the arrays
+  data.start();
+  for (std::vector<TagArray>::const_iterator t = node_tags.begin(); t != node_tags.end(); ++t) {
+    rval = write_tag_data(data, *t, nodes);MB_CHK_ERR(rval);
+  }
+  for (std::vector<TagArray>::const_iterator t = elem_tags.begin(); t != elem_tags.end(); ++t) {
+    rval = write_tag_data(data, *t, elems);MB_CHK_ERR(rval);
+  }
+  rval = write_points(data, nodes);MB_CHK_ERR(rval);
+  rval = write_cells(data, nodes, elems);MB_CHK_ERR(rval);
+
+  return data.finish();
+}
+
+ErrorCode WriteVtu::write_points(AppendedData& data, const Range& nodes)
+{
+  ErrorCode rval;
+
+  data.begin_array(3 * sizeof(double) * nodes.size());
+
+  std::vector<double> xyz(3 * std::min(nodes.size(), CHUNK_SIZE));
+  Range::const_iterator i = nodes.begin();
+  while (i != nodes.end()) {
+    double *x, *y, *z;
+    float *xf = 0, *yf = 0, *zf = 0;
+    int count;
+    rval = mbImpl->coords_iterate(i, nodes.end(), x, y, z, count);
+    if (MB_TYPE_OUT_OF_RANGE == rval)
+      rval = mbImpl->coords_iterate(i, nodes.end(), xf, yf, zf, count);
+    MB_CHK_ERR(rval);
+    i += count;
+
+    // Interleave the coordinates of this sequence a chunk at a time
+    for (int done = 0; done < count; ) {
+      const int n = std::min(count - done, (int)CHUNK_SIZE);
+      for (int j = 0; j < n; ++j, ++done) {
+        xyz[3*j]     = xf ? xf[done] : x[done];
+        xyz[3*j + 1] = yf ? yf[done] : y[done];
+        xyz[3*j + 2] = zf ? zf[done] : z[done];
+      }
+      data.write(&xyz[0], 3 * sizeof(double) * n);
+    }
+  }
+
+  return data.end_array();
+}
+
+ErrorCode WriteVtu::write_cells(AppendedData& data, const Range& nodes, const Range& elems)
+{
+  ErrorCode rval;
+  const NodeIndex index(nodes);
+
+  // First pass: find contiguous blocks of elements and the size of
+  // the connectivity array.  Vertex lists and faces of polyhedra are
+  // assembled here as polyhedra have no contiguous vertex list.
+  std::vector<CellBlock> blocks;
+  std::vector<int64_t> poly_conn, poly_sizes, faces, face_offsets;
+  uint64_t conn_size = 0;
+  Range::const_iterator i = elems.begin();
+  while (i != elems.end()) {
+    CellBlock b;
+    EntityHandle* conn;
+    const EntityType type = TYPE_FROM_HANDLE(*i);
+    rval = mbImpl->connect_iterate(i, elems.end(), conn, b.vpe, b.count);MB_CHK_ERR(rval);
+    b.conn = conn;
+
+    b.vtk_type = VtkUtil::get_vtk_type(type, b.vpe);
+    b.num_nodes = b.vpe;
+    if (!b.vtk_type) {
+      // Try connectivity with 1 fewer node
+      b.vtk_type = VtkUtil::get_vtk_type(type, b.vpe - 1);
+      b.num_nodes = b.vpe - 1;
+      if (!b.vtk_type) {
+        MB_SET_ERR(MB_FAILURE, "Vtk file format does not support elements of type " << CN::EntityTypeName(type) << " (" << (int)type << ") with " << b.vpe << " nodes");
+      }
+    }
+
+    if (MBPOLYHEDRON == type) {
+      std::vector<EntityHandle> verts;
+      for (int e = 0; e < b.count; ++e) {
+        const EntityHandle* cell_faces = b.conn + e * b.vpe;
+        const size_t first_vert = poly_conn.size();
+        faces.push_back(b.vpe);
+        for (int f = 0; f < b.vpe; ++f) {
+          rval = mbImpl->get_connectivity(&cell_faces[f], 1, verts);MB_CHK_ERR(rval);
+          faces.push_back(verts.size());
+          for (size_t v = 0; v < verts.size(); ++v) {
+            const int64_t idx = index(verts[v]);
+            faces.push_back(idx);
+            if (std::find(poly_conn.begin() + first_vert, poly_conn.end(), idx) == poly_conn.end())
+              poly_conn.push_back(idx);
+          }
+        }
+        face_offsets.push_back(faces.size());
+        poly_sizes.push_back(poly_conn.size() - first_vert);
+      }
+      b.num_nodes = 0;
+    }
+    else {
+      face_offsets.resize(face_offsets.size() + b.count, -1);
+      conn_size += (uint64_t)b.count * b.num_nodes;
+    }
+
+    blocks.push_back(b);
+    i += b.count;
+  }
+  conn_size += poly_conn.size();
+
+  // Connectivity as indices into the list of points
+  std::vector<int64_t> buffer;
+  buffer.reserve(CHUNK_SIZE);
+  data.begin_array(sizeof(int64_t) * conn_size);
+  for (std::vector<CellBlock>::const_iterator b = blocks.begin(); b != blocks.end(); ++b) {
+    const unsigned* order = b->vtk_type->node_order;
+    for (int e = 0; e < b->count; ++e) {
+      const EntityHandle* conn = b->conn + e * b->vpe;
+      if (buffer.size() + b->num_nodes > CHUNK_SIZE) {
+        data.write(&buffer[0], sizeof(int64_t) * buffer.size());
+        buffer.clear();
+      }
+      for (int k = 0; k < b->num_nodes; ++k)
+        buffer.push_back(index(conn[order ? order[k] : k]));
+    }
+  }
+  if (!buffer.empty())
+    data.write(&buffer[0], sizeof(int64_t) * buffer.size());
+  if (!poly_conn.empty())
+    data.write(&poly_conn[0], sizeof(int64_t) * poly_conn.size());
+  rval = data.end_array();MB_CHK_ERR(rval);
+
+  // Offset of the end of each cell's connectivity
+  buffer.clear();
+  data.begin_array(sizeof(int64_t) * elems.size());
+  int64_t offset = 0;
+  std::vector<int64_t>::const_iterator ps = poly_sizes.begin();
+  for (std::vector<CellBlock>::const_iterator b = blocks.begin(); b != blocks.end(); ++b) {
+    for (int e = 0; e < b->count; ++e) {
+      if (b->vtk_type->mb_type == MBPOLYHEDRON)
+        offset += *ps++;
+      else
+        offset += b->num_nodes;
+      buffer.push_back(offset);
+      if (buffer.size() == CHUNK_SIZE) {
+        data.write(&buffer[0], sizeof(int64_t) * buffer.size());
+        buffer.clear();
+      }
+    }
+  }
+  if (!buffer.empty())
+    data.write(&buffer[0], sizeof(int64_t) * buffer.size());
+  rval = data.end_array();MB_CHK_ERR(rval);
+
+  // VTK cell types
+  std::vector<unsigned char> types;
+  types.reserve(elems.size());
+  for (std::vector<CellBlock>::const_iterator b = blocks.begin(); b != blocks.end(); ++b)
+    types.resize(types.size() + b->count, (unsigned char)b->vtk_type->vtk_type);
+  data.begin_array(types.size());
+  if (!types.empty())
+    data.write(&types[0], types.size());
+  rval = data.end_array();MB_CHK_ERR(rval);
+
+  if (faces.empty())
+    return MB_SUCCESS;
+
+  // Face streams of polyhedra
+  data.begin_array(sizeof(int64_t) * faces.size());
+  data.write(&faces[0], sizeof(int64_t) * faces.size());
+  rval = data.end_array();MB_CHK_ERR(rval);
+
+  data.begin_array(sizeof(int64_t) * face_offsets.size());
+  data.write(&face_offsets[0], sizeof(int64_t) * face_offsets.size());
+  return data.end_array();
+}
+
+ErrorCode WriteVtu::write_tag_data(AppendedData& data, const TagArray& arr, const Range& entities)
+{
+  ErrorCode rval;
+
+  // Value written for entities for which the tag is not set.  An array
+  // without a tag is one that only exists in other parts of the mesh.
+  const int bytes = arr.length * vtk_value_size(arr.type);
+  std::vector<unsigned char> def_value(bytes, 0);
+  if (arr.tag && MB_TYPE_BIT != arr.type &&
+      MB_SUCCESS != mbImpl->tag_get_default_value(arr.tag, &def_value[0]))
+    std::fill(def_value.begin(), def_value.end(), 0);
+
+  data.begin_array((uint64_t)bytes * entities.size());
+
+  std::vector<unsigned char> buffer;
+  Range::const_iterator i = entities.begin();
+  if (arr.tag && arr.dense) {
+    // Write directly from the tag storage, a sequence at a time
+    while (i != entities.end()) {
+      int count;
+      void* ptr;
+      rval = mbImpl->tag_iterate(arr.tag, i, entities.end(), count, ptr, false);MB_CHK_ERR(rval);
+      i += count;
+      if (ptr)
+        data.write(ptr, (size_t)bytes * count);
+      else {
+        buffer.resize((size_t)bytes * count);
+        SysUtil::setmem(&buffer[0], &def_value[0], bytes, count);
+        data.write(&buffer[0], buffer.size());
+      }
+    }
+    return data.end_array();
+  }
+
+  // Sparse and bit tags: fill in a chunk at a time the values
+  // of the entities that have the tag
+  Range::const_iterator t = arr.tagged.begin();
+  while (i != entities.end()) {
+    size_t n = 0;
+    buffer.resize((size_t)bytes * CHUNK_SIZE);
+    SysUtil::setmem(&buffer[0], &def_value[0], bytes, CHUNK_SIZE);
+    for ( ; n < CHUNK_SIZE && i != entities.end(); ++n, ++i) {
+      if (t == arr.tagged.end() || *i != *t)
+        continue;
+      ++t;
+      unsigned char* val = &buffer[n * bytes];
+      if (MB_TYPE_BIT == arr.type) {
+        unsigned char bits;
+        rval = mbImpl->tag_get_data(arr.tag, &*i, 1, &bits);MB_CHK_ERR(rval);
+        for (int j = 0; j < arr.length; ++j)
+          val[j] = (bits >> j) & 1;
+      }
+      else {
+        rval = mbImpl->tag_get_data(arr.tag, &*i, 1, val);MB_CHK_ERR(rval);
+      }
+    }
+    data.write(&buffer[0], n * bytes);
+  }
+
+  return data.end_array();
+}
+
+} // namespace moab
@@ -0,0 +1,138 @@
+/**
+ * MOAB, a Mesh-Oriented datABase, is a software component for creating,
+ * storing and accessing finite element mesh data.
+ *
+ * Copyright 2004 Sandia Corporation.  Under the terms of Contract
+ * DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government
+ * retains certain rights in this software.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ */
+
+#ifndef WRITE_VTU_HPP
+#define WRITE_VTU_HPP
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "moab/Forward.hpp"
+#include "moab/Range.hpp"
+#include "moab/WriterIface.hpp"
+
+namespace moab {
+
+class WriteUtilIface;
+struct VtkElemType;
+
+/**\brief Writer for VTK XML unstructured grid (.vtu) files
+ *
+ * All heavy data is written as raw binary in an appended data section,
+ * straight from the coordinate, connectivity and dense tag arrays of
+ * MOAB, so no ASCII formatting is involved.
+ *
+ * Options:
+ *  - COMPRESS[=level] : compress the appended data with zlib
+ *                       (vtkZLibDataCompressor); requires MOAB to be
+ *                       built with zlib.
+ *  - STRICT / RELAXED : as for the legacy VTK writer, skip tags whose
+ *                       length does not fit a VTK attribute (default)
+ *                       or write them all.
+ */
+class WriteVtu : public WriterIface
+{
+
+public:
+
+   //! Constructor
+   WriteVtu(Interface *impl);
+
+   //! Destructor
+  virtual ~WriteVtu();
+
+  static WriterIface* factory( Interface* );
+
+    //! writes out a file
+  ErrorCode write_file(const char *file_name,
+                         const bool overwrite,
+                         const FileOptions& opts,
+                         const EntityHandle *output_list,
+                         const int num_sets,
+                         const std::vector<std::string>& qa_list,
+                         const Tag* tag_list = NULL,
+                         int num_tags = 0,
+                         int export_dimension = 3);
+
+protected:
+
+    //! Description of one tag written as a point or cell data array
+  struct TagArray {
+    Tag tag;         //!< Zero for an array of zeros (tag not defined locally)
+    std::string name;
+    DataType type;
+    int length;      //!< Number of components
+    bool dense;      //!< Can be read with tag_iterate
+    Range tagged;    //!< Entities for which tag is set (sparse/bit tags only)
+  };
+
+    //! Get entities to write, given set list passed to \ref write_file
+  ErrorCode gather_mesh( const EntityHandle* set_list,
+                           int num_sets,
+                           Range& nodes,
+                           Range& elems );
+
+    //! Add the vertices of the passed elements to \c nodes
+  ErrorCode get_vertex_closure( const Range& elems, Range& nodes );
+
+    //! Choose the tags to write on the passed nodes or elements
+  ErrorCode gather_tags( const Range& entities,
+                           const Tag* tag_list,
+                           int num_tags,
+                           std::vector<TagArray>& arrays );
+
+    //! Describe a tag, and find for which of the passed entities it is set
+  ErrorCode get_tag_array( Tag tag, const Range& entities, TagArray& arr );
+
+    //! Write nodes, elements and tag data as a single-piece .vtu file
+  ErrorCode write_vtu( const char* file_name,
+                         const Range& nodes,
+                         const Range& elems,
+                         const std::vector<TagArray>& node_tags,
+                         const std::vector<TagArray>& elem_tags );
+
+    //! Parse the options common to serial and parallel writes
+  ErrorCode parse_options( const FileOptions& opts );
+
+    //! Name of the VTK XML type used to store values of a tag
+  static const char* vtk_xml_type( DataType type );
+
+    //! Size in bytes of one component of a tag written as \ref vtk_xml_type
+  static int vtk_value_size( DataType type );
+
+    //! Escape a string for use in an XML attribute
+  static std::string xml_escape( const std::string& str );
+
+  Interface* mbImpl;
+  WriteUtilIface* writeTool;
+
+  bool mStrict;          //!< If true, do not write tags that do not fit a VTK attribute
+  int compressLevel;     //!< zlib compression level, or -1 for raw data
+
+private:
+
+  class AppendedData;
+
+  ErrorCode write_points( AppendedData& data, const Range& nodes );
+
+  ErrorCode write_cells( AppendedData& data, const Range& nodes, const Range& elems );
+
+  ErrorCode write_tag_data( AppendedData& data, const TagArray& arr, const Range& entities );
+};
+
+} // namespace moab
+
+#endif
@@ -53,6 +53,7 @@ namespace moab {
          * SPLITS_PER_DIR: number of candidate splits considered per direction; default = 3
          * PLANE_SET: method used to decide split planes; see CandidatePlaneSet enum (below)
          *          for possible values; default = 1 (SUBDIVISION_SNAP)
+         * FLAT_TREE=<true|false>: also copy the tree to flat in-memory arrays (see build_flat_tree); default = false
          * \param entities Entities with which to build the tree
          * \param tree_root Root set for tree (see function description)
          * \param opts Options for tree (see function description)
@@ -144,6 +145,68 @@ namespace moab {
                          double min[3], double max[3],
                          unsigned int &dep);
 
+        /** \brief Copy the tree to flat in-memory arrays
+         *
+         * The nodes are stored in one array, with the children of a node next
+         * to each other; each leaf refers to a range of an array holding the
+         * entities of all leaves, leaf after leaf, and the vertices among them
+         * are copied with their coordinates.  Once built, the flat tree is used
+         * by point_search from the root, and by the batched queries below,
+         * which do not access sets or tags, do not update the tree statistics,
+         * and can be called concurrently.  The flat tree is freed by
+         * reset_tree, and must be built again if the tree is modified.
+         */
+      ErrorCode build_flat_tree();
+
+        //! True if build_flat_tree was called since the last reset_tree
+      bool has_flat_tree() const { return !flatNodes.empty(); }
+
+        /** \brief Get the leaves containing a set of points, with the flat tree
+         * \param points Coordinates of the points, 3 per point
+         * \param num_points Number of points
+         * \param leaves_out Leaf containing each point, 0 for points outside
+         *        the bounding box of the tree
+         * \param iter_tol Tolerance on the bounding box of the tree
+         */
+      ErrorCode point_search(const double *points,
+                             unsigned num_points,
+                             std::vector<EntityHandle>& leaves_out,
+                             const double iter_tol = 1.0e-10) const;
+
+        /** \brief Find the k vertices closest to each of a set of points, with the flat tree
+         * Only the vertices in the tree are considered.
+         * \param points Coordinates of the points, 3 per point
+         * \param num_points Number of points
+         * \param k Number of vertices to find for each point
+         * \param verts_out k vertices for each point, by increasing distance;
+         *        padded with 0 if the tree has fewer than k vertices
+         * \param dists_out If non-NULL, distances to the vertices in verts_out
+         *        (HUGE_VAL for padding)
+         */
+      ErrorCode nearest_vertices(const double *points,
+                                 unsigned num_points,
+                                 unsigned k,
+                                 std::vector<EntityHandle>& verts_out,
+                                 std::vector<double> *dists_out = NULL) const;
+
+        /** \brief Find the vertices within a distance of each of a set of points, with the flat tree
+         * Only the vertices in the tree are considered.
+         * \param points Coordinates of the points, 3 per point
+         * \param num_points Number of points
+         * \param distance Search radius
+         * \param verts_out Vertices found, for one point after the other, by
+         *        increasing distance
+         * \param offsets Vertices for point i are verts_out[offsets[i]] up to
+         *        verts_out[offsets[i+1]]
+         * \param dists_out If non-NULL, distances to the vertices in verts_out
+         */
+      ErrorCode vertices_in_radius(const double *points,
+                                   unsigned num_points,
+                                   double distance,
+                                   std::vector<EntityHandle>& verts_out,
+                                   std::vector<unsigned>& offsets,
+                                   std::vector<double> *dists_out = NULL) const;
+
         //! Enumeriate split plane directions
       enum Axis { X = 0, Y = 1, Z = 2 };
 
@@ -319,6 +382,32 @@ namespace moab {
                                                  std::vector<EntityHandle>& indices,
                                                  double eps );
 
+        /** find the flat leaf containing a point, descending from the root */
+      unsigned flat_leaf( const double *point ) const;
+
+        /** find the k closest vertices to one point, by increasing distance */
+      void flat_nearest( const double *point, unsigned k,
+                         std::vector<std::pair<double,unsigned> >& result ) const;
+
+        /** find the vertices within distance of one point, by increasing distance */
+      void flat_in_radius( const double *point, double distance,
+                           std::vector<std::pair<double,unsigned> >& result ) const;
+
+        //! Node of the flat tree
+      struct FlatNode {
+        double coord;       //!< split plane location (inner nodes)
+        int norm;           //!< split plane normal, -1 for leaves
+        unsigned child;     //!< index of left child; the right child follows it
+        unsigned firstEnt, numEnts;    //!< leaf entities in flatEnts
+        unsigned firstVert, numVerts;  //!< leaf vertices in flatVerts
+        EntityHandle handle;           //!< tree node set
+      };
+
+      std::vector<FlatNode> flatNodes;       //!< flat tree, root first
+      std::vector<EntityHandle> flatEnts;    //!< entities of the leaves, leaf after leaf
+      std::vector<EntityHandle> flatVerts;   //!< vertices of the leaves, leaf after leaf
+      std::vector<double> flatCoords;        //!< coordinates of flatVerts
+
       static const char *treeName;
 
       Tag planeTag, axisTag;
@@ -329,6 +418,8 @@ namespace moab {
 
       bool spherical;
       double radius;
+
+      bool flatTree;
     };
 
 
@@ -498,6 +589,10 @@ namespace moab {
 
     inline ErrorCode AdaptiveKDTree::reset_tree()
     {
+      flatNodes.clear();
+      flatEnts.clear();
+      flatVerts.clear();
+      flatCoords.clear();
       return delete_tree_sets();
     }
 
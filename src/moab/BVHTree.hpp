@@ -55,6 +55,12 @@ namespace moab {
          * SPLITS_PER_DIR: number of candidate splits considered per direction; default = 3
          * CANDIDATE_PLANE_SET: method used to decide split planes; see CandidatePlaneSet enum (below)
          *          for possible values; default = 1 (SUBDIVISION_SNAP)
+         * BINNED_SAH=<true|false>: choose splits with the surface area heuristic over binned element
+         *          centroids, build with OpenMP threads if available, and store single precision boxes;
+         *          default = false
+         * SAH_BINS: number of bins per direction for BINNED_SAH; default = 16
+         * ENTITY_SETS=<true|false>: if false, build with BINNED_SAH and keep the tree in memory only,
+         *          without entity sets for the nodes (see point_search); default = true
          * \param entities Entities with which to build the tree
          * \param tree_root Root set for tree (see function description)
          * \param opts Options for tree (see function description)
@@ -81,6 +87,11 @@ namespace moab {
          *          the input point
          * \param start_node Start from this tree node (non-NULL) instead of tree root (NULL)
          * \return Non-success returned only in case of failure; not-found indicated by leaf_out=0
+         *
+         * If the tree was built with ENTITY_SETS=false, there are no leaf sets, and leaf_out is
+         * an element: the one containing the point if an evaluator is set and params is non-NULL,
+         * else the first one whose bounding box contains the point.  start_node must be NULL or
+         * the tree root.
          */
       virtual ErrorCode point_search(const double *point,
                                      EntityHandle& leaf_out,
@@ -104,6 +115,9 @@ namespace moab {
          * \param result_dists If non-NULL, will contain distsances to leaves
          * \param result_params If non-NULL, will contain parameters of the point in the ents in leaves_out
          * \param tree_root Start from this tree node (non-NULL) instead of tree root (NULL)
+         *
+         * If the tree was built with ENTITY_SETS=false, result_list holds the elements whose
+         * bounding box is within distance, instead of leaves.
          */
       virtual ErrorCode distance_search(const double from_point[3],
                                         const double distance,
@@ -271,10 +285,53 @@ namespace moab {
         // print tree nodes
       ErrorCode print_nodes(std::vector<Node> &nodes);
 
+        //! Element of a tree built with BINNED_SAH, with its bounding box in single precision
+      class SAHPrim {
+    public:
+        float bMin[3], bMax[3];
+        EntityHandle handle;
+      }; // SAHPrim
+
+        //! Node of a tree built with BINNED_SAH
+      class SAHNode {
+    public:
+        float bMin[3], bMax[3];
+        unsigned int child; // inner nodes: left child, the right one follows; leaves: first element
+        unsigned int count; // number of elements in leaves, 0 for inner nodes
+      }; // SAHNode
+
+        // compute the bounding boxes of the elements, rounded outwards to single precision,
+        // and the bounding box of all elements
+      ErrorCode construct_sah_prims(const Range &elements, std::vector<SAHPrim> &prims,
+                                    BoundBox &box) const;
+
+        // choose the binned SAH split of [begin,end), partition the elements and set the
+        // boxes of the children; returns the number of elements on the left
+      size_t sah_split(SAHPrim *begin, SAHPrim *end, SAHNode &left, SAHNode &right) const;
+
+        // build the subtree of [begin,end) rooted at nodes[index]; returns its depth
+      int sah_build_subtree(std::vector<SAHNode> &nodes, const unsigned int index,
+                            SAHPrim *begin, SAHPrim *end, const int depth) const;
+
+        // build sahNodes over sahPrims
+      ErrorCode build_sah_tree();
+
+        // convert sahNodes to myTree and a bunch of entity sets, then free them
+      ErrorCode convert_sah_tree();
+
+        // get the elements whose box is within distance of point, and the squared distances
+      void sah_search(const double *point, const double distance,
+                      std::vector<std::pair<double, EntityHandle> > &result);
+
       Range entityHandles;
       std::vector<TreeNode> myTree;
       int splitsPerDir;
       EntityHandle startSetHandle;
+      bool binnedSAH;
+      int sahBins;
+      bool entitySets;
+      std::vector<SAHNode> sahNodes;  // tree built with BINNED_SAH, kept if ENTITY_SETS=false
+      std::vector<SAHPrim> sahPrims;  // elements of the leaves of sahNodes, leaf after leaf
       static const char *treeName;
     }; //class Bvh_tree
 
@@ -306,7 +363,8 @@ namespace moab {
     }
 
     inline BVHTree::BVHTree(Interface *impl) :
-            Tree(impl), splitsPerDir(3), startSetHandle(0) {boxTagName = treeName;}
+            Tree(impl), splitsPerDir(3), startSetHandle(0), binnedSAH(false), sahBins(16), entitySets(true)
+    {boxTagName = treeName;}
 
     inline unsigned int BVHTree::set_interval(BoundBox &interval,
                                               std::vector<Bucket>::const_iterator begin,
@@ -383,6 +441,8 @@ namespace moab {
 
     inline ErrorCode BVHTree::reset_tree()
     {
+      sahNodes.clear();
+      sahPrims.clear();
       return delete_tree_sets();
     }
 
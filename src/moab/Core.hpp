@@ -177,6 +177,14 @@ public:
                                    double*& zcoords_ptr,
                                    int& count);
 
+    //! get pointers to single precision coordinate data
+  virtual ErrorCode coords_iterate(Range::const_iterator iter,
+                                   Range::const_iterator end,
+                                   float*& xcoords_ptr,
+                                   float*& ycoords_ptr,
+                                   float*& zcoords_ptr,
+                                   int& count);
+
   //! get the coordinate information for this handle if it is of type Vertex
   //! otherwise, return an error
   virtual ErrorCode  get_coords(const Range &entity_handles,
@@ -1325,6 +1333,17 @@ public:
      */
     virtual void set_sequence_multiplier(double factor);
 
+    /** \brief Interface to control the precision of vertex coordinates
+     * If true, vertices created with create_vertex or create_vertices in
+     * new sequences store their coordinates in single precision.
+     */
+    virtual bool get_float_coordinates() const;
+
+    /** \brief Interface to control the precision of vertex coordinates
+     * \param flag If true, store coordinates of new vertices in single precision
+     */
+    virtual void set_float_coordinates(bool flag);
+
 
   /**@}*/
 
@@ -1403,7 +1422,6 @@ private:
 
 #ifdef MOAB_HAVE_AHF
   HalfFacetRep *ahfRep;
-  bool mesh_modified;
 #endif
 
 };
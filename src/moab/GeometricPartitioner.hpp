@@ -0,0 +1,124 @@
+/**
+ * MOAB, a Mesh-Oriented datABase, is a software component for creating,
+ * storing and accessing finite element mesh data.
+ *
+ * Copyright 2004 Sandia Corporation.  Under the terms of Contract
+ * DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government
+ * retains certain rights in this software.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ */
+
+#ifndef __geometricpartitioner_hpp__
+#define __geometricpartitioner_hpp__
+
+#include <stdlib.h>
+#include "moab/PartitionerBase.hpp"
+
+namespace moab {
+
+  class Interface;
+  class Range;
+}
+
+  /** \class GeometricPartitioner
+   * \brief Built-in partitioner working on element centroids only
+   *
+   * Needs no third-party library. Supported methods are recursive coordinate
+   * bisection ("RCB") and splitting of the Hilbert ("HILBERT") or Morton ("MORTON")
+   * space-filling curve into equal pieces. Centroids and curve keys are computed
+   * with OpenMP when MOAB is built with it. With MPI, every rank partitions its own
+   * elements and the cuts are agreed on through reductions over the communicator,
+   * so the result is a global partition.
+   */
+  class GeometricPartitioner : public PartitionerBase<int>
+  {
+
+  public:
+    GeometricPartitioner( moab::Interface *impl = NULL,
+                          const bool use_coords = false);
+
+    virtual ~GeometricPartitioner();
+
+    virtual moab::ErrorCode partition_mesh_and_geometry(const double part_geom_mesh_size,
+                                                        const int nparts,
+                                                        const char *zmethod,
+                                                        const char *other_method,
+                                                        double imbal_tol,
+                                                        const int part_dim = 3,
+                                                        const bool write_as_sets = true,
+                                                        const bool write_as_tags = false,
+                                                        const int obj_weight = 0,
+                                                        const int edge_weight = 0,
+                                                        const bool part_surf = false,
+                                                        const bool ghost = false,
+                                                        const bool spherical_coords = false,
+                                                        const bool print_time = false);
+
+    virtual moab::ErrorCode partition_mesh( const int nparts,
+                                            const char *method,
+                                            const int part_dim = 3,
+                                            const bool write_as_sets = true,
+                                            const bool write_as_tags = false,
+                                            const bool partition_tagged_sets = false,
+                                            const bool partition_tagged_ents = false,
+                                            const char *aggregating_tag = NULL,
+                                            const bool print_time = false);
+
+    virtual moab::ErrorCode write_partition(const int nparts, moab::Range &elems,
+                                      const int *assignment,
+                                      const bool write_as_sets,
+                                      const bool write_as_tags);
+
+      // put closure of entities in the part sets too
+    virtual moab::ErrorCode include_closure();
+
+      //! Project centroids on the unit sphere before partitioning
+    void set_project_on_sphere(bool project) {projectOnSphere = project;}
+
+  private:
+
+    moab::ErrorCode compute_centroids(moab::Range &elems,
+                                      std::vector<double> &centroids);
+
+    moab::ErrorCode rcb_partition(const int nparts,
+                                  const std::vector<double> &centroids,
+                                  std::vector<int> &assignment);
+
+    moab::ErrorCode sfc_partition(const int nparts,
+                                  const std::vector<double> &centroids,
+                                  const bool hilbert,
+                                  std::vector<int> &assignment);
+
+    bool projectOnSphere;
+  };
+
+// Inline functions
+
+inline
+moab::ErrorCode GeometricPartitioner::partition_mesh_and_geometry(const double ,
+                                                        const int nparts,
+                                                        const char *zmethod,
+                                                        const char *,
+                                                        double ,
+                                                        const int part_dim,
+                                                        const bool write_as_sets,
+                                                        const bool write_as_tags,
+                                                        const int ,
+                                                        const int ,
+                                                        const bool ,
+                                                        const bool ,
+                                                        const bool spherical_coords,
+                                                        const bool print_time)
+{
+  // Only partition the mesh - no geometric partition available
+  projectOnSphere = spherical_coords;
+  return partition_mesh( nparts, zmethod, part_dim, write_as_sets, write_as_tags, false, false, NULL, print_time);
+}
+
+#endif
+
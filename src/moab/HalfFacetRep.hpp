@@ -43,7 +43,10 @@ namespace moab
  *  \        CURRENTLY NOT SUPPORTED:
  *  \        1. Meshes with mixed entity types of same dimension. Ex. a volume mesh with both tets and prisms.
  *  \        2. create_if_missing = true
- *  \        3. Modified meshes
+ *  \
+ *  \        Modified meshes: edges, faces and cells are stitched into (or cut out of) the maps as they are created
+ *  \        or deleted, see notify_create_entity() and notify_delete_entity(). A modification the maps cannot hold
+ *  \        drops them, and they are rebuilt at the next query.
  *  \
  */
 
@@ -90,6 +93,9 @@ public:
   //! Deinitialize
   ErrorCode deinitialize();
 
+  //! Whether the maps are built; notifications the maps cannot be patched for drop them
+  bool is_initialized() const { return mInitAHFmaps; }
+
   //! Prints the tag values.
   ErrorCode print_tags(int dim);
 
@@ -142,6 +148,25 @@ public:
 
   ErrorCode get_down_adjacencies(EntityHandle ent, int out_dim, std::vector<EntityHandle> &adjents);
 
+  //! Update the maps for a newly created entity.
+  /** Edges, faces and cells are stitched into the sibling and incident maps in place. A new entity of
+     *  a mixed or unsupported type, a face shared by a third cell, or any entity when the maps cover a set
+     *  or skip ghosts drops the maps, which are then rebuilt at the next query.
+     *
+     * \param entity EntityHandle of the entity that was just created.
+     */
+
+  ErrorCode notify_create_entity(EntityHandle entity);
+
+  //! Update the maps for an entity that is about to be deleted.
+  /** Must be called while the entity still exists. A connectivity change is handled as a delete
+     *  notification before the change followed by a create notification after it.
+     *
+     * \param entity EntityHandle of the entity that is going away.
+     */
+
+  ErrorCode notify_delete_entity(EntityHandle entity);
+
 
   // 1D Maps and queries
 
@@ -439,6 +464,14 @@ public:
 
   ErrorCode resize_hf_maps(EntityHandle start_vert, int nverts, EntityHandle start_edge, int nedges, EntityHandle start_face, int nfaces, EntityHandle start_cell, int ncells);
 
+  //! Iterator-style access to the sibling half-facets of ent, in local id order, so that queries walk
+  //! the maps without dispatching on the entity type; decode them with fid_from_halfacet() and
+  //! lid_from_halffacet(). ent must be an edge, a face or a cell of the mesh; both are NULL if
+  //! there is no sibling map for its type.
+  const HFacet* sibling_begin(EntityHandle ent) const;
+
+  const HFacet* sibling_end(EntityHandle ent) const;
+
   ErrorCode get_sibling_map(EntityType type, EntityHandle ent, EntityHandle *sib_entids, int *sib_lids, int num_halffacets);
 
   ErrorCode get_sibling_map(EntityType type, EntityHandle ent, int lid, EntityHandle &sib_entid, int &sib_lid);
@@ -499,7 +532,8 @@ public:
   static const LocalMaps3D lConnMap3D[4];
   MESHTYPE thismeshtype;
 
-   std::map<EntityType, int> cell_index;
+   //! Index of each cell type in lConnMap3D, -1 for the other types
+   int cell_index[MBMAXTYPE];
 
   int get_index_in_lmap(EntityHandle cid);
   ErrorCode get_entity_ranges(Range &verts, Range &edges, Range &faces, Range &cells);
@@ -524,6 +558,10 @@ protected:
   std::vector<HFacet> sibhes, v2he;
   std::vector<HFacet> sibhfs, v2hf;
 
+  //Sibling map and number of half-facets per entity of each type, NULL and 0 for the types without one
+  std::vector<HFacet>* sib_map[MBMAXTYPE];
+  int sib_nhf[MBMAXTYPE];
+
   //AHF maps for non-manifold vertices 2D, 3D
   std::multimap<EntityHandle, HFacet> v2hes, v2hfs;
 
@@ -547,6 +585,25 @@ protected:
   ErrorCode init_surface();
   ErrorCode init_volume();
 
+  //! Drop all the maps; they are rebuilt by the next call to initialize()
+  void invalidate_maps();
+
+  //! Link a new entity into the sibling maps and the incident maps of its vertices, or unlink one going away
+  ErrorCode add_edge_to_maps(EntityHandle eid);
+  ErrorCode remove_edge_from_maps(EntityHandle eid);
+  ErrorCode add_face_to_maps(EntityHandle fid);
+  ErrorCode remove_face_from_maps(EntityHandle fid);
+  //! patched is false if a face of the cell already has two cells, then the maps have to be rebuilt
+  ErrorCode add_cell_to_maps(EntityHandle cid, bool &patched);
+  ErrorCode remove_cell_from_maps(EntityHandle cid);
+
+  //! Recompute v2he or v2hf of a vertex, walking each component of its star once
+  /** \param type Type of the faces or cells of the star
+     * \param skip An entity of the star that is being deleted
+     * \param starts Entities of the star that reach the components the current incident half-facets may miss
+     */
+  ErrorCode reset_incident_halffacets(EntityHandle vid, EntityType type, EntityHandle skip, std::vector<EntityHandle> &starts);
+
   //! Contains the local information for 2D entities
   /** Given a face, find the face type specific information
      *
@@ -634,6 +691,9 @@ protected:
     ErrorCode add_cells_of_single_component(EntityHandle vid, EntityHandle curcid, int curlid, std::multimap<EntityHandle, EntityHandle> &comps, HFacet &hf);
     bool find_cell_in_component(EntityHandle vid, EntityHandle cell, std::multimap<EntityHandle, EntityHandle> &comps);
 
+    //! Adds the faces of the component of the star of vid holding curfid, and returns a boundary half-edge of it
+    ErrorCode add_faces_of_single_component(EntityHandle vid, EntityHandle curfid, std::multimap<EntityHandle, EntityHandle> &comps, HFacet &hf);
+
     //! Given an edge, finds a matching local edge in an incident cell.
     /** Find a local edge with the same connectivity as the input edge, belonging to an incident cell.
      *
@@ -392,6 +392,19 @@ public:
                                      /**< Number of entities for which returned pointers are valid/contiguous */
                                    ) = 0;
 
+    //! get pointers to single precision coordinate data
+    /** As coords_iterate above, for vertices whose coordinates are stored in
+     * single precision (see set_float_coordinates).  Each overload returns
+     * MB_TYPE_OUT_OF_RANGE, without setting an error, if the vertex at \c iter
+     * is stored in the other precision.
+     */
+  virtual ErrorCode coords_iterate(Range::const_iterator iter,
+                                   Range::const_iterator end,
+                                   float*& xcoords_ptr,
+                                   float*& ycoords_ptr,
+                                   float*& zcoords_ptr,
+                                   int& count) = 0;
+
     //! Gets xyz coordinate information for range of vertices
     /** Length of 'coords' should be at least 3*<em>entity_handles.size()</em> before making call.
         \param entity_handles Range of vertex handles (error if not of type MBVERTEX)
@@ -1238,7 +1251,10 @@ public:
      * with MOAB entities.  If the tag does not already exist then
      * \c flags should contain exactly one of \c MB_TAG_SPARSE,
      * \c MB_TAG_DENSE, \c MB_TAG_MESH unless \c type is MB_TYPE_BIT,
-     * which implies \c MB_TAG_BIT storage.
+     * which implies \c MB_TAG_BIT storage.  A dense, fixed-length
+     * \c MB_TYPE_DOUBLE tag created with \c MB_TAG_FLOAT stores its
+     * values as float, converting them in tag_get_data and tag_set_data;
+     * tag_iterate and tag_get_by_ptr return \c MB_TYPE_OUT_OF_RANGE for it.
      * .
      *\param name          The tag name
      *\param size          Tag size as number of values of of data type per entity
@@ -2046,6 +2062,23 @@ public:
      */
     virtual void set_sequence_multiplier(double factor) = 0;
 
+    /** \brief Interface to control the precision of vertex coordinates
+     * If true, vertices created with create_vertex or create_vertices in
+     * new sequences store their coordinates in single precision, halving
+     * the memory used for them.  get_coords and set_coords convert to and
+     * from double; get_coords returning pointers, and coords_iterate with
+     * double pointers, fail for these vertices.  Vertices created by file
+     * readers are always stored in double precision.  The default is false.
+     */
+    virtual bool get_float_coordinates() const = 0;
+
+    /** \brief Interface to control the precision of vertex coordinates
+     * See get_float_coordinates.
+     *
+     * \param flag If true, store coordinates of new vertices in single precision
+     */
+    virtual void set_float_coordinates(bool flag) = 0;
+
 
   /**@}*/
 
@@ -250,6 +250,11 @@ protected:
   ErrorCode subdivide_cells(EntityType type, int cur_level, int deg);
   ErrorCode subdivide_tets(int cur_level, int deg);
 
+  // Helpers of the (optionally threaded) cell refinement
+  ErrorCode get_cell_conn_pointers(int cur_level, std::vector<const EntityHandle*> &cell_conn);
+  ErrorCode number_new_cell_verts(EntityType type, int cur_level, int deg, std::vector<const EntityHandle*> &cell_conn, std::vector<EntityHandle> &trackvertsC_edg, std::vector<EntityHandle> &trackvertsC_face, std::vector<EntityHandle> &vfirst);
+  void get_cell_vbuffer(EntityType type, int cur_level, int deg, int cid, const EntityHandle *conn, const std::vector<EntityHandle> &trackvertsC_edg, const std::vector<EntityHandle> &trackvertsC_face, const EntityHandle *vown, EntityHandle *vbuffer);
+
   // General helper functions
   ErrorCode copy_vertices_from_prev_level(int cur_level);
   ErrorCode count_subentities(EntityHandle set, int cur_level, int *nedges, int *nfaces);
@@ -283,13 +288,16 @@ protected:
   ErrorCode print_maps_3D(int level, EntityType type);
 
   // Coordinates
-  ErrorCode compute_coordinates(int cur_level, int deg, EntityType type, EntityHandle *vbuffer, int vtotal, double *corner_coords, std::vector<int> &vflag, int nverts_prev);
+  // When vown is given, only the vertices with handles in [vown[0], vown[1]) are computed and vflag is not used
+  ErrorCode compute_coordinates(int cur_level, int deg, EntityType type, EntityHandle *vbuffer, int vtotal, double *corner_coords, std::vector<int> &vflag, int nverts_prev, const EntityHandle *vown = NULL);
 
   // Update the ahf maps
 
-  ErrorCode update_local_ahf(int deg, EntityType type, EntityHandle *vbuffer, EntityHandle *ent_buffer, int etotal);
+  // When vown is given, the maps of the children are assumed empty and only the incident maps of the vertices
+  // with handles in [vown[0], vown[1]) are set; this is safe to call for different cells at the same time
+  ErrorCode update_local_ahf(int deg, EntityType type, EntityHandle *vbuffer, EntityHandle *ent_buffer, int etotal, const EntityHandle *vown = NULL);
 
-  ErrorCode update_local_ahf(int deg, EntityType type, int pat_id, EntityHandle *vbuffer, EntityHandle *ent_buffer, int etotal);
+  ErrorCode update_local_ahf(int deg, EntityType type, int pat_id, EntityHandle *vbuffer, EntityHandle *ent_buffer, int etotal, const EntityHandle *vown = NULL);
 
   //  ErrorCode update_global_ahf(EntityType type, int cur_level, int deg);
 
@@ -123,6 +123,43 @@ public:
   static inline void reorder(const int* order, EntityHandle* conn,
                              int num_elem, int node_per_elem);
 
+  /**\brief Copy interleaved vertex coordinates into the coordinate arrays
+   *
+   * Store the coordinates of the vertices at positions
+   * [offset, offset+count) of the arrays returned by get_node_coords.
+   * Calls for disjoint ranges of vertices write disjoint parts of the
+   * arrays, so a reader may fill a block of vertices chunk by chunk
+   * from multiple threads.
+   *\param arrays The coordinate arrays returned by get_node_coords
+   *\param offset Position of the first vertex to set
+   *\param count  The number of vertices to set
+   *\param xyz    The coordinates of the vertices, 3*count values
+   */
+  template <typename T> static inline
+  void set_node_coords(const std::vector<double*>& arrays, size_t offset,
+                       size_t count, const T* xyz);
+
+  /**\brief Store element connectivity from vertex indices
+   *
+   * Set the connectivity of the elements at positions [offset, offset+count)
+   * of an array returned by get_element_connect, the handle of each vertex
+   * being \c vertex_offset plus its index.  Calls for disjoint ranges of
+   * elements write disjoint parts of the array, so a reader may fill a
+   * block of elements chunk by chunk from multiple threads.
+   *\param conn  The connectivity array returned by get_element_connect
+   *\param offset Position of the first element to set
+   *\param count The number of elements to set
+   *\param node_per_elem The number of nodes in each element's connectivity list.
+   *\param ids   The vertex indices of the elements, count*node_per_elem values
+   *\param vertex_offset The handle of the vertex with index zero
+   *\param order If not NULL, a permutation as for \ref reorder, from the
+   *             order of \c ids to the MBCN order
+   */
+  template <typename T> static inline
+  void set_element_connect(EntityHandle* conn, size_t offset, size_t count,
+                           int node_per_elem, const T* ids,
+                           EntityHandle vertex_offset, const int* order = 0);
+
   //! Given an ordered list of bounding entities and the sense of
   //! those entities, return an ordered list of vertices
   virtual ErrorCode get_ordered_vertices(EntityHandle *bound_ents,
@@ -162,6 +199,39 @@ inline void ReadUtilIface::reorder(const int* order, EntityHandle* conn,
   }
 }
 
+template <typename T> inline
+void ReadUtilIface::set_node_coords(const std::vector<double*>& arrays,
+                                    size_t offset, size_t count, const T* xyz)
+{
+  double* x = arrays[0] + offset;
+  double* y = arrays[1] + offset;
+  double* z = arrays[2] + offset;
+  for (size_t i = 0; i < count; ++i) {
+    x[i] = xyz[3*i];
+    y[i] = xyz[3*i + 1];
+    z[i] = xyz[3*i + 2];
+  }
+}
+
+template <typename T> inline
+void ReadUtilIface::set_element_connect(EntityHandle* conn, size_t offset,
+                                        size_t count, int node_per_elem,
+                                        const T* ids, EntityHandle vertex_offset,
+                                        const int* order)
+{
+  conn += offset * node_per_elem;
+  if (order) {
+    for (size_t i = 0; i < count; ++i, conn += node_per_elem, ids += node_per_elem)
+      for (int j = 0; j < node_per_elem; ++j)
+        conn[order[j]] = vertex_offset + ids[j];
+  }
+  else {
+    const size_t n = count * node_per_elem;
+    for (size_t i = 0; i < n; ++i)
+      conn[i] = vertex_offset + ids[i];
+  }
+}
+
 } // namespace moab
 
 #endif
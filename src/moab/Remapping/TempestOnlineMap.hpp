@@ -18,6 +18,7 @@
 
 #include <string>
 #include <vector>
+#include <map>
 
 #ifdef MOAB_HAVE_EIGEN
 #include <Eigen/Sparse>
@@ -337,6 +338,25 @@ public:
 	///	</summary>
 	moab::ErrorCode WriteParallelMap (std::string strOutputFile) const;
 
+	///	<summary>
+	///		Parallel I/O with NetCDF to read a precomputed SCRIP/ESMF map file (n_a, n_b, n_s, row, col, S)
+	///     from multiple processors. Every rank reads only a contiguous slab of the nonzero entries, which
+	///     are then routed to the rank that owns the corresponding row. The local CSR Eigen matrix and the
+	///     row/column DoF maps are built directly; col_gdofmap lists the source DoFs needed locally, and
+	///     the communication graph from the ranks owning them is setup without computing any overlap.
+	///     If \p owned_dof_ids (1-based global target DoF IDs) is empty, rows are block-partitioned;
+	///     likewise for the source DoFs owned by this rank, \p owned_src_dof_ids.
+	///	</summary>
+	moab::ErrorCode ReadParallelMap (const char* strSource, const std::vector<int>& owned_dof_ids,
+	                                 const std::vector<int>& owned_src_dof_ids = std::vector<int>());
+
+	///	<summary>
+	///		Gather the source values needed by the local rows of a map read with ReadParallelMap, using its
+	///     communication graph. \p ownedSrcVals follows the owned source DoFs given to ReadParallelMap;
+	///     \p srcVals is ordered as col_gdofmap and can be passed to ApplyWeights.
+	///	</summary>
+	moab::ErrorCode ExchangeSourceValues (const std::vector<double>& ownedSrcVals, std::vector<double>& srcVals);
+
 #endif
 
 public:
@@ -363,6 +383,15 @@ public:
 	WeightRowVector m_rowVector;
 	WeightColVector m_colVector;
 
+	///	<summary>
+	///		Communication graph of a map read with ReadParallelMap: the source DoFs owned by this rank,
+	///     and for every rank, the positions in m_srcOwnedDofs of the source values it needs.
+	///	</summary>
+	std::vector<int> m_srcOwnedDofs;
+	std::map<int, std::vector<int> > m_srcSendGraph;
+
+	moab::ErrorCode SetupSourceCommGraph (int nA, const std::vector<int>& neededCols, const std::vector<int>& owned_src_dof_ids);
+
 #endif
 
 	///	<summary>
@@ -101,6 +101,37 @@ class ReorderTool
     ErrorCode handle_order_from_sets_and_adj( const Range& sets,
                                               Tag& new_handle_tag_out );
 
+    /**\brief Calculate new handle order by reverse Cuthill-McKee
+     *
+     * Order elements of the specified dimension by reverse Cuthill-McKee
+     * on their dual graph, such that elements sharing a side get nearby
+     * handles.  Two elements are considered to share a side if they have
+     * at least \c dim vertices in common.  Vertices are then ordered by
+     * their first use in the new element order.  Entities of other
+     * dimensions keep their current handles.
+     *
+     *\param dim           Dimension of elements to order, or -1 for the
+     *                     largest dimension present in the mesh.
+     *\param new_handle_tag_out  Passed back new tag handle containing the
+     *                     entity mapping, as for \c handle_order_from_int_tag.
+     *                     The caller is responsible for releasing the tag.
+     */
+    ErrorCode handle_order_rcm( int dim, Tag& new_handle_tag_out );
+
+    /**\brief Calculate new handle order along a space-filling curve
+     *
+     * Order vertices by the position of their coordinates, and elements by
+     * the position of their centroid, along a Hilbert or Morton curve laid
+     * over the bounding box of the mesh.
+     *
+     *\param hilbert       Use the Hilbert curve if true, Morton (Z-order)
+     *                     curve otherwise.
+     *\param new_handle_tag_out  Passed back new tag handle containing the
+     *                     entity mapping, as for \c handle_order_from_int_tag.
+     *                     The caller is responsible for releasing the tag.
+     */
+    ErrorCode handle_order_sfc( bool hilbert, Tag& new_handle_tag_out );
+
     /**\brief Do the re-ordering indicated by the passed handle tag.
      *
      * The specified re-ordering must be a permutation.  Each existing
@@ -185,6 +216,18 @@ class ReorderTool
                                            int skip_val,
                                            std::vector<std::vector<EntityHandle>*>& data );
 
+    /**\brief convert a list of entities and their positions in the
+     *        new order to the output of \c handle_order_from_int_tag
+     */
+    ErrorCode handle_order_from_positions( const std::vector<EntityHandle>& entities,
+                                           const std::vector<int>& positions,
+                                           Tag& new_handle_tag_out );
+
+    /**\brief Get corner vertices of an element, including polyhedra */
+    ErrorCode get_element_vertices( EntityHandle elem,
+                                    std::vector<EntityHandle>& verts,
+                                    std::vector<EntityHandle>& storage );
+
     Core* mMB;
 };
 
@@ -20,6 +20,9 @@
 
 #include "moab/Types.hpp"
 #include <string>
+#include <vector>
+#include <iterator>
+#include <cstddef>
 
 /* Integral types defined here to ensure variable type sizes are consistent */
 /* integer type to use for everything */
@@ -122,6 +125,158 @@ namespace moab
 
     };
 
+    /*---------------------------------------------------------------------------
+
+      builder: append-only assembly of a TupleList
+
+      Tuples are appended to segments that are never reallocated while the
+      list is assembled; a full segment is kept and a new one started.  The
+      first segment becomes the storage of the finalized TupleList: finalize
+      only resizes it to the number of tuples and copies the later segments
+      behind it.  With an estimate of the number of tuples as the size of the
+      first segment, the list is assembled without copies and without extra
+      capacity; when the estimate is exceeded, the excess tuples are copied
+      once.  Finalize before sorting or sending the list.
+
+      Usage:
+
+      TupleList::builder tb(1, 0, 1, 3, estimate);
+      sint *sp; slong *lp; Ulong *ulp; realType *rp;
+      for (...) {
+        tb.append(sp, lp, ulp, rp);  // or tb.push_back(...)
+        sp[0] = ...; ulp[0] = ...; rp[0] = ...; ...
+      }
+      TupleList tl;
+      tb.finalize(tl);
+
+      ---------------------------------------------------------------------------*/
+    class builder
+    {
+    public:
+      /**Constructor taking the tuple layout, as TupleList::initialize
+       *
+       * param first_size  capacity of the first segment, in tuples; later
+       *                   segments hold as many tuples as all previous ones
+       */
+      builder(uint mi, uint ml, uint mul, uint mr, uint first_size = 1024);
+
+      ~builder () { this->reset(); };
+
+      /**Appends a tuple and returns where its values are to be written;
+       * pointers are NULL for the types that are not part of the tuple.
+       * The pointers stay valid until finalize or reset.
+       */
+      void append(sint *&sp, slong *&ip, Ulong *&lp, realType *&dp)
+      {
+        if (!segLeft)
+          new_segment();
+        segment &seg = segments.back();
+        sp = seg.vi ? seg.vi + (size_t)seg.n*mi : NULL;
+        ip = seg.vl ? seg.vl + (size_t)seg.n*ml : NULL;
+        lp = seg.vul ? seg.vul + (size_t)seg.n*mul : NULL;
+        dp = seg.vr ? seg.vr + (size_t)seg.n*mr : NULL;
+        seg.n++, segLeft--, n++;
+      }
+
+      /**Appends a tuple, copying its values; as TupleList::push_back
+       */
+      void push_back(const sint *sp, const slong *ip,
+                     const Ulong *lp, const realType *dp);
+
+      /**Number of tuples appended
+       */
+      uint get_n() const { return n; };
+
+      /**Moves the tuples to tl, which is reinitialized with the layout of the
+       * builder and a capacity of get_n() tuples; the builder is empty after
+       */
+      void finalize(TupleList &tl);
+
+      /**Frees all segments
+       */
+      void reset();
+
+    private:
+      struct segment { sint *vi; slong *vl; Ulong *vul; realType *vr; uint max, n; };
+
+      void new_segment();
+
+      uint mi, ml, mul, mr;
+      uint n, firstSize, segLeft;
+      std::vector<segment> segments;
+
+      builder(const builder&);
+      builder& operator=(const builder&);
+    };
+
+    /*---------------------------------------------------------------------------
+
+      column: read-only view of the m'th value of one type in all tuples,
+      e.g. the destination procs of a list before gs_transfer
+
+      TupleList::column<const sint> procs = tl.vi_column(0);
+      for (uint i = 0; i < procs.size(); i++) ... procs[i] ...
+      std::count(procs.begin(), procs.end(), rank);
+
+      A view sees the tuples in the list when it was made, and is invalidated
+      by resize, reset or initialize.  The view of a value the tuples do not
+      have is empty.
+
+      ---------------------------------------------------------------------------*/
+    template <typename T>
+    class column
+    {
+    public:
+      class iterator
+      {
+      public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef T* pointer;
+        typedef T& reference;
+
+        iterator(T *p = NULL, uint s = 1) : ptr(p), stride(s) {}
+
+        T &operator*() const { return *ptr; }
+        T *operator->() const { return ptr; }
+        T &operator[](difference_type i) const { return ptr[i*(difference_type)stride]; }
+
+        iterator &operator++() { ptr += stride; return *this; }
+        iterator operator++(int) { iterator tmp(*this); ptr += stride; return tmp; }
+        iterator &operator--() { ptr -= stride; return *this; }
+        iterator operator--(int) { iterator tmp(*this); ptr -= stride; return tmp; }
+        iterator &operator+=(difference_type i) { ptr += i*(difference_type)stride; return *this; }
+        iterator &operator-=(difference_type i) { ptr -= i*(difference_type)stride; return *this; }
+        iterator operator+(difference_type i) const { return iterator(ptr + i*(difference_type)stride, stride); }
+        iterator operator-(difference_type i) const { return iterator(ptr - i*(difference_type)stride, stride); }
+        difference_type operator-(const iterator &other) const { return (ptr - other.ptr)/(difference_type)stride; }
+
+        bool operator==(const iterator &other) const { return ptr == other.ptr; }
+        bool operator!=(const iterator &other) const { return ptr != other.ptr; }
+        bool operator<(const iterator &other) const { return ptr < other.ptr; }
+        bool operator>(const iterator &other) const { return ptr > other.ptr; }
+        bool operator<=(const iterator &other) const { return ptr <= other.ptr; }
+        bool operator>=(const iterator &other) const { return ptr >= other.ptr; }
+
+      private:
+        T *ptr;
+        uint stride;
+      };
+
+      column(T *p, uint s, uint cnt) : ptr(p), stride(s), count(cnt) {}
+
+      T &operator[](uint i) const { return ptr[(size_t)i*stride]; }
+      uint size() const { return count; }
+      bool empty() const { return 0 == count; }
+      iterator begin() const { return iterator(ptr, stride); }
+      iterator end() const { return iterator(ptr + (size_t)count*stride, stride); }
+
+    private:
+      T *ptr;
+      uint stride, count;
+    };
+
   public:
 
     /**Constructor that takes all parameters and initializes the TupleList
@@ -183,6 +338,22 @@ namespace moab
       ----------------------------------------------------------------------------*/
     ErrorCode sort(uint key, TupleList::buffer *buf);
 
+    /**Sorts the TupleList by 'key1', and tuples with equal key1 by 'key2'
+     * (e.g. by processor, then by global id); keys are numbered as in
+     * sort(key, buf), and compared as unsigned integers.
+     * When the significant bits of both keys fit in 64 bits, the keys are
+     * packed and the list is sorted with a single LSD radix sort, and the
+     * tuples are permuted once; otherwise it is sorted by key2, then by key1.
+     * The radix passes and the permutation are multithreaded when MOAB is
+     * built with OpenMP.  sort(key, buf) uses the same radix sort for large
+     * lists when more than one thread is available.
+     *
+     * param key1  primary key
+     * param key2  secondary key
+     * param *buf  buffer space used for sorting
+     */
+    ErrorCode sort(uint key1, uint key2, TupleList::buffer *buf);
+
     /**Frees all allocated memory in use by the TupleList
      */
     void reset();
@@ -226,6 +397,16 @@ namespace moab
     ErrorCode get(unsigned int index, const sint *&sp,
 		  const slong *&ip, const Ulong *&lp, const realType *&dp);
 
+    /**get a read-only view of the mth value of one type in all tuples,
+     * without enabling write access; the view is empty if m is out of bounds
+     *
+     * param m         index of the value within the tuple
+     */
+    column<const sint> vi_column(unsigned int m) const;
+    column<const slong> vl_column(unsigned int m) const;
+    column<const Ulong> vul_column(unsigned int m) const;
+    column<const realType> vr_column(unsigned int m) const;
+
     /**push back a new tuple on the TupleList;
      *
      * param *sp   pointer to a list of signed ints
@@ -296,6 +477,9 @@ namespace moab
     //void sort_bits(uint *work, uint key);
     void permute(uint *perm, void *work);
 
+    // Used by sort:  radix sort on the packed (key1, key2); see .cpp
+    ErrorCode radix_sort64(uint key1, uint key2, TupleList::buffer *buf);
+
     /* last_sorted = the last sorted position in the tuple (if the
      * TupleList has not been sorted, or has become unsorted--i.e.
      * by adding a tuple--last_sorted = -1) */
@@ -386,6 +570,15 @@ namespace moab
   inline uint TupleList::get_n() const{ return n; }
   inline bool TupleList::get_writeEnabled() const{ return writeEnabled; }
 
+  inline TupleList::column<const sint> TupleList::vi_column(unsigned int m) const
+  { return m < mi ? column<const sint>(vi + m, mi, n) : column<const sint>(vi, 1, 0); }
+  inline TupleList::column<const slong> TupleList::vl_column(unsigned int m) const
+  { return m < ml ? column<const slong>(vl + m, ml, n) : column<const slong>(vl, 1, 0); }
+  inline TupleList::column<const Ulong> TupleList::vul_column(unsigned int m) const
+  { return m < mul ? column<const Ulong>(vul + m, mul, n) : column<const Ulong>(vul, 1, 0); }
+  inline TupleList::column<const realType> TupleList::vr_column(unsigned int m) const
+  { return m < mr ? column<const realType>(vr + m, mr, n) : column<const realType>(vr, 1, 0); }
+
 } //namespace
 #endif
 #include <stdlib.h>
@@ -71,8 +71,9 @@ enum TagType {
   MB_TAG_STORE = 1<<7, /**< Fail if tag exists and has different storage type */
   MB_TAG_ANY   = 1<<8, /**< Do not fail if size, type, or default value do not match. */
   MB_TAG_NOOPQ = 1<<9, /**< Do not accept MB_TYPE_OPAQUE as a match for any type. */
-  MB_TAG_DFTOK = 1<<10 /**< Do not fail for mismatched default values */
+  MB_TAG_DFTOK = 1<<10, /**< Do not fail for mismatched default values */
 /**<  MB_TAG_CNVRT = 1<<11,  Convert storage type if it does not match */
+  MB_TAG_FLOAT = 1<<12 /**< Store the values of a dense MB_TYPE_DOUBLE tag as float */
 };
 
 /** Specify data type for tags. */
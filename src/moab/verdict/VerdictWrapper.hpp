@@ -9,11 +9,13 @@
 #define SRC_VERDICT_MOAB_VERDICTWRAPPER_HPP_
 
 #include <map>
+#include <vector>
 
 namespace moab
 {
 
 class Interface;
+class Range;
 
 enum QualityType {
   // order exactly from HexMetricVals
@@ -147,6 +149,25 @@ public:
   */
   ErrorCode quality_measure(EntityHandle eh, QualityType q, double & quality,
       int num_nodes=0, EntityType etype=MBMAXTYPE, double *coords=NULL);
+  //! compute a quality for many elements, and store it in a tag
+  /** The elements are processed a block of consecutive handles at a time:
+   * connectivity is read in place with connect_iterate, the corner coordinates
+   * of a block are gathered from the coords_iterate arrays, and the quality is
+   * computed for the whole block. Blocks are computed concurrently when MOAB is
+   * built with OpenMP (except for MB_DISTORTION, which is not thread safe).
+  \param elems elements; the quality must be possible for all of their types
+  \param q quality requested
+  \param qtag tag with one double value; a dense tag is written in place
+  return MB_SUCCESS, MB_NOT_IMPLEMENTED if the quality is not available for some element
+  Example: \code
+  Tag jac_tag;
+  mb->tag_get_handle("JACOBIAN", 1, MB_TYPE_DOUBLE, jac_tag, MB_TAG_DENSE|MB_TAG_CREAT);
+  rval = quality_measure(hexes, MB_JACOBIAN, jac_tag); \endcode
+  */
+  ErrorCode quality_measure(const Range & elems, QualityType q, Tag qtag);
+  //! compute a quality for many elements
+  /** as above, with the qualities returned in the order of \a elems */
+  ErrorCode quality_measure(const Range & elems, QualityType q, std::vector<double> & qualities);
   //! return a quality name
     /** return quality name (convert an enum QualityType to a string)
     \param  q quality type
@@ -178,6 +199,9 @@ public:
     */
   ErrorCode all_quality_measures(EntityHandle eh, std::map<QualityType, double> & qualities);
 private:
+  //! compute a quality for many elements, into \a values if not NULL, or into \a qtag
+  ErrorCode quality_measure_range(const Range & elems, QualityType q, Tag qtag, double * values);
+
   Interface * mbImpl;
 
 };
@@ -535,8 +535,44 @@ ErrorCode ParCommGraph::release_send_buffers(MPI_Comm /*jcomm*/)
   return MB_SUCCESS;
 }
 
+// find the local entities with the given global ids, in the order of the ids, for each
+// task we communicate with; after coverage, the tag values are packed in this order
+ErrorCode ParCommGraph::find_ents_by_ids(Interface * mb, Range & owned,
+    std::map<int, std::vector<int> > & ids_map, std::map<int, std::vector<EntityHandle> > & ents_map)
+{
+  Tag gidTag;
+  ErrorCode rval = mb->tag_get_handle("GLOBAL_ID", gidTag); MB_CHK_ERR ( rval );
+  std::vector<int> gids;
+  gids.resize(owned.size());
+  if (!owned.empty())
+  {
+    rval = mb->tag_get_data(gidTag, owned, &gids[0]);  MB_CHK_ERR ( rval );
+  }
+  std::map<int, EntityHandle> gidToHandle;
+  size_t i=0;
+  for (Range::iterator it=owned.begin(); it!= owned.end(); it++)
+    gidToHandle[gids[i++]] = *it;
+
+  ents_map.clear();
+  for (std::map<int ,std::vector<int> >::iterator mit =ids_map.begin(); mit!=ids_map.end(); mit++)
+  {
+    std::vector<int> & eids = mit->second;
+    std::vector<EntityHandle> & ents = ents_map[mit->first];
+    ents.resize(eids.size());
+    for (i=0; i<eids.size(); i++)
+    {
+      std::map<int, EntityHandle>::iterator hit = gidToHandle.find(eids[i]);
+      if (hit == gidToHandle.end())
+        MB_SET_ERR(MB_ENTITY_NOT_FOUND, "Cannot find element with global id " << eids[i]);
+      ents[i] = hit->second;
+    }
+  }
+  return MB_SUCCESS;
+}
+
 // again, will use the send buffers, for nonblocking sends;
-// should be the receives non-blocking too?
+// the values of all tags for a receiver are packed in one message, tag after tag;
+// the buffers are kept, and reused by the next call
 ErrorCode ParCommGraph::send_tag_values (MPI_Comm jcomm, ParallelComm *pco, Range & owned,
     std::vector<Tag> & tag_handles )
 {
@@ -549,132 +585,71 @@ ErrorCode ParCommGraph::send_tag_values (MPI_Comm jcomm, ParallelComm *pco, Rang
   int total_bytes_per_entity=0; // we need to know, to allocate buffers
   ErrorCode  rval;
   std::vector<int> vect_bytes_per_tag;
-#ifdef VERBOSE
-  std::vector<int> tag_sizes;
-#endif
   for (size_t i=0; i<tag_handles.size(); i++)
   {
     int bytes_per_tag;
     rval = mb-> tag_get_bytes(tag_handles[i],  bytes_per_tag) ;MB_CHK_ERR ( rval );
     total_bytes_per_entity +=bytes_per_tag;
     vect_bytes_per_tag.push_back(bytes_per_tag);
-#ifdef VERBOSE
-    int tag_size;
-    rval = mb->tag_get_length(tag_handles[i], tag_size);MB_CHK_ERR ( rval );
-    tag_sizes.push_back(tag_size);
-#endif
   }
 
-
+  // the buffers of the previous call are reused; make sure they were sent, in case
+  // release_send_buffers was not called in between
+  if (!sendReqs.empty())
+  {
+    ierr = MPI_Waitall((int)sendReqs.size(), &sendReqs[0], MPI_STATUSES_IGNORE);
+    if (ierr!=0) return MB_FAILURE;
+  }
 
   // bool specified_ids = send_IDs_map.size() > 0;
   bool specified_ids = recomputed_send_graph; // in cases when sender is completely over land, send_IDs_map can still be size 0
-  int indexReq=0;
-  if (!specified_ids) // original send
+  if (specified_ids && (send_ents_map.size() != send_IDs_map.size() || owned != send_ents_owned))
   {
-    // use the buffers data structure to allocate memory for sending the tags
-    sendReqs.resize(split_ranges.size());
-
-    for (std::map<int, Range>::iterator it=split_ranges.begin(); it!=split_ranges.end(); it++)
-    {
-      int receiver_proc = it->first;
-      Range ents = it->second; // primary entities, with the tag data
-      int size_buffer = 4 + total_bytes_per_entity*(int)ents.size(); // hopefully, below 2B; if more, we have a big problem ...
-      ParallelComm::Buffer * buffer = new ParallelComm::Buffer(size_buffer);
-
-      buffer->reset_ptr(sizeof(int));
-      for (size_t i=0; i<tag_handles.size(); i++)
-      {
-        // copy tag data to buffer->buff_ptr, and send the buffer (we could have used regular char arrays)
-        rval = mb->tag_get_data(tag_handles[i], ents, (void*)(buffer->buff_ptr) );MB_CHK_ERR ( rval );
-        // advance the butter
-        buffer->buff_ptr += vect_bytes_per_tag[i]*ents.size();
-      }
-      *((int*)buffer->mem_ptr) = size_buffer;
-      //int size_pack = buffer->get_current_size(); // debug check
-      ierr = MPI_Isend(buffer->mem_ptr, size_buffer, MPI_CHAR, receiver_proc, 222, jcomm, &sendReqs[indexReq]); // we have to use global communicator
-      if (ierr!=0) return MB_FAILURE;
-      indexReq++;
-      localSendBuffs.push_back(buffer); // we will release them after nonblocking sends are completed
-    }
+    // we know that we will need to send some tag data in a specific order (by ids stored);
+    // find the local elements once, they are used for all the following sends with the same owned range
+    rval = find_ents_by_ids(mb, owned, send_IDs_map, send_ents_map); MB_CHK_ERR ( rval );
+    send_ents_owned = owned;
   }
-  else
+
+  // either a range (original send) or a list of entities (after coverage) for each receiver
+  std::map<int, Range>::iterator rit = split_ranges.begin();
+  std::map<int, std::vector<EntityHandle> >::iterator vit = send_ents_map.begin();
+  size_t num_receivers = specified_ids ? send_ents_map.size() : split_ranges.size();
+  sendReqs.resize(num_receivers);
+  for (size_t indexReq=0; indexReq<num_receivers; indexReq++)
   {
-    // we know that we will need to send some tag data in a specific order
-    // first, get the ids of the local elements, from owned Range; arrange the buffer in order of increasing global id
-    Tag gidTag;
-    rval = mb->tag_get_handle("GLOBAL_ID", gidTag); MB_CHK_ERR ( rval );
-    std::vector<int> gids;
-    gids.resize(owned.size());
-    rval = mb->tag_get_data(gidTag, owned, &gids[0]);  MB_CHK_ERR ( rval );
-    std::map<int, EntityHandle> gidToHandle;
-    size_t i=0;
-    for (Range::iterator it=owned.begin(); it!= owned.end(); it++)
-    {
-      EntityHandle eh = *it;
-      gidToHandle[gids[i++]] = eh;
-    }
-    // now, pack the data and send it
-    sendReqs.resize(send_IDs_map.size());
-    for (std::map<int ,std::vector<int> >::iterator mit =send_IDs_map.begin(); mit!=send_IDs_map.end(); mit++)
+    int receiver_proc = specified_ids ? vit->first : rit->first;
+    size_t num_ents = specified_ids ? vit->second.size() : rit->second.size();
+    int size_buffer = 4 + total_bytes_per_entity*(int)num_ents; // hopefully, below 2B; if more, we have a big problem ...
+    std::vector<char> & buffer = tagSendBuffs[receiver_proc];
+    buffer.resize(size_buffer);
+    *((int*)&buffer[0]) = size_buffer;
+    char * buff_ptr = &buffer[0] + sizeof(int);
+    for (size_t i=0; i<tag_handles.size() && num_ents>0; i++)
     {
-      int receiver_proc = mit->first;
-      std::vector<int> & eids = mit->second;
-      int size_buffer = 4 + total_bytes_per_entity*(int)eids.size(); // hopefully, below 2B; if more, we have a big problem ...
-      ParallelComm::Buffer * buffer = new ParallelComm::Buffer(size_buffer);
-      buffer->reset_ptr(sizeof(int));
-#ifdef VERBOSE
-      std::ofstream dbfile;
-      std::stringstream outf;
-      outf << "from_" << rankInJoin <<"_send_to_" << receiver_proc << ".txt";
-      dbfile.open (outf.str().c_str());
-      dbfile << "from "  << rankInJoin << " send to " << receiver_proc << "\n";
-#endif
-      // copy tag data to buffer->buff_ptr, and send the buffer (we could have used regular char arrays)
-      // pack data by tag, to be consistent with above, even though we loop through the entities for each tag
-
-      for (std::vector<int>::iterator it=eids.begin(); it!=eids.end(); it++)
-      {
-        int eID = *it;
-        EntityHandle eh = gidToHandle[eID];
-        for (i=0; i<tag_handles.size(); i++)
-        {
-          rval = mb->tag_get_data(tag_handles[i], &eh, 1, (void*)(buffer->buff_ptr) );  MB_CHK_ERR ( rval );
-#ifdef VERBOSE
-          dbfile<< "global ID " << eID << " local handle " << mb->id_from_handle(eh)  << " vals: ";
-          double * vals = (double*) (buffer->buff_ptr);
-          for (int kk=0; kk<tag_sizes[i]; kk++)
-          {
-            dbfile << " " << *vals;
-            vals++;
-          }
-          dbfile << "\n";
-#endif
-          buffer->buff_ptr+=vect_bytes_per_tag[i];
-        }
-      }
-
-#ifdef VERBOSE
-      dbfile.close();
-#endif
-      *((int*)buffer->mem_ptr) = size_buffer;
-        //int size_pack = buffer->get_current_size(); // debug check
-      ierr = MPI_Isend(buffer->mem_ptr, size_buffer, MPI_CHAR, receiver_proc, 222, jcomm, &sendReqs[indexReq]); // we have to use global communicator
-      if (ierr!=0) return MB_FAILURE;
-      indexReq++;
-      localSendBuffs.push_back(buffer); // we will release them after nonblocking sends are completed
+      // copy tag data to the buffer, for all entities at once
+      if (specified_ids)
+        rval = mb->tag_get_data(tag_handles[i], &(vit->second[0]), (int)num_ents, (void*)buff_ptr );
+      else
+        rval = mb->tag_get_data(tag_handles[i], rit->second, (void*)buff_ptr );
+      MB_CHK_ERR ( rval );
+      buff_ptr += vect_bytes_per_tag[i]*num_ents;
     }
+    ierr = MPI_Isend(&buffer[0], size_buffer, MPI_CHAR, receiver_proc, 222, jcomm, &sendReqs[indexReq]); // we have to use global communicator
+    if (ierr!=0) return MB_FAILURE;
+    if (specified_ids) ++vit; else ++rit;
   }
+  // the sends are completed in release_send_buffers
 
   return MB_SUCCESS;
 }
 
+// the receives are posted for all senders at once, and the tag values are set as the
+// messages arrive, in any order
 ErrorCode ParCommGraph::receive_tag_values (MPI_Comm jcomm, ParallelComm *pco, Range & owned,
     std::vector<Tag> & tag_handles )
 {
-  // opposite to sending, we will use blocking receives
   int ierr;
-  MPI_Status status;
   // basically, owned.size() needs to be equal to sum(corr_sizes)
   // get info about the tag size, type, etc
   Core * mb = (Core*)pco->get_moab();
@@ -683,127 +658,68 @@ ErrorCode ParCommGraph::receive_tag_values (MPI_Comm jcomm, ParallelComm *pco, R
   ErrorCode  rval;
   int total_bytes_per_entity=0;
   std::vector<int> vect_bytes_per_tag;
-#ifdef VERBOSE
-  std::vector<int> tag_sizes;
-#endif
   for (size_t i=0; i<tag_handles.size(); i++)
   {
     int bytes_per_tag;
     rval = mb-> tag_get_bytes(tag_handles[i],  bytes_per_tag) ;MB_CHK_ERR ( rval );
     total_bytes_per_entity +=bytes_per_tag;
     vect_bytes_per_tag.push_back(bytes_per_tag);
-#ifdef VERBOSE
-    int tag_size;
-    rval = mb->tag_get_length(tag_handles[i], tag_size);MB_CHK_ERR ( rval );
-    tag_sizes.push_back(tag_size);
-#endif
   }
 
-
-
   bool specified_ids = recv_IDs_map.size() > 0;
-  if (!specified_ids)
+  if (specified_ids && (recv_ents_map.size() != recv_IDs_map.size() || owned != recv_ents_owned))
   {
-    //std::map<int, Range> split_ranges;
-    //rval = split_owned_range ( owned);MB_CHK_ERR ( rval );
-
-    // use the buffers data structure to allocate memory for sending the tags
-    for (std::map<int, Range>::iterator it=split_ranges.begin(); it!=split_ranges.end(); it++)
-    {
-      int sender_proc = it->first;
-      Range ents = it->second; // primary entities, with the tag data, we will receive
-      int size_buffer = 4 + total_bytes_per_entity*(int)ents.size(); // hopefully, below 2B; if more, we have a big problem ...
-      ParallelComm::Buffer * buffer = new ParallelComm::Buffer(size_buffer);
-
-      buffer->reset_ptr(sizeof(int));
-
-      *((int*)buffer->mem_ptr) = size_buffer;
-      //int size_pack = buffer->get_current_size(); // debug check
-
-      ierr = MPI_Recv (buffer->mem_ptr, size_buffer, MPI_CHAR, sender_proc, 222, jcomm, &status);
-      if (ierr!=0) return MB_FAILURE;
-      // now set the tag
-      // copy to tag
-
-      for (size_t i=0; i<tag_handles.size(); i++)
-      {
-        rval = mb->tag_set_data(tag_handles[i], ents, (void*)(buffer->buff_ptr) );
-        buffer->buff_ptr += vect_bytes_per_tag[i]*ents.size();
-      }
-      delete buffer; // no need for it afterwards
-      MB_CHK_ERR ( rval );
+    // we know that we will need to receive some tag data in a specific order (by ids stored);
+    // find the local elements once, they are used for all the following receives with the same owned range
+    rval = find_ents_by_ids(mb, owned, recv_IDs_map, recv_ents_map); MB_CHK_ERR ( rval );
+    recv_ents_owned = owned;
+  }
 
-    }
+  // post all receives
+  std::map<int, Range>::iterator rit = split_ranges.begin();
+  std::map<int, std::vector<EntityHandle> >::iterator vit = recv_ents_map.begin();
+  size_t num_senders = specified_ids ? recv_ents_map.size() : split_ranges.size();
+  std::vector<MPI_Request> recvReqs(num_senders);
+  std::vector<int> sender_procs(num_senders);
+  for (size_t k=0; k<num_senders; k++)
+  {
+    int sender_proc = specified_ids ? vit->first : rit->first;
+    size_t num_ents = specified_ids ? vit->second.size() : rit->second.size();
+    int size_buffer = 4 + total_bytes_per_entity*(int)num_ents; // hopefully, below 2B; if more, we have a big problem ...
+    std::vector<char> & buffer = tagRecvBuffs[sender_proc];
+    buffer.resize(size_buffer);
+    sender_procs[k] = sender_proc;
+    ierr = MPI_Irecv(&buffer[0], size_buffer, MPI_CHAR, sender_proc, 222, jcomm, &recvReqs[k]);
+    if (ierr!=0) return MB_FAILURE;
+    if (specified_ids) ++vit; else ++rit;
   }
-  else // receive buffer, then extract tag data, in a loop
+
+  // set the tag values from each message as soon as it is received
+  for (size_t k=0; k<num_senders; k++)
   {
-    // we know that we will need to receive some tag data in a specific order (by ids stored)
-    // first, get the ids of the local elements, from owned Range; unpack the buffer in order
-    Tag gidTag;
-    rval = mb->tag_get_handle("GLOBAL_ID", gidTag); MB_CHK_ERR ( rval );
-    std::vector<int> gids;
-    gids.resize(owned.size());
-    rval = mb->tag_get_data(gidTag, owned, &gids[0]);  MB_CHK_ERR ( rval );
-    std::map<int, EntityHandle> gidToHandle;
-    size_t i=0;
-    for (Range::iterator it=owned.begin(); it!= owned.end(); it++)
+    int index;
+    ierr = MPI_Waitany((int)num_senders, &recvReqs[0], &index, MPI_STATUS_IGNORE);
+    if (ierr!=0) return MB_FAILURE;
+    int sender_proc = sender_procs[index];
+    char * buff_ptr = &tagRecvBuffs[sender_proc][0] + sizeof(int);
+    if (specified_ids)
     {
-      EntityHandle eh = *it;
-      gidToHandle[gids[i++]] = eh;
+      std::vector<EntityHandle> & ents = recv_ents_map[sender_proc];
+      for (size_t i=0; i<tag_handles.size() && !ents.empty(); i++)
+      {
+        rval = mb->tag_set_data(tag_handles[i], &ents[0], (int)ents.size(), (void*)buff_ptr ); MB_CHK_ERR ( rval );
+        buff_ptr += vect_bytes_per_tag[i]*ents.size();
+      }
     }
-    //
-    // now, unpack the data and set it to the tag
-    for (std::map<int ,std::vector<int> >::iterator mit =recv_IDs_map.begin(); mit!=recv_IDs_map.end(); mit++)
+    else
     {
-      int sender_proc = mit->first;
-      std::vector<int> & eids = mit->second;
-      int size_buffer = 4 + total_bytes_per_entity*(int)eids.size(); // hopefully, below 2B; if more, we have a big problem ...
-      ParallelComm::Buffer * buffer = new ParallelComm::Buffer(size_buffer);
-      buffer->reset_ptr(sizeof(int));
-      *((int*)buffer->mem_ptr) = size_buffer; // this is really not necessary, it should receive this too
-
-      // receive the buffer
-      ierr = MPI_Recv (buffer->mem_ptr, size_buffer, MPI_CHAR, sender_proc, 222, jcomm, &status);
-      if (ierr!=0) return MB_FAILURE;
-// start copy
-#ifdef VERBOSE
-        std::ofstream dbfile;
-        std::stringstream outf;
-        outf << "recvFrom_" << sender_proc <<"_on_proc_" << rankInJoin << ".txt";
-        dbfile.open (outf.str().c_str());
-        dbfile << "recvFrom_"  << sender_proc << " on proc  " << rankInJoin << "\n";
-#endif
-
-      // copy tag data from buffer->buff_ptr
-      // data is arranged by tag , and repeat the loop for each entity ()
-        // maybe it should be arranged by entity now, not by tag (so one loop for entities, outside)
-
-      for (std::vector<int>::iterator it=eids.begin(); it!=eids.end(); it++)
+      Range & ents = split_ranges[sender_proc];
+      for (size_t i=0; i<tag_handles.size() && !ents.empty(); i++)
       {
-        int eID = *it;
-        EntityHandle eh = gidToHandle[eID];
-        for (i=0; i<tag_handles.size(); i++)
-        {
-          rval = mb->tag_set_data(tag_handles[i], &eh, 1, (void*)(buffer->buff_ptr) );  MB_CHK_ERR ( rval );
-#ifdef VERBOSE
-          dbfile<< "global ID " << eID << " local handle " << mb->id_from_handle(eh)  << " vals: ";
-          double * vals = (double*) (buffer->buff_ptr );
-          for (int kk=0; kk<tag_sizes[i]; kk++)
-          {
-            dbfile << " " << *vals;
-            vals++;
-          }
-          dbfile << "\n";
-#endif
-          buffer->buff_ptr+=vect_bytes_per_tag[i];
-        }
+        rval = mb->tag_set_data(tag_handles[i], ents, (void*)buff_ptr ); MB_CHK_ERR ( rval );
+        buff_ptr += vect_bytes_per_tag[i]*ents.size();
       }
-#ifdef VERBOSE
-      dbfile.close();
-#endif
-
     }
-
   }
   return MB_SUCCESS;
 }
@@ -863,6 +779,7 @@ ErrorCode ParCommGraph::settle_send_graph(TupleList & TLcovIDs)
   // will have "receiving proc" and global id of element
   int n = TLcovIDs.get_n();
   recomputed_send_graph = true; // do not rely only on send_IDs_map.size(); this can be 0 in some cases
+  send_ents_map.clear(); // will be found again at next send of tags
   for (int i=0; i<n; i++)
   {
     int to_proc= TLcovIDs.vi_wr[2 * i];
@@ -886,6 +803,7 @@ ErrorCode ParCommGraph::settle_send_graph(TupleList & TLcovIDs)
 // this will set recv_IDs_map will store all ids to be received from one sender task
 void ParCommGraph::SetReceivingAfterCoverage(std::map<int, std::set<int> > & idsFromProcs) // will make sense only on receivers, right now after cov
 {
+  recv_ents_map.clear(); // will be found again at next receive of tags
   for (std::map<int, std::set<int> >::iterator mt=idsFromProcs.begin(); mt!=idsFromProcs.end(); mt++)
   {
     int fromProc = mt->first;
@@ -3972,21 +3972,25 @@ ErrorCode ParallelComm::get_remote_handles(EntityHandle *local_vec, EntityHandle
     result = get_shared_proc_tags(shp_tag, shps_tag,
                                   shh_tag, shhs_tag, pstat_tag);MB_CHK_SET_ERR(result, "Failed to get shared proc tags");
 
-    // Load shared verts into a tuple, then sort by index
-    TupleList shared_verts;
-    shared_verts.initialize(2, 0, 1, 0,
-                            skin_ents[0].size()*(MAX_SHARING_PROCS + 1));
-    shared_verts.enableWriteAccess();
-
-    unsigned int i = 0, j = 0;
+    // Load shared verts into a tuple, then sort by index; the builder
+    // allocates for the verts actually shared, most with a single proc,
+    // not for MAX_SHARING_PROCS sharing procs per skin vertex
+    TupleList::builder shared_builder(2, 0, 1, 0, skin_ents[0].size());
+    sint *si;
+    slong *sl;
+    Ulong *sul;
+    realType *sr;
+    unsigned int j = 0;
     for (unsigned int p = 0; p < gsd->nlinfo->_np; p++)
       for (unsigned int np = 0; np < gsd->nlinfo->_nshared[p]; np++) {
-        shared_verts.vi_wr[i++] = gsd->nlinfo->_sh_ind[j];
-        shared_verts.vi_wr[i++] = gsd->nlinfo->_target[p];
-        shared_verts.vul_wr[j] = gsd->nlinfo->_ulabels[j];
+        shared_builder.append(si, sl, sul, sr);
+        si[0] = gsd->nlinfo->_sh_ind[j];
+        si[1] = gsd->nlinfo->_target[p];
+        sul[0] = gsd->nlinfo->_ulabels[j];
         j++;
-        shared_verts.inc_n();
       }
+    TupleList shared_verts;
+    shared_builder.finalize(shared_verts);
 
     myDebug->tprintf(3, " shared verts size %d \n", (int)shared_verts.get_n());
 
@@ -4002,7 +4006,6 @@ ErrorCode ParallelComm::get_remote_handles(EntityHandle *local_vec, EntityHandle
     std::vector<int> sharing_procs(MAX_SHARING_PROCS);
     std::fill(sharing_procs.begin(), sharing_procs.end(), maxp);
     j = 0;
-    i = 0;
 
     // Get ents shared by 1 or n procs
     std::map<std::vector<int>, std::vector<EntityHandle> > proc_nvecs;
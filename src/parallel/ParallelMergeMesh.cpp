@@ -480,10 +480,8 @@ namespace moab{
     //Sorts are necessary to check for doubles
     //Sort by remote handle
     myMatches.sort(3,&buf);
-    //Sort by matching proc
-    myMatches.sort(1,&buf);
-    //Sort by local handle
-    myMatches.sort(2,&buf);
+    //Sort by local handle, then by matching proc
+    myMatches.sort(2,1,&buf);
     buf.reset();
     return MB_SUCCESS;
   }
@@ -0,0 +1,313 @@
+#include "WriteVtuParallel.hpp"
+#include "moab/Interface.hpp"
+#include "moab/ParallelComm.hpp"
+#include "moab/WriteUtilIface.hpp"
+#include "moab/FileOptions.hpp"
+#include "MBParallelConventions.h"
+#include "SysUtil.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <set>
+#include <stdio.h>
+
+namespace moab {
+
+WriterIface *WriteVtuParallel::factory(Interface* iface)
+{
+  return new WriteVtuParallel(iface);
+}
+
+WriteVtuParallel::WriteVtuParallel(Interface* impl)
+  : WriteVtu(impl), myPcomm(0), pcommAllocated(false)
+{
+}
+
+WriteVtuParallel::~WriteVtuParallel()
+{
+  if (pcommAllocated && myPcomm)
+    delete myPcomm;
+}
+
+ErrorCode WriteVtuParallel::write_file(const char *file_name,
+                                       const bool overwrite,
+                                       const FileOptions& opts,
+                                       const EntityHandle *output_list,
+                                       const int num_sets,
+                                       const std::vector<std::string>& qa_list,
+                                       const Tag* tag_list,
+                                       int num_tags,
+                                       int export_dimension)
+{
+  ErrorCode rval;
+
+  const char* optnames[] = {"WRITE_PART", 0};
+  int junk;
+  if (MB_SUCCESS != opts.match_option("PARALLEL", optnames, junk))
+    return WriteVtu::write_file(file_name, overwrite, opts, output_list, num_sets,
+                                qa_list, tag_list, num_tags, export_dimension);
+
+  rval = parse_options(opts);MB_CHK_ERR(rval);
+
+  int pcomm_no = 0;
+  opts.get_int_option("PARALLEL_COMM", pcomm_no);
+  myPcomm = ParallelComm::get_pcomm(mbImpl, pcomm_no);
+  if (0 == myPcomm) {
+    myPcomm = new ParallelComm(mbImpl, MPI_COMM_WORLD);
+    pcommAllocated = true;
+  }
+
+  rval = write_parallel(file_name, overwrite, output_list, num_sets, tag_list, num_tags);
+
+  if (pcommAllocated) {
+    delete myPcomm;
+    pcommAllocated = false;
+  }
+  myPcomm = 0;
+
+  return rval;
+}
+
+ErrorCode WriteVtuParallel::check_all(ErrorCode rval)
+{
+  int failed = (MB_SUCCESS != rval), any_failed = 1;
+  if (MPI_SUCCESS != MPI_Allreduce(&failed, &any_failed, 1, MPI_INT, MPI_MAX,
+                                   myPcomm->proc_config().proc_comm()))
+    return MB_FAILURE;
+
+  if (MB_SUCCESS != rval)
+    return rval;
+  return any_failed ? MB_FAILURE : MB_SUCCESS;
+}
+
+ErrorCode WriteVtuParallel::write_parallel(const char* file_name,
+                                           bool overwrite,
+                                           const EntityHandle* set_list,
+                                           int num_sets,
+                                           const Tag* tag_list,
+                                           int num_tags)
+{
+  ErrorCode rval;
+  const int rank = myPcomm->proc_config().proc_rank();
+  const int size = myPcomm->proc_config().proc_size();
+  MPI_Comm comm = myPcomm->proc_config().proc_comm();
+
+  // Pieces are named after the output file, without its extension
+  std::string stem(file_name);
+  const size_t dot = stem.find_last_of('.');
+  const size_t slash = stem.find_last_of('/');
+  if (dot != std::string::npos && (slash == std::string::npos || dot > slash))
+    stem.erase(dot);
+  std::vector<std::string> pieces(size);
+  for (int p = 0; p < size; ++p) {
+    std::ostringstream name;
+    name << stem << "_" << p << ".vtu";
+    pieces[p] = name.str();
+  }
+
+  // Write elements owned by this process, with their vertices, and
+  // owned vertices that are not in any element
+  Range nodes, elems;
+  rval = gather_mesh(set_list, num_sets, nodes, elems);
+  if (MB_SUCCESS == rval && !elems.empty())
+    rval = myPcomm->filter_pstatus(elems, PSTATUS_NOT_OWNED, PSTATUS_NOT);
+  if (MB_SUCCESS == rval && !nodes.empty())
+    rval = myPcomm->filter_pstatus(nodes, PSTATUS_NOT_OWNED, PSTATUS_NOT);
+  if (MB_SUCCESS == rval)
+    rval = get_vertex_closure(elems, nodes);
+  if (MB_SUCCESS == rval && !overwrite && !nodes.empty())
+    rval = writeTool->check_doesnt_exist(pieces[rank].c_str());
+  if (MB_SUCCESS == rval && !overwrite && 0 == rank)
+    rval = writeTool->check_doesnt_exist(file_name);
+  rval = check_all(rval);MB_CHK_ERR(rval);
+
+  std::vector<TagArray> node_tags, elem_tags;
+  rval = exchange_tag_arrays(nodes, elems, tag_list, num_tags, node_tags, elem_tags);MB_CHK_ERR(rval);
+
+  // Pieces are written concurrently; processes without any mesh write none
+  if (!nodes.empty())
+    rval = write_vtu(pieces[rank].c_str(), nodes, elems, node_tags, elem_tags);
+  rval = check_all(rval);MB_CHK_ERR(rval);
+
+  int have_piece = !nodes.empty();
+  std::vector<int> all_have(size);
+  if (MPI_SUCCESS != MPI_Gather(&have_piece, 1, MPI_INT, &all_have[0], 1, MPI_INT, 0, comm)) {
+    MB_SET_ERR(MB_FAILURE, "Failed to gather VTU piece list");
+  }
+
+  rval = MB_SUCCESS;
+  if (0 == rank) {
+    std::vector<std::string> sources;
+    for (int p = 0; p < size; ++p) {
+      if (!all_have[p])
+        continue;
+      // Pieces are in the same directory as the index
+      const size_t sep = pieces[p].find_last_of('/');
+      sources.push_back(sep == std::string::npos ? pieces[p] : pieces[p].substr(sep + 1));
+    }
+    if (sources.empty()) {
+      MB_SET_ERR_CONT("Nothing to write");
+      rval = MB_ENTITY_NOT_FOUND;
+    }
+    else
+      rval = write_pvtu(file_name, sources, node_tags, elem_tags);
+  }
+
+  return check_all(rval);
+}
+
+ErrorCode WriteVtuParallel::exchange_tag_arrays(const Range& nodes,
+                                                const Range& elems,
+                                                const Tag* tag_list,
+                                                int num_tags,
+                                                std::vector<TagArray>& node_tags,
+                                                std::vector<TagArray>& elem_tags)
+{
+  ErrorCode rval;
+  const int rank = myPcomm->proc_config().proc_rank();
+  const int size = myPcomm->proc_config().proc_size();
+  MPI_Comm comm = myPcomm->proc_config().proc_comm();
+
+  // Arrays that would be written for the local entities
+  std::vector<TagArray> local[2];
+  rval = gather_tags(nodes, tag_list, num_tags, local[0]);
+  if (MB_SUCCESS == rval)
+    rval = gather_tags(elems, tag_list, num_tags, local[1]);
+  rval = check_all(rval);MB_CHK_ERR(rval);
+
+  // Describe them as a list of "<0|1 for nodes|elems> <type> <length> <name>\0"
+  std::string desc;
+  for (int k = 0; k < 2; ++k) {
+    for (std::vector<TagArray>::const_iterator i = local[k].begin(); i != local[k].end(); ++i) {
+      std::ostringstream str;
+      str << k << ' ' << (int)i->type << ' ' << i->length << ' ' << i->name;
+      desc += str.str();
+      desc.push_back('\0');
+    }
+  }
+
+  // Take the union of all lists on the root, in rank order
+  int len = desc.size();
+  std::vector<int> lengths(size), displs(size);
+  if (MPI_SUCCESS != MPI_Gather(&len, 1, MPI_INT, &lengths[0], 1, MPI_INT, 0, comm)) {
+    MB_SET_ERR(MB_FAILURE, "Failed to gather tag descriptions");
+  }
+  std::vector<char> all(1);
+  if (0 == rank) {
+    for (int p = 1; p < size; ++p)
+      displs[p] = displs[p - 1] + lengths[p - 1];
+    all.resize(displs[size - 1] + lengths[size - 1] + 1);
+  }
+  if (MPI_SUCCESS != MPI_Gatherv(const_cast<char*>(desc.c_str()), len, MPI_CHAR,
+                                 &all[0], &lengths[0], &displs[0], MPI_CHAR, 0, comm)) {
+    MB_SET_ERR(MB_FAILURE, "Failed to gather tag descriptions");
+  }
+
+  std::string merged;
+  if (0 == rank) {
+    std::set<std::string> seen;
+    for (size_t pos = 0; pos + 1 < all.size(); ) {
+      std::string entry(&all[pos]);
+      pos += entry.size() + 1;
+      // Same name and kind; type and length are checked by each process
+      const size_t name_pos = entry.find(' ', entry.find(' ', 2) + 1);
+      if (seen.insert(entry.substr(0, 2) + entry.substr(name_pos)).second) {
+        merged += entry;
+        merged.push_back('\0');
+      }
+    }
+  }
+
+  len = merged.size();
+  if (MPI_SUCCESS != MPI_Bcast(&len, 1, MPI_INT, 0, comm)) {
+    MB_SET_ERR(MB_FAILURE, "Failed to broadcast tag descriptions");
+  }
+  merged.resize(len);
+  if (len && MPI_SUCCESS != MPI_Bcast(&merged[0], len, MPI_CHAR, 0, comm)) {
+    MB_SET_ERR(MB_FAILURE, "Failed to broadcast tag descriptions");
+  }
+
+  // Describe the merged arrays for the local entities
+  node_tags.clear();
+  elem_tags.clear();
+  rval = MB_SUCCESS;
+  for (size_t pos = 0; pos < merged.size() && MB_SUCCESS == rval; ) {
+    const std::string entry(merged.c_str() + pos);
+    pos += entry.size() + 1;
+
+    int kind, type, length, name_pos = 0;
+    sscanf(entry.c_str(), "%d %d %d %n", &kind, &type, &length, &name_pos);
+    const std::string name = entry.substr(name_pos);
+
+    TagArray arr;
+    Tag tag;
+    if (MB_SUCCESS == mbImpl->tag_get_handle(name.c_str(), 0, MB_TYPE_OPAQUE, tag, MB_TAG_ANY)) {
+      rval = get_tag_array(tag, kind ? elems : nodes, arr);
+      if (MB_SUCCESS != rval)
+        break;
+      if ((int)arr.type != type || arr.length != length) {
+        MB_SET_ERR_CONT("Tag \"" << name << "\" has a different type or length on another process");
+        rval = MB_TYPE_OUT_OF_RANGE;
+        break;
+      }
+      if (arr.dense)
+        arr.tagged.clear();
+    }
+    else {
+      arr.tag = 0;
+      arr.name = name;
+      arr.type = (DataType)type;
+      arr.length = length;
+      arr.dense = false;
+    }
+    (kind ? elem_tags : node_tags).push_back(arr);
+  }
+
+  return check_all(rval);
+}
+
+ErrorCode WriteVtuParallel::write_pvtu(const char* file_name,
+                                       const std::vector<std::string>& pieces,
+                                       const std::vector<TagArray>& node_tags,
+                                       const std::vector<TagArray>& elem_tags)
+{
+  std::ofstream file(file_name, std::ios::out | std::ios::trunc);
+  if (!file) {
+    MB_SET_ERR(MB_FILE_WRITE_ERROR, "Could not open file: " << file_name);
+  }
+
+  file << "<?xml version=\"1.0\"?>" << std::endl;
+  file << "<VTKFile type=\"PUnstructuredGrid\" version=\"1.0\" byte_order=\""
+       << (SysUtil::little_endian() ? "LittleEndian" : "BigEndian")
+       << "\" header_type=\"UInt64\">" << std::endl;
+  file << "  <PUnstructuredGrid GhostLevel=\"0\">" << std::endl;
+
+  const char* data_names[] = {"PPointData", "PCellData"};
+  const std::vector<TagArray>* tag_arrays[] = {&node_tags, &elem_tags};
+  for (int i = 0; i < 2; ++i) {
+    if (tag_arrays[i]->empty())
+      continue;
+    file << "    <" << data_names[i] << ">" << std::endl;
+    for (std::vector<TagArray>::const_iterator t = tag_arrays[i]->begin(); t != tag_arrays[i]->end(); ++t)
+      file << "      <PDataArray type=\"" << vtk_xml_type(t->type) << "\" Name=\""
+           << xml_escape(t->name) << "\" NumberOfComponents=\"" << t->length << "\"/>" << std::endl;
+    file << "    </" << data_names[i] << ">" << std::endl;
+  }
+
+  file << "    <PPoints>" << std::endl;
+  file << "      <PDataArray type=\"Float64\" NumberOfComponents=\"3\"/>" << std::endl;
+  file << "    </PPoints>" << std::endl;
+
+  for (std::vector<std::string>::const_iterator p = pieces.begin(); p != pieces.end(); ++p)
+    file << "    <Piece Source=\"" << xml_escape(*p) << "\"/>" << std::endl;
+
+  file << "  </PUnstructuredGrid>" << std::endl;
+  file << "</VTKFile>" << std::endl;
+
+  if (!file) {
+    MB_SET_ERR(MB_FILE_WRITE_ERROR, "Error writing PVTU file");
+  }
+  return MB_SUCCESS;
+}
+
+} // namespace moab
@@ -0,0 +1,81 @@
+#ifndef WRITE_VTU_PARALLEL_HPP
+#define WRITE_VTU_PARALLEL_HPP
+
+#include "WriteVtu.hpp"
+
+namespace moab {
+
+class ParallelComm;
+
+/**
+ * \brief Write a distributed mesh as a VTK XML parallel unstructured grid.
+ *
+ * With the PARALLEL=WRITE_PART option, each process writes the elements
+ * it owns, and the vertices of those elements, to its own .vtu piece,
+ * named after the output file with the rank appended
+ * (e.g. out.pvtu -> out_0.vtu, out_1.vtu, ...).  Ghost and other
+ * non-owned elements are not written.  The root process then writes
+ * the .pvtu index referencing the pieces.  All processes declare the
+ * same point and cell data arrays; values are zero in parts of the
+ * mesh where a tag is not set.
+ *
+ * Without the PARALLEL option, this behaves as \ref WriteVtu.
+ */
+class WriteVtuParallel : public WriteVtu
+{
+public:
+
+  static WriterIface* factory( Interface* );
+
+  WriteVtuParallel( Interface* impl );
+
+  virtual ~WriteVtuParallel();
+
+  ErrorCode write_file(const char *file_name,
+                         const bool overwrite,
+                         const FileOptions& opts,
+                         const EntityHandle *output_list,
+                         const int num_sets,
+                         const std::vector<std::string>& qa_list,
+                         const Tag* tag_list = NULL,
+                         int num_tags = 0,
+                         int export_dimension = 3);
+
+protected:
+
+    //! Write this process' piece, and the index on the root process
+  ErrorCode write_parallel( const char* file_name,
+                              bool overwrite,
+                              const EntityHandle* set_list,
+                              int num_sets,
+                              const Tag* tag_list,
+                              int num_tags );
+
+    //! Get the union over all processes of the arrays to write, and
+    //! describe them for the local entities
+  ErrorCode exchange_tag_arrays( const Range& nodes,
+                                   const Range& elems,
+                                   const Tag* tag_list,
+                                   int num_tags,
+                                   std::vector<TagArray>& node_tags,
+                                   std::vector<TagArray>& elem_tags );
+
+    //! Write the .pvtu index file
+  ErrorCode write_pvtu( const char* file_name,
+                          const std::vector<std::string>& pieces,
+                          const std::vector<TagArray>& node_tags,
+                          const std::vector<TagArray>& elem_tags );
+
+    //! Combine the result of a step over all processes: returns \c rval
+    //! if it is an error, MB_FAILURE if the step failed elsewhere
+  ErrorCode check_all( ErrorCode rval );
+
+private:
+
+  ParallelComm* myPcomm;
+  bool pcommAllocated;
+};
+
+} // namespace moab
+
+#endif
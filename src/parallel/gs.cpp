@@ -70,6 +70,8 @@
 #include <stdarg.h>
 #include <string.h>
 #include <math.h>
+#include <vector>
+#include <algorithm>
 #include "moab/gs.hpp"
 #ifdef MOAB_HAVE_MPI
 #  include "moab_mpi.h"
@@ -321,7 +323,7 @@ void gs_data::nonlocal_info::nonlocal_vec(realType *u, uint n,
   for (i=0; i<np; ++i)
   {
     int nsn=n*nshared[i];
-    MPI_Irecv((void*)start,nsn*size,MPI_UNSIGNED_CHAR,targ[i],targ[i],comm,reqs++);
+    MPI_Irecv((void*)start,nsn*sizeof(realType),MPI_UNSIGNED_CHAR,targ[i],targ[i],comm,reqs++);
     start+=nsn;
   }
   for (reqs=this->_reqs,i=np*2;i;--i)
@@ -420,7 +422,7 @@ void gs_data::nonlocal_info::nonlocal_many(realType **u, uint n, int op,
 /*---------------------------------------------------------------------------
  MOAB Crystal Router
  ---------------------------------------------------------------------------*/
-gs_data::crystal_data::crystal_data()
+gs_data::crystal_data::crystal_data() : _mode(CRYSTAL_ROUTER), _epoch(0)
 {
 }
 
@@ -438,6 +440,8 @@ void gs_data::crystal_data::initialize(MPI_Comm comm)
   this->_id =id;
   MPI_Comm_size(comm,&num);
   this->_num=num;
+  this->_mode=CRYSTAL_ROUTER;
+  this->_epoch=0;
 }
 
 void gs_data::crystal_data::reset()
@@ -556,6 +560,116 @@ void gs_data::crystal_data::crystal_router()
   }
 }
 
+/*---------------------------------------------------------------------------
+ Sparse exchange with nonblocking consensus (Hoefler et al., NBX)
+
+ Messages for the same target are packed together and sent directly with
+ synchronous sends.  Each proc receives whatever arrives until its own sends
+ have been matched, then enters a nonblocking barrier; once the barrier
+ completes, every message has been received everywhere.
+
+ A proc leaves the barrier only after all procs entered it, so when a proc
+ starts the next exchange the others are at most one exchange behind,
+ still probing for messages of this one.  Consecutive exchanges therefore
+ alternate between two tags, and a message of the next exchange is never
+ received by the current one.
+ ---------------------------------------------------------------------------*/
+#define GS_NBX_TAG 32766
+
+void gs_data::crystal_data::sparse_exchange()
+{
+#if MPI_VERSION >= 3
+  const int tag = GS_NBX_TAG - (int)(_epoch++ & 1);
+  const uint *src = (uint*) all->buf.ptr;
+  const uint *end = src + all->n;
+
+  /* group messages by target, keeping their order */
+  std::vector< std::pair<uint, uint> > msgs; /* (target, offset) */
+  for (const uint *p = src; p != end; p += 3 + p[2])
+    msgs.push_back(std::make_pair(p[0], (uint)(p - src)));
+  std::sort(msgs.begin(), msgs.end());
+
+  send->buf.buffer_reserve(all->n*sizeof(uint));
+  uint *sbuf = (uint*) send->buf.ptr;
+  std::vector<uint> targets, starts;
+  uint n = 0;
+  for (size_t i = 0; i < msgs.size(); ++i) {
+    if (targets.empty() || targets.back() != msgs[i].first) {
+      targets.push_back(msgs[i].first);
+      starts.push_back(n);
+    }
+    const uint *p = src + msgs[i].second;
+    memcpy(sbuf+n, p, (3 + p[2])*sizeof(uint));
+    n += 3 + p[2];
+  }
+  starts.push_back(n);
+
+  /* received chunks, as (source, (offset, length)) in keep */
+  std::vector< std::pair<uint, std::pair<uint, uint> > > chunks;
+  keep->n = 0;
+  std::vector<MPI_Request> reqs;
+  reqs.reserve(targets.size());
+  for (size_t i = 0; i < targets.size(); ++i) {
+    uint len = starts[i+1] - starts[i];
+    if (targets[i] == _id) {
+      keep->buf.buffer_reserve((keep->n + len)*sizeof(uint));
+      memcpy((uint*)keep->buf.ptr + keep->n, sbuf + starts[i], len*sizeof(uint));
+      chunks.push_back(std::make_pair(_id, std::make_pair(keep->n, len)));
+      keep->n += len;
+      continue;
+    }
+    (void)VALGRIND_CHECK_MEM_IS_DEFINED( sbuf + starts[i], len*sizeof(uint) );
+    reqs.push_back(MPI_REQUEST_NULL);
+    MPI_Issend((void*)(sbuf + starts[i]), len*sizeof(uint), MPI_UNSIGNED_CHAR,
+        targets[i], tag, _comm, &reqs.back());
+  }
+
+  MPI_Request barrier = MPI_REQUEST_NULL;
+  bool in_barrier = false;
+  int done = 0;
+  while (!done) {
+    int flag;
+    MPI_Status status;
+    MPI_Iprobe(MPI_ANY_SOURCE, tag, _comm, &flag, &status);
+    if (flag) {
+      int count;
+      MPI_Get_count(&status, MPI_UNSIGNED_CHAR, &count);
+      uint len = count/sizeof(uint);
+      keep->buf.buffer_reserve((keep->n + len)*sizeof(uint));
+      MPI_Recv((void*)((uint*)keep->buf.ptr + keep->n), count, MPI_UNSIGNED_CHAR,
+          status.MPI_SOURCE, tag, _comm, MPI_STATUS_IGNORE);
+      chunks.push_back(std::make_pair((uint)status.MPI_SOURCE, std::make_pair(keep->n, len)));
+      keep->n += len;
+    }
+    if (in_barrier)
+      MPI_Test(&barrier, &done, MPI_STATUS_IGNORE);
+    else {
+      int sent = 1;
+      if (!reqs.empty())
+        MPI_Testall((int)reqs.size(), &reqs[0], &sent, MPI_STATUSES_IGNORE);
+      if (sent) {
+        MPI_Ibarrier(_comm, &barrier);
+        in_barrier = true;
+      }
+    }
+  }
+
+  /* order the incoming messages by source */
+  std::sort(chunks.begin(), chunks.end());
+  all->buf.buffer_reserve(keep->n*sizeof(uint));
+  uint *dst = (uint*) all->buf.ptr;
+  for (size_t i = 0; i < chunks.size(); ++i) {
+    memcpy(dst, (uint*)keep->buf.ptr + chunks[i].second.first,
+        chunks[i].second.second*sizeof(uint));
+    dst += chunks[i].second.second;
+  }
+  all->n = keep->n;
+  keep->n = 0;
+#else
+  crystal_router();
+#endif
+}
+
 #define UINT_PER_X(X) ((sizeof(X)+sizeof(uint)-1)/sizeof(uint))
 #define UINT_PER_REAL UINT_PER_X(realType)
 #define UINT_PER_LONG UINT_PER_X(slong)
@@ -632,7 +746,10 @@ ErrorCode gs_data::crystal_data::gs_transfer(int dynamic,
     *len += tsize, all->n += tsize;
   }
 
-  crystal_router();
+  if (SPARSE_NBX == _mode)
+    sparse_exchange();
+  else
+    crystal_router();
 
   /* unpack */
   buf = (uint*)all->buf.ptr;
@@ -736,10 +853,6 @@ void gs_data::gs_data_op_many(realType **u, uint n, int op)
 #endif
   for (i = 0; i < n; ++i)
     local_condense(u[i], op, local_cm);
-
-  moab::fail("%s: initialized with max vec size = %d,"
-      " but called with vec size = %d\n", __FILE__, 6, n);
-
 #ifdef MOAB_HAVE_MPI
   this->nlinfo->nonlocal_many(u,n,op,_comm);
 #endif
@@ -946,10 +1059,8 @@ ErrorCode gs_data::initialize(uint n, const long *label, const Ulong *ulabel,
   if (rval != MB_SUCCESS)
   return rval;
   /* shared list: (useless, proc2, index, label) */
-  /* sort by label */
-  shared.sort(3,&crystal->all->buf);
-  /* sort by partner proc */
-  shared.sort(1,&crystal->all->buf);
+  /* sort by partner proc, then by label */
+  shared.sort(1,3,&crystal->all->buf);
   /* count partner procs */
   {
     uint i, count=0;
@@ -102,9 +102,29 @@ namespace moab {
 
 	  ErrorCode release_send_buffers(MPI_Comm jcomm);
 
+	  /**
+	    \brief send the values of some tags on the owned elements to the receivers
+
+	    <B>Operations:</B> Nonblocking, called on sender tasks
+
+	    All tags for a receiver are packed in one message. The sends are completed by
+	    release_send_buffers, so the sender can keep working meanwhile; the buffers
+	    are kept for the next call, which must come after release_send_buffers.
+	    After coverage, the elements to send are found once and reused by the following calls
+	    with the same owned range; they are found again when owned changes.
+	   */
 	  ErrorCode send_tag_values (MPI_Comm jcomm, ParallelComm *pco, Range & owned,
 	      std::vector<Tag> & tag_handles );
 
+	  /**
+	    \brief receive the values of some tags, sent by send_tag_values
+
+	    <B>Operations:</B> Blocking, called on receiver tasks
+
+	    The receives from all senders are posted at once, and the tag values from each
+	    message are set as soon as it arrives. After coverage, the elements to receive are
+	    found once and reused by the following calls with the same owned range.
+	   */
 	  ErrorCode receive_tag_values (MPI_Comm jcomm, ParallelComm *pco, Range & owned,
         std::vector<Tag> & tag_handles );
 
@@ -131,6 +151,10 @@ namespace moab {
     */
 	  void find_group_ranks(MPI_Group group, MPI_Comm join, std::vector<int> & ranks);
 
+	  // find the owned entities for the global ids in ids_map, in the same order
+	  ErrorCode find_ents_by_ids(Interface * mb, Range & owned, std::map<int, std::vector<int> > & ids_map,
+	      std::map<int, std::vector<EntityHandle> > & ents_map);
+
 	  MPI_Comm  comm;
 	  std::vector<int>  senderTasks;  // these are the sender tasks in joint comm
 	  std::vector<int>  receiverTasks; // these are all the receiver tasks in joint comm
@@ -170,6 +194,16 @@ namespace moab {
 	  std::map<int ,std::vector<int> > send_IDs_map; // maybe moab::Range instead of std::vector<int> // these will be on sender side
 	  std::map<int, std::vector<int> > recv_IDs_map; // receiver side, after coverage, how many elements need to be received from each sender process
 
+	  // tag migration: entities for send_IDs_map and recv_IDs_map, found at first use and
+	  // found again when the owned range changes (the global ids of the owned entities are
+	  // assumed not to change), and the message buffers for each task, kept from one call to the next
+	  std::map<int, std::vector<EntityHandle> > send_ents_map;
+	  std::map<int, std::vector<EntityHandle> > recv_ents_map;
+	  Range send_ents_owned; // owned range send_ents_map was found in
+	  Range recv_ents_owned; // owned range recv_ents_map was found in
+	  std::map<int, std::vector<char> > tagSendBuffs;
+	  std::map<int, std::vector<char> > tagRecvBuffs;
+
 };
 
 } // namespace moab
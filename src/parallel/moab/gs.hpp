@@ -105,6 +105,19 @@ namespace moab {
     class crystal_data
     {
     public:
+      /**Algorithm used by gs_transfer to exchange the messages
+       */
+      enum exchange_mode {
+        /** Staged hypercube exchange: log2(P) rounds, messages are forwarded
+         *  through intermediate procs */
+        CRYSTAL_ROUTER,
+        /** Sparse exchange with nonblocking consensus (NBX): each message is
+         *  sent directly to its target and termination is detected with a
+         *  nonblocking barrier.  Needs MPI-3; falls back to the crystal
+         *  router otherwise */
+        SPARSE_NBX
+      };
+
       //moab_crystal_data member variables & data
       typedef struct { uint n; moab::TupleList::buffer buf; } crystal_buf;
       crystal_buf buffers[3];
@@ -112,6 +125,8 @@ namespace moab {
       crystal_buf *all, *keep, *send;
       MPI_Comm _comm;
       uint _num, _id;
+      exchange_mode _mode;
+      uint _epoch; /* number of sparse exchanges, selects their tag */
 
       /**Default constructor (Note:  moab_crystal_data must be initialized
        * before use!)
@@ -140,8 +155,25 @@ namespace moab {
        */
       void crystal_router();
 
+      /**Communicates messages with other processors, as crystal_router, but
+       * sends each message directly to its target.  Incoming messages are
+       * ordered by source proc.  Consecutive calls alternate between two
+       * message tags, so a fast proc can start the next exchange while the
+       * others finish this one; no other communication with these tags may
+       * be pending on the communicator.
+       */
+      void sparse_exchange();
+
+      /**Selects the algorithm used by gs_transfer; the default is
+       * CRYSTAL_ROUTER.  All procs must use the same mode.
+       */
+      void set_exchange_mode(exchange_mode mode) { _mode = mode; }
+
+      exchange_mode get_exchange_mode() const { return _mode; }
+
       /**Treats one integer (not long) member of the TupleList as a target proc;
-       * Sends out tuples accordingly, using the crystal router.
+       * Sends out tuples accordingly, using the crystal router or the sparse
+       * exchange (see set_exchange_mode).
        * Target proc member overwritten with source proc.
        *
        * param dynamic   non-zero if the TupleList should grow to accomodate
@@ -209,8 +241,25 @@ namespace moab {
 
     void reset();
 
+    /**Gather-scatter on one value per point
+     *
+     * param u   array of values, one per tuple
+     * param op  one of the GS_OP_* operations
+     */
     void gs_data_op(realType *u, int op);
+
+    /**Gather-scatter on n interleaved fields: the n values of point i are
+     * u[n*i] ... u[n*i+n-1].  The reductions run over the fields in the
+     * inner loop, and each partner proc gets a single message with the
+     * values of a point stored contiguously.  This is the preferred layout
+     * when many fields are exchanged at once.  n must not exceed maxv.
+     */
     void gs_data_op_vec(realType *u, uint n, int op);
+
+    /**Gather-scatter on n separate field arrays u[0] ... u[n-1].  The local
+     * reductions are done field by field; each partner proc gets a single
+     * message holding all fields.  n must not exceed maxv.
+     */
     void gs_data_op_many(realType **u, uint n, int op);
 
 #define GS_OP_ADD 1
@@ -9,6 +9,11 @@
 #include "moab/verdict/VerdictWrapper.hpp"
 #include "Internals.hpp"
 #include "moab/verdict.h"
+#include "moab/Range.hpp"
+#include "moab/MOABConfig.h"
+
+#include <algorithm>
+#include <math.h>
 
 namespace moab
 {
@@ -138,41 +143,10 @@ static const char * nameType[MBMAXTYPE] =
     "MBENTITYSET", /**< MeshSet */
 };
 
-ErrorCode VerdictWrapper::quality_measure(EntityHandle eh, QualityType q, double & quality,
-    int num_nodes, EntityType etype, double * coords)
+// verdict function computing a quality for an element type, and the number of corners it uses
+static ErrorCode verdict_function(EntityType etype, QualityType q, VerdictFunction & func, int & num_nodes)
 {
-  double coordinates[27][3]; // at most 27 nodes per element
-
-  if (0==num_nodes && NULL==coords)
-  {
-    etype= TYPE_FROM_HANDLE(eh);
-    if (possibleQuality[etype][q]==0)
-      return MB_NOT_IMPLEMENTED;
-
-    // get coordinates of points, if not passed already
-    const EntityHandle * conn = NULL;
-    //int num_nodes;
-    ErrorCode rval = mbImpl->get_connectivity(eh, conn, num_nodes);
-    if (rval!=MB_SUCCESS)
-      return rval;
-    if (etype!=MBPOLYHEDRON)
-    {
-      rval = mbImpl->get_coords(conn, num_nodes, &(coordinates[0][0]));
-      if (rval!=MB_SUCCESS)
-        return rval;
-    }
-  }
-  else
-  {
-    if (num_nodes > 27)
-      return MB_FAILURE;
-    for (int i=0; i<num_nodes; i++)
-    {
-      for (int j=0; j<3; j++)
-        coordinates[i][j]=coords[3*i+j];
-    }
-  }
-  VerdictFunction func=0;
+  func = 0;
 
   switch(etype){
   case MBHEX:
@@ -314,11 +288,447 @@ ErrorCode VerdictWrapper::quality_measure(EntityHandle eh, QualityType q, double
 
   if (!func)
     return MB_NOT_IMPLEMENTED;
+  return MB_SUCCESS;
+}
+
+ErrorCode VerdictWrapper::quality_measure(EntityHandle eh, QualityType q, double & quality,
+    int num_nodes, EntityType etype, double * coords)
+{
+  double coordinates[27][3]; // at most 27 nodes per element
+
+  if (0==num_nodes && NULL==coords)
+  {
+    etype= TYPE_FROM_HANDLE(eh);
+    if (possibleQuality[etype][q]==0)
+      return MB_NOT_IMPLEMENTED;
+
+    // get coordinates of points, if not passed already
+    const EntityHandle * conn = NULL;
+    std::vector<EntityHandle> storage; // for structured mesh
+    //int num_nodes;
+    ErrorCode rval = mbImpl->get_connectivity(eh, conn, num_nodes, false, &storage);
+    if (rval!=MB_SUCCESS)
+      return rval;
+    if (etype!=MBPOLYHEDRON)
+    {
+      rval = mbImpl->get_coords(conn, num_nodes, &(coordinates[0][0]));
+      if (rval!=MB_SUCCESS)
+        return rval;
+    }
+  }
+  else
+  {
+    if (num_nodes > 27)
+      return MB_FAILURE;
+    for (int i=0; i<num_nodes; i++)
+    {
+      for (int j=0; j<3; j++)
+        coordinates[i][j]=coords[3*i+j];
+    }
+  }
+  VerdictFunction func = 0;
+  ErrorCode rval = verdict_function(etype, q, func, num_nodes);
+  if (MB_SUCCESS != rval)
+    return rval;
   // actual computation happens here
   quality = (*func)(num_nodes, coordinates);
 
   return MB_SUCCESS;
 }
+// number of elements whose corner coordinates are gathered together
+static const int QUALITY_BLOCK_SIZE = 256;
+// the most corners used by a verdict function (hex)
+static const int MAX_QUALITY_CORNERS = 8;
+
+// coordinate arrays of the vertex sequences, looked up by handle
+class VertexCoordArrays
+{
+public:
+  // only the vertices of elems are made available
+  ErrorCode init(Interface * mb, const Range & elems)
+  {
+    Range verts;
+    ErrorCode rval = mb->get_connectivity(elems, verts);
+    if (MB_SUCCESS != rval)
+      return rval;
+    Range::const_iterator it = verts.begin();
+    while (it != verts.end())
+    {
+      Block b;
+      b.dbl[0] = b.dbl[1] = b.dbl[2] = NULL;
+      b.flt[0] = b.flt[1] = b.flt[2] = NULL;
+      int count;
+      rval = mb->coords_iterate(it, verts.end(), b.dbl[0], b.dbl[1], b.dbl[2], count);
+      if (MB_TYPE_OUT_OF_RANGE == rval) // coordinates stored in single precision
+        rval = mb->coords_iterate(it, verts.end(), b.flt[0], b.flt[1], b.flt[2], count);
+      if (MB_SUCCESS != rval)
+        return rval;
+      b.first = *it;
+      b.last = b.first + count - 1;
+      blocks.push_back(b);
+      it += count;
+    }
+    return MB_SUCCESS;
+  }
+
+  // get the coordinates of a vertex; hint is the block of the previous vertex
+  bool get_coords(EntityHandle v, double * xyz, size_t & hint) const
+  {
+    if (hint >= blocks.size() || v < blocks[hint].first || v > blocks[hint].last)
+    {
+      size_t lo = 0, hi = blocks.size();
+      while (lo < hi)
+      {
+        size_t mid = (lo + hi) / 2;
+        if (blocks[mid].last < v)
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+      if (lo == blocks.size() || v < blocks[lo].first)
+        return false;
+      hint = lo;
+    }
+    const Block & b = blocks[hint];
+    const size_t i = v - b.first;
+    for (int j = 0; j < 3; j++)
+      xyz[j] = b.dbl[j] ? b.dbl[j][i] : b.flt[j][i];
+    return true;
+  }
+
+private:
+  struct Block {
+    EntityHandle first, last;
+    double * dbl[3];
+    float * flt[3];
+  };
+  std::vector<Block> blocks;
+};
+
+// corner coordinates of a block of elements, one array per coordinate and corner
+struct CornerBlock {
+  double c[3][MAX_QUALITY_CORNERS][QUALITY_BLOCK_SIZE];
+};
+
+// computes a quality for the n elements of a block
+typedef void (*BlockQualityFunction)(int n, const CornerBlock & corners, double * values);
+
+// a . (b x c), evaluated in the same order as the verdict vector operators
+static inline double triple_product(double ax, double ay, double az,
+    double bx, double by, double bz, double cx, double cy, double cz)
+{
+  return ax * (by * cz - bz * cy) + ay * (bz * cx - bx * cz) + az * (bx * cy - by * cx);
+}
+
+// corner, and its neighbors along xi, eta and zeta, for the hex corner jacobians
+static const int hexCornerEdges[8][4] = {
+  {0, 1, 3, 4}, {1, 2, 0, 5}, {2, 3, 1, 6}, {3, 0, 2, 7},
+  {4, 7, 5, 0}, {5, 4, 6, 1}, {6, 5, 7, 2}, {7, 6, 4, 3}
+};
+
+// the principal axes of a hex (calc_hex_efg 1, 2 and 3 in verdict)
+static inline void hex_efg(const CornerBlock & cb, int j, int e, double efg[3])
+{
+  const double (*c)[QUALITY_BLOCK_SIZE] = cb.c[j];
+  efg[0] = c[1][e] + c[2][e] + c[5][e] + c[6][e] - c[0][e] - c[3][e] - c[4][e] - c[7][e];
+  efg[1] = c[2][e] + c[3][e] + c[6][e] + c[7][e] - c[0][e] - c[1][e] - c[4][e] - c[5][e];
+  efg[2] = c[4][e] + c[5][e] + c[6][e] + c[7][e] - c[0][e] - c[1][e] - c[2][e] - c[3][e];
+}
+
+static inline double clamp_quality(double q)
+{
+  return q > 0 ? std::min(q, VERDICT_DBL_MAX) : std::max(q, -VERDICT_DBL_MAX);
+}
+
+static void hex_volume_block(int n, const CornerBlock & cb, double * values)
+{
+  for (int e = 0; e < n; e++)
+  {
+    double ex[3], ey[3], ez[3];
+    hex_efg(cb, 0, e, ex);
+    hex_efg(cb, 1, e, ey);
+    hex_efg(cb, 2, e, ez);
+    values[e] = clamp_quality(triple_product(ex[0], ey[0], ez[0], ex[1], ey[1], ez[1], ex[2], ey[2], ez[2]) / 64.0);
+  }
+}
+
+static void hex_jacobian_block(int n, const CornerBlock & cb, double * values)
+{
+  const double (*x)[QUALITY_BLOCK_SIZE] = cb.c[0];
+  const double (*y)[QUALITY_BLOCK_SIZE] = cb.c[1];
+  const double (*z)[QUALITY_BLOCK_SIZE] = cb.c[2];
+  for (int e = 0; e < n; e++)
+  {
+    double ex[3], ey[3], ez[3];
+    hex_efg(cb, 0, e, ex);
+    hex_efg(cb, 1, e, ey);
+    hex_efg(cb, 2, e, ez);
+    double jac = std::min(VERDICT_DBL_MAX,
+        triple_product(ex[0], ey[0], ez[0], ex[1], ey[1], ez[1], ex[2], ey[2], ez[2]) / 64.0);
+    for (int k = 0; k < 8; k++)
+    {
+      const int* ce = hexCornerEdges[k];
+      const double j = triple_product(
+          x[ce[1]][e] - x[ce[0]][e], y[ce[1]][e] - y[ce[0]][e], z[ce[1]][e] - z[ce[0]][e],
+          x[ce[2]][e] - x[ce[0]][e], y[ce[2]][e] - y[ce[0]][e], z[ce[2]][e] - z[ce[0]][e],
+          x[ce[3]][e] - x[ce[0]][e], y[ce[3]][e] - y[ce[0]][e], z[ce[3]][e] - z[ce[0]][e]);
+      jac = std::min(jac, j);
+    }
+    values[e] = clamp_quality(jac);
+  }
+}
+
+// jacobian at a corner divided by the lengths of the edge vectors; false if
+// an edge vector is degenerate
+static inline bool scaled_jacobian(const double a[3], const double b[3], const double c[3], double & sj)
+{
+  const double la = a[0] * a[0] + a[1] * a[1] + a[2] * a[2];
+  const double lb = b[0] * b[0] + b[1] * b[1] + b[2] * b[2];
+  const double lc = c[0] * c[0] + c[1] * c[1] + c[2] * c[2];
+  sj = triple_product(a[0], a[1], a[2], b[0], b[1], b[2], c[0], c[1], c[2]) / sqrt(la * lb * lc);
+  return la > VERDICT_DBL_MIN && lb > VERDICT_DBL_MIN && lc > VERDICT_DBL_MIN;
+}
+
+static void hex_scaled_jacobian_block(int n, const CornerBlock & cb, double * values)
+{
+  const double (*x)[QUALITY_BLOCK_SIZE] = cb.c[0];
+  const double (*y)[QUALITY_BLOCK_SIZE] = cb.c[1];
+  const double (*z)[QUALITY_BLOCK_SIZE] = cb.c[2];
+  for (int e = 0; e < n; e++)
+  {
+    double a[3], b[3], c[3], sj;
+    for (int j = 0; j < 3; j++)
+    {
+      double efg[3];
+      hex_efg(cb, j, e, efg);
+      a[j] = efg[0]; b[j] = efg[1]; c[j] = efg[2];
+    }
+    bool valid = scaled_jacobian(a, b, c, sj);
+    double min_sj = std::min(VERDICT_DBL_MAX, sj);
+    for (int k = 0; k < 8; k++)
+    {
+      const int* ce = hexCornerEdges[k];
+      a[0] = x[ce[1]][e] - x[ce[0]][e]; a[1] = y[ce[1]][e] - y[ce[0]][e]; a[2] = z[ce[1]][e] - z[ce[0]][e];
+      b[0] = x[ce[2]][e] - x[ce[0]][e]; b[1] = y[ce[2]][e] - y[ce[0]][e]; b[2] = z[ce[2]][e] - z[ce[0]][e];
+      c[0] = x[ce[3]][e] - x[ce[0]][e]; c[1] = y[ce[3]][e] - y[ce[0]][e]; c[2] = z[ce[3]][e] - z[ce[0]][e];
+      valid = scaled_jacobian(a, b, c, sj) && valid;
+      min_sj = std::min(min_sj, sj);
+    }
+    values[e] = valid ? clamp_quality(min_sj) : VERDICT_DBL_MAX;
+  }
+}
+
+static void tet_volume_block(int n, const CornerBlock & cb, double * values)
+{
+  const double (*x)[QUALITY_BLOCK_SIZE] = cb.c[0];
+  const double (*y)[QUALITY_BLOCK_SIZE] = cb.c[1];
+  const double (*z)[QUALITY_BLOCK_SIZE] = cb.c[2];
+  for (int e = 0; e < n; e++)
+  {
+    // side3 % (side2 * side0), as in verdict
+    values[e] = triple_product(
+        x[3][e] - x[0][e], y[3][e] - y[0][e], z[3][e] - z[0][e],
+        x[0][e] - x[2][e], y[0][e] - y[2][e], z[0][e] - z[2][e],
+        x[1][e] - x[0][e], y[1][e] - y[0][e], z[1][e] - z[0][e]) / 6.0;
+  }
+}
+
+// kernel computing a quality for a whole block of elements, if there is one
+static BlockQualityFunction block_function(EntityType etype, QualityType q)
+{
+  switch (etype) {
+  case MBHEX:
+    switch (q) {
+    case MB_VOLUME:               return hex_volume_block;
+    case MB_JACOBIAN:             return hex_jacobian_block;
+    case MB_SCALED_JACOBIAN:      return hex_scaled_jacobian_block;
+    default:                      return 0;
+    }
+  case MBTET:
+    return MB_VOLUME == q ? tet_volume_block : 0;
+  default:
+    return 0;
+  }
+}
+
+// compute a quality for count elements with explicit connectivity, with
+// vertices_per_elem vertices each; the corner coordinates of a block of elements
+// are gathered first, then the quality is computed for the block
+static ErrorCode quality_for_elements(VerdictFunction func, BlockQualityFunction block_func,
+    int num_nodes, bool thread_safe,
+    const EntityHandle * conn, int vertices_per_elem, int count,
+    const VertexCoordArrays & coords, double * values)
+{
+  const int num_blocks = (count + QUALITY_BLOCK_SIZE - 1) / QUALITY_BLOCK_SIZE;
+  bool found = true;
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel if(thread_safe)
+#endif
+  {
+    // one corner block per thread, on the heap: it is too large for the stack of a thread
+    std::vector<CornerBlock> corner_buffer(1);
+    CornerBlock & corners = corner_buffer[0];
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (int b = 0; b < num_blocks; b++)
+    {
+      const int first = b * QUALITY_BLOCK_SIZE;
+      const int n = std::min(QUALITY_BLOCK_SIZE, count - first);
+      size_t hint = 0;
+      bool block_found = true;
+      for (int e = 0; e < n && block_found; e++)
+      {
+        const EntityHandle * elem_conn = conn + (size_t)(first + e) * vertices_per_elem;
+        for (int k = 0; k < num_nodes && block_found; k++)
+        {
+          double xyz[3];
+          block_found = coords.get_coords(elem_conn[k], xyz, hint);
+          for (int j = 0; j < 3; j++)
+            corners.c[j][k][e] = xyz[j];
+        }
+      }
+      if (!block_found)
+      {
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp critical
+#endif
+        found = false;
+        continue;
+      }
+
+      if (block_func)
+      {
+        (*block_func)(n, corners, values + first);
+        continue;
+      }
+      for (int e = 0; e < n; e++)
+      {
+        double coordinates[MAX_QUALITY_CORNERS][3];
+        for (int k = 0; k < num_nodes; k++)
+          for (int j = 0; j < 3; j++)
+            coordinates[k][j] = corners.c[j][k][e];
+        values[first + e] = (*func)(num_nodes, coordinates);
+      }
+    }
+  }
+  (void)thread_safe;
+  return found ? MB_SUCCESS : MB_ENTITY_NOT_FOUND;
+}
+
+ErrorCode VerdictWrapper::quality_measure(const Range & elems, QualityType q, Tag qtag)
+{
+  DataType type;
+  int length;
+  ErrorCode rval = mbImpl->tag_get_data_type(qtag, type);MB_CHK_ERR(rval);
+  rval = mbImpl->tag_get_length(qtag, length);MB_CHK_ERR(rval);
+  if (MB_TYPE_DOUBLE != type || 1 != length)
+    MB_SET_ERR(MB_TYPE_OUT_OF_RANGE, "Quality tag must hold one double value");
+
+  return quality_measure_range(elems, q, qtag, NULL);
+}
+
+ErrorCode VerdictWrapper::quality_measure(const Range & elems, QualityType q, std::vector<double> & qualities)
+{
+  qualities.resize(elems.size());
+  if (elems.empty())
+    return MB_SUCCESS;
+  return quality_measure_range(elems, q, 0, &qualities[0]);
+}
+
+ErrorCode VerdictWrapper::quality_measure_range(const Range & elems, QualityType q, Tag qtag, double * values)
+{
+  ErrorCode rval;
+  bool dense = false;
+  if (!values)
+  {
+    TagType ttype;
+    rval = mbImpl->tag_get_type(qtag, ttype);MB_CHK_ERR(rval);
+    dense = (MB_TAG_DENSE == ttype);
+  }
+
+  VertexCoordArrays coords;
+  rval = coords.init(mbImpl, elems);MB_CHK_ERR(rval);
+
+  std::vector<double> buffer;
+  std::vector<EntityHandle> handles, conn_list;
+  Range::const_iterator it = elems.begin();
+  while (it != elems.end())
+  {
+    EntityType etype = TYPE_FROM_HANDLE(*it);
+    if (possibleQuality[etype][q] == 0)
+      return MB_NOT_IMPLEMENTED;
+    VerdictFunction func = 0;
+    int num_nodes;
+    rval = verdict_function(etype, q, func, num_nodes);
+    if (MB_SUCCESS != rval)
+      return rval;
+    // the verdict distortion uses global Gauss integration data
+    const bool thread_safe = (MB_DISTORTION != q);
+
+    // structured mesh has no connectivity array
+    const EntityHandle * first_conn;
+    int first_len;
+    const bool structured = (MB_STRUCTURED_MESH == mbImpl->get_connectivity(*it, first_conn, first_len));
+
+    EntityHandle * conn = NULL;
+    int vertices_per_elem, count;
+    handles.clear();
+    if (!structured)
+    {
+      rval = mbImpl->connect_iterate(it, elems.end(), conn, vertices_per_elem, count);MB_CHK_ERR(rval);
+    }
+    else
+    {
+      // get the corners of a block of elements
+      Range::const_iterator end = elems.upper_bound(etype, it);
+      for (Range::const_iterator hit = it; hit != end && handles.size() < (size_t)QUALITY_BLOCK_SIZE; ++hit)
+        handles.push_back(*hit);
+      rval = mbImpl->get_connectivity(&handles[0], (int)handles.size(), conn_list, true);MB_CHK_ERR(rval);
+      conn = &conn_list[0];
+      count = (int)handles.size();
+      vertices_per_elem = (int)(conn_list.size() / handles.size());
+    }
+
+    double * elem_values = values;
+    if (dense && handles.empty())
+    {
+      void * ptr;
+      int tag_count;
+      rval = mbImpl->tag_iterate(qtag, it, elems.end(), tag_count, ptr);MB_CHK_ERR(rval);
+      count = std::min(count, tag_count);
+      elem_values = static_cast<double*>(ptr);
+    }
+    else if (!values)
+    {
+      buffer.resize(count);
+      elem_values = &buffer[0];
+    }
+
+    rval = quality_for_elements(func, block_function(etype, q), num_nodes, thread_safe,
+        conn, vertices_per_elem, count, coords, elem_values);MB_CHK_SET_ERR(rval, "Failed to get vertex coordinates of " << nameType[etype] << " elements");
+
+    if (!values && elem_values == &buffer[0])
+    {
+      if (handles.empty())
+      {
+        Range block(*it, *it + count - 1);
+        rval = mbImpl->tag_set_data(qtag, block, elem_values);MB_CHK_ERR(rval);
+      }
+      else
+      {
+        rval = mbImpl->tag_set_data(qtag, &handles[0], count, elem_values);MB_CHK_ERR(rval);
+      }
+    }
+
+    if (values)
+      values += count;
+    it += count;
+  }
+
+  return MB_SUCCESS;
+}
+
 const char * VerdictWrapper::quality_name (QualityType q)
 {
   return nameQuality[q];
@@ -355,8 +765,9 @@ ErrorCode VerdictWrapper::all_quality_measures(EntityHandle eh, std::map<Quality
   double coordinates[27][3]; // at most 27 nodes per element
   // get coordinates of points, if not passed already
   const EntityHandle * conn = NULL;
+  std::vector<EntityHandle> storage; // for structured mesh
   int num_nodes;
-  ErrorCode rval = mbImpl->get_connectivity(eh, conn, num_nodes);
+  ErrorCode rval = mbImpl->get_connectivity(eh, conn, num_nodes, false, &storage);
   if (rval != MB_SUCCESS)
     return rval;
   rval = mbImpl->get_coords(conn, num_nodes, &(coordinates[0][0]));
@@ -10,6 +10,7 @@ void test_create_tag();
 void test_get_set_sparse_int();
 void test_get_set_dense_int();
 void test_get_set_dense_double();
+void test_get_set_dense_float();
 void test_get_set_bit();
 void test_get_by_tag( );
 void test_get_by_tag_value( );
@@ -54,6 +55,7 @@ int main()
   failures += RUN_TEST( test_get_set_sparse_int );
   failures += RUN_TEST( test_get_set_dense_int );
   failures += RUN_TEST( test_get_set_dense_double );
+  failures += RUN_TEST( test_get_set_dense_float );
   failures += RUN_TEST( test_get_set_bit );
   failures += RUN_TEST( test_get_by_tag );
   failures += RUN_TEST( test_get_by_tag_value );
@@ -674,6 +676,97 @@ void test_get_set_dense_double()
                 defaultval );
 }
 
+void test_get_set_dense_float()
+{
+  Core moab;
+  Interface& mb = moab;
+  setup_mesh( mb );
+  ErrorCode rval;
+
+    // only dense, fixed-length double tags can be stored as float
+  Tag tag;
+  rval = mb.tag_get_handle( "float_sparse", 1, MB_TYPE_DOUBLE, tag, MB_TAG_SPARSE|MB_TAG_FLOAT|MB_TAG_EXCL );
+  CHECK_EQUAL( MB_TYPE_OUT_OF_RANGE, rval );
+  rval = mb.tag_get_handle( "float_int", 1, MB_TYPE_INTEGER, tag, MB_TAG_DENSE|MB_TAG_FLOAT|MB_TAG_EXCL );
+  CHECK_EQUAL( MB_TYPE_OUT_OF_RANGE, rval );
+
+  const double defval[] = { 0.5, -0.25 };
+  rval = mb.tag_get_handle( "float_dense", 2, MB_TYPE_DOUBLE, tag, MB_TAG_DENSE|MB_TAG_FLOAT|MB_TAG_EXCL, defval );
+  CHECK_ERR( rval );
+  int bytes;
+  rval = mb.tag_get_bytes( tag, bytes );
+  CHECK_ERR( rval );
+  CHECK_EQUAL( (int)(2*sizeof(double)), bytes );
+  Tag tag2;
+  rval = mb.tag_get_handle( "float_dense", 2, MB_TYPE_DOUBLE, tag2, MB_TAG_DENSE|MB_TAG_STORE );
+  CHECK_EQUAL( MB_TYPE_OUT_OF_RANGE, rval );
+  rval = mb.tag_get_handle( "float_dense", 2, MB_TYPE_DOUBLE, tag2, MB_TAG_DENSE|MB_TAG_FLOAT|MB_TAG_STORE );
+  CHECK_ERR( rval );
+  CHECK_EQUAL( tag, tag2 );
+
+    // values read back rounded to float
+  Range verts;
+  rval = mb.get_entities_by_type( 0, MBVERTEX, verts );
+  CHECK_ERR( rval );
+  std::vector<double> values( 2*verts.size() ), result( 2*verts.size() );
+  for (size_t i = 0; i < values.size(); ++i)
+    values[i] = 0.1 * i;
+  rval = mb.tag_set_data( tag, verts, &values[0] );
+  CHECK_ERR( rval );
+  rval = mb.tag_get_data( tag, verts, &result[0] );
+  CHECK_ERR( rval );
+  for (size_t i = 0; i < values.size(); ++i)
+    CHECK_REAL_EQUAL( (double)(float)values[i], result[i], 0.0 );
+
+  const EntityHandle last = verts.back();
+  const double one[] = { 1.1, 2.2 };
+  rval = mb.tag_set_data( tag, &last, 1, one );
+  CHECK_ERR( rval );
+  rval = mb.tag_get_data( tag, &last, 1, &result[0] );
+  CHECK_ERR( rval );
+  CHECK_REAL_EQUAL( (double)(float)one[0], result[0], 0.0 );
+  CHECK_REAL_EQUAL( (double)(float)one[1], result[1], 0.0 );
+
+    // entities without storage get the default value
+  Range hexes;
+  rval = mb.get_entities_by_type( 0, MBHEX, hexes );
+  CHECK_ERR( rval );
+  rval = mb.tag_get_data( tag, &hexes.front(), 1, &result[0] );
+  CHECK_ERR( rval );
+  CHECK_REAL_EQUAL( defval[0], result[0], 0.0 );
+  CHECK_REAL_EQUAL( defval[1], result[1], 0.0 );
+
+    // search compares with the value rounded to float
+  const void* ptrs[] = { one };
+  Range found;
+  rval = mb.get_entities_by_type_and_tag( 0, MBVERTEX, &tag, ptrs, 1, found );
+  CHECK_ERR( rval );
+  CHECK_EQUAL( (size_t)1, found.size() );
+  CHECK_EQUAL( last, found.front() );
+
+    // no pointers to the storage
+  int count;
+  void* data;
+  rval = mb.tag_iterate( tag, verts.begin(), verts.end(), count, data );
+  CHECK_EQUAL( MB_TYPE_OUT_OF_RANGE, rval );
+  const void* ptr;
+  rval = mb.tag_get_by_ptr( tag, &last, 1, &ptr );
+  CHECK_EQUAL( MB_TYPE_OUT_OF_RANGE, rval );
+
+    // clear and remove
+  const double cleared[] = { 3.3, 4.4 };
+  rval = mb.tag_clear_data( tag, verts, cleared );
+  CHECK_ERR( rval );
+  rval = mb.tag_get_data( tag, &verts.front(), 1, &result[0] );
+  CHECK_ERR( rval );
+  CHECK_REAL_EQUAL( (double)(float)cleared[1], result[1], 0.0 );
+  rval = mb.tag_delete_data( tag, &last, 1 );
+  CHECK_ERR( rval );
+  rval = mb.tag_get_data( tag, &last, 1, &result[0] );
+  CHECK_ERR( rval );
+  CHECK_REAL_EQUAL( defval[0], result[0], 0.0 );
+  CHECK_REAL_EQUAL( defval[1], result[1], 0.0 );
+}
 
 void test_get_pointers_sparse()
 {
@@ -6,6 +6,7 @@
 #include "moab/Range.hpp"
 #include "moab/MeshTopoUtil.hpp"
 #include "moab/HalfFacetRep.hpp"
+#include "moab/ReadUtilIface.hpp"
 #include "TestUtil.hpp"
 
 #ifdef MOAB_HAVE_MPI
@@ -326,6 +327,319 @@ ErrorCode ahf_test(const char* filename)
 
 }
 
+ErrorCode compare_modified_ahf(Core *moab, HalfFacetRep &ahf, int dim = 3)
+{
+    ErrorCode error;
+    Range verts, ents;
+    error = moab->get_entities_by_dimension(0, dim, ents);CHECK_ERR(error);
+    error = moab->get_connectivity(ents, verts);CHECK_ERR(error);
+
+    // The notifications patch the maps in place, they must not have dropped them
+    CHECK(ahf.is_initialized());
+
+    // Maps built from scratch on the modified mesh
+    HalfFacetRep fresh(moab);
+    error = fresh.initialize();CHECK_ERR(error);
+
+    std::vector<EntityHandle> adjents, freshents;
+    Range mbents;
+
+    //IQ: For every vertex, obtain incident entities
+    for (Range::iterator i = verts.begin(); i != verts.end(); ++i) {
+        adjents.clear();
+        error = ahf.get_adjacencies( *i, dim, adjents);CHECK_ERR(error);
+        mbents.clear();
+        error = moab->get_adjacencies( &*i, 1, dim, false, mbents);CHECK_ERR(error);
+
+        CHECK_EQUAL(mbents.size(), adjents.size());
+        std::sort(adjents.begin(), adjents.end());
+        CHECK(std::equal(adjents.begin(), adjents.end(), mbents.begin()));
+
+        freshents.clear();
+        error = fresh.get_adjacencies( *i, dim, freshents);CHECK_ERR(error);
+        std::sort(freshents.begin(), freshents.end());
+        CHECK(adjents == freshents);
+      }
+
+    //NQ: For every entity, obtain neighbor entities
+    for (Range::iterator i = ents.begin(); i != ents.end(); ++i) {
+        adjents.clear();
+        error = ahf.get_adjacencies( *i, dim, adjents);CHECK_ERR(error);
+        freshents.clear();
+        error = fresh.get_adjacencies( *i, dim, freshents);CHECK_ERR(error);
+
+        CHECK_EQUAL(freshents.size(), adjents.size());
+        std::sort(adjents.begin(), adjents.end());
+        std::sort(freshents.begin(), freshents.end());
+        CHECK(adjents == freshents);
+
+        // The sibling half-facets themselves, including the local ids; a curve orders
+        // the half-verts on a vertex in a cycle, which the neighbors above already cover
+        if (dim == 1)
+          continue;
+        EntityType type = moab->type_from_handle(*i);
+        int nhf = CN::NumSubEntities(type, dim-1);
+        EntityHandle sibents[6], freshsibents[6];
+        int siblids[6], freshsiblids[6];
+        error = ahf.get_sibling_map(type, *i, sibents, siblids, nhf);CHECK_ERR(error);
+        error = fresh.get_sibling_map(type, *i, freshsibents, freshsiblids, nhf);CHECK_ERR(error);
+        for (int f = 0; f < nhf; f++) {
+            CHECK_EQUAL(freshsibents[f], sibents[f]);
+            CHECK_EQUAL(freshsiblids[f], siblids[f]);
+          }
+      }
+
+    return MB_SUCCESS;
+}
+
+ErrorCode ahf_modify_test()
+{
+    Core moab;
+    Interface* mbImpl = &moab;
+    ErrorCode error;
+
+    // 3x3x3 block of hexes
+    const int N = 3;
+    std::vector<EntityHandle> verts((N+1)*(N+1)*(N+1));
+    for (int k = 0; k <= N; k++)
+      for (int j = 0; j <= N; j++)
+        for (int i = 0; i <= N; i++) {
+            double coords[] = {(double)i, (double)j, (double)k};
+            error = mbImpl->create_vertex(coords, verts[i+(N+1)*(j+(N+1)*k)]);CHECK_ERR(error);
+          }
+
+    std::vector<EntityHandle> hexes(N*N*N);
+    std::vector<EntityHandle> hexconn(8*N*N*N);
+    for (int k = 0; k < N; k++)
+      for (int j = 0; j < N; j++)
+        for (int i = 0; i < N; i++) {
+            int h = i+N*(j+N*k);
+            EntityHandle *conn = &hexconn[8*h];
+            for (int c = 0; c < 8; c++) {
+                int ii = i + (((c+1)/2)%2), jj = j + (c/2)%2, kk = k + c/4;
+                conn[c] = verts[ii+(N+1)*(jj+(N+1)*kk)];
+              }
+            error = mbImpl->create_element(MBHEX, conn, 8, hexes[h]);CHECK_ERR(error);
+          }
+
+    HalfFacetRep ahf(&moab);
+    error = ahf.initialize();CHECK_ERR(error);
+
+    // Remove the center hex, leaving an interior cavity
+    EntityHandle center = hexes[13];
+    error = ahf.notify_delete_entity(center);CHECK_ERR(error);
+    error = mbImpl->delete_entities(&center, 1);CHECK_ERR(error);
+    error = compare_modified_ahf(&moab, ahf);CHECK_ERR(error);
+
+    // Remove a corner hex, which drops the last cell of a vertex
+    EntityHandle corner = hexes[0];
+    error = ahf.notify_delete_entity(corner);CHECK_ERR(error);
+    error = mbImpl->delete_entities(&corner, 1);CHECK_ERR(error);
+    error = compare_modified_ahf(&moab, ahf);CHECK_ERR(error);
+
+    // Fill the cavity again
+    error = mbImpl->create_element(MBHEX, &hexconn[8*13], 8, center);CHECK_ERR(error);
+    error = ahf.notify_create_entity(center);CHECK_ERR(error);
+    error = compare_modified_ahf(&moab, ahf);CHECK_ERR(error);
+
+    // Stack a new hex with new vertices on top of the block
+    EntityHandle top[8];
+    std::copy(&hexconn[8*22+4], &hexconn[8*22+8], top);
+    for (int c = 0; c < 4; c++) {
+        double coords[3];
+        error = mbImpl->get_coords(&top[c], 1, coords);CHECK_ERR(error);
+        coords[2] += 1.0;
+        error = mbImpl->create_vertex(coords, top[c+4]);CHECK_ERR(error);
+      }
+    EntityHandle newhex;
+    error = mbImpl->create_element(MBHEX, top, 8, newhex);CHECK_ERR(error);
+    error = ahf.notify_create_entity(newhex);CHECK_ERR(error);
+    error = compare_modified_ahf(&moab, ahf);CHECK_ERR(error);
+
+    // Grow a column of hexes on top of it one at a time, then delete every other one
+    std::vector<EntityHandle> column(1, newhex);
+    for (int l = 0; l < 100; l++) {
+        std::copy(top+4, top+8, top);
+        for (int c = 0; c < 4; c++) {
+            double coords[3];
+            error = mbImpl->get_coords(&top[c], 1, coords);CHECK_ERR(error);
+            coords[2] += 1.0;
+            error = mbImpl->create_vertex(coords, top[c+4]);CHECK_ERR(error);
+          }
+        error = mbImpl->create_element(MBHEX, top, 8, newhex);CHECK_ERR(error);
+        error = ahf.notify_create_entity(newhex);CHECK_ERR(error);
+        column.push_back(newhex);
+      }
+    error = compare_modified_ahf(&moab, ahf);CHECK_ERR(error);
+
+    for (size_t l = 1; l < column.size(); l += 2) {
+        error = ahf.notify_delete_entity(column[l]);CHECK_ERR(error);
+        error = mbImpl->delete_entities(&column[l], 1);CHECK_ERR(error);
+      }
+    error = compare_modified_ahf(&moab, ahf);CHECK_ERR(error);
+
+#ifdef MOAB_HAVE_AHF
+    // Elements created in bulk, as readers and pymoab do, patch the maps of the instance
+    HalfFacetRep* coreahf = moab.a_half_facet_rep();
+    error = coreahf->initialize();CHECK_ERR(error);
+
+    const int nlayers = 10;
+    std::vector<EntityHandle> layerverts(4*nlayers);
+    for (int l = 0; l < nlayers; l++)
+      for (int c = 0; c < 4; c++) {
+          double coords[3];
+          error = mbImpl->get_coords(&top[c+4], 1, coords);CHECK_ERR(error);
+          coords[2] += 1.0 + l;
+          error = mbImpl->create_vertex(coords, layerverts[4*l+c]);CHECK_ERR(error);
+        }
+
+    ReadUtilIface* readIface;
+    error = mbImpl->query_interface(readIface);CHECK_ERR(error);
+    EntityHandle start, *conn;
+    error = readIface->get_element_connect(nlayers, 8, MBHEX, 1, start, conn);CHECK_ERR(error);
+    for (int l = 0; l < nlayers; l++) {
+        const EntityHandle* below = l ? &layerverts[4*(l-1)] : top+4;
+        std::copy(below, below+4, conn+8*l);
+        std::copy(&layerverts[4*l], &layerverts[4*l+4], conn+8*l+4);
+      }
+    error = readIface->update_adjacencies(start, nlayers, 8, conn);CHECK_ERR(error);
+    error = mbImpl->release_interface(readIface);CHECK_ERR(error);
+    error = compare_modified_ahf(&moab, *coreahf);CHECK_ERR(error);
+#endif
+
+    std::cout<<"Finished modified mesh queries"<<std::endl;
+
+    return MB_SUCCESS;
+}
+
+ErrorCode ahf_modify_surface_test()
+{
+    Core moab;
+    Interface* mbImpl = &moab;
+    ErrorCode error;
+
+    // 4x4 grid of quads
+    const int N = 4;
+    std::vector<EntityHandle> verts((N+1)*(N+1));
+    for (int j = 0; j <= N; j++)
+      for (int i = 0; i <= N; i++) {
+          double coords[] = {(double)i, (double)j, 0.0};
+          error = mbImpl->create_vertex(coords, verts[i+(N+1)*j]);CHECK_ERR(error);
+        }
+
+    std::vector<EntityHandle> quads(N*N);
+    std::vector<EntityHandle> quadconn(4*N*N);
+    for (int j = 0; j < N; j++)
+      for (int i = 0; i < N; i++) {
+          int q = i+N*j;
+          EntityHandle *conn = &quadconn[4*q];
+          conn[0] = verts[i+(N+1)*j];
+          conn[1] = verts[i+1+(N+1)*j];
+          conn[2] = verts[i+1+(N+1)*(j+1)];
+          conn[3] = verts[i+(N+1)*(j+1)];
+          error = mbImpl->create_element(MBQUAD, conn, 4, quads[q]);CHECK_ERR(error);
+        }
+
+    HalfFacetRep ahf(&moab);
+    error = ahf.initialize();CHECK_ERR(error);
+
+    // Remove two quads meeting at a single vertex, which leaves that vertex non-manifold
+    EntityHandle gone[] = {quads[5], quads[10]};
+    for (int k = 0; k < 2; k++) {
+        error = ahf.notify_delete_entity(gone[k]);CHECK_ERR(error);
+        error = mbImpl->delete_entities(&gone[k], 1);CHECK_ERR(error);
+        error = compare_modified_ahf(&moab, ahf, 2);CHECK_ERR(error);
+      }
+
+    // Put one back, the vertex is manifold again
+    error = mbImpl->create_element(MBQUAD, &quadconn[4*5], 4, quads[5]);CHECK_ERR(error);
+    error = ahf.notify_create_entity(quads[5]);CHECK_ERR(error);
+    error = compare_modified_ahf(&moab, ahf, 2);CHECK_ERR(error);
+
+    // Grow a strip of quads from the top edge one at a time, then delete every other one
+    EntityHandle top[4] = {verts[(N+1)*N], verts[1+(N+1)*N], 0, 0};
+    std::vector<EntityHandle> strip;
+    for (int l = 0; l < 100; l++) {
+        for (int c = 0; c < 2; c++) {
+            double coords[3];
+            error = mbImpl->get_coords(&top[c], 1, coords);CHECK_ERR(error);
+            coords[1] += 1.0;
+            error = mbImpl->create_vertex(coords, top[3-c]);CHECK_ERR(error);
+          }
+        EntityHandle newquad;
+        error = mbImpl->create_element(MBQUAD, top, 4, newquad);CHECK_ERR(error);
+        error = ahf.notify_create_entity(newquad);CHECK_ERR(error);
+        strip.push_back(newquad);
+        top[0] = top[3];
+        top[1] = top[2];
+      }
+    error = compare_modified_ahf(&moab, ahf, 2);CHECK_ERR(error);
+
+    for (size_t l = 1; l < strip.size(); l += 2) {
+        error = ahf.notify_delete_entity(strip[l]);CHECK_ERR(error);
+        error = mbImpl->delete_entities(&strip[l], 1);CHECK_ERR(error);
+      }
+    error = compare_modified_ahf(&moab, ahf, 2);CHECK_ERR(error);
+
+#ifdef MOAB_HAVE_AHF
+    // A connectivity change goes through the maps of the instance as a delete and a create
+    HalfFacetRep* coreahf = moab.a_half_facet_rep();
+    error = coreahf->initialize();CHECK_ERR(error);
+
+    EntityHandle flipped[4];
+    std::reverse_copy(&quadconn[0], &quadconn[4], flipped);
+    error = mbImpl->set_connectivity(quads[0], flipped, 4);CHECK_ERR(error);
+    error = compare_modified_ahf(&moab, *coreahf, 2);CHECK_ERR(error);
+#endif
+
+    return MB_SUCCESS;
+}
+
+ErrorCode ahf_modify_curve_test()
+{
+    Core moab;
+    Interface* mbImpl = &moab;
+    ErrorCode error;
+
+    // A chain of edges, with three more edges branching off its middle vertex
+    const int N = 10;
+    std::vector<EntityHandle> verts(N+4), edges;
+    for (int i = 0; i < N+4; i++) {
+        double coords[] = {(double)(i < N+1 ? i : N/2), (double)(i < N+1 ? 0 : i-N), 0.0};
+        error = mbImpl->create_vertex(coords, verts[i]);CHECK_ERR(error);
+      }
+    for (int i = 0; i < N+3; i++) {
+        EntityHandle conn[] = {i < N ? verts[i] : verts[N/2], verts[i+1]};
+        EntityHandle edge;
+        error = mbImpl->create_element(MBEDGE, conn, 2, edge);CHECK_ERR(error);
+        edges.push_back(edge);
+      }
+
+    HalfFacetRep ahf(&moab);
+    error = ahf.initialize();CHECK_ERR(error);
+
+    // Cut the branch vertex down to a single edge, then to none
+    const int cut[] = {N, N/2-1, N+1, N/2, N+2};
+    for (int k = 0; k < 5; k++) {
+        error = ahf.notify_delete_entity(edges[cut[k]]);CHECK_ERR(error);
+        error = mbImpl->delete_entities(&edges[cut[k]], 1);CHECK_ERR(error);
+        error = compare_modified_ahf(&moab, ahf, 1);CHECK_ERR(error);
+      }
+
+    // Branch out again, one edge at a time
+    for (int i = 0; i < 4; i++) {
+        double coords[] = {(double)(N/2), -1.0-i, 0.0};
+        EntityHandle conn[2] = {verts[N/2], 0};
+        error = mbImpl->create_vertex(coords, conn[1]);CHECK_ERR(error);
+        EntityHandle edge;
+        error = mbImpl->create_element(MBEDGE, conn, 2, edge);CHECK_ERR(error);
+        error = ahf.notify_create_entity(edge);CHECK_ERR(error);
+        error = compare_modified_ahf(&moab, ahf, 1);CHECK_ERR(error);
+      }
+
+    return MB_SUCCESS;
+}
+
 int main(int argc, char *argv[])
 {
 
@@ -378,6 +692,26 @@ int main(int argc, char *argv[])
     handle_error_code(result, number_tests_failed, number_tests_successful);
     std::cout<<"\n";
 
+#ifdef MOAB_HAVE_MPI
+    if (rank == 0)
+#endif
+    {
+      std::cout<<"ahf_modify_test:";
+      result = ahf_modify_test();
+      handle_error_code(result, number_tests_failed, number_tests_successful);
+      std::cout<<"\n";
+
+      std::cout<<"ahf_modify_surface_test:";
+      result = ahf_modify_surface_test();
+      handle_error_code(result, number_tests_failed, number_tests_successful);
+      std::cout<<"\n";
+
+      std::cout<<"ahf_modify_curve_test:";
+      result = ahf_modify_curve_test();
+      handle_error_code(result, number_tests_failed, number_tests_successful);
+      std::cout<<"\n";
+    }
+
 #ifdef MOAB_HAVE_MPI
     MPI_Finalize();
 #endif
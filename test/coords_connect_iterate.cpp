@@ -10,6 +10,7 @@
 void test_coords_connect_iterate();
 void test_scd_invalid();
 void test_iterates();
+void test_float_coords();
 
 using namespace moab;
 
@@ -20,6 +21,7 @@ int main()
   failures += RUN_TEST(test_coords_connect_iterate);
   failures += RUN_TEST(test_scd_invalid);
   failures += RUN_TEST(test_iterates);
+  failures += RUN_TEST(test_float_coords);
 
   if (failures)
     std::cerr << "<<<< " << failures << " TESTS FAILED >>>>" << std::endl;
@@ -285,3 +287,88 @@ void test_iterates()
       hit += count;
     }
 }
+
+void test_float_coords()
+{
+  const unsigned int NUM_VTX = 1000;
+  Core moab;
+  Interface& mb = moab;
+  ErrorCode rval;
+
+  // Vertices in single precision, then in double precision
+  CHECK(!mb.get_float_coordinates());
+  mb.set_float_coordinates(true);
+  CHECK(mb.get_float_coordinates());
+
+  std::vector<double> coords(3*NUM_VTX);
+  for (unsigned int i = 0; i < 3*NUM_VTX; i++)
+    coords[i] = 0.1 * i;
+  Range float_verts, double_verts;
+  rval = mb.create_vertices(&coords[0], NUM_VTX, float_verts);CHECK_ERR(rval);
+  EntityHandle single;
+  rval = mb.create_vertex(&coords[0], single);CHECK_ERR(rval);
+  float_verts.insert(single);
+
+  mb.set_float_coordinates(false);
+  rval = mb.create_vertices(&coords[0], NUM_VTX, double_verts);CHECK_ERR(rval);
+
+  // Values are rounded to float, in either access pattern
+  std::vector<double> xyz(3*float_verts.size()), x(float_verts.size());
+  rval = mb.get_coords(float_verts, &xyz[0]);CHECK_ERR(rval);
+  for (unsigned int i = 0; i < 3*NUM_VTX; i++)
+    CHECK_REAL_EQUAL((double)(float)coords[i], xyz[i], 0.0);
+  rval = mb.get_coords(float_verts, &x[0], NULL, NULL);CHECK_ERR(rval);
+  for (unsigned int i = 0; i < NUM_VTX; i++)
+    CHECK_REAL_EQUAL((double)(float)coords[3*i], x[i], 0.0);
+  rval = mb.get_coords(&single, 1, &xyz[0]);CHECK_ERR(rval);
+  CHECK_REAL_EQUAL((double)(float)coords[1], xyz[1], 0.0);
+
+  rval = mb.get_coords(double_verts, &xyz[0]);CHECK_ERR(rval);
+  for (unsigned int i = 0; i < 3*NUM_VTX; i++)
+    CHECK_REAL_EQUAL(coords[i], xyz[i], 0.0);
+
+  // Iterate with the native type only
+  double *dx, *dy, *dz;
+  float *fx, *fy, *fz;
+  int count;
+  rval = mb.coords_iterate(float_verts.begin(), float_verts.end(), dx, dy, dz, count);
+  CHECK_EQUAL(MB_TYPE_OUT_OF_RANGE, rval);
+  rval = mb.coords_iterate(double_verts.begin(), double_verts.end(), fx, fy, fz, count);
+  CHECK_EQUAL(MB_TYPE_OUT_OF_RANGE, rval);
+  const double *cx, *cy, *cz;
+  rval = moab.get_coords(single, cx, cy, cz);
+  CHECK_EQUAL(MB_TYPE_OUT_OF_RANGE, rval);
+
+  Range::iterator it = float_verts.begin();
+  while (it != float_verts.end()) {
+    rval = mb.coords_iterate(it, float_verts.end(), fx, fy, fz, count);CHECK_ERR(rval);
+    for (int j = 0; j < count; j++)
+      fz[j] = 1.5f;
+    it += count;
+  }
+  rval = mb.get_coords(float_verts, NULL, NULL, &x[0]);CHECK_ERR(rval);
+  for (unsigned int i = 0; i < NUM_VTX; i++)
+    CHECK_REAL_EQUAL(1.5, x[i], 0.0);
+
+  // Set, and split the float sequence by deleting vertices
+  double new_xyz[] = { 1.0, 2.0, 3.0 };
+  EntityHandle last = float_verts[NUM_VTX - 1];
+  rval = mb.set_coords(&last, 1, new_xyz);CHECK_ERR(rval);
+  Range dead;
+  for (size_t i = 0; i < float_verts.size(); i += 100)
+    dead.insert(float_verts[i]);
+  rval = mb.delete_entities(dead);CHECK_ERR(rval);
+  float_verts = subtract(float_verts, dead);
+  rval = mb.get_coords(&last, 1, &xyz[0]);CHECK_ERR(rval);
+  CHECK_REAL_EQUAL(1.0, xyz[0], 0.0);
+  CHECK_REAL_EQUAL(2.0, xyz[1], 0.0);
+  CHECK_REAL_EQUAL(3.0, xyz[2], 0.0);
+  rval = mb.coords_iterate(float_verts.begin(), float_verts.end(), fx, fy, fz, count);CHECK_ERR(rval);
+  CHECK_REAL_EQUAL((float)coords[3], fx[0], 0.0f);
+
+  // Mixed ranges convert per sequence
+  Range all = unite(float_verts, double_verts);
+  xyz.resize(3*all.size());
+  rval = mb.get_coords(all, &xyz[0]);CHECK_ERR(rval);
+  CHECK_REAL_EQUAL(coords[3*NUM_VTX - 1], xyz.back(), 0.0);
+}
@@ -0,0 +1,176 @@
+#include "moab/Core.hpp"
+#include "moab/GeometricPartitioner.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <math.h>
+
+using namespace moab;
+
+const int INTERVALS = 8;
+
+void build_hex_mesh(Interface &mb, Range &hexes)
+{
+  const int N = INTERVALS;
+  ErrorCode rval;
+  std::vector<EntityHandle> verts((N+1)*(N+1)*(N+1));
+  for (int k = 0; k <= N; k++)
+    for (int j = 0; j <= N; j++)
+      for (int i = 0; i <= N; i++) {
+        double coords[] = {(double)i, (double)j, (double)k};
+        rval = mb.create_vertex(coords, verts[i+(N+1)*(j+(N+1)*k)]);CHECK_ERR(rval);
+      }
+
+  for (int k = 0; k < N; k++)
+    for (int j = 0; j < N; j++)
+      for (int i = 0; i < N; i++) {
+        EntityHandle conn[8], hex;
+        for (int c = 0; c < 8; c++) {
+          int ii = i + (((c+1)/2)%2), jj = j + (c/2)%2, kk = k + c/4;
+          conn[c] = verts[ii+(N+1)*(jj+(N+1)*kk)];
+        }
+        rval = mb.create_element(MBHEX, conn, 8, hex);CHECK_ERR(rval);
+        hexes.insert(hex);
+      }
+}
+
+  // every element is in exactly one part set, and the tag matches the set
+void check_partition(Interface &mb, GeometricPartitioner &tool, const Range &hexes, int nparts)
+{
+  ErrorCode rval;
+  Tag part_tag;
+  rval = mb.tag_get_handle("PARALLEL_PARTITION", 1, MB_TYPE_INTEGER, part_tag);CHECK_ERR(rval);
+
+  const Range &sets = tool.part_sets();
+  CHECK_EQUAL((size_t)nparts, sets.size());
+
+  Range all;
+  size_t total = 0;
+  for (Range::const_iterator sit = sets.begin(); sit != sets.end(); ++sit) {
+    int part;
+    rval = mb.tag_get_data(part_tag, &*sit, 1, &part);CHECK_ERR(rval);
+
+    Range ents;
+    rval = mb.get_entities_by_handle(*sit, ents);CHECK_ERR(rval);
+    total += ents.size();
+    all.merge(ents);
+
+      // parts are balanced to within rounding of the bisection
+    double ideal = (double)hexes.size()/nparts;
+    CHECK(fabs(ents.size() - ideal) <= 2.0);
+
+    std::vector<int> tagged(ents.size());
+    rval = mb.tag_get_data(part_tag, ents, &tagged[0]);CHECK_ERR(rval);
+    CHECK_EQUAL((long)ents.size(), (long)std::count(tagged.begin(), tagged.end(), part));
+  }
+  CHECK_EQUAL(hexes.size(), total);
+  CHECK_EQUAL(hexes.size(), all.size());
+}
+
+  // on a cube split in 8, every method must return the octants
+void check_octants(Interface &mb, GeometricPartitioner &tool)
+{
+  ErrorCode rval;
+  const Range &sets = tool.part_sets();
+  for (Range::const_iterator sit = sets.begin(); sit != sets.end(); ++sit) {
+    Range ents, verts;
+    rval = mb.get_entities_by_handle(*sit, ents);CHECK_ERR(rval);
+    CHECK_EQUAL((size_t)(INTERVALS*INTERVALS*INTERVALS/8), ents.size());
+    rval = mb.get_connectivity(ents, verts);CHECK_ERR(rval);
+
+    std::vector<double> coords(3*verts.size());
+    rval = mb.get_coords(verts, &coords[0]);CHECK_ERR(rval);
+    for (int d = 0; d < 3; d++) {
+      double lo = coords[d], hi = coords[d];
+      for (size_t i = 0; i < verts.size(); i++) {
+        lo = std::min(lo, coords[3*i+d]);
+        hi = std::max(hi, coords[3*i+d]);
+      }
+      CHECK_REAL_EQUAL(INTERVALS/2.0, hi-lo, 1e-12);
+    }
+  }
+}
+
+void test_method(const char *method)
+{
+  Core moab;
+  Interface &mb = moab;
+  Range hexes;
+  build_hex_mesh(mb, hexes);
+
+  GeometricPartitioner tool(&mb);
+  ErrorCode rval = tool.partition_mesh(8, method, 3, true, true);CHECK_ERR(rval);
+  check_partition(mb, tool, hexes, 8);
+  check_octants(mb, tool);
+
+    // repartitioning reuses and trims the existing part sets
+  rval = tool.partition_mesh(7, method, 3, true, true);CHECK_ERR(rval);
+  check_partition(mb, tool, hexes, 7);
+}
+
+void test_rcb() { test_method("RCB"); }
+void test_hilbert() { test_method("HILBERT"); }
+void test_morton() { test_method("MORTON"); }
+
+  // with the closure, every part also holds the vertices of its elements
+void test_include_closure()
+{
+  Core moab;
+  Interface &mb = moab;
+  Range hexes;
+  build_hex_mesh(mb, hexes);
+
+  GeometricPartitioner tool(&mb);
+  ErrorCode rval = tool.partition_mesh(8, "RCB", 3);CHECK_ERR(rval);
+  rval = tool.include_closure();CHECK_ERR(rval);
+
+  Tag closure_tag;
+  rval = mb.tag_get_handle("INCLUDES_CLOSURE", 1, MB_TYPE_INTEGER, closure_tag);CHECK_ERR(rval);
+
+  const Range &sets = tool.part_sets();
+  for (Range::const_iterator sit = sets.begin(); sit != sets.end(); ++sit) {
+    int closure;
+    rval = mb.tag_get_data(closure_tag, &*sit, 1, &closure);CHECK_ERR(rval);
+    CHECK_EQUAL(1, closure);
+
+    Range ents, verts;
+    rval = mb.get_entities_by_type(*sit, MBHEX, ents);CHECK_ERR(rval);
+    CHECK_EQUAL((size_t)(INTERVALS*INTERVALS*INTERVALS/8), ents.size());
+    rval = mb.get_connectivity(ents, verts);CHECK_ERR(rval);
+    Range set_verts;
+    rval = mb.get_entities_by_type(*sit, MBVERTEX, set_verts);CHECK_ERR(rval);
+    CHECK_EQUAL(verts, set_verts);
+  }
+}
+
+void test_bad_method()
+{
+  Core moab;
+  Range hexes;
+  build_hex_mesh(moab, hexes);
+
+  GeometricPartitioner tool(&moab);
+  ErrorCode rval = tool.partition_mesh(4, "PHG", 3);
+  CHECK(MB_SUCCESS != rval);
+}
+
+int main(int argc, char* argv[])
+{
+#ifdef MOAB_HAVE_MPI
+  MPI_Init(&argc, &argv);
+#else
+  (void)argc; (void)argv;
+#endif
+
+  int result = 0;
+  result += RUN_TEST(test_rcb);
+  result += RUN_TEST(test_hilbert);
+  result += RUN_TEST(test_morton);
+  result += RUN_TEST(test_include_closure);
+  result += RUN_TEST(test_bad_method);
+
+#ifdef MOAB_HAVE_MPI
+  MPI_Finalize();
+#endif
+  return result;
+}
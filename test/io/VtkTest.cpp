@@ -13,6 +13,10 @@ using namespace moab;
 #include <sstream>
 
 #include "TestUtil.hpp"
+#include "moab/MOABConfig.h"
+#ifdef MOAB_HAVE_ZLIB
+#include <zlib.h>
+#endif
 
 std::string poly_example = TestDir + "/io/poly8-10.vtk";
 std::string polyhedra_example = TestDir + "/io/polyhedra.vtk";
@@ -126,6 +130,12 @@ DECLARE_TEST(write_free_nodes)
 
 DECLARE_TEST(unstructured_field)
 
+DECLARE_TEST(binary_unstructured)
+DECLARE_TEST(write_vtu)
+#ifdef MOAB_HAVE_ZLIB
+DECLARE_TEST(write_vtu_compressed)
+#endif
+
 int main( int argc, char* argv[] )
 {
   int *test_indices = (int*)malloc(sizeof(int) * num_tests);
@@ -1656,3 +1666,198 @@ bool test_unstructured_field()
 
   return true;
 }
+
+// Append values to a binary legacy VTK file in big-endian byte order
+template <typename T>
+void append_big_endian( std::string& file, const T* values, size_t count )
+{
+  const unsigned one = 1;
+  const bool little = 0 != *(const char*)&one;
+  for (size_t i = 0; i < count; ++i) {
+    const char* bytes = reinterpret_cast<const char*>(values + i);
+    for (size_t b = 0; b < sizeof(T); ++b)
+      file += bytes[little ? sizeof(T) - 1 - b : b];
+  }
+}
+
+bool test_binary_unstructured()
+{
+  std::string file( "# vtk DataFile Version 3.0\n"
+                    "MOAB Version 1.00\n"
+                    "BINARY\n"
+                    "DATASET UNSTRUCTURED_GRID\n"
+                    "POINTS 6 float\n" );
+  float coords[18];
+  std::copy( two_quad_mesh_coords, two_quad_mesh_coords + 18, coords );
+  append_big_endian( file, coords, 18 );
+
+  file += "\nCELLS 2 10\n";
+  const int cells[] = { 4, 0, 1, 4, 3, 4, 1, 2, 5, 4 };
+  append_big_endian( file, cells, 10 );
+  file += "\nCELL_TYPES 2\n";
+  const int types[] = { 9, 9 };
+  append_big_endian( file, types, 2 );
+
+  file += "\nPOINT_DATA 6\nSCALARS data int 1\nLOOKUP_TABLE default\n";
+  append_big_endian( file, vertex_values, 6 );
+    // six bits packed most significant first: 1 0 1 1 0 1
+  file += "\nSCALARS bits bit 1\nLOOKUP_TABLE default\n";
+  file += (char)0xB4;
+  file += "\nCELL_DATA 2\nSCALARS data short\nLOOKUP_TABLE default\n";
+  const short elem_values[] = { (short)element_values[0], (short)element_values[1] };
+  append_big_endian( file, elem_values, 2 );
+  file += "\nVECTORS vec double\n";
+  double vecs[6];
+  std::copy( element_values, element_values + 6, vecs );
+  append_big_endian( file, vecs, 6 );
+  file += "\n";
+
+  const char fname[] = "tmp_file.vtk";
+  FILE* fptr = fopen( fname, "wb" );
+  fwrite( file.data(), 1, file.size(), fptr );
+  fclose( fptr );
+
+  Core instance;
+  ErrorCode rval = instance.load_mesh( fname );
+  remove( fname );
+  CHECK(rval);
+
+  bool bval = check_tag_values( &instance, MB_TYPE_INTEGER, 1 ); CHECK(bval);
+
+  EntityHandle vert_handles[6], elem_handles[2];
+  bval = match_vertices_and_elements( &instance, MBQUAD, 6, 2, 4,
+                                      two_quad_mesh_coords, two_quad_mesh_conn,
+                                      vert_handles, elem_handles ); CHECK(bval);
+
+  Tag tag;
+  rval = instance.tag_get_handle( "bits", 1, MB_TYPE_BIT, tag ); CHECK(rval);
+  const unsigned char expected_bits[] = { 1, 0, 1, 1, 0, 1 };
+  for (int i = 0; i < 6; ++i) {
+    unsigned char bits;
+    rval = instance.tag_get_data( tag, vert_handles + i, 1, &bits ); CHECK(rval);
+    CHECK( expected_bits[i] == bits );
+  }
+
+  rval = instance.tag_get_handle( "vec", 3, MB_TYPE_DOUBLE, tag ); CHECK(rval);
+  double vec_data[6];
+  rval = instance.tag_get_data( tag, elem_handles, 2, vec_data ); CHECK(rval);
+  for (int i = 0; i < 6; ++i)
+    CHECK( vec_data[i] == vecs[i] );
+
+  return true;
+}
+
+// Get the data of a named array in the appended section of a .vtu file
+bool read_vtu_array( const std::string& file, const char* name,
+                     bool compressed, std::vector<unsigned char>& data )
+{
+  std::string key = name ? std::string("Name=\"") + name + "\"" : std::string("<Points>");
+  size_t pos = file.find( key );
+  CHECK( pos != std::string::npos );
+  pos = file.find( "offset=\"", pos );
+  CHECK( pos != std::string::npos );
+  unsigned long offset = strtoul( file.c_str() + pos + 8, 0, 10 );
+
+  pos = file.find( "<AppendedData encoding=\"raw\">" );
+  CHECK( pos != std::string::npos );
+  pos = file.find( '_', pos ) + 1 + offset;
+
+  uint64_t header[3];
+  memcpy( header, file.data() + pos, sizeof(header) );
+  if (!compressed) {
+    data.assign( file.begin() + pos + 8, file.begin() + pos + 8 + header[0] );
+    return true;
+  }
+
+#ifdef MOAB_HAVE_ZLIB
+  const uint64_t num_blocks = header[0], block_size = header[1], last = header[2];
+  std::vector<uint64_t> sizes( num_blocks + 1 );
+  if (num_blocks)
+    memcpy( &sizes[0], file.data() + pos + 24, num_blocks * sizeof(uint64_t) );
+  pos += 8 * (3 + num_blocks);
+  data.clear();
+  for (uint64_t b = 0; b < num_blocks; ++b) {
+    uLongf len = (b + 1 == num_blocks && last) ? last : block_size;
+    std::vector<unsigned char> block( len );
+    CHECK( Z_OK == uncompress( &block[0], &len, (const Bytef*)file.data() + pos, sizes[b] ) );
+    data.insert( data.end(), block.begin(), block.begin() + len );
+    pos += sizes[b];
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool check_vtu( const char* options, bool compressed )
+{
+  Core instance;
+  bool bval = read_file( &instance, two_quad_mesh ); CHECK(bval);
+
+  Tag tag;
+  ErrorCode rval = instance.tag_get_handle( "data", 1, MB_TYPE_INTEGER, tag,
+                                            MB_TAG_SPARSE | MB_TAG_CREAT ); CHECK(rval);
+  EntityHandle vert_handles[6], elem_handles[2];
+  bval = match_vertices_and_elements( &instance, MBQUAD, 6, 2, 4,
+                                      two_quad_mesh_coords, two_quad_mesh_conn,
+                                      vert_handles, elem_handles ); CHECK(bval);
+  rval = instance.tag_set_data( tag, vert_handles, 6, vertex_values ); CHECK(rval);
+
+  const char fname[] = "tmp_file.vtu";
+  rval = instance.write_file( fname, 0, options );
+  CHECK(rval);
+
+  std::string file;
+  FILE* fptr = fopen( fname, "rb" );
+  CHECK( NULL != fptr );
+  char buffer[4096];
+  size_t len;
+  while ((len = fread( buffer, 1, sizeof(buffer), fptr )))
+    file.append( buffer, len );
+  fclose( fptr );
+  remove( fname );
+
+  CHECK( file.find( "NumberOfPoints=\"6\" NumberOfCells=\"2\"" ) != std::string::npos );
+  CHECK( compressed == (file.find( "vtkZLibDataCompressor" ) != std::string::npos) );
+
+  std::vector<unsigned char> data;
+  bval = read_vtu_array( file, 0, compressed, data ); CHECK(bval);
+  CHECK( data.size() == 18 * sizeof(double) );
+  const double* coords = reinterpret_cast<const double*>(&data[0]);
+  for (int i = 0; i < 18; ++i)
+    CHECK( coords[i] == two_quad_mesh_coords[i] );
+
+  bval = read_vtu_array( file, "connectivity", compressed, data ); CHECK(bval);
+  CHECK( data.size() == 8 * sizeof(int64_t) );
+  const int64_t* conn = reinterpret_cast<const int64_t*>(&data[0]);
+  for (int i = 0; i < 8; ++i)
+    CHECK( conn[i] == two_quad_mesh_conn[i] );
+
+  bval = read_vtu_array( file, "offsets", compressed, data ); CHECK(bval);
+  CHECK( data.size() == 2 * sizeof(int64_t) );
+  const int64_t* offsets = reinterpret_cast<const int64_t*>(&data[0]);
+  CHECK( offsets[0] == 4 && offsets[1] == 8 );
+
+  bval = read_vtu_array( file, "types", compressed, data ); CHECK(bval);
+  CHECK( data.size() == 2 && data[0] == 9 && data[1] == 9 );
+
+  bval = read_vtu_array( file, "data", compressed, data ); CHECK(bval);
+  CHECK( data.size() == 6 * sizeof(int) );
+  const int* values = reinterpret_cast<const int*>(&data[0]);
+  for (int i = 0; i < 6; ++i)
+    CHECK( values[i] == vertex_values[i] );
+
+  return true;
+}
+
+bool test_write_vtu()
+{
+  return check_vtu( "", false );
+}
+
+#ifdef MOAB_HAVE_ZLIB
+bool test_write_vtu_compressed()
+{
+  return check_vtu( "COMPRESS", true );
+}
+#endif
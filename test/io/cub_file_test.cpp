@@ -5,6 +5,8 @@
 #include "moab/Range.hpp"
 #include "moab/GeomTopoTool.hpp"
 #include <math.h>
+#include <time.h>
+#include <stdlib.h>
 #include <algorithm>
 
 using namespace moab;
@@ -141,10 +143,24 @@ void test_multiple_files();
 void test_cubit12();
 void test_cubit14();
 
-int main()
+// Read many copies of a file into one instance, so that id lookups and set
+// population run against a large mesh; the time of each read is only
+// reported when run as a benchmark
+void test_read_many_copies();
+int num_copies = 4;
+bool print_times = false;
+
+int main( int argc, char* argv[] )
 {
   int result = 0;
 
+  // With a number of copies as argument, only run the benchmark
+  if (argc > 1) {
+    num_copies = atoi(argv[1]);
+    print_times = true;
+    return RUN_TEST(test_read_many_copies);
+  }
+
   result += RUN_TEST(test_vertices);
   result += RUN_TEST(test_edges);
   result += RUN_TEST(test_quads);
@@ -168,6 +184,7 @@ int main()
   result += RUN_TEST(test_multiple_files);
   result += RUN_TEST(test_cubit12);
   result += RUN_TEST(test_cubit14);
+  result += RUN_TEST(test_read_many_copies);
   return result;
 }
 
@@ -1093,3 +1110,36 @@ void test_cubit14()
   rval = mb.tag_get_data(gid_tag, &set0, 1, &val );
   CHECK ( val!=0 );
 }
+
+void test_read_many_copies()
+{
+  Core mb_impl;
+  Interface& mb = mb_impl;
+  ErrorCode rval;
+
+  const EntityType types[] = { MBVERTEX, MBEDGE, MBTRI, MBQUAD, MBTET, MBHEX, MBENTITYSET };
+  const int num_types = sizeof(types)/sizeof(types[0]);
+  int first_counts[num_types], counts[num_types];
+
+  double total = 0;
+  for (int i = 0; i < num_copies; ++i) {
+    clock_t start = clock();
+    read_file( mb, input_file_1 );
+    double secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+    total += secs;
+    if (print_times)
+      std::cout << "  copy " << i + 1 << " of " << num_copies << ": " << secs << " s" << std::endl;
+
+    // Each copy adds the same entities
+    for (int t = 0; t < num_types; ++t) {
+      rval = mb.get_number_entities_by_type( 0, types[t], counts[t] );CHECK_ERR(rval);
+      if (0 == i)
+        first_counts[t] = counts[t];
+      else
+        CHECK_EQUAL( (i+1)*first_counts[t], counts[t] );
+    }
+  }
+  if (print_times)
+    std::cout << "  total: " << total << " s for " << counts[0] << " vertices and "
+              << counts[5] + counts[4] << " 3D elements" << std::endl;
+}
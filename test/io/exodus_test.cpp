@@ -98,6 +98,7 @@ void test_read_polygons();
 void test_read_polyhedra();
 
 void test_read_alternate_coord_format();
+void test_read_shared_sides();
 
 int main()
 {
@@ -135,6 +136,7 @@ int main()
   result += RUN_TEST(test_read_nodeset_ids);
 
   result += RUN_TEST(test_read_alternate_coord_format);
+  result += RUN_TEST(test_read_shared_sides);
 
   result += RUN_TEST(test_write_polygons);
   result += RUN_TEST(test_write_polyhedra);
@@ -1094,3 +1096,112 @@ void test_read_polyhedra()
   ErrorCode rval = mb.load_file( rpolyh );
   CHECK_ERR(rval);
 }
+
+// Write a 2x2x1 hex mesh with three sidesets sharing faces, read it back
+// and check that every face is created once and shared by the sidesets
+void test_read_shared_sides()
+{
+  Core moab;
+  Interface& mb = moab;
+  ErrorCode rval;
+
+  // Vertices of a 3x3x2 grid, hexes in a block
+  EntityHandle verts[18];
+  for (int k = 0; k < 2; ++k)
+    for (int j = 0; j < 3; ++j)
+      for (int i = 0; i < 3; ++i) {
+        const double coords[] = { (double)i, (double)j, (double)k };
+        rval = mb.create_vertex( coords, verts[i + 3*j + 9*k] );
+        CHECK_ERR(rval);
+      }
+  Range hexes;
+  for (int j = 0; j < 2; ++j)
+    for (int i = 0; i < 2; ++i) {
+      const int b = i + 3*j;
+      const EntityHandle conn[] = { verts[b], verts[b+1], verts[b+4], verts[b+3],
+                                    verts[b+9], verts[b+10], verts[b+13], verts[b+12] };
+      EntityHandle hex;
+      rval = mb.create_element( MBHEX, conn, 8, hex );
+      CHECK_ERR(rval);
+      hexes.insert( hex );
+    }
+
+  // Top faces, and the faces on x = 0
+  std::vector<EntityHandle> top, side;
+  for (int j = 0; j < 2; ++j) {
+    for (int i = 0; i < 2; ++i) {
+      const int b = 9 + i + 3*j;
+      const EntityHandle conn[] = { verts[b], verts[b+1], verts[b+4], verts[b+3] };
+      EntityHandle quad;
+      rval = mb.create_element( MBQUAD, conn, 4, quad );
+      CHECK_ERR(rval);
+      top.push_back( quad );
+    }
+    const int b = 3*j;
+    const EntityHandle conn[] = { verts[b], verts[b+9], verts[b+12], verts[b+3] };
+    EntityHandle quad;
+    rval = mb.create_element( MBQUAD, conn, 4, quad );
+    CHECK_ERR(rval);
+    side.push_back( quad );
+  }
+
+  Tag mat_tag, ss_tag;
+  rval = mb.tag_get_handle( MATERIAL_SET_TAG_NAME, 1, MB_TYPE_INTEGER, mat_tag );
+  CHECK_ERR(rval);
+  rval = mb.tag_get_handle( NEUMANN_SET_TAG_NAME, 1, MB_TYPE_INTEGER, ss_tag );
+  CHECK_ERR(rval);
+  EntityHandle block, ss[3];
+  const int block_id = 1, ss_ids[] = { 1, 2, 3 };
+  rval = mb.create_meshset( MESHSET_SET, block );
+  CHECK_ERR(rval);
+  rval = mb.add_entities( block, hexes );
+  CHECK_ERR(rval);
+  rval = mb.tag_set_data( mat_tag, &block, 1, &block_id );
+  CHECK_ERR(rval);
+  for (int i = 0; i < 3; ++i) {
+    rval = mb.create_meshset( MESHSET_SET, ss[i] );
+    CHECK_ERR(rval);
+    rval = mb.tag_set_data( ss_tag, ss + i, 1, ss_ids + i );
+    CHECK_ERR(rval);
+  }
+  // Sideset 1: top faces; 2: faces on x = 0 and the top faces next to
+  // them; 3: all of them
+  rval = mb.add_entities( ss[0], &top[0], top.size() );
+  CHECK_ERR(rval);
+  rval = mb.add_entities( ss[1], &side[0], side.size() );
+  CHECK_ERR(rval);
+  const EntityHandle top_side[] = { top[0], top[2] };
+  rval = mb.add_entities( ss[1], top_side, 2 );
+  CHECK_ERR(rval);
+  rval = mb.add_entities( ss[2], &top[0], top.size() );
+  CHECK_ERR(rval);
+  rval = mb.add_entities( ss[2], &side[0], side.size() );
+  CHECK_ERR(rval);
+
+  const char filename[] = "shared_sides.exo";
+  rval = mb.write_file( filename );
+  CHECK_ERR(rval);
+
+  Core moab2;
+  Interface& mb2 = moab2;
+  rval = mb2.load_file( filename );
+  remove( filename );
+  CHECK_ERR(rval);
+
+  Range quads;
+  rval = mb2.get_entities_by_type( 0, MBQUAD, quads );
+  CHECK_ERR(rval);
+  CHECK_EQUAL( (size_t)6, quads.size() );
+
+  Range sides[3];
+  const size_t expected[] = { 4, 4, 6 };
+  for (int i = 0; i < 3; ++i) {
+    EntityHandle set = find_sideset( mb2, ss_ids[i], MBQUAD );
+    rval = mb2.get_entities_by_type( set, MBQUAD, sides[i] );
+    CHECK_ERR(rval);
+    CHECK_EQUAL( expected[i], sides[i].size() );
+  }
+  CHECK( quads == sides[2] );
+  CHECK_EQUAL( (size_t)2, intersect( sides[0], sides[1] ).size() );
+  CHECK( sides[0] == intersect( sides[0], sides[2] ) );
+}
@@ -157,6 +157,26 @@ void test_read_eul_onevar()
     CHECK_REAL_EQUAL(232.6670, val[5 * levels], eps); // 2304th global quad
     CHECK_REAL_EQUAL(234.6922, val[6 * levels], eps); // 2353th global quad
     CHECK_REAL_EQUAL(200.6828, val[7 * levels], eps); // Last global quad
+
+    // Check the upper levels too, transposed from the (lev, lat, lon) layout of the file
+    CHECK_REAL_EQUAL(243.8996, val[0 * levels + 1], eps); // First global quad
+    CHECK_REAL_EQUAL(239.7601, val[0 * levels + 2], eps);
+    CHECK_REAL_EQUAL(229.4436, val[1 * levels + 1], eps); // 2256th global quad
+    CHECK_REAL_EQUAL(226.3047, val[1 * levels + 2], eps);
+    CHECK_REAL_EQUAL(196.9892, val[7 * levels + 1], eps); // Last global quad
+    CHECK_REAL_EQUAL(194.4979, val[7 * levels + 2], eps);
+
+    // And the second timestep
+    rval = mb.tag_get_data(Ttag1, &gloabl_quad_ents[0], 8, val);
+    CHECK_REAL_EQUAL(241.7353, val[0 * levels], eps); // First global quad
+    CHECK_REAL_EQUAL(234.2631, val[0 * levels + 1], eps);
+    CHECK_REAL_EQUAL(230.7376, val[0 * levels + 2], eps);
+    CHECK_REAL_EQUAL(235.1443, val[1 * levels], eps); // 2256th global quad
+    CHECK_REAL_EQUAL(230.0676, val[1 * levels + 1], eps);
+    CHECK_REAL_EQUAL(227.2019, val[1 * levels + 2], eps);
+    CHECK_REAL_EQUAL(198.2482, val[7 * levels], eps); // Last global quad
+    CHECK_REAL_EQUAL(193.6392, val[7 * levels + 1], eps);
+    CHECK_REAL_EQUAL(189.7952, val[7 * levels + 2], eps);
   }
   else if (2 == procs) {
     Range local_quads;
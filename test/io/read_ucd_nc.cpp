@@ -127,6 +127,14 @@ void test_read_onevar()
     CHECK_REAL_EQUAL(236.1505, data[1728 * levels], eps); // Median vert
     CHECK_REAL_EQUAL(235.7722, data[1729 * levels], eps); // Median vert
     CHECK_REAL_EQUAL(234.0416, data[3457 * levels], eps); // Last vert
+
+    // Check the upper levels too, transposed from the (lev, ncol) layout of the file
+    CHECK_REAL_EQUAL(227.3698, data[0 * levels + 1], eps); // First vert
+    CHECK_REAL_EQUAL(224.5246, data[0 * levels + 2], eps);
+    CHECK_REAL_EQUAL(230.2251, data[1728 * levels + 1], eps); // Median vert
+    CHECK_REAL_EQUAL(225.5801, data[1728 * levels + 2], eps);
+    CHECK_REAL_EQUAL(228.9458, data[3457 * levels + 1], eps); // Last vert
+    CHECK_REAL_EQUAL(225.3311, data[3457 * levels + 2], eps);
   }
 }
 
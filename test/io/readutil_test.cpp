@@ -1,5 +1,6 @@
 
 #include <iostream>
+#include <algorithm>
 #include "moab/Interface.hpp"
 #ifndef IS_BUILDING_MB
 #define IS_BUILDING_MB
@@ -54,6 +55,109 @@ ErrorCode gather_related_test()
   return MB_SUCCESS;
 }
 
+// check the elements adjacent to each vertex against the connectivity
+ErrorCode check_vertex_adjacencies(Interface& mb, const Range& verts)
+{
+  Range elems;
+  ErrorCode rval = mb.get_entities_by_dimension(0, 3, elems); CHKERR(rval);
+  for (Range::const_iterator v = verts.begin(); v != verts.end(); ++v) {
+    std::vector<EntityHandle> expected;
+    for (Range::const_iterator e = elems.begin(); e != elems.end(); ++e) {
+      const EntityHandle* conn;
+      int len;
+      rval = mb.get_connectivity(*e, conn, len); CHKERR(rval);
+      if (std::find(conn, conn + len, *v) != conn + len)
+        expected.push_back(*e);
+    }
+    std::vector<EntityHandle> adj;
+    rval = mb.get_adjacencies(&*v, 1, 3, false, adj); CHKERR(rval);
+    if (adj != expected) return MB_FAILURE;
+  }
+  return MB_SUCCESS;
+}
+
+ErrorCode update_adjacencies_test()
+{
+  Core mb;
+  ReadUtilIface* readMeshIface;
+  mb.Interface::query_interface(readMeshIface);
+
+    // a row of 2x2x(N+1) vertices, filled in two chunks
+  const int N = 10, num_verts = 4*(N+1);
+  std::vector<double> xyz(3*num_verts);
+  for (int i = 0; i < num_verts; ++i) {
+    xyz[3*i] = i%2;
+    xyz[3*i+1] = (i/2)%2;
+    xyz[3*i+2] = i/4;
+  }
+  EntityHandle first_vert;
+  std::vector<double*> arrays;
+  ErrorCode rval = readMeshIface->get_node_coords(3, num_verts, 1, first_vert, arrays); CHKERR(rval);
+  ReadUtilIface::set_node_coords(arrays, 0, num_verts/2, &xyz[0]);
+  ReadUtilIface::set_node_coords(arrays, num_verts/2, num_verts - num_verts/2,
+                                 &xyz[3*(num_verts/2)]);
+  Range verts(first_vert, first_vert + num_verts - 1);
+  std::vector<double> coords(3*num_verts);
+  rval = mb.get_coords(verts, &coords[0]); CHKERR(rval);
+  if (coords != xyz) return MB_FAILURE;
+
+    // enable vertex to element adjacencies, then create a hex and a tet
+    // the usual way
+  std::vector<EntityHandle> adj;
+  rval = mb.get_adjacencies(&first_vert, 1, 3, false, adj); CHKERR(rval);
+  EntityHandle conn[8], elem;
+  const int hex_order[] = {0, 1, 3, 2, 4, 5, 7, 6};
+  for (int j = 0; j < 8; ++j)
+    conn[hex_order[j]] = first_vert + j;
+  rval = mb.create_element(MBHEX, conn, 8, elem); CHKERR(rval);
+  rval = mb.create_element(MBTET, conn, 4, elem); CHKERR(rval);
+
+    // hexes after existing ones, from indices in lexicographic order,
+    // filled in chunks of different sizes
+  std::vector<int> ids(8*N);
+  for (int i = 0; i < N; ++i)
+    for (int j = 0; j < 8; ++j)
+      ids[8*i+j] = 4*i + j;
+  EntityHandle start, *hex_conn;
+  rval = readMeshIface->get_element_connect(N, 8, MBHEX, 1, start, hex_conn); CHKERR(rval);
+  ReadUtilIface::set_element_connect(hex_conn, 0, 3, 8, &ids[0], first_vert, hex_order);
+  ReadUtilIface::set_element_connect(hex_conn, 3, N-3, 8, &ids[24], first_vert, hex_order);
+  for (int j = 0; j < 8; ++j)
+    if (hex_conn[8 + hex_order[j]] != first_vert + 4 + j) return MB_FAILURE;
+  rval = readMeshIface->update_adjacencies(start, N, 8, hex_conn); CHKERR(rval);
+  rval = check_vertex_adjacencies(mb, verts); CHKERR(rval);
+
+    // tets have lower handles than the existing hexes, and some are
+    // degenerate, repeating a vertex
+  EntityHandle* tet_conn;
+  rval = readMeshIface->get_element_connect(N, 4, MBTET, 1, start, tet_conn); CHKERR(rval);
+  for (int i = 0; i < N; ++i) {
+    EntityHandle tet[] = {first_vert + 4*i, first_vert + 4*i + 1,
+                          first_vert + 4*i + 2, first_vert + 4*i + 4};
+    if (i%3 == 0)
+      tet[3] = tet[0];
+    ReadUtilIface::set_element_connect(tet_conn, i, 1, 4, tet, 0);
+  }
+  rval = readMeshIface->update_adjacencies(start, N, 4, tet_conn); CHKERR(rval);
+  rval = check_vertex_adjacencies(mb, verts); CHKERR(rval);
+
+    // vertices far apart in handle space
+  EntityHandle gap_vert, last_vert;
+  rval = readMeshIface->get_node_coords(3, 1000, 1, gap_vert, arrays); CHKERR(rval);
+  rval = readMeshIface->get_node_coords(3, 2, 1, last_vert, arrays); CHKERR(rval);
+  ReadUtilIface::set_node_coords(arrays, 0, 2, &xyz[0]);
+  EntityHandle* far_conn;
+  rval = readMeshIface->get_element_connect(2, 4, MBTET, 1, start, far_conn); CHKERR(rval);
+  EntityHandle far_tets[] = {first_vert, first_vert + 1, last_vert, last_vert + 1,
+                             first_vert + 2, first_vert + 3, last_vert, last_vert + 1};
+  ReadUtilIface::set_element_connect(far_conn, 0, 2, 4, far_tets, 0);
+  rval = readMeshIface->update_adjacencies(start, 2, 4, far_conn); CHKERR(rval);
+  verts.insert(last_vert, last_vert + 1);
+  rval = check_vertex_adjacencies(mb, verts); CHKERR(rval);
+
+  return MB_SUCCESS;
+}
+
 int number_tests = 0;
 int number_tests_failed = 0;
 #define RUN_TEST( A ) _run_test( (A), #A )
@@ -84,6 +188,7 @@ static void _run_test( TestFunc func, const char* func_str )
 int main(int /*argc*/, char** /*argv[]*/)
 {
   RUN_TEST( gather_related_test );
+  RUN_TEST( update_adjacencies_test );
 
   std::cout << "\nMB TEST SUMMARY: \n"
        << "   Number Tests:           " << number_tests << "\n"
@@ -2,6 +2,7 @@
 #include "moab/AdaptiveKDTree.hpp"
 #include "moab/Range.hpp"
 #include "moab/CartVect.hpp"
+#include "moab/FileOptions.hpp"
 
 #ifdef MOAB_HAVE_MPI
 #include "moab_mpi.h"
@@ -11,6 +12,9 @@
 #include <assert.h>
 #include <float.h>
 #include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
 
 #include "TestUtil.hpp"
 
@@ -29,6 +33,8 @@ void test_tree_readwrite();
 void test_tree_delete();
 void test_iterator_back();
 void test_point_search();
+void test_flat_point_search();
+void test_flat_vertex_search();
 
 int main(int argc, char **argv)
 {
@@ -50,6 +56,8 @@ int main(int argc, char **argv)
   err += RUN_TEST(test_tree_delete);
   err += RUN_TEST(test_iterator_back);
   err += RUN_TEST(test_point_search);
+  err += RUN_TEST(test_flat_point_search);
+  err += RUN_TEST(test_flat_vertex_search);
 
 #ifdef MOAB_HAVE_MPI
   fail = MPI_Finalize();
@@ -407,3 +415,139 @@ void test_point_search()
 
 
 
+
+void test_flat_point_search()
+{
+  Core mb;
+  AdaptiveKDTree tool(&mb);
+  create_tree( tool, DEPTH, INTERVALS );
+
+  ErrorCode rval;
+  CHECK(!tool.has_flat_tree());
+  rval = tool.build_flat_tree();
+  CHECK_ERR(rval);
+  CHECK(tool.has_flat_tree());
+
+    // points at the center of each unit cube, plus one outside the tree
+  std::vector<double> points;
+  for (unsigned k = 0; k < INTERVALS; k++)
+    for (unsigned j = 0; j < INTERVALS; j++)
+      for (unsigned i = 0; i < INTERVALS; i++) {
+        points.push_back(i + 0.5);
+        points.push_back(j + 0.5);
+        points.push_back(k + 0.5);
+      }
+  points.push_back(-1.0);
+  points.push_back(0.5);
+  points.push_back(0.5);
+  const unsigned num_points = points.size()/3;
+
+  std::vector<EntityHandle> leaves;
+  rval = tool.point_search(&points[0], num_points, leaves);
+  CHECK_ERR(rval);
+  CHECK_EQUAL( (size_t)num_points, leaves.size() );
+  CHECK_EQUAL( (EntityHandle)0, leaves.back() );
+
+    // same leaves as the search through the tree sets
+  AdaptiveKDTreeIter iter;
+  for (unsigned i = 0; i + 1 < num_points; i++) {
+    rval = tool.point_search(&points[3*i], iter);
+    CHECK_ERR(rval);
+    CHECK_EQUAL( iter.handle(), leaves[i] );
+    EntityHandle leaf;
+    rval = tool.point_search(&points[3*i], leaf);
+    CHECK_ERR(rval);
+    CHECK_EQUAL( iter.handle(), leaf );
+  }
+
+  rval = tool.reset_tree();
+  CHECK_ERR(rval);
+  CHECK(!tool.has_flat_tree());
+}
+
+void test_flat_vertex_search()
+{
+  Core mb;
+  ErrorCode rval;
+
+    // random vertices, plus a few on a regular grid so that some of them
+    // fall on the split planes
+  srand(42);
+  Range verts;
+  for (int i = 0; i < 1000; i++) {
+    double coords[3] = { (double)rand()/RAND_MAX, (double)rand()/RAND_MAX, (double)rand()/RAND_MAX };
+    if (i < 125) {
+      coords[0] = 0.25*(i%5);
+      coords[1] = 0.25*((i/5)%5);
+      coords[2] = 0.25*(i/25);
+    }
+    EntityHandle v;
+    rval = mb.create_vertex(coords, v);
+    CHECK_ERR(rval);
+    verts.insert(v);
+  }
+  std::vector<double> vert_coords(3*verts.size());
+  rval = mb.get_coords(verts, &vert_coords[0]);
+  CHECK_ERR(rval);
+
+  AdaptiveKDTree tool(&mb);
+  FileOptions opts("MAX_PER_LEAF=8;PLANE_SET=0;FLAT_TREE=true");
+  EntityHandle root;
+  rval = tool.build_tree(verts, &root, &opts);
+  CHECK_ERR(rval);
+  CHECK(tool.has_flat_tree());
+
+  std::vector<double> points;
+  for (int i = 0; i < 50; i++)
+    for (int j = 0; j < 3; j++)
+      points.push_back(1.4*rand()/RAND_MAX - 0.2);
+  const unsigned num_points = points.size()/3;
+
+  const unsigned k = 5;
+  const double radius = 0.15;
+  std::vector<EntityHandle> nearest, in_radius;
+  std::vector<double> nearest_dists, radius_dists;
+  std::vector<unsigned> offsets;
+  rval = tool.nearest_vertices(&points[0], num_points, k, nearest, &nearest_dists);
+  CHECK_ERR(rval);
+  CHECK_EQUAL( (size_t)num_points*k, nearest.size() );
+  rval = tool.vertices_in_radius(&points[0], num_points, radius, in_radius, offsets, &radius_dists);
+  CHECK_ERR(rval);
+  CHECK_EQUAL( (size_t)num_points+1, offsets.size() );
+  CHECK_EQUAL( (size_t)offsets.back(), in_radius.size() );
+
+    // compare with brute force
+  for (unsigned p = 0; p < num_points; p++) {
+    const CartVect point(&points[3*p]);
+    std::vector<std::pair<double,EntityHandle> > all;
+    for (size_t i = 0; i < verts.size(); i++)
+      all.push_back(std::make_pair((CartVect(&vert_coords[3*i]) - point).length(), verts[i]));
+    std::sort(all.begin(), all.end());
+
+    for (unsigned j = 0; j < k; j++) {
+      CHECK_REAL_EQUAL( all[j].first, nearest_dists[p*k+j], 1e-12 );
+      CHECK_REAL_EQUAL( all[j].first, (CartVect(&vert_coords[3*(verts.index(nearest[p*k+j]))]) - point).length(), 1e-12 );
+    }
+
+    size_t count = 0;
+    while (count < all.size() && all[count].first <= radius)
+      count++;
+    CHECK_EQUAL( count, (size_t)(offsets[p+1] - offsets[p]) );
+    std::vector<EntityHandle> expected, found(in_radius.begin() + offsets[p], in_radius.begin() + offsets[p+1]);
+    for (size_t j = 0; j < count; j++) {
+      expected.push_back(all[j].second);
+      CHECK_REAL_EQUAL( all[j].first, radius_dists[offsets[p]+j], 1e-12 );
+    }
+    std::sort(expected.begin(), expected.end());
+    std::sort(found.begin(), found.end());
+    CHECK( expected == found );
+  }
+
+    // more neighbours than vertices in the tree
+  rval = tool.nearest_vertices(&points[0], 1, verts.size() + 2, nearest, &nearest_dists);
+  CHECK_ERR(rval);
+  CHECK_EQUAL( (EntityHandle)0, nearest.back() );
+  CHECK( HUGE_VAL == nearest_dists.back() );
+  std::sort(nearest.begin(), nearest.end() - 2);
+  CHECK( std::unique(nearest.begin(), nearest.end() - 2) == nearest.end() - 2 );
+}
@@ -0,0 +1,55 @@
+#ifndef PREFETCH_TIMESTEPS_TEST_HPP
+#define PREFETCH_TIMESTEPS_TEST_HPP
+
+// Shared by the parallel NetCDF read tests; include after TestUtil.hpp and using namespace moab
+
+#include "moab/Core.hpp"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Read timesteps 0 and 1 of a variable with and without PREFETCH_TIMESTEPS, and check that the
+// values on entities of the given type are identical; read_opts selects the parallel read and
+// the partition method
+static void check_prefetched_timesteps(const std::string& filename, const std::string& read_opts,
+                                       const char* var_name, EntityType type)
+{
+  Core moab_plain, moab_prefetch;
+  Interface* mbs[] = {&moab_plain, &moab_prefetch};
+  std::string opts = read_opts + ";VARIABLE=" + std::string(var_name) + ";TIMESTEP=0,1";
+  ErrorCode rval = mbs[0]->load_file(filename.c_str(), NULL, opts.c_str());
+  CHECK_ERR(rval);
+  opts += ";PREFETCH_TIMESTEPS";
+  rval = mbs[1]->load_file(filename.c_str(), NULL, opts.c_str());
+  CHECK_ERR(rval);
+
+  Range ents[2];
+  for (int i = 0; i < 2; i++) {
+    rval = mbs[i]->get_entities_by_type(0, type, ents[i]);
+    CHECK_ERR(rval);
+  }
+  CHECK_EQUAL(ents[0].size(), ents[1].size());
+
+  for (int t = 0; t < 2; t++) {
+    std::ostringstream tag_name;
+    tag_name << var_name << t;
+    std::vector<double> vals[2];
+    for (int i = 0; i < 2; i++) {
+      Tag tag;
+      rval = mbs[i]->tag_get_handle(tag_name.str().c_str(), tag);
+      CHECK_ERR(rval);
+      int len;
+      rval = mbs[i]->tag_get_length(tag, len);
+      CHECK_ERR(rval);
+      vals[i].resize(len * ents[i].size());
+      rval = mbs[i]->tag_get_data(tag, ents[i], &vals[i][0]);
+      CHECK_ERR(rval);
+    }
+    CHECK_EQUAL(vals[0].size(), vals[1].size());
+    for (size_t j = 0; j < vals[0].size(); j++)
+      CHECK_REAL_EQUAL(vals[0][j], vals[1][j], 0.0);
+  }
+}
+
+#endif
@@ -10,6 +10,8 @@
 
 using namespace moab;
 
+#include "PrefetchTimestepsTest.hpp"
+
 std::string example = TestDir + "/io/gcrm_r3.nc";
 
 void test_read_onevar_trivial();
@@ -27,6 +29,8 @@ void test_gather_onevar_on_rank1();
 
 void test_multiple_loads_of_same_file();
 
+void test_read_prefetched_timesteps();
+
 // Helper functions
 void read_one_cell_var(bool rcbzoltan);
 void read_mesh_parallel(bool rcbzoltan);
@@ -57,6 +61,8 @@ int main(int argc, char* argv[])
 
   result += RUN_TEST(test_multiple_loads_of_same_file);
 
+  result += RUN_TEST(test_read_prefetched_timesteps);
+
   MPI_Finalize();
   return result;
 }
@@ -631,3 +637,8 @@ void multiple_loads_of_same_file()
     }
   }
 }
+
+void test_read_prefetched_timesteps()
+{
+  check_prefetched_timesteps(example, "PARALLEL=READ_PART;PARTITION_METHOD=TRIVIAL;NO_EDGES", "vorticity", MBPOLYGON);
+}
@@ -0,0 +1,89 @@
+/** \file gs_exchange_perf.cpp
+ * Compares the crystal router and the sparse (NBX) exchange of
+ * gs_data::crystal_data::gs_transfer.  Each proc sends a number of tuples
+ * to each of its nearest neighbours in rank order, the usual pattern of a
+ * partitioned mesh.
+ *
+ * Usage: mpiexec -np <procs> gs_exchange_perf [<neighbors> [<tuples> [<repeats>]]]
+ */
+
+#include "moab/gs.hpp"
+#include "moab/TupleList.hpp"
+#include "moab_mpi.h"
+
+#include <iostream>
+#include <stdlib.h>
+
+using namespace moab;
+
+// Fill the tuple list with the messages of one exchange
+static void fill_tuples( TupleList& tl, int rank, int size, int neighbors, int tuples )
+{
+  tl.set_n( 0 );
+  for (int i = 1; i <= neighbors; ++i) {
+    int p = (rank + (i%2 ? (i+1)/2 : size - i/2)) % size;
+    for (int k = 0; k < tuples; ++k) {
+      int n = tl.get_n();
+      tl.vi_wr[2*n] = p;
+      tl.vi_wr[2*n+1] = k;
+      for (int j = 0; j < 3; ++j)
+        tl.vr_wr[3*n+j] = rank + 0.1*j;
+      tl.inc_n();
+    }
+  }
+}
+
+int main( int argc, char* argv[] )
+{
+  MPI_Init( &argc, &argv );
+  int rank, size;
+  MPI_Comm_rank( MPI_COMM_WORLD, &rank );
+  MPI_Comm_size( MPI_COMM_WORLD, &size );
+
+  int neighbors = argc > 1 ? atoi( argv[1] ) : 20;
+  int tuples = argc > 2 ? atoi( argv[2] ) : 1000;
+  int repeats = argc > 3 ? atoi( argv[3] ) : 10;
+  if (neighbors > size - 1)
+    neighbors = size - 1;
+
+  gs_data::crystal_data crystal( MPI_COMM_WORLD );
+  const char* names[] = { "crystal router", "sparse NBX" };
+  gs_data::crystal_data::exchange_mode modes[] = { gs_data::crystal_data::CRYSTAL_ROUTER,
+                                                   gs_data::crystal_data::SPARSE_NBX };
+  if (0 == rank)
+    std::cout << size << " procs, " << neighbors << " neighbors, " << tuples
+              << " tuples per neighbor, " << repeats << " exchanges" << std::endl;
+
+  for (int m = 0; m < 2; ++m) {
+    crystal.set_exchange_mode( modes[m] );
+    TupleList tl;
+    tl.initialize( 2, 0, 0, 3, neighbors*tuples );
+    tl.enableWriteAccess();
+
+    double time = 0;
+    unsigned long received = 0;
+    for (int r = 0; r < repeats; ++r) {
+      fill_tuples( tl, rank, size, neighbors, tuples );
+      MPI_Barrier( MPI_COMM_WORLD );
+      double t = MPI_Wtime();
+      ErrorCode rval = crystal.gs_transfer( 1, tl, 0 );
+      time += MPI_Wtime() - t;
+      if (MB_SUCCESS != rval) {
+        std::cerr << "gs_transfer failed on proc " << rank << std::endl;
+        MPI_Abort( MPI_COMM_WORLD, 1 );
+      }
+      received += tl.get_n();
+    }
+
+    double max_time;
+    unsigned long total;
+    MPI_Reduce( &time, &max_time, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD );
+    MPI_Reduce( &received, &total, 1, MPI_UNSIGNED_LONG, MPI_SUM, 0, MPI_COMM_WORLD );
+    if (0 == rank)
+      std::cout << names[m] << ": " << max_time/repeats << " s per exchange, "
+                << total/repeats << " tuples received" << std::endl;
+  }
+
+  MPI_Finalize();
+  return 0;
+}
@@ -10,6 +10,8 @@
 
 using namespace moab;
 
+#include "PrefetchTimestepsTest.hpp"
+
 std::string example = TestDir + "/io/mpasx1.642.t.2.nc";
 
 void test_read_onevar_trivial();
@@ -32,6 +34,8 @@ void test_gather_onevar_on_rank1();
 void test_multiple_loads_of_same_file();
 void test_multiple_loads_of_same_file_no_mixed_elements();
 
+void test_read_prefetched_timesteps();
+
 // Helper functions
 void read_one_cell_var(bool rcbzoltan, bool no_mixed_elements);
 void read_mesh_parallel(bool rcbzoltan, bool no_mixed_elements);
@@ -66,6 +70,8 @@ int main(int argc, char* argv[])
   result += RUN_TEST(test_multiple_loads_of_same_file);
   result += RUN_TEST(test_multiple_loads_of_same_file_no_mixed_elements);
 
+  result += RUN_TEST(test_read_prefetched_timesteps);
+
   MPI_Finalize();
   return result;
 }
@@ -577,3 +583,10 @@ void multiple_loads_of_same_file(bool no_mixed_elements)
     }
   }
 }
+
+void test_read_prefetched_timesteps()
+{
+  // Cells in several groups are read through buffers, a single group straight into tag storage
+  check_prefetched_timesteps(example, "PARALLEL=READ_PART;PARTITION_METHOD=TRIVIAL;NO_EDGES", "ke", MBPOLYGON);
+  check_prefetched_timesteps(example, "PARALLEL=READ_PART;PARTITION_METHOD=TRIVIAL;NO_EDGES;NO_MIXED_ELEMENTS", "ke", MBPOLYGON);
+}
@@ -1,6 +1,7 @@
 #include "moab/ParallelComm.hpp"
 #include "MBParallelConventions.h"
 #include "moab/ParCommGraph.hpp"
+#include "moab/gs.hpp"
 #include "ReadParallel.hpp"
 #include "moab/FileOptions.hpp"
 #include "MBTagConventions.hpp"
@@ -11,6 +12,7 @@
 #include <iostream>
 #include <algorithm>
 #include <map>
+#include <set>
 #include <sstream>
 #include <assert.h>
 #if !defined(_MSC_VER) && !defined(__MINGW32__)
@@ -140,6 +142,14 @@ ErrorCode test_too_few_parts(const char *);
 ErrorCode test_sequences_after_ghosting(const char *);
 // Test trivial partition in use by iMOAB
 void test_trivial_partition();
+// Test that the sparse exchange delivers the same tuples as the crystal router,
+// also in back to back exchanges
+ErrorCode test_sparse_exchange( const char* );
+// Test that gather-scatter on many fields at once, stored separately or
+// interleaved, matches one field at a time
+ErrorCode test_gs_data_op_many( const char* );
+// Test migration of several tags at once through ParCommGraph, after coverage
+ErrorCode test_tag_migration( const char* );
 
 
 /**************************************************************************
@@ -247,6 +257,9 @@ int main( int argc, char* argv[] )
   num_errors += RUN_TEST_ARG2( test_ghosted_entity_shared_data, 0 );
   num_errors += RUN_TEST_ARG2( regression_owners_with_ghosting, 0 );
   num_errors += RUN_TEST ( test_trivial_partition);
+  num_errors += RUN_TEST_ARG2( test_sparse_exchange, 0 );
+  num_errors += RUN_TEST_ARG2( test_gs_data_op_many, 0 );
+  num_errors += RUN_TEST_ARG2( test_tag_migration, 0 );
 
   if (rank == 0) {
     if (!num_errors)
@@ -1864,3 +1877,226 @@ void test_trivial_partition()
 
 }
 
+// Send (rank+p+round)%3 tuples to each proc p, including this one, exchange
+// them and check locally what was received; the values are returned sorted.
+// There is no other communication, so that exchanges can run back to back.
+static bool sparse_exchange_round( gs_data::crystal_data& crystal, int round,
+                                   std::vector<double>& received )
+{
+  int rank, size;
+  MPI_Comm_rank( MPI_COMM_WORLD, &rank );
+  MPI_Comm_size( MPI_COMM_WORLD, &size );
+
+  TupleList tl;
+  tl.initialize( 3, 0, 0, 1, 3*size );
+  tl.enableWriteAccess();
+  for (int p = 0; p < size; ++p) {
+    for (int k = 0; k < (rank+p+round)%3; ++k) {
+      int n = tl.get_n();
+      tl.vi_wr[3*n] = p;
+      tl.vi_wr[3*n+1] = rank;
+      tl.vi_wr[3*n+2] = k;
+      tl.vr_wr[n] = 1e4*round + 100.0*rank + k;
+      tl.inc_n();
+    }
+  }
+  if (MB_SUCCESS != crystal.gs_transfer( 1, tl, 0 ))
+    return false;
+
+    // the target proc is replaced by the source proc
+  int expected = 0;
+  for (int p = 0; p < size; ++p)
+    expected += (rank+p+round)%3;
+  bool valid = (int)tl.get_n() == expected;
+  received.clear();
+  for (unsigned i = 0; i < tl.get_n(); ++i) {
+    valid = valid && tl.vi_rd[3*i] == tl.vi_rd[3*i+1];
+    valid = valid && tl.vr_rd[i] == 1e4*round + 100.0*tl.vi_rd[3*i] + tl.vi_rd[3*i+2];
+    received.push_back( tl.vr_rd[i] );
+  }
+  std::sort( received.begin(), received.end() );
+
+  return valid;
+}
+
+ErrorCode test_sparse_exchange( const char* )
+{
+  gs_data::crystal_data crystal( MPI_COMM_WORLD );
+  std::vector<double> received[2];
+  for (int mode = 0; mode < 2; ++mode) {
+    crystal.set_exchange_mode( mode ? gs_data::crystal_data::SPARSE_NBX
+                                    : gs_data::crystal_data::CRYSTAL_ROUTER );
+    PCHECK( sparse_exchange_round( crystal, 0, received[mode] ) );
+  }
+  PCHECK( received[0] == received[1] );
+
+    // back to back exchanges with different payloads; each must receive
+    // only its own messages
+  crystal.set_exchange_mode( gs_data::crystal_data::SPARSE_NBX );
+  bool valid = true;
+  for (int round = 1; round <= 20; ++round)
+    valid = sparse_exchange_round( crystal, round, received[0] ) && valid;
+  PCHECK( valid );
+
+  return MB_SUCCESS;
+}
+
+ErrorCode test_gs_data_op_many( const char* )
+{
+  int rank, size;
+  MPI_Comm_rank( MPI_COMM_WORLD, &rank );
+  MPI_Comm_size( MPI_COMM_WORLD, &size );
+
+    // entries 0-5 share their first and last two labels with the previous
+    // and next procs, entry 6 repeats the label of entry 2, entry 7 has a
+    // label shared by all procs and entry 8 is not labeled
+  const unsigned n = 9, nfields = 4;
+  long labels[n];
+  for (unsigned i = 0; i < 6; ++i)
+    labels[i] = 4*rank + 1 + i;
+  labels[6] = labels[2];
+  labels[7] = 4*size + 10;
+  labels[8] = 0;
+
+  gs_data::crystal_data crystal( MPI_COMM_WORLD );
+  ErrorCode rval;
+  gs_data gsd( n, labels, NULL, nfields, 1, 0, &crystal, rval );
+  PCHECK( MB_SUCCESS == rval );
+
+  const int ops[] = { GS_OP_ADD, GS_OP_MUL, GS_OP_MIN, GS_OP_MAX };
+  for (unsigned o = 0; o < sizeof(ops)/sizeof(ops[0]); ++o) {
+    std::vector<double> expected( nfields*n ), values( nfields*n ), interleaved( nfields*n );
+    for (unsigned f = 0; f < nfields; ++f)
+      for (unsigned i = 0; i < n; ++i)
+        expected[f*n+i] = values[f*n+i] = interleaved[i*nfields+f] = 1.0 + f + 0.5*((rank + i)%5);
+
+    realType* fields[nfields];
+    for (unsigned f = 0; f < nfields; ++f) {
+      gsd.gs_data_op( &expected[f*n], ops[o] );
+      fields[f] = &values[f*n];
+    }
+    gsd.gs_data_op_many( fields, nfields, ops[o] );
+    PCHECK( values == expected );
+
+    gsd.gs_data_op_vec( &interleaved[0], nfields, ops[o] );
+    bool same = true;
+    for (unsigned f = 0; f < nfields; ++f)
+      for (unsigned i = 0; i < n; ++i)
+        same = same && interleaved[i*nfields+f] == expected[f*n+i];
+    PCHECK( same );
+  }
+
+  return MB_SUCCESS;
+}
+
+ErrorCode test_tag_migration( const char* )
+{
+  int rank, size;
+  MPI_Comm_rank( MPI_COMM_WORLD, &rank );
+  MPI_Comm_size( MPI_COMM_WORLD, &size );
+
+  Core moab;
+  Interface& mb = moab;
+  ParallelComm pcomm( &mb, MPI_COMM_WORLD );
+  ErrorCode rval;
+
+    // each proc owns elements with ids rank*n+1 ... rank*n+n, and sends
+    // element id to proc id%size; received elements are created in
+    // decreasing id order
+  const int n = 10;
+  Tag id_tag;
+  rval = mb.tag_get_handle( GLOBAL_ID_TAG_NAME, 1, MB_TYPE_INTEGER, id_tag, MB_TAG_DENSE|MB_TAG_CREAT );
+  PCHECK( MB_SUCCESS == rval );
+  double coords[] = { 0, 0, 0 };
+  EntityHandle vtx;
+  rval = mb.create_vertex( coords, vtx ); PCHECK( MB_SUCCESS == rval );
+  const EntityHandle conn[] = { vtx, vtx, vtx, vtx };
+
+  Range sent, received;
+  std::vector<int> sent_ids, received_ids;
+  std::map<int, std::set<int> > ids_from_procs;
+  TupleList tl;
+  tl.initialize( 2, 0, 0, 0, n );
+  tl.enableWriteAccess();
+  for (int i = 0; i < n; ++i) {
+    int id = rank*n + i + 1;
+    sent_ids.push_back( id );
+    tl.vi_wr[2*i] = id%size;
+    tl.vi_wr[2*i+1] = id;
+    tl.inc_n();
+  }
+  for (int id = n*size; id > 0; --id)
+    if (id%size == rank) {
+      received_ids.push_back( id );
+      ids_from_procs[(id-1)/n].insert( id );
+    }
+  for (size_t i = 0; i < sent_ids.size() + received_ids.size(); ++i) {
+    EntityHandle quad;
+    rval = mb.create_element( MBQUAD, conn, 4, quad ); PCHECK( MB_SUCCESS == rval );
+    (i < sent_ids.size() ? sent : received).insert( quad );
+  }
+  rval = mb.tag_set_data( id_tag, sent, &sent_ids[0] ); PCHECK( MB_SUCCESS == rval );
+  rval = mb.tag_set_data( id_tag, received, &received_ids[0] ); PCHECK( MB_SUCCESS == rval );
+
+    // a double and a 2-integer tag
+  std::vector<Tag> send_tags( 2 ), recv_tags( 2 );
+  rval = mb.tag_get_handle( "send_dbl", 1, MB_TYPE_DOUBLE, send_tags[0], MB_TAG_DENSE|MB_TAG_CREAT );
+  PCHECK( MB_SUCCESS == rval );
+  rval = mb.tag_get_handle( "send_int", 2, MB_TYPE_INTEGER, send_tags[1], MB_TAG_DENSE|MB_TAG_CREAT );
+  PCHECK( MB_SUCCESS == rval );
+  rval = mb.tag_get_handle( "recv_dbl", 1, MB_TYPE_DOUBLE, recv_tags[0], MB_TAG_DENSE|MB_TAG_CREAT );
+  PCHECK( MB_SUCCESS == rval );
+  rval = mb.tag_get_handle( "recv_int", 2, MB_TYPE_INTEGER, recv_tags[1], MB_TAG_DENSE|MB_TAG_CREAT );
+  PCHECK( MB_SUCCESS == rval );
+
+  MPI_Group world_group;
+  MPI_Comm_group( MPI_COMM_WORLD, &world_group );
+  ParCommGraph graph( MPI_COMM_WORLD, world_group, world_group, 1, 2 );
+  rval = graph.settle_send_graph( tl ); PCHECK( MB_SUCCESS == rval );
+  graph.SetReceivingAfterCoverage( ids_from_procs );
+  MPI_Group_free( &world_group );
+
+    // migrate twice, to reuse the buffers and the entities found, then again
+    // with new entities for the same ids, which must be found again
+  for (int step = 1; step <= 3; ++step) {
+    if (3 == step) {
+      Range new_sent, new_received;
+      for (size_t i = 0; i < sent_ids.size() + received_ids.size(); ++i) {
+        EntityHandle quad;
+        rval = mb.create_element( MBQUAD, conn, 4, quad ); PCHECK( MB_SUCCESS == rval );
+        (i < sent_ids.size() ? new_sent : new_received).insert( quad );
+      }
+      rval = mb.tag_set_data( id_tag, new_sent, &sent_ids[0] ); PCHECK( MB_SUCCESS == rval );
+      rval = mb.tag_set_data( id_tag, new_received, &received_ids[0] ); PCHECK( MB_SUCCESS == rval );
+      sent.swap( new_sent );
+      received.swap( new_received );
+    }
+
+    std::vector<double> dvals( n );
+    std::vector<int> ivals( 2*n );
+    for (int i = 0; i < n; ++i) {
+      dvals[i] = 0.5*step*sent_ids[i];
+      ivals[2*i] = step*sent_ids[i];
+      ivals[2*i+1] = -sent_ids[i];
+    }
+    rval = mb.tag_set_data( send_tags[0], sent, &dvals[0] ); PCHECK( MB_SUCCESS == rval );
+    rval = mb.tag_set_data( send_tags[1], sent, &ivals[0] ); PCHECK( MB_SUCCESS == rval );
+
+    rval = graph.send_tag_values( MPI_COMM_WORLD, &pcomm, sent, send_tags ); PCHECK( MB_SUCCESS == rval );
+    rval = graph.receive_tag_values( MPI_COMM_WORLD, &pcomm, received, recv_tags ); PCHECK( MB_SUCCESS == rval );
+    rval = graph.release_send_buffers( MPI_COMM_WORLD ); PCHECK( MB_SUCCESS == rval );
+
+    dvals.resize( received.size() );
+    ivals.resize( 2*received.size() );
+    rval = mb.tag_get_data( recv_tags[0], received, &dvals[0] ); PCHECK( MB_SUCCESS == rval );
+    rval = mb.tag_get_data( recv_tags[1], received, &ivals[0] ); PCHECK( MB_SUCCESS == rval );
+    bool valid = true;
+    for (size_t i = 0; i < received_ids.size(); ++i) {
+      valid = valid && dvals[i] == 0.5*step*received_ids[i];
+      valid = valid && ivals[2*i] == step*received_ids[i] && ivals[2*i+1] == -received_ids[i];
+    }
+    PCHECK( valid );
+  }
+
+  return MB_SUCCESS;
+}
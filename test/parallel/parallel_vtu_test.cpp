@@ -0,0 +1,145 @@
+#include "moab/Core.hpp"
+#include "moab/ParallelComm.hpp"
+#include "MBParallelConventions.h"
+#include "MBTagConventions.hpp"
+#include "moab_mpi.h"
+#include "TestUtil.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <stdio.h>
+
+using namespace moab;
+
+const int N = 3;
+const char* INDEX_NAME = "parallel_vtu_test.pvtu";
+
+// Each process gets an NxNxN block of hexes, the blocks being stacked along x
+void build_mesh(Interface& mb, ParallelComm& pcomm, Range& hexes)
+{
+  const int rank = pcomm.proc_config().proc_rank();
+  const int size = pcomm.proc_config().proc_size();
+  const int nx = size*N + 1;
+  ErrorCode rval;
+
+  Tag id_tag;
+  rval = mb.tag_get_handle(GLOBAL_ID_TAG_NAME, 1, MB_TYPE_INTEGER, id_tag);CHECK_ERR(rval);
+
+  std::vector<EntityHandle> verts((N+1)*(N+1)*(N+1));
+  for (int k = 0; k <= N; k++)
+    for (int j = 0; j <= N; j++)
+      for (int i = 0; i <= N; i++) {
+        double coords[] = {(double)(rank*N + i), (double)j, (double)k};
+        EntityHandle& v = verts[i+(N+1)*(j+(N+1)*k)];
+        rval = mb.create_vertex(coords, v);CHECK_ERR(rval);
+        int id = 1 + rank*N + i + nx*(j + (N+1)*k);
+        rval = mb.tag_set_data(id_tag, &v, 1, &id);CHECK_ERR(rval);
+      }
+
+  for (int k = 0; k < N; k++)
+    for (int j = 0; j < N; j++)
+      for (int i = 0; i < N; i++) {
+        EntityHandle conn[8], hex;
+        for (int c = 0; c < 8; c++) {
+          int ii = i + (((c+1)/2)%2), jj = j + (c/2)%2, kk = k + c/4;
+          conn[c] = verts[ii+(N+1)*(jj+(N+1)*kk)];
+        }
+        rval = mb.create_element(MBHEX, conn, 8, hex);CHECK_ERR(rval);
+        hexes.insert(hex);
+      }
+
+  rval = pcomm.resolve_shared_ents(0, hexes, 3, 0);CHECK_ERR(rval);
+  rval = pcomm.exchange_ghost_cells(3, 0, 1, 0, true);CHECK_ERR(rval);
+}
+
+std::string read_file(const std::string& name)
+{
+  std::ifstream file(name.c_str(), std::ios::in | std::ios::binary);
+  CHECK(file.good());
+  std::ostringstream str;
+  str << file.rdbuf();
+  return str.str();
+}
+
+size_t count_substr(const std::string& str, const std::string& sub)
+{
+  size_t count = 0;
+  for (size_t pos = str.find(sub); pos != std::string::npos; pos = str.find(sub, pos + 1))
+    ++count;
+  return count;
+}
+
+void test_write_pvtu()
+{
+  Core moab;
+  Interface& mb = moab;
+  ParallelComm pcomm(&mb, MPI_COMM_WORLD);
+  const int rank = pcomm.proc_config().proc_rank();
+  const int size = pcomm.proc_config().proc_size();
+  ErrorCode rval;
+
+  Range hexes;
+  build_mesh(mb, pcomm, hexes);
+
+  // Ghost cells are there, and must not be written
+  Range all_hexes;
+  rval = mb.get_entities_by_type(0, MBHEX, all_hexes);CHECK_ERR(rval);
+  if (size > 1)
+    CHECK(all_hexes.size() > hexes.size());
+
+  // A cell tag set everywhere, and a vertex tag set only on the root
+  Tag rank_tag, root_tag;
+  rval = mb.tag_get_handle("rank", 1, MB_TYPE_INTEGER, rank_tag,
+                           MB_TAG_DENSE|MB_TAG_CREAT);CHECK_ERR(rval);
+  std::vector<int> ranks(hexes.size(), rank);
+  rval = mb.tag_set_data(rank_tag, hexes, &ranks[0]);CHECK_ERR(rval);
+
+  rval = mb.tag_get_handle("root_only", 1, MB_TYPE_DOUBLE, root_tag,
+                           MB_TAG_SPARSE|MB_TAG_CREAT);CHECK_ERR(rval);
+  if (0 == rank) {
+    Range verts;
+    rval = mb.get_connectivity(hexes, verts);CHECK_ERR(rval);
+    std::vector<double> vals(verts.size(), 1.0);
+    rval = mb.tag_set_data(root_tag, verts, &vals[0]);CHECK_ERR(rval);
+  }
+
+  // Write a set holding all hexes, including the ghosts
+  EntityHandle set;
+  rval = mb.create_meshset(MESHSET_SET, set);CHECK_ERR(rval);
+  rval = mb.add_entities(set, all_hexes);CHECK_ERR(rval);
+  rval = mb.write_file(INDEX_NAME, 0, "PARALLEL=WRITE_PART", &set, 1);CHECK_ERR(rval);
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  // Each piece holds the owned cells and their vertices
+  std::ostringstream piece_name;
+  piece_name << "parallel_vtu_test_" << rank << ".vtu";
+  std::string piece = read_file(piece_name.str());
+  std::ostringstream counts;
+  counts << "NumberOfPoints=\"" << (N+1)*(N+1)*(N+1) << "\" NumberOfCells=\"" << N*N*N << "\"";
+  CHECK(piece.find(counts.str()) != std::string::npos);
+  CHECK(piece.find("Name=\"rank\"") != std::string::npos);
+  CHECK(piece.find("Name=\"root_only\"") != std::string::npos);
+
+  // The index lists all pieces and all arrays
+  if (0 == rank) {
+    std::string index = read_file(INDEX_NAME);
+    CHECK_EQUAL((size_t)size, count_substr(index, "<Piece Source="));
+    CHECK(index.find("<Piece Source=\"parallel_vtu_test_0.vtu\"/>") != std::string::npos);
+    CHECK(index.find("<PDataArray type=\"Int32\" Name=\"rank\" NumberOfComponents=\"1\"/>") != std::string::npos);
+    CHECK(index.find("<PDataArray type=\"Float64\" Name=\"root_only\" NumberOfComponents=\"1\"/>") != std::string::npos);
+    remove(INDEX_NAME);
+  }
+  remove(piece_name.str().c_str());
+}
+
+int main(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+
+  int result = 0;
+  result += RUN_TEST(test_write_pvtu);
+
+  MPI_Finalize();
+  return result;
+}
@@ -0,0 +1,152 @@
+/*
+ * read_map_par.cpp
+ *
+ *  Reads a SCRIP map file in parallel with TempestOnlineMap::ReadParallelMap, gathers the
+ *  source values through the communication graph of the map and applies it; the projected
+ *  values are compared with the ones computed directly from the map entries.
+ */
+
+#include "moab/Core.hpp"
+#include "moab/ParallelComm.hpp"
+#include "moab/Remapping/TempestRemapper.hpp"
+#include "moab/Remapping/TempestOnlineMap.hpp"
+#include "moab_mpi.h"
+#include "netcdfcpp.h"
+
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using namespace moab;
+
+void test_read_map_block();
+void test_read_map_round_robin();
+
+static const char* mapFile = "test_read_map.nc";
+static const int nA = 53, nB = 37;
+
+// Column of the k-th (0-2) nonzero of the 1-based row, and its weight
+static int map_col( int row, int k ) { return ( ( row - 1 ) * 7 + 11 * k ) % nA + 1; }
+static double map_weight( int k ) { return 0 == k ? 0.5 : 0.25; }
+static double src_value( int col ) { return 0.1 * col * col; }
+
+static double expected_value( int row )
+{
+  double val = 0.0;
+  for (int k = 0; k < 3; ++k)
+    val += map_weight( k ) * src_value( map_col( row, k ) );
+  return val;
+}
+
+// Rank 0 writes the map with the entries in reverse row order, so that most of them are read
+// by a rank other than the one owning the row
+static void write_map_file()
+{
+  NcError error( NcError::verbose_nonfatal );
+  const int nS = 3 * nB;
+  std::vector<int> rows( nS ), cols( nS );
+  std::vector<double> vals( nS );
+  for (int i = 0; i < nS; ++i) {
+    const int row = nB - i / 3, k = i % 3;
+    rows[i] = row;
+    cols[i] = map_col( row, k );
+    vals[i] = map_weight( k );
+  }
+
+  NcFile ncMap( mapFile, NcFile::Replace );
+  CHECK( ncMap.is_valid() );
+  NcDim* dimNA = ncMap.add_dim( "n_a", nA );
+  NcDim* dimNB = ncMap.add_dim( "n_b", nB );
+  NcDim* dimNS = ncMap.add_dim( "n_s", nS );
+  CHECK( dimNA && dimNB && dimNS );
+  NcVar* varRow = ncMap.add_var( "row", ncInt, dimNS );
+  NcVar* varCol = ncMap.add_var( "col", ncInt, dimNS );
+  NcVar* varS = ncMap.add_var( "S", ncDouble, dimNS );
+  CHECK( varRow->put( &rows[0], nS ) );
+  CHECK( varCol->put( &cols[0], nS ) );
+  CHECK( varS->put( &vals[0], nS ) );
+  ncMap.close();
+}
+
+// Read the map with the given ownership (empty for block partitions), apply it and check the result
+static void read_and_apply( const std::vector<int>& ownedRows, const std::vector<int>& ownedCols )
+{
+  Core mb;
+  ParallelComm pcomm( &mb, MPI_COMM_WORLD );
+  TempestRemapper remapper( &mb, &pcomm );
+  ErrorCode rval = remapper.initialize();CHECK_ERR( rval );
+
+  TempestOnlineMap weightMap( &remapper );
+  rval = weightMap.ReadParallelMap( mapFile, ownedRows, ownedCols );CHECK_ERR( rval );
+
+  // Owned source values, in the order of the owned source DoFs
+  std::vector<int> srcDofs( ownedCols );
+  if (srcDofs.empty()) {
+    const int rank = pcomm.rank(), size = pcomm.size();
+    const int nloc = nA / size + ( rank < nA % size ? 1 : 0 );
+    const int offset = rank * ( nA / size ) + std::min( rank, nA % size );
+    for (int i = 0; i < nloc; ++i)
+      srcDofs.push_back( offset + i + 1 );
+  }
+  std::vector<double> ownedVals( srcDofs.size() );
+  for (size_t i = 0; i < srcDofs.size(); ++i)
+    ownedVals[i] = src_value( srcDofs[i] );
+
+  std::vector<double> srcVals;
+  rval = weightMap.ExchangeSourceValues( ownedVals, srcVals );CHECK_ERR( rval );
+  CHECK_EQUAL( (size_t)weightMap.GetSourceLocalNDofs(), srcVals.size() );
+  for (size_t i = 0; i < srcVals.size(); ++i)
+    CHECK_REAL_EQUAL( src_value( weightMap.GetColGlobalDoF( i ) + 1 ), srcVals[i], 1e-12 );
+
+  std::vector<double> tgtVals( weightMap.GetDestinationLocalNDofs() );
+  rval = weightMap.ApplyWeights( srcVals, tgtVals );CHECK_ERR( rval );
+
+  // Every row is owned by exactly one rank
+  int nrows = tgtVals.size(), ntotal = 0;
+  MPI_Allreduce( &nrows, &ntotal, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD );
+  CHECK_EQUAL( nB, ntotal );
+  for (size_t i = 0; i < tgtVals.size(); ++i)
+    CHECK_REAL_EQUAL( expected_value( weightMap.GetRowGlobalDoF( i ) + 1 ), tgtVals[i], 1e-12 );
+}
+
+void test_read_map_block()
+{
+  read_and_apply( std::vector<int>(), std::vector<int>() );
+}
+
+void test_read_map_round_robin()
+{
+  int rank, size;
+  MPI_Comm_rank( MPI_COMM_WORLD, &rank );
+  MPI_Comm_size( MPI_COMM_WORLD, &size );
+
+  // Rows and source DoFs dealt out in reverse round robin, unlike the block partition
+  std::vector<int> ownedRows, ownedCols;
+  for (int gid = nB - rank; gid > 0; gid -= size)
+    ownedRows.push_back( gid );
+  for (int gid = nA - rank; gid > 0; gid -= size)
+    ownedCols.push_back( gid );
+  read_and_apply( ownedRows, ownedCols );
+}
+
+int main( int argc, char** argv )
+{
+  int fail = MPI_Init( &argc, &argv );
+  if (fail) return fail;
+
+  int rank;
+  MPI_Comm_rank( MPI_COMM_WORLD, &rank );
+  if (0 == rank)
+    write_map_file();
+  MPI_Barrier( MPI_COMM_WORLD );
+
+  int result = 0;
+  result += RUN_TEST( test_read_map_block );
+  result += RUN_TEST( test_read_map_round_robin );
+
+  fail = MPI_Finalize();
+  if (fail) return fail;
+
+  return result;
+}
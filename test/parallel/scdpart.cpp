@@ -7,6 +7,8 @@
 
 using namespace moab;
 
+#include "PrefetchTimestepsTest.hpp"
+
 std::string example = TestDir + "/io/eul3x48x96.t.3.nc";
 
 void test_read_parallel(int nverts);
@@ -14,6 +16,7 @@ void test_read_parallel_alljorkori();
 void test_read_parallel_alljkbal();
 void test_read_parallel_sqij();
 void test_read_parallel_sqjk();
+void test_read_prefetched_timesteps();
 
 std::string partition_method;
 
@@ -26,6 +29,7 @@ int main(int argc, char **argv)
   result += RUN_TEST(test_read_parallel_alljkbal);
   result += RUN_TEST(test_read_parallel_sqij);
   result += RUN_TEST(test_read_parallel_sqjk);
+  result += RUN_TEST(test_read_prefetched_timesteps);
 
   MPI_Finalize();
   return result;
@@ -55,6 +59,11 @@ void test_read_parallel_sqjk()
   test_read_parallel(4704);
 }
 
+void test_read_prefetched_timesteps()
+{
+  check_prefetched_timesteps(example, "PARALLEL=READ_PART;PARTITION_METHOD=alljorkori", "T", MBQUAD);
+}
+
 void test_read_parallel(int num_verts)
 {
   Core moab;
@@ -5,8 +5,12 @@
 #include "MBParallelConventions.h"
 #include "moab/ReadUtilIface.hpp"
 
+#include <sstream>
+
 using namespace moab;
 
+#include "PrefetchTimestepsTest.hpp"
+
 std::string example = TestDir + "/io/homme3x3458.t.3.nc";
 
 void test_read_parallel_ucd_trivial();
@@ -15,6 +19,8 @@ void test_read_parallel(int num_verts, bool test_nb_nodes);
 
 void test_multiple_loads_of_same_file();
 
+void test_read_prefetched_timesteps();
+
 std::string partition_method;
 const int levels = 3;
 
@@ -27,6 +33,8 @@ int main(int argc, char* argv[])
   result += RUN_TEST(test_read_parallel_ucd_trivial_spectral);
   result += RUN_TEST(test_multiple_loads_of_same_file);
 
+  result += RUN_TEST(test_read_prefetched_timesteps);
+
   MPI_Finalize();
   return result;
 }
@@ -217,3 +225,8 @@ void test_multiple_loads_of_same_file()
     }
   }
 }
+
+void test_read_prefetched_timesteps()
+{
+  check_prefetched_timesteps(example, "PARALLEL=READ_PART;PARTITION_METHOD=TRIVIAL", "T", MBVERTEX);
+}
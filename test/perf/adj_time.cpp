@@ -1,5 +1,7 @@
 #include "moab/Core.hpp"
 #include "moab/Range.hpp"
+#include "moab/HalfFacetRep.hpp"
+#include "moab/MeshTopoUtil.hpp"
 #include "TestUtil.hpp"
 #include <iostream>
 #include <assert.h>
@@ -64,6 +66,78 @@ int main()
   std::cout << "Querying of faces for " << vols.size() << " volumes: "
             << t_down/(double)CLOCKS_PER_SEC << " seconds" << std::endl;
 
+    // compare the same kind of queries answered by the half-facet maps (AHF)
+    // with the ones answered by AEntityFactory
+  Range verts;
+  rval = mb.get_entities_by_dimension( 0, 0, verts );
+  if (MB_SUCCESS != rval)
+    return 2;
+
+  HalfFacetRep ahf( &moab );
+  t_0 = clock();
+  rval = ahf.initialize();
+  if (MB_SUCCESS != rval)
+    return 2;
+  clock_t t_init = clock() - t_0;
+  unsigned long long ahf_entity_mem, ahf_total_mem;
+  ahf.get_memory_use( ahf_entity_mem, ahf_total_mem );
+  std::cout << "Construction of AHF maps: " << t_init/(double)CLOCKS_PER_SEC
+            << " seconds, " << ahf_total_mem << " bytes" << std::endl;
+
+    // vertex to incident volumes
+  size_t count_aef = 0, count_ahf = 0;
+  t_0 = clock();
+  for (Range::iterator i = verts.begin(); i != verts.end(); ++i) {
+    adj.clear();
+    rval = mb.get_adjacencies( &*i, 1, 3, false, adj );
+    if (MB_SUCCESS != rval)
+      return 2;
+    count_aef += adj.size();
+  }
+  clock_t t_aef = clock() - t_0;
+  t_0 = clock();
+  for (Range::iterator i = verts.begin(); i != verts.end(); ++i) {
+    adj.clear();
+    rval = ahf.get_up_adjacencies( *i, 3, adj );
+    if (MB_SUCCESS != rval)
+      return 2;
+    count_ahf += adj.size();
+  }
+  clock_t t_ahf = clock() - t_0;
+  if (count_aef != count_ahf)
+    return 3;
+  std::cout << "Querying of volumes for " << verts.size() << " vertices: AEntityFactory "
+            << t_aef/(double)CLOCKS_PER_SEC << " seconds, AHF "
+            << t_ahf/(double)CLOCKS_PER_SEC << " seconds" << std::endl;
+
+    // volume to neighbor volumes across faces
+  MeshTopoUtil mtu( &mb );
+  Range ngb;
+  count_aef = count_ahf = 0;
+  t_0 = clock();
+  for (Range::iterator i = vols.begin(); i != vols.end(); ++i) {
+    ngb.clear();
+    rval = mtu.get_bridge_adjacencies( *i, 2, 3, ngb );
+    if (MB_SUCCESS != rval)
+      return 2;
+    count_aef += ngb.size();
+  }
+  t_aef = clock() - t_0;
+  t_0 = clock();
+  for (Range::iterator i = vols.begin(); i != vols.end(); ++i) {
+    adj.clear();
+    rval = ahf.get_neighbor_adjacencies( *i, adj );
+    if (MB_SUCCESS != rval)
+      return 2;
+    count_ahf += adj.size();
+  }
+  t_ahf = clock() - t_0;
+  if (count_aef != count_ahf)
+    return 3;
+  std::cout << "Querying of neighbor volumes for " << vols.size() << " volumes: AEntityFactory "
+            << t_aef/(double)CLOCKS_PER_SEC << " seconds, AHF "
+            << t_ahf/(double)CLOCKS_PER_SEC << " seconds" << std::endl;
+
   return 0;
 }
 
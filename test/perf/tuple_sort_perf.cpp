@@ -0,0 +1,107 @@
+/** \file tuple_sort_perf.cpp
+ * Times the sorts of TupleList on tuples (proc, index, global id, value),
+ * the layout of the lists exchanged by resolve_shared_ents: a sort on the
+ * global id alone, the two sorts by global id and then by proc that were
+ * used to order by (proc, global id), and the composite sort doing the same
+ * in one pass.  The results of the two orderings are compared.
+ *
+ * Usage: tuple_sort_perf [<tuples> [<procs>]]
+ * The default is 100 million tuples, which needs about 8 GB of memory.
+ */
+
+#include "moab/TupleList.hpp"
+
+#include <iostream>
+#include <stdlib.h>
+#include <stdint.h>
+#include <sys/time.h>
+
+#ifdef MOAB_HAVE_OPENMP
+#include <omp.h>
+#endif
+
+using namespace moab;
+
+// Wall clock time; the sorts may be multithreaded
+static double wall_time()
+{
+  struct timeval tv;
+  gettimeofday( &tv, 0 );
+  return tv.tv_sec + 1e-6*tv.tv_usec;
+}
+
+// Fill the list with the same pseudo random tuples for a given n
+static void fill_tuples( TupleList& tl, uint n, uint procs )
+{
+  uint64_t x = 88172645463325252ull;
+  tl.set_n( n );
+  for (uint i = 0; i < n; ++i) {
+    x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+    tl.vi_wr[2*i] = x % procs;
+    tl.vi_wr[2*i+1] = i;
+    tl.vul_wr[i] = (x >> 20) % (4*(uint64_t)n);
+    tl.vr_wr[i] = i;
+  }
+  tl.disableWriteAccess();
+}
+
+// Check that the list is ordered by (proc, global id), and stable
+static bool check_order( const TupleList& tl )
+{
+  for (uint i = 1; i < tl.get_n(); ++i) {
+    const sint *a = tl.vi_rd + 2*(i-1), *b = tl.vi_rd + 2*i;
+    if (a[0] > b[0] || (a[0] == b[0] && tl.vul_rd[i-1] > tl.vul_rd[i]))
+      return false;
+    if (a[0] == b[0] && tl.vul_rd[i-1] == tl.vul_rd[i] && a[1] > b[1])
+      return false;
+    if (tl.vr_rd[i] != b[1])
+      return false;
+  }
+  return true;
+}
+
+int main( int argc, char* argv[] )
+{
+  uint n = argc > 1 ? strtoul( argv[1], 0, 0 ) : 100000000;
+  uint procs = argc > 2 ? strtoul( argv[2], 0, 0 ) : 1024;
+  int threads = 1;
+#ifdef MOAB_HAVE_OPENMP
+  threads = omp_get_max_threads();
+#endif
+  std::cout << n << " tuples, " << procs << " procs, " << threads << " threads" << std::endl;
+
+  TupleList two_pass, one_pass;
+  two_pass.initialize( 2, 0, 1, 1, n );
+  one_pass.initialize( 2, 0, 1, 1, n );
+  TupleList::buffer buf;
+  buf.buffer_init( 0 );
+  double t;
+
+  fill_tuples( one_pass, n, procs );
+  t = wall_time();
+  one_pass.sort( 2, &buf );
+  std::cout << "sort by global id:             " << wall_time() - t << " s" << std::endl;
+
+  fill_tuples( two_pass, n, procs );
+  t = wall_time();
+  two_pass.sort( 2, &buf );
+  two_pass.sort( 0, &buf );
+  std::cout << "sort by global id, then proc:  " << wall_time() - t << " s" << std::endl;
+
+  fill_tuples( one_pass, n, procs );
+  t = wall_time();
+  one_pass.sort( 0, 2, &buf );
+  std::cout << "sort by (proc, global id):     " << wall_time() - t << " s" << std::endl;
+
+  if (!check_order( one_pass )) {
+    std::cerr << "composite sort is out of order" << std::endl;
+    return 1;
+  }
+  for (uint i = 0; i < n; ++i) {
+    if (one_pass.vi_rd[2*i+1] != two_pass.vi_rd[2*i+1]) {
+      std::cerr << "composite and two pass sorts differ at tuple " << i << std::endl;
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -1,6 +1,8 @@
 #include "moab/Core.hpp"
 #include "moab/ReorderTool.hpp"
 #include "TestUtil.hpp"
+#include <stdlib.h>
+#include <algorithm>
 
 using namespace moab;
 
@@ -63,6 +65,8 @@ void check_big_meshset();
 void check_handle_tag();
 void check_varlen_tag();
 void check_bit_tag();
+void check_rcm_order();
+void check_hilbert_order();
 
 int main()
 {
@@ -79,6 +83,10 @@ int main()
   int errors = 0;
   errors += RUN_TEST(check_order_by_sets_and_adj);
 
+    // these use their own mesh
+  errors += RUN_TEST(check_rcm_order);
+  errors += RUN_TEST(check_hilbert_order);
+
     // if reorder returned failure, don't bother doing anything else
   int tmp = RUN_TEST(call_reorder);
   if (tmp)
@@ -645,3 +653,135 @@ void check_bit_tag()
 
   CHECK_EQUAL( exp, act );
 }
+
+const int LOCALITY_INTERVALS = 8;
+
+  // hex grid with elements and vertices created in scrambled order,
+  // each hex tagged with the linear index of its grid cell
+void build_scrambled_hexes( Interface& moab, Tag& cell_tag )
+{
+  const int N = LOCALITY_INTERVALS;
+  const int nv = (N+1)*(N+1)*(N+1), nh = N*N*N;
+  ErrorCode rval;
+
+  rval = moab.tag_get_handle( "CELL", 1, MB_TYPE_INTEGER, cell_tag, MB_TAG_DENSE|MB_TAG_CREAT );
+  CHECK_ERR(rval);
+
+  std::vector<EntityHandle> verts(nv);
+  for (int n = 0; n < nv; ++n) {
+    int v = (n*131) % nv;
+    double coords[3] = { (double)(v%(N+1)), (double)((v/(N+1))%(N+1)), (double)(v/((N+1)*(N+1))) };
+    rval = moab.create_vertex( coords, verts[v] );
+    CHECK_ERR(rval);
+  }
+
+  for (int n = 0; n < nh; ++n) {
+    int h = (n*97) % nh;
+    int i = h%N, j = (h/N)%N, k = h/(N*N);
+    EntityHandle conn[8], hex;
+    for (int c = 0; c < 8; ++c) {
+      int ii = i + (((c+1)/2)%2), jj = j + (c/2)%2, kk = k + c/4;
+      conn[c] = verts[ii+(N+1)*(jj+(N+1)*kk)];
+    }
+    rval = moab.create_element( MBHEX, conn, 8, hex );
+    CHECK_ERR(rval);
+    rval = moab.tag_set_data( cell_tag, &hex, 1, &h );
+    CHECK_ERR(rval);
+  }
+}
+
+  // cell index of each hex in handle order, checking that the
+  // connectivity still matches the cell
+void get_cells_in_handle_order( Interface& moab, Tag cell_tag, std::vector<int>& cells )
+{
+  const int N = LOCALITY_INTERVALS;
+  Range hexes;
+  ErrorCode rval = moab.get_entities_by_type( 0, MBHEX, hexes );
+  CHECK_ERR(rval);
+  cells.resize( hexes.size() );
+  rval = moab.tag_get_data( cell_tag, hexes, &cells[0] );
+  CHECK_ERR(rval);
+
+  size_t n = 0;
+  for (Range::iterator i = hexes.begin(); i != hexes.end(); ++i, ++n) {
+    const EntityHandle* conn;
+    int len;
+    rval = moab.get_connectivity( *i, conn, len );
+    CHECK_ERR(rval);
+    double coords[24], centroid[3] = { 0.0, 0.0, 0.0 };
+    rval = moab.get_coords( conn, len, coords );
+    CHECK_ERR(rval);
+    for (int c = 0; c < 8; ++c)
+      for (int d = 0; d < 3; ++d)
+        centroid[d] += coords[3*c+d] / 8;
+    CHECK_REAL_EQUAL( cells[n]%N + 0.5, centroid[0], 1e-12 );
+    CHECK_REAL_EQUAL( (cells[n]/N)%N + 0.5, centroid[1], 1e-12 );
+    CHECK_REAL_EQUAL( cells[n]/(N*N) + 0.5, centroid[2], 1e-12 );
+  }
+}
+
+  // largest distance in handle order between hexes sharing a face
+int face_bandwidth( const std::vector<int>& cells )
+{
+  const int N = LOCALITY_INTERVALS;
+  std::vector<int> pos( cells.size() );
+  for (size_t p = 0; p < cells.size(); ++p)
+    pos[cells[p]] = p;
+
+  int bandwidth = 0;
+  for (int h = 0; h < N*N*N; ++h) {
+    int i = h%N, j = (h/N)%N, k = h/(N*N);
+    if (i+1 < N) bandwidth = std::max( bandwidth, abs(pos[h] - pos[h+1]) );
+    if (j+1 < N) bandwidth = std::max( bandwidth, abs(pos[h] - pos[h+N]) );
+    if (k+1 < N) bandwidth = std::max( bandwidth, abs(pos[h] - pos[h+N*N]) );
+  }
+  return bandwidth;
+}
+
+void check_rcm_order()
+{
+  Core moab;
+  Tag cell_tag, new_handles;
+  build_scrambled_hexes( moab, cell_tag );
+
+  std::vector<int> cells;
+  get_cells_in_handle_order( moab, cell_tag, cells );
+  int before = face_bandwidth( cells );
+
+  ReorderTool tool( &moab );
+  ErrorCode rval = tool.handle_order_rcm( -1, new_handles );
+  CHECK_ERR(rval);
+  rval = tool.reorder_entities( new_handles );
+  CHECK_ERR(rval);
+  moab.tag_delete( new_handles );
+
+  get_cells_in_handle_order( moab, cell_tag, cells );
+  int after = face_bandwidth( cells );
+  CHECK( after < before );
+    // face neighbors end up in the same or adjacent BFS levels, each about a grid layer
+  CHECK( after <= 2*LOCALITY_INTERVALS*LOCALITY_INTERVALS );
+}
+
+void check_hilbert_order()
+{
+  const int N = LOCALITY_INTERVALS;
+  Core moab;
+  Tag cell_tag, new_handles;
+  build_scrambled_hexes( moab, cell_tag );
+
+  ReorderTool tool( &moab );
+  ErrorCode rval = tool.handle_order_sfc( true, new_handles );
+  CHECK_ERR(rval);
+  rval = tool.reorder_entities( new_handles );
+  CHECK_ERR(rval);
+  moab.tag_delete( new_handles );
+
+    // consecutive cells along the Hilbert curve share a face
+  std::vector<int> cells;
+  get_cells_in_handle_order( moab, cell_tag, cells );
+  for (size_t p = 1; p < cells.size(); ++p) {
+    int a = cells[p-1], b = cells[p];
+    int dist = abs(a%N - b%N) + abs((a/N)%N - (b/N)%N) + abs(a/(N*N) - b/(N*N));
+    CHECK_EQUAL( 1, dist );
+  }
+}
@@ -17,12 +17,14 @@
 #include "TestUtil.hpp"
 
 #include <cstdlib>
+#include <cmath>
 #include <sstream>
 
 using namespace moab;
 
 void test_kd_tree();
 void test_bvh_tree();
+void test_bvh_sah_tree();
 void test_locator(SpatialLocator *sl);
 
 ErrorCode create_hex_mesh(Interface &mb, Range &elems, int n, int dim);
@@ -53,6 +55,7 @@ int main(int argc, char **argv)
 
   RUN_TEST(test_kd_tree);
   RUN_TEST(test_bvh_tree);
+  RUN_TEST(test_bvh_sah_tree);
 
 #ifdef MOAB_HAVE_MPI
   fail = MPI_Finalize();
@@ -99,22 +102,83 @@ void test_bvh_tree()
   Range elems;
   rval = create_hex_mesh(mb, elems, ints, 3); CHECK_ERR(rval);
 
-    // initialize spatial locator with the elements and a BVH tree
-  BVHTree bvh(&mb);
-  std::ostringstream opts;
-  opts << "MAX_DEPTH=" << max_depth << ";MAX_PER_LEAF=" << leaf;
-  FileOptions fo(opts.str().c_str());
-  rval = bvh.parse_options(fo);
-  SpatialLocator *sl = new SpatialLocator(&mb, elems, &bvh);
-  test_locator(sl);
+    // default build, binned SAH build, and binned SAH build without entity sets
+  const char *build_opts[] = {"", ";BINNED_SAH=true", ";ENTITY_SETS=false"};
+  for (int i = 0; i < 3; i++) {
+      // initialize spatial locator with the elements and a BVH tree
+    BVHTree bvh(&mb);
+    std::ostringstream opts;
+    opts << "MAX_DEPTH=" << max_depth << ";MAX_PER_LEAF=" << leaf << build_opts[i];
+    FileOptions fo(opts.str().c_str());
+    rval = bvh.parse_options(fo);
+    SpatialLocator *sl = new SpatialLocator(&mb, elems, &bvh);
+    test_locator(sl);
+
+      // test with an evaluator
+    ElemEvaluator eval(&mb);
+    bvh.set_eval(&eval);
+    test_locator(sl);
+
+      // destroy spatial locator, and tree along with it
+    delete sl;
+  }
+}
 
-    // test with an evaluator
-  ElemEvaluator eval(&mb);
-  bvh.set_eval(&eval);
-  test_locator(sl);
+void test_bvh_sah_tree()
+{
+  ErrorCode rval;
+  Core mb;
 
-    // destroy spatial locator, and tree along with it
-  delete sl;
+    // a mesh large enough for the parallel splits of the top of the tree
+  Range elems;
+  const int n = 30;
+  rval = create_hex_mesh(mb, elems, n, 3); CHECK_ERR(rval);
+
+  for (int sets = 0; sets < 2; sets++) {
+    BVHTree bvh(&mb);
+    std::ostringstream opts;
+    opts << "MAX_PER_LEAF=" << leaf << ";BINNED_SAH=true;SAH_BINS=8" << (sets ? "" : ";ENTITY_SETS=false");
+    FileOptions fo(opts.str().c_str());
+    EntityHandle root = 0;
+    rval = bvh.build_tree(elems, &root, &fo); CHECK_ERR(rval);
+    CHECK_EQUAL((unsigned int)elems.size(), (unsigned int)(bvh.tree_stats().avgObjPerLeaf * bvh.tree_stats().numLeaves + 0.5));
+
+      // the centroid of each element is located in that element
+    ElemEvaluator eval(&mb);
+    bvh.set_eval(&eval);
+    for (Range::iterator it = elems.begin(); it != elems.end(); it += 7) {
+      CartVect centroid, params;
+      EntityHandle ent = 0;
+      rval = mb.get_coords(&*it, 1, centroid.array()); CHECK_ERR(rval);
+      rval = bvh.point_search(centroid.array(), ent, 1.0e-10, 1.0e-6, NULL, NULL, &params); CHECK_ERR(rval);
+      CHECK_EQUAL(*it, ent);
+      if (elems.end() - it <= 7) break;
+    }
+    bvh.set_eval(NULL);
+
+    if (sets) continue;
+
+      // without sets, distance_search returns the elements whose box is close enough;
+      // the elements are unit cubes, with their box at distance 0.5 for the corners
+      // of a cube centered at the point
+    CartVect point(n/2.0 + 0.25, n/2.0 + 0.25, n/2.0 + 0.25);
+    std::vector<EntityHandle> found;
+    std::vector<double> dists;
+    rval = bvh.distance_search(point.array(), 0.9, found, 1.0e-10, 1.0e-6, &dists); CHECK_ERR(rval);
+    CHECK_EQUAL(found.size(), dists.size());
+    unsigned int expected = 0;
+    for (Range::iterator it = elems.begin(); it != elems.end(); ++it) {
+      CartVect centroid;
+      rval = mb.get_coords(&*it, 1, centroid.array()); CHECK_ERR(rval);
+      double d_sqr = 0.0;
+      for (int d = 0; d < 3; d++) {
+        double diff = std::max(0.0, fabs(point[d] - centroid[d]) - 0.5);
+        d_sqr += diff*diff;
+      }
+      if (d_sqr <= 0.81) expected++;
+    }
+    CHECK_EQUAL(expected, (unsigned int)found.size());
+  }
 }
 
 void test_locator(SpatialLocator *sl)
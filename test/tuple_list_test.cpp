@@ -0,0 +1,181 @@
+#include "TestUtil.hpp"
+#include "moab/TupleList.hpp"
+
+using namespace moab;
+
+#include <algorithm>
+#include <iterator>
+
+//! tuples appended to a builder, within and beyond the first segment
+void test_builder_fit();
+void test_builder_overflow();
+void test_builder_empty();
+//! columns of a list, and of values the tuples do not have
+void test_column();
+void test_column_empty();
+
+int main()
+{
+  int err = 0;
+
+  err += RUN_TEST(test_builder_fit);
+  err += RUN_TEST(test_builder_overflow);
+  err += RUN_TEST(test_builder_empty);
+  err += RUN_TEST(test_column);
+  err += RUN_TEST(test_column_empty);
+
+  if (!err)
+    printf("ALL TESTS PASSED\n");
+  else
+    printf("%d TESTS FAILED\n",err);
+
+  return err;
+}
+
+// Append n tuples (i, -i; 3i; 7i; i/2, -i), alternating append and push_back
+static void fill_builder( TupleList::builder& tb, uint n )
+{
+  for (uint i = 0; i < n; ++i) {
+    if (i%2) {
+      const sint s[] = { (sint)i, -(sint)i };
+      const slong l = 3*(slong)i;
+      const Ulong ul = 7*(Ulong)i;
+      const realType r[] = { 0.5*i, -1.0*i };
+      tb.push_back( s, &l, &ul, r );
+    }
+    else {
+      sint *sp;
+      slong *lp;
+      Ulong *ulp;
+      realType *rp;
+      tb.append( sp, lp, ulp, rp );
+      sp[0] = i;
+      sp[1] = -(sint)i;
+      lp[0] = 3*(slong)i;
+      ulp[0] = 7*(Ulong)i;
+      rp[0] = 0.5*i;
+      rp[1] = -1.0*i;
+    }
+  }
+}
+
+// Finalize the builder into a list with a different layout, and check its tuples
+static void check_finalize( TupleList::builder& tb, uint n )
+{
+  CHECK_EQUAL( n, tb.get_n() );
+  TupleList tl;
+  tl.initialize( 1, 0, 0, 0, 10 );
+  tb.finalize( tl );
+  CHECK_EQUAL( 0u, tb.get_n() );
+
+  CHECK_EQUAL( n, tl.get_n() );
+  CHECK_EQUAL( n, tl.get_max() );
+  uint mi, ml, mul, mr;
+  tl.getTupleSize( mi, ml, mul, mr );
+  CHECK_EQUAL( 2u, mi );
+  CHECK_EQUAL( 1u, ml );
+  CHECK_EQUAL( 1u, mul );
+  CHECK_EQUAL( 2u, mr );
+  for (uint i = 0; i < n; ++i) {
+    CHECK_EQUAL( (sint)i, tl.vi_rd[2*i] );
+    CHECK_EQUAL( -(sint)i, tl.vi_rd[2*i+1] );
+    CHECK_EQUAL( 3*(slong)i, tl.vl_rd[i] );
+    CHECK_EQUAL( 7*(Ulong)i, tl.vul_rd[i] );
+    CHECK_REAL_EQUAL( 0.5*i, tl.vr_rd[2*i], 1e-12 );
+    CHECK_REAL_EQUAL( -1.0*i, tl.vr_rd[2*i+1], 1e-12 );
+  }
+
+  // The builder can be used again after finalize
+  const sint s[] = { 1, 2 };
+  const slong l = 0;
+  const Ulong ul = 0;
+  const realType r[] = { 0, 0 };
+  tb.push_back( s, &l, &ul, r );
+  tb.finalize( tl );
+  CHECK_EQUAL( 1u, tl.get_n() );
+  CHECK_EQUAL( 2, tl.vi_rd[1] );
+}
+
+void test_builder_fit()
+{
+  TupleList::builder tb( 2, 1, 1, 2, 1024 );
+  fill_builder( tb, 1024 );
+  check_finalize( tb, 1024 );
+}
+
+void test_builder_overflow()
+{
+  // one tuple more than the estimate, then several later segments
+  TupleList::builder tb( 2, 1, 1, 2, 1024 );
+  fill_builder( tb, 1025 );
+  check_finalize( tb, 1025 );
+
+  fill_builder( tb, 10000 );
+  check_finalize( tb, 10000 );
+}
+
+void test_builder_empty()
+{
+  TupleList::builder tb( 2, 1, 1, 2, 1024 );
+  check_finalize( tb, 0 );
+
+  TupleList::builder tb1( 2, 1, 1, 2, 1 );
+  fill_builder( tb1, 5 );
+  check_finalize( tb1, 5 );
+}
+
+void test_column()
+{
+  const uint n = 100;
+  TupleList::builder tb( 2, 1, 1, 2, 10 );
+  fill_builder( tb, n );
+  TupleList tl;
+  tb.finalize( tl );
+
+  TupleList::column<const sint> c0 = tl.vi_column(0), c1 = tl.vi_column(1);
+  TupleList::column<const realType> r1 = tl.vr_column(1);
+  CHECK_EQUAL( n, c0.size() );
+  CHECK( !c0.empty() );
+  for (uint i = 0; i < n; ++i) {
+    CHECK_EQUAL( (sint)i, c0[i] );
+    CHECK_EQUAL( -(sint)i, c1[i] );
+    CHECK_EQUAL( 3*(slong)i, tl.vl_column(0)[i] );
+    CHECK_EQUAL( 7*(Ulong)i, tl.vul_column(0)[i] );
+    CHECK_REAL_EQUAL( -1.0*i, r1[i], 1e-12 );
+  }
+
+  CHECK_EQUAL( (std::ptrdiff_t)n, std::distance( c0.begin(), c0.end() ) );
+  CHECK_EQUAL( (std::ptrdiff_t)n, c1.end() - c1.begin() );
+  CHECK_EQUAL( 1, (int)std::count( c1.begin(), c1.end(), -5 ) );
+  CHECK_EQUAL( 10, (int)(std::lower_bound( c0.begin(), c0.end(), 10 ) - c0.begin()) );
+
+  TupleList::column<const sint>::iterator it = c0.end();
+  --it;
+  CHECK_EQUAL( (sint)n-1, *it );
+  CHECK_EQUAL( (sint)n-2, it[-1] );
+  CHECK_EQUAL( 0, *(it - (n-1)) );
+}
+
+void test_column_empty()
+{
+  // values the tuples do not have
+  TupleList tl;
+  tl.initialize( 1, 0, 0, 0, 10 );
+  tl.enableWriteAccess();
+  tl.inc_n();
+  tl.vi_wr[0] = 3;
+  TupleList::column<const sint> c = tl.vi_column(1);
+  TupleList::column<const slong> l = tl.vl_column(0);
+  TupleList::column<const realType> r = tl.vr_column(5);
+  CHECK( c.empty() && l.empty() && r.empty() );
+  CHECK_EQUAL( 0, (int)std::distance( c.begin(), c.end() ) );
+  CHECK_EQUAL( 0, (int)std::distance( l.begin(), l.end() ) );
+  CHECK_EQUAL( 0, (int)(r.end() - r.begin()) );
+
+  // a list without tuples
+  TupleList tl0;
+  tl0.initialize( 2, 0, 0, 1, 0 );
+  TupleList::column<const sint> c0 = tl0.vi_column(0);
+  CHECK( c0.empty() );
+  CHECK_EQUAL( 0, (int)std::distance( c0.begin(), c0.end() ) );
+}
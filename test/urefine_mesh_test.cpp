@@ -10,8 +10,13 @@
 #include "moab/MeshTopoUtil.hpp"
 #include "moab/ReadUtilIface.hpp"
 #include "moab/NestedRefine.hpp"
+#include "moab/CN.hpp"
 #include "TestUtil.hpp"
 
+#ifdef MOAB_HAVE_OPENMP
+#include <omp.h>
+#endif
+
 #ifdef MOAB_HAVE_MPI
 #include "moab/ParallelComm.hpp"
 #include "MBParallelConventions.h"
@@ -1231,6 +1236,92 @@ ErrorCode test_3D()
   return MB_SUCCESS;
 }
 
+// Refine a small mesh of the given type with nthreads threads, and return for every level the
+// vertex coordinates and the cell connectivity, as indices into the vertices of the level
+ErrorCode refine_with_threads(EntityType type, int *level_degrees, int num_levels, int nthreads,
+                              std::vector<std::vector<double> > &coords, std::vector<std::vector<int> > &conn)
+{
+#ifdef MOAB_HAVE_OPENMP
+  omp_set_num_threads(nthreads);
+#else
+  if (nthreads != 1)
+    return MB_NOT_IMPLEMENTED;
+#endif
+
+  ErrorCode error;
+  Core mb;
+  error = create_mesh(&mb, type); CHECK_ERR(error);
+
+  EntityHandle fset;
+  Range ents;
+  error = mb.create_meshset(MESHSET_SET, fset); CHECK_ERR(error);
+  error = mb.get_entities_by_handle(0, ents); CHECK_ERR(error);
+  error = mb.add_entities(fset, ents); CHECK_ERR(error);
+
+  NestedRefine uref(&mb, 0, fset);
+  std::vector<EntityHandle> set;
+  error = uref.generate_mesh_hierarchy(num_levels, level_degrees, set, true); CHECK_ERR(error);
+
+  coords.resize(num_levels+1);
+  conn.resize(num_levels+1);
+  for (int l = 0; l <= num_levels; l++)
+    {
+      Range verts, cells;
+      error = mb.get_entities_by_dimension(set[l], 0, verts); CHECK_ERR(error);
+      error = mb.get_entities_by_dimension(set[l], 3, cells); CHECK_ERR(error);
+
+      coords[l].resize(3*verts.size());
+      error = mb.get_coords(verts, &coords[l][0]); CHECK_ERR(error);
+
+      std::vector<EntityHandle> cellv(cells.begin(), cells.end()), adjs;
+      error = mb.get_connectivity(&cellv[0], cellv.size(), adjs); CHECK_ERR(error);
+      conn[l].resize(adjs.size());
+      for (size_t i = 0; i < adjs.size(); i++)
+        conn[l][i] = verts.index(adjs[i]);
+    }
+
+  return MB_SUCCESS;
+}
+
+// The 3D refinement runs over the cells in an OpenMP loop; the hierarchy has to be the same
+// as the one refined by a single thread, level by level
+ErrorCode test_threads()
+{
+  ErrorCode error;
+  int nthreads = 1;
+#ifdef MOAB_HAVE_OPENMP
+  int max_threads = omp_get_max_threads();
+  nthreads = std::max(4, max_threads);
+#endif
+
+  EntityType types[2] = {MBTET, MBHEX};
+  int deg[2] = {2,3};
+  int len = sizeof(deg) / sizeof(int);
+
+  for (int t = 0; t < 2; t++)
+    {
+      std::cout<<"Comparing "<<CN::EntityTypeName(types[t])<<" hierarchies refined by 1 and "<<nthreads<<" threads"<<std::endl;
+      std::vector<std::vector<double> > coords1, coordsN;
+      std::vector<std::vector<int> > conn1, connN;
+      error = refine_with_threads(types[t], deg, len, 1, coords1, conn1); CHECK_ERR(error);
+      error = refine_with_threads(types[t], deg, len, nthreads, coordsN, connN); CHECK_ERR(error);
+
+      for (int l = 0; l <= len; l++)
+        {
+          CHECK_EQUAL(coords1[l].size(), coordsN[l].size());
+          for (size_t i = 0; i < coords1[l].size(); i++)
+            CHECK_REAL_EQUAL(coords1[l][i], coordsN[l][i], 1e-12);
+          CHECK(conn1[l] == connN[l]);
+        }
+    }
+
+#ifdef MOAB_HAVE_OPENMP
+  omp_set_num_threads(max_threads);
+#endif
+
+  return MB_SUCCESS;
+}
+
 ErrorCode test_mesh(const char* filename, int *level_degrees, int num_levels)
 {
   Core moab;
@@ -1298,6 +1389,10 @@ int main(int argc, char *argv[])
         result = test_3D();
         handle_error_code(result, number_tests_failed, number_tests_successful);
         std::cout<<"\n";
+
+        result = test_threads();
+        handle_error_code(result, number_tests_failed, number_tests_successful);
+        std::cout<<"\n";
   }
     else if (argc == 2)
       {
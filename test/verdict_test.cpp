@@ -2,6 +2,7 @@
 #include "moab/CartVect.hpp"
 #include "moab/Range.hpp"
 #include "moab/verdict/VerdictWrapper.hpp"
+#include "moab/ScdInterface.hpp"
 #include <iostream>
 #include <iomanip>
 #include <cstdio>
@@ -13,6 +14,8 @@ using namespace moab;
 
 void verdict_test1();
 void verdict_unit_tests();
+void verdict_range_test();
+void verdict_structured_test();
 
 int main( int argc, char* argv[] )
 {
@@ -22,6 +25,8 @@ int main( int argc, char* argv[] )
 
   result += RUN_TEST(verdict_test1);
   result += RUN_TEST(verdict_unit_tests);
+  result += RUN_TEST(verdict_range_test);
+  result += RUN_TEST(verdict_structured_test);
 
   return result;
 }
@@ -80,6 +85,93 @@ void verdict_test1()
   return;
 }
 
+// compare qualities computed for a range of elements, in a dense tag, a sparse
+// tag and a vector, with the qualities computed one element at a time
+static void check_range_qualities(Interface* mb, VerdictWrapper& vw, const Range& elems, QualityType q)
+{
+  ErrorCode rval;
+  std::vector<double> expected(elems.size());
+  std::vector<double>::iterator eit = expected.begin();
+  for (Range::const_iterator it = elems.begin(); it != elems.end(); ++it, ++eit)
+  {
+    rval = vw.quality_measure(*it, q, *eit);CHECK_ERR(rval);
+  }
+
+  std::vector<double> values;
+  rval = vw.quality_measure(elems, q, values);CHECK_ERR(rval);
+  CHECK_EQUAL(expected.size(), values.size());
+  for (size_t i = 0; i < values.size(); i++)
+    CHECK_REAL_EQUAL(expected[i], values[i], 0.0);
+
+  Tag dense_tag, sparse_tag;
+  double def_val = -1.0;
+  rval = mb->tag_get_handle("quality_dense", 1, MB_TYPE_DOUBLE, dense_tag,
+                            MB_TAG_DENSE|MB_TAG_CREAT, &def_val);CHECK_ERR(rval);
+  rval = mb->tag_get_handle("quality_sparse", 1, MB_TYPE_DOUBLE, sparse_tag,
+                            MB_TAG_SPARSE|MB_TAG_CREAT);CHECK_ERR(rval);
+  rval = vw.quality_measure(elems, q, dense_tag);CHECK_ERR(rval);
+  rval = vw.quality_measure(elems, q, sparse_tag);CHECK_ERR(rval);
+  rval = mb->tag_get_data(dense_tag, elems, &values[0]);CHECK_ERR(rval);
+  for (size_t i = 0; i < values.size(); i++)
+    CHECK_REAL_EQUAL(expected[i], values[i], 0.0);
+  rval = mb->tag_get_data(sparse_tag, elems, &values[0]);CHECK_ERR(rval);
+  for (size_t i = 0; i < values.size(); i++)
+    CHECK_REAL_EQUAL(expected[i], values[i], 0.0);
+}
+
+void verdict_range_test()
+{
+  ErrorCode rval;
+  Core moab_core;
+  Interface* mb = &moab_core;
+  rval = mb->load_mesh( filename.c_str());CHECK_ERR(rval);
+
+  VerdictWrapper vw(mb);
+  rval = vw.set_size(1.0);CHECK_ERR(rval);
+  for (EntityType et = MBEDGE; et <= MBHEX; et++)
+  {
+    Range elems;
+    rval = mb->get_entities_by_type(0, et, elems);CHECK_ERR(rval);
+    if (elems.empty())
+      continue;
+    for (int quality = 0; quality < MB_QUALITY_COUNT; quality++)
+    {
+      QualityType q = (QualityType)quality;
+      if (!vw.possible_quality(et, q))
+        continue;
+      check_range_qualities(mb, vw, elems, q);
+    }
+  }
+
+  // every element type of the range must have the quality
+  Range tris, hexes;
+  rval = mb->get_entities_by_type(0, MBTRI, tris);CHECK_ERR(rval);
+  rval = mb->get_entities_by_type(0, MBHEX, hexes);CHECK_ERR(rval);
+  CHECK(!tris.empty() && !hexes.empty());
+  std::vector<double> values;
+  rval = vw.quality_measure(unite(tris, hexes), MB_VOLUME, values);
+  CHECK_EQUAL(MB_NOT_IMPLEMENTED, rval);
+  rval = vw.quality_measure(unite(tris, hexes), MB_EDGE_RATIO, values);CHECK_ERR(rval);
+}
+
+void verdict_structured_test()
+{
+  ErrorCode rval;
+  Core moab_core;
+  Interface* mb = &moab_core;
+  ScdInterface* scdi;
+  rval = mb->query_interface(scdi);CHECK_ERR(rval);
+  ScdBox* box;
+  rval = scdi->construct_box(HomCoord(0, 0, 0), HomCoord(4, 3, 2), NULL, 0, box);CHECK_ERR(rval);
+
+  Range hexes;
+  rval = mb->get_entities_by_type(0, MBHEX, hexes);CHECK_ERR(rval);
+  CHECK_EQUAL((size_t)24, hexes.size());
+
+  VerdictWrapper vw(mb);
+  check_range_qualities(mb, vw, hexes, MB_VOLUME);
+  check_range_qualities(mb, vw, hexes, MB_SCALED_JACOBIAN);
+}
 
 #define MAX_NODES_PER_ELEMENT 27
 #define MAX_TESTS_PER_ELEMENT 20
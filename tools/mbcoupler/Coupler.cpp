@@ -47,6 +47,7 @@ Coupler::Coupler(Interface *impl,
   // Initialize tuple lists to indicate not initialized
   mappedPts = NULL;
   targetPts = NULL;
+  interpOp = NULL;
   _spectralSource = _spectralTarget = NULL;
 }
 
@@ -60,6 +61,7 @@ Coupler::~Coupler()
   delete myTree;
   delete targetPts;
   delete mappedPts;
+  delete interpOp;
 }
 
 ErrorCode Coupler::initialize_tree()
@@ -304,6 +306,10 @@ ErrorCode Coupler::locate_points(double *xyz, unsigned int num_points,
 {
   assert(tl || store_local);
 
+  // Weights of an assembled operator are for the old points
+  delete interpOp;
+  interpOp = NULL;
+
   // target_pts: TL(to_proc, tgt_index, x, y, z): tuples sent to source mesh procs representing pts to be located
   // source_pts: TL(from_proc, tgt_index, src_index): results of source mesh proc point location, ready to send
   //             back to tgt procs; src_index of -1 indicates point not located (arguably not useful...)
@@ -648,6 +654,10 @@ ErrorCode Coupler::interpolate(Coupler::Method *methods,
   if (pts_total != tl_tmp->get_n())
     return MB_FAILURE;
 
+  // Use the assembled operator if it is for these points and this method
+  if (interpOp && !tl && 1 == num_methods && methods[0] == interpOp->method)
+    return apply_interpolation_operator(tags, 1, interp_vals);
+
   TupleList tinterp;
   tinterp.initialize(5, 0, 0, 1, tl_tmp->get_n());
   int t = 0;
@@ -705,6 +715,179 @@ ErrorCode Coupler::interpolate(Coupler::Method *methods,
   return MB_SUCCESS;
 }
 
+ErrorCode Coupler::assemble_interpolation_operator(Coupler::Method method)
+{
+  if (!targetPts || !mappedPts) {
+    MB_SET_ERR(MB_FAILURE, "Points must be located and stored before assembling an interpolation operator");
+  }
+  if (SPECTRAL == method || _spectralSource) {
+    MB_SET_ERR(MB_NOT_IMPLEMENTED, "No interpolation operator for spectral elements");
+  }
+
+  delete interpOp;
+  interpOp = NULL;
+
+  InterpOperator op;
+  op.method = method;
+  op.numPoints = targetPts->get_n();
+
+  // Ask the source procs for the weights of each located point, and
+  // remember from which proc each point's value will come, in the
+  // order the source procs will send them: by target index
+  TupleList requests;
+  requests.initialize(3, 0, 0, 0, op.numPoints);
+  requests.enableWriteAccess();
+  std::vector<std::pair<int, int> > sources;
+  for (unsigned int i = 0; i < op.numPoints; i++) {
+    int proc = targetPts->vi_rd[3*i];
+    if (proc < 0)
+      continue; // Not located
+    requests.vi_wr[3*requests.get_n()] = proc;
+    requests.vi_wr[3*requests.get_n() + 1] = targetPts->vi_rd[3*i + 1];
+    requests.vi_wr[3*requests.get_n() + 2] = targetPts->vi_rd[3*i + 2];
+    requests.inc_n();
+    sources.push_back(std::make_pair(proc, targetPts->vi_rd[3*i + 1]));
+  }
+  std::sort(sources.begin(), sources.end());
+  for (unsigned int i = 0; i < sources.size(); i++) {
+    if (op.recvProcs.empty() || op.recvProcs.back() != sources[i].first) {
+      op.recvProcs.push_back(sources[i].first);
+      op.recvOffsets.push_back(i);
+    }
+    op.recvIndex.push_back(sources[i].second);
+  }
+  op.recvOffsets.push_back(sources.size());
+
+  if (myPc)
+    (myPc->proc_config().crystal_router())->gs_transfer(1, requests, 0);
+
+  // After the transfer, each request holds the target proc, the
+  // target index and the index into mappedPts; one row per request,
+  // grouped by target proc and sorted by target index
+  std::vector<std::pair<std::pair<int, int>, int> > rows(requests.get_n());
+  for (unsigned int i = 0; i < requests.get_n(); i++)
+    rows[i] = std::make_pair(std::make_pair(requests.vi_rd[3*i], requests.vi_rd[3*i + 1]),
+                             requests.vi_rd[3*i + 2]);
+  requests.reset();
+  std::sort(rows.begin(), rows.end());
+
+  std::vector<EntityHandle> col_ents, ents;
+  std::vector<double> weights;
+  op.rowPtr.push_back(0);
+  for (unsigned int i = 0; i < rows.size(); i++) {
+    int proc = rows[i].first.first;
+    if (op.sendProcs.empty() || op.sendProcs.back() != proc) {
+      op.sendProcs.push_back(proc);
+      op.sendOffsets.push_back(i);
+    }
+    int mindex = rows[i].second;
+    ErrorCode result = interp_weights(method, mappedPts->vul_rd[mindex],
+                                      CartVect(mappedPts->vr_rd + 3*mindex),
+                                      ents, weights);MB_CHK_ERR(result);
+    col_ents.insert(col_ents.end(), ents.begin(), ents.end());
+    op.weights.insert(op.weights.end(), weights.begin(), weights.end());
+    op.rowPtr.push_back(op.weights.size());
+  }
+  op.sendOffsets.push_back(rows.size());
+
+  // Number the source entities
+  op.srcEnts = col_ents;
+  std::sort(op.srcEnts.begin(), op.srcEnts.end());
+  op.srcEnts.erase(std::unique(op.srcEnts.begin(), op.srcEnts.end()), op.srcEnts.end());
+  op.colIndex.resize(col_ents.size());
+  for (unsigned int j = 0; j < col_ents.size(); j++)
+    op.colIndex[j] = std::lower_bound(op.srcEnts.begin(), op.srcEnts.end(), col_ents[j])
+                   - op.srcEnts.begin();
+
+  interpOp = new InterpOperator(op);
+
+  return MB_SUCCESS;
+}
+
+ErrorCode Coupler::apply_interpolation_operator(Tag *tags,
+                                                int num_tags,
+                                                double *interp_vals)
+{
+  if (!interpOp) {
+    MB_SET_ERR(MB_FAILURE, "Interpolation operator not assembled");
+  }
+  const InterpOperator &op = *interpOp;
+  const int num_ents = op.srcEnts.size();
+  const int num_rows = op.rowPtr.size() - 1;
+  ErrorCode result;
+
+  // Gather the source values, interleaved by tag
+  std::vector<double> src_vals((size_t)num_ents*num_tags), tag_vals(num_ents);
+  for (int k = 0; k < num_tags; k++) {
+    int len;
+    DataType type;
+    result = mbImpl->tag_get_length(tags[k], len);MB_CHK_ERR(result);
+    result = mbImpl->tag_get_data_type(tags[k], type);MB_CHK_ERR(result);
+    if (1 != len || MB_TYPE_DOUBLE != type) {
+      MB_SET_ERR(MB_TYPE_OUT_OF_RANGE, "Interpolated tags must be single double values");
+    }
+    if (!num_ents)
+      continue;
+    result = mbImpl->tag_get_data(tags[k], &op.srcEnts[0], num_ents, &tag_vals[0]);MB_CHK_ERR(result);
+    for (int j = 0; j < num_ents; j++)
+      src_vals[(size_t)j*num_tags + k] = tag_vals[j];
+  }
+
+  // Interpolate all tags at once, one row of the operator at a time
+  std::vector<double> row_vals((size_t)num_rows*num_tags, 0.0);
+#ifdef MOAB_HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (int r = 0; r < num_rows; r++) {
+    double *vals = &row_vals[(size_t)r*num_tags];
+    for (int j = op.rowPtr[r]; j < op.rowPtr[r + 1]; j++) {
+      const double w = op.weights[j];
+      const double *src = &src_vals[(size_t)op.colIndex[j]*num_tags];
+      for (int k = 0; k < num_tags; k++)
+        vals[k] += w*src[k];
+    }
+  }
+
+  // Send the values to the target procs; the pattern is fixed, so
+  // each pair of procs exchanges a single message of known size
+  std::vector<double> recv_vals(op.recvIndex.size()*num_tags);
+  const int my_rank = (myPc ? myPc->proc_config().proc_rank() : 0);
+  std::vector<MPI_Request> reqs;
+  for (unsigned int j = 0; j < op.recvProcs.size(); j++) {
+    if (op.recvProcs[j] == my_rank)
+      continue;
+    int count = (op.recvOffsets[j + 1] - op.recvOffsets[j])*num_tags;
+    reqs.push_back(MPI_REQUEST_NULL);
+    int success = MPI_Irecv(&recv_vals[(size_t)op.recvOffsets[j]*num_tags], count, MPI_DOUBLE,
+                            op.recvProcs[j], myId, myPc->proc_config().proc_comm(), &reqs.back());
+    ERRORMPI("Failed to post receive of interpolated values", success);
+  }
+  for (unsigned int j = 0; j < op.sendProcs.size(); j++) {
+    int count = (op.sendOffsets[j + 1] - op.sendOffsets[j])*num_tags;
+    double *vals = &row_vals[(size_t)op.sendOffsets[j]*num_tags];
+    if (op.sendProcs[j] == my_rank) {
+      std::vector<int>::const_iterator it = std::find(op.recvProcs.begin(), op.recvProcs.end(), my_rank);
+      assert(it != op.recvProcs.end());
+      std::copy(vals, vals + count, &recv_vals[(size_t)op.recvOffsets[it - op.recvProcs.begin()]*num_tags]);
+      continue;
+    }
+    reqs.push_back(MPI_REQUEST_NULL);
+    int success = MPI_Isend(vals, count, MPI_DOUBLE, op.sendProcs[j], myId,
+                            myPc->proc_config().proc_comm(), &reqs.back());
+    ERRORMPI("Failed to send interpolated values", success);
+  }
+  if (!reqs.empty()) {
+    int success = MPI_Waitall(reqs.size(), &reqs[0], MPI_STATUSES_IGNORE);
+    ERRORMPI("Failed to exchange interpolated values", success);
+  }
+
+  for (unsigned int i = 0; i < op.recvIndex.size(); i++)
+    for (int k = 0; k < num_tags; k++)
+      interp_vals[(size_t)k*op.numPoints + op.recvIndex[i]] = recv_vals[(size_t)i*num_tags + k];
+
+  return MB_SUCCESS;
+}
+
 ErrorCode Coupler::nat_param(double xyz[3],
                              std::vector<EntityHandle> &entities,
                              std::vector<CartVect> &nat_coords,
@@ -958,6 +1141,35 @@ ErrorCode Coupler::nat_param(double xyz[3],
   return MB_SUCCESS;
 }
 
+// Element map used to interpolate vertex fields on an element, or NULL if
+// the element is not supported; num_verts is set to the number of vertices used
+static Element::Map* interp_map(EntityType etype, int num_connect, int &num_verts)
+{
+  if (MBHEX == etype) {
+    if (8 == num_connect) {
+      num_verts = 8;
+      return new moab::Element::LinearHex();
+    }
+    else { /* (MBHEX == etype && 27 == num_connect) */
+      num_verts = 27;
+      return new moab::Element::QuadraticHex();
+    }
+  }
+  else if (MBTET == etype) {
+    num_verts = 4;
+    return new moab::Element::LinearTet();
+  }
+  else if (MBQUAD == etype) {
+    num_verts = 4;
+    return new moab::Element::LinearQuad();
+  }
+  else if (MBTRI == etype) {
+    num_verts = 3;
+    return new moab::Element::LinearTri();
+  }
+  return NULL;
+}
+
 ErrorCode Coupler::interp_field(EntityHandle elem,
                                 CartVect nat_coord,
                                 Tag tag,
@@ -976,7 +1188,6 @@ ErrorCode Coupler::interp_field(EntityHandle elem,
   }
   else {
     double vfields[27]; // Will work for linear hex, quadratic hex or Tets
-    moab::Element::Map *elemMap = NULL;
     int num_verts = 0;
     // Get the EntityType
     // Get the tag values at the vertices
@@ -985,30 +1196,9 @@ ErrorCode Coupler::interp_field(EntityHandle elem,
     ErrorCode result = mbImpl->get_connectivity(elem, connect, num_connect);
     if (MB_SUCCESS != result)
       return result;
-    EntityType etype = mbImpl->type_from_handle(elem);
-    if (MBHEX == etype) {
-      if (8 == num_connect) {
-        elemMap = new moab::Element::LinearHex();
-        num_verts = 8;
-      }
-      else { /* (MBHEX == etype && 27 == num_connect) */
-        elemMap = new moab::Element::QuadraticHex();
-        num_verts = 27;
-      }
-    }
-    else if (MBTET == etype) {
-      elemMap = new moab::Element::LinearTet();
-      num_verts = 4;
-    }
-    else if (MBQUAD == etype) {
-      elemMap = new moab::Element::LinearQuad();
-      num_verts = 4;
-    }
-    else if (MBTRI == etype) {
-      elemMap = new moab::Element::LinearTri();
-      num_verts = 3;
-    }
-    else
+    moab::Element::Map *elemMap = interp_map(mbImpl->type_from_handle(elem),
+                                             num_connect, num_verts);
+    if (!elemMap)
       return MB_FAILURE;
 
     result = mbImpl->tag_get_data(tag, connect, std::min(num_verts, num_connect), vfields);
@@ -1038,6 +1228,54 @@ ErrorCode Coupler::interp_field(EntityHandle elem,
   return MB_SUCCESS;
 }
 
+ErrorCode Coupler::interp_weights(Coupler::Method method,
+                                  EntityHandle elem,
+                                  const CartVect &nat_coord,
+                                  std::vector<EntityHandle> &ents,
+                                  std::vector<double> &weights)
+{
+  ents.clear();
+  weights.clear();
+
+  if (CONSTANT == method) {
+    ents.push_back(elem);
+    weights.push_back(1.0);
+    return MB_SUCCESS;
+  }
+  else if (LINEAR_FE != method && QUADRATIC_FE != method && SPHERICAL != method)
+    return MB_FAILURE;
+
+  const EntityHandle *connect;
+  int num_connect, num_verts = 0;
+  ErrorCode result = mbImpl->get_connectivity(elem, connect, num_connect);
+  if (MB_SUCCESS != result)
+    return result;
+  moab::Element::Map *elemMap = interp_map(mbImpl->type_from_handle(elem),
+                                           num_connect, num_verts);
+  if (!elemMap)
+    return MB_FAILURE;
+  num_verts = std::min(num_verts, num_connect);
+
+  // The interpolated field is linear in the vertex values; the weight
+  // of a vertex is the field interpolated from a unit value on it
+  double unit[27] = {0.0};
+  try {
+    for (int i = 0; i < num_verts; i++) {
+      unit[i] = 1.0;
+      weights.push_back(elemMap->evaluate_scalar_field(nat_coord, unit));
+      unit[i] = 0.0;
+    }
+  }
+  catch (moab::Element::Map::EvaluationError&) {
+    delete elemMap;
+    return MB_FAILURE;
+  }
+  delete elemMap;
+
+  ents.assign(connect, connect + num_verts);
+  return MB_SUCCESS;
+}
+
 // Simplest "interpolation" for element-based source fields. Set the value of the field
 // at the target point to that of the field in the source element it lies in.
 ErrorCode Coupler::constant_interp(EntityHandle elem,
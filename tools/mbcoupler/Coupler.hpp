@@ -215,6 +215,37 @@ public:
                         TupleList *tl = NULL,
                         bool normalize = true);
 
+    /* \brief Assemble the interpolation onto the stored points as a sparse operator
+     * For a fixed source mesh and fixed target points, interpolation is a
+     * linear map from the source field values to the target values.  This
+     * function, called collectively after locate_points has stored the
+     * located points in this object, computes the interpolation weights of
+     * each point once, as a CSR matrix on the source processors, and sets up
+     * the exchange of interpolated values between processors.  Afterwards,
+     * interpolate with this method and no tuple list, and
+     * apply_interpolation_operator, only gather the tag values, multiply by
+     * the matrix and send the results to the target processors.
+     *
+     * The operator is discarded when points are located again.
+     * \param method Interpolation method; CONSTANT, LINEAR_FE, QUADRATIC_FE
+     *    or SPHERICAL (spectral elements are not supported)
+     */
+  ErrorCode assemble_interpolation_operator(Coupler::Method method);
+
+    /* \brief Interpolate data from multiple tags using the assembled operator
+     * Interpolate each tag onto all points stored in this object, with the
+     * operator built by assemble_interpolation_operator.  Results for tag k
+     * at point i are written to interp_vals[k*num_points + i].  Must be
+     * called collectively.
+     *
+     * \param tags Single-valued double tags on source mesh holding data to be interpolated
+     * \param num_tags Number of tags
+     * \param interp_vals Memory holding interpolated data, num_tags*num_points values
+     */
+  ErrorCode apply_interpolation_operator(Tag *tags,
+                                         int num_tags,
+                                         double *interp_vals);
+
     /* \brief Normalize a field over an entire mesh
      * A field existing on the vertices of elements of a mesh is integrated
      * over all elements in the mesh.  The integrated value is normalized
@@ -452,6 +483,14 @@ private:
                             Tag tag,
                             double &field);
 
+    // Get the source entities and weights interpolating a field
+    // at natural coordinates nat_coord in elem
+  ErrorCode interp_weights(Coupler::Method method,
+                           EntityHandle elem,
+                           const CartVect &nat_coord,
+                           std::vector<EntityHandle> &ents,
+                           std::vector<double> &weights);
+
   ErrorCode test_local_box(double *xyz,
                            int from_proc, int remote_index, int index,
                            bool &point_located,
@@ -508,6 +547,33 @@ private:
      */
   TupleList *targetPts;
 
+    /* \brief Sparse interpolation operator
+     * Rows are target points located in this processor's source mesh,
+     * grouped by target processor and sorted by target index within each
+     * group; columns are the source entities whose tag values are
+     * interpolated.
+     */
+  struct InterpOperator {
+      // Method the weights were computed for
+    Method method;
+      // CSR matrix; colIndex indexes into srcEnts
+    std::vector<int> rowPtr;
+    std::vector<int> colIndex;
+    std::vector<double> weights;
+    std::vector<EntityHandle> srcEnts;
+      // Rows sendOffsets[j] to sendOffsets[j+1]-1 go to processor sendProcs[j]
+    std::vector<int> sendProcs;
+    std::vector<int> sendOffsets;
+      // Values received from processor recvProcs[j] are for the target
+      // points recvIndex[recvOffsets[j]] to recvIndex[recvOffsets[j+1]-1]
+    std::vector<int> recvProcs;
+    std::vector<int> recvOffsets;
+    std::vector<int> recvIndex;
+      // Number of target points on this processor
+    unsigned int numPoints;
+  };
+  InterpOperator *interpOp;
+
     /* \brief Number of iterations of tree building before failing
      *
      */
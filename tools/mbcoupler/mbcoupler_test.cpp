@@ -582,6 +582,20 @@ ErrorCode test_interpolation(Interface *mbImpl,
 
   interp_time = MPI_Wtime();
 
+  // Interpolate again with the precomputed operator; results should match
+  if (!specSou && !specTar) {
+    result = mbc.assemble_interpolation_operator(method);MB_CHK_ERR(result);
+    std::vector<double> op_field(numPointsOfInterest);
+    result = mbc.interpolate(method, interpTag, &op_field[0]);MB_CHK_ERR(result);
+    for (int i = 0; i < numPointsOfInterest; i++) {
+      if (fabs(op_field[i] - field[i]) > 1.e-10*std::max(1.0, fabs(field[i]))) {
+        std::cerr << "Interpolation operator differs at point " << i << ": "
+                  << op_field[i] << " vs " << field[i] << std::endl;
+        return MB_FAILURE;
+      }
+    }
+  }
+
   // Do global normalization if specified
   if (!gNormTag.empty()) {
     // Normalize the source mesh
@@ -1,6 +1,7 @@
 #include "moab/Core.hpp"
 #include "moab/ProgOptions.hpp"
 #include "moab/ReorderTool.hpp"
+#include "moab/GeometricPartitioner.hpp"
 
 #ifdef MOAB_HAVE_MPI
 #include "moab/ParallelComm.hpp"
@@ -42,7 +43,9 @@ const char ZOLTAN_OCTPART_METHOD[] = "OCTPART";
 const char METIS_DEFAULT_METHOD[] = "ML_KWAY";
 /* const char METIS_ALTERNATIVE_METHOD[] = "ML_RB"; */
 
-const char BRIEF_DESC[] = "Use Zoltan or Metis to partition MOAB meshes for use on parallel computers";
+const char GEOMETRIC_DEFAULT_METHOD[] = "RCB";
+
+const char BRIEF_DESC[] = "Use Zoltan, Metis or the built-in geometric partitioner to partition MOAB meshes for use on parallel computers";
 std::ostringstream LONG_DESC;
 
 int main(int argc, char* argv[])
@@ -65,13 +68,17 @@ int main(int argc, char* argv[])
 #ifdef MOAB_HAVE_METIS
   bool moab_use_metis=false;
 #endif
+  bool moab_use_geometric=false;
 
-  LONG_DESC << "This utility invokes the ZoltanPartitioner or MetisPartitioner component of MOAB/CGM "
-            "to partition a mesh/geometry." << std::endl
+  LONG_DESC << "This utility invokes the ZoltanPartitioner, MetisPartitioner or GeometricPartitioner "
+            "component of MOAB/CGM to partition a mesh/geometry." << std::endl
             << "If no partitioning method is specified, the defaults are: "
             << "for Zoltan=\"" << DEFAULT_ZOLTAN_METHOD
-            << "\" and Metis=\"" << METIS_DEFAULT_METHOD
-            << " method" << std::endl;
+            << "\", Metis=\"" << METIS_DEFAULT_METHOD
+            << "\" and native=\"" << GEOMETRIC_DEFAULT_METHOD
+            << "\" method" << std::endl
+            << "The built-in geometric partitioner is used when a native method is given, "
+            "or, with a notice, when no method is given at all." << std::endl;
 
   ProgOptions opts(LONG_DESC.str(), BRIEF_DESC);
 
@@ -88,10 +95,10 @@ int main(int argc, char* argv[])
   opts.addOpt<std::string>("parmetis,p", "(Zoltan+PARMetis) Specify PARMetis partition method.", &parm_method);
 #endif // MOAB_HAVE_PARMETIS
   opts.addOpt<std::string>("octpart,o", "(Zoltan) Specify OctPart partition method.", &oct_method);
+#endif // MOAB_HAVE_ZOLTAN
 
   bool incl_closure = false;
   opts.addOpt<void>("include_closure,c", "Include element closure for part sets.", &incl_closure);
-#endif // MOAB_HAVE_ZOLTAN
 
   double imbal_tol = 1.03;
   opts.addOpt<double>("imbalance,i", "Imbalance tolerance (used in PHG/Hypergraph method)", &imbal_tol);
@@ -100,6 +107,9 @@ int main(int argc, char* argv[])
   opts.addOpt<std::string>( "metis,m", "(Metis) Specify Metis partition method. One of ML_RB or ML_KWAY.", &metis_method);
 #endif // MOAB_HAVE_METIS
 
+  std::string geom_method;
+  opts.addOpt<std::string>( "native,n", "(Native) Specify built-in geometric partition method. One of RCB, HILBERT or MORTON.", &geom_method);
+
   bool write_sets = true, write_tags = false;
   opts.addOpt<void>( "sets,s", "Write partition as tagged sets (Default)", &write_sets);
   opts.addOpt<void>( "tags,t",  "Write partition by tagging entities", &write_tags);
@@ -167,17 +177,38 @@ int main(int argc, char* argv[])
 
   opts.parseCommandLine(argc, argv);
 
+  int num_methods = 0;
 #ifdef MOAB_HAVE_ZOLTAN
-  if (!zoltan_method.empty())
+  if (!zoltan_method.empty()) {
     moab_use_zoltan=true;
-  else
+    num_methods++;
+  }
 #endif
 #ifdef MOAB_HAVE_METIS
-    if (!metis_method.empty())
-      moab_use_metis=true;
-    else
+  if (!metis_method.empty()) {
+    moab_use_metis=true;
+    num_methods++;
+  }
 #endif
-  MB_SET_ERR(MB_FAILURE, "Specify either Zoltan or Metis partitioner type");
+  if (!geom_method.empty() || !num_methods) {
+    moab_use_geometric=true;
+    num_methods++;
+  }
+
+  if (num_methods > 1)
+  {
+    std::cerr << "Only one of the Zoltan, Metis or native partition methods can be specified."
+              << std::endl << std::endl;
+    opts.printHelp();
+    return EXIT_FAILURE;
+  }
+
+  if (moab_use_geometric && geom_method.empty())
+  {
+    geom_method = GEOMETRIC_DEFAULT_METHOD;
+    std::cerr << "No partition method specified, using the built-in geometric partitioner with method "
+              << geom_method << " (select one with -n)." << std::endl;
+  }
 
 #ifdef MOAB_HAVE_ZOLTAN
   ZoltanPartitioner *zoltan_tool = NULL;
@@ -257,6 +288,13 @@ int main(int argc, char* argv[])
 
 #endif // MOAB_HAVE_METIS
 
+  GeometricPartitioner *geom_tool = NULL;
+  if (moab_use_geometric) {
+    geom_tool = new GeometricPartitioner (&mb, false);
+    geom_tool->set_global_id_option(assign_global_ids);
+    geom_tool->set_project_on_sphere(spherical_coords);
+  }
+
   if (!write_sets && !write_tags)
     write_sets = true;
 
@@ -393,6 +431,10 @@ int main(int argc, char* argv[])
                                    aggregating_tag.c_str(), print_time);
     }
 #endif
+    if (moab_use_geometric) {
+      rval = geom_tool->partition_mesh( num_parts, geom_method.c_str(), part_dim,
+                                        write_sets, write_tags, false, false, NULL, print_time);
+    }
     if (MB_SUCCESS != rval)
     {
       std::cerr << "Partitioner failed!" << std::endl;
@@ -451,17 +493,26 @@ int main(int argc, char* argv[])
                   << std::endl;
     }
 
-#ifdef MOAB_HAVE_ZOLTAN
     if (incl_closure)
     {
-      rval = zoltan_tool->include_closure();
+      // only the partitioner that was run knows the part sets
+      rval = MB_NOT_IMPLEMENTED;
+#ifdef MOAB_HAVE_ZOLTAN
+      if (moab_use_zoltan)
+        rval = zoltan_tool->include_closure();
+#endif
+#ifdef MOAB_HAVE_METIS
+      if (moab_use_metis)
+        rval = metis_tool->include_closure();
+#endif
+      if (moab_use_geometric)
+        rval = geom_tool->include_closure();
       if (MB_SUCCESS != rval)
       {
         std::cerr << "Closure inclusion failed." << std::endl;
         return 1;
       }
     }
-#endif
 
     std::ostringstream tmp_output_file;
 
@@ -551,6 +602,7 @@ int main(int argc, char* argv[])
 #ifdef MOAB_HAVE_METIS
   delete metis_tool;
 #endif
+  delete geom_tool;
 
 #ifdef MOAB_HAVE_MPI
   err = MPI_Finalize();
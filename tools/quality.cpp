@@ -1,7 +1,7 @@
 #include <iostream>
 #include <stdlib.h>
 #include <vector>
-#include <map>
+#include <algorithm>
 #include <string>
 #include <stdio.h>
 #include <iomanip>
@@ -125,7 +125,6 @@ int main( int argc, char* argv[] )
     if (!num_qualities)
       continue;
     Range owned=entities.subset_by_type(et);
-    std::map<QualityType, double> qualities, minq, maxq;
     int ne_local = (int)owned.size();
     int ne_global = ne_local;
 
@@ -154,67 +153,42 @@ int main( int argc, char* argv[] )
 #endif
     if (ne_global>0)
     {
-      if (ne_local>0)
+      // compute each quality for all entities of this type at once
+      std::vector<QualityType> qtypes;
+      std::vector< std::vector<double> > qvalues;
+      for (int q=0; q<MB_QUALITY_COUNT; q++)
       {
-        Range::iterator  it = owned.begin();
-        rval = vw.all_quality_measures(*it, qualities);
+        QualityType quality_type = (QualityType)q;
+        if (!vw.possible_quality(et, quality_type))
+          continue;
+        qtypes.push_back(quality_type);
+        qvalues.push_back(std::vector<double>());
+        rval = vw.quality_measure(owned, quality_type, qvalues.back());
         if (MB_SUCCESS!=rval )
         {
-          fprintf(stderr, "Error getting quality for entity type %d with id %ld \n", et, (long)mb.id_from_handle(*it) );
+          fprintf(stderr, "Error getting %s for entity type %d \n", vw.quality_name(quality_type), et );
   #ifdef MOAB_HAVE_MPI
           MPI_Finalize();
   #endif
           return 1;
         }
-        if (ofile.is_open())
+      }
+      if (ofile.is_open() && ne_local>0)
+      {
+        // write first header or this entity type, then the values, separated by commas
+        ofile<<" There are " << ne_local << " entities of type " << vw.entity_type_name(et) << " with " <<
+            qtypes.size() << " qualities:\n" << " Entity id ";
+        for (size_t i=0; i<qtypes.size(); i++)
+          ofile<<", " << vw.quality_name(qtypes[i]);
+        ofile<<"\n";
+        size_t j=0;
+        for (Range::iterator it = owned.begin(); it!=owned.end(); ++it, ++j)
         {
-          // write first header or this entity type, then the first values, separated by commas
-          ofile<<" There are " << ne_local << " entities of type " << vw.entity_type_name(et) << " with " <<
-              qualities.size() << " qualities:\n" << " Entity id ";
-          for (std::map<QualityType, double>::iterator qit=qualities.begin(); qit!=qualities.end(); ++qit)
-          {
-            ofile<<", " << vw.quality_name(qit->first);
-          }
-          ofile<<"\n";
           ofile <<  mb.id_from_handle(*it) ;
-          for (std::map<QualityType, double>::iterator qit=qualities.begin(); qit!=qualities.end(); ++qit)
-          {
-            ofile<<", " << qit->second;
-          }
+          for (size_t i=0; i<qtypes.size(); i++)
+            ofile<< ", " << qvalues[i][j];
           ofile<<"\n";
         }
-        minq=qualities; maxq=qualities;
-        ++it;
-        for ( ;it!=owned.end(); ++it)
-        {
-          rval = vw.all_quality_measures(*it, qualities);
-          if (MB_SUCCESS!=rval )
-          {
-            fprintf(stderr, "Error getting quality for entity type %d with id %ld \n", et, (long)mb.id_from_handle(*it) );
-  #ifdef MOAB_HAVE_MPI
-            MPI_Finalize();
-  #endif
-            return 1;
-          }
-          if (ofile.is_open())
-          {
-            ofile <<  mb.id_from_handle(*it) ;
-            for (std::map<QualityType, double>::iterator qit=qualities.begin(); qit!=qualities.end(); ++qit)
-            {
-              ofile<< ", " << qit->second;
-            }
-            ofile<<"\n";
-          }
-          std::map<QualityType, double>::iterator minit=minq.begin();
-          std::map<QualityType, double>::iterator maxit=maxq.begin();
-          for (std::map<QualityType, double>::iterator mit=qualities.begin();
-              mit!=qualities.end();
-              ++mit, ++minit, ++maxit)
-          {
-            if (mit->second > maxit->second) maxit->second = mit->second;
-            if (mit->second < minit->second) minit->second = mit->second;
-          }
-        }
       }
       if (0==proc_id)
       {
@@ -222,18 +196,15 @@ int main( int argc, char* argv[] )
         std::cout <<std::setw(30) << "Quality Name" << std::setw(15) << "    MIN" << std::setw(15) << "  MAX" << "\n";
       }
 
-      QualityType quality_type=MB_EDGE_RATIO;
-      for (int i=0; i<num_qualities; i++, quality_type=(QualityType)(quality_type+1))
+      for (size_t i=0; i<qtypes.size(); i++)
       {
-        while(! (vw.possible_quality(et, quality_type)) && quality_type<MB_QUALITY_COUNT)
-          quality_type=(QualityType)(quality_type+1); // will get them in order
-        const char * name_q = vw.quality_name(quality_type);
+        const char * name_q = vw.quality_name(qtypes[i]);
         double local_min, global_min;
         double local_max, global_max;
         if (ne_local>0)
         {
-          local_min = minq[quality_type];
-          local_max = maxq[quality_type];
+          local_min = *std::min_element(qvalues[i].begin(), qvalues[i].end());
+          local_max = *std::max_element(qvalues[i].begin(), qvalues[i].end());
         }
         else
         {